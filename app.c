@@ -52,6 +52,10 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 		return;
 	}
 
+	latency_Begin((evt_id == gecko_evt_mesh_generic_server_client_request_id) ? LATENCY_EVT_CLIENT_REQUEST :
+				  (evt_id == gecko_evt_hardware_soft_timer_id) ? LATENCY_EVT_SOFT_TIMER : LATENCY_EVT_OTHER,
+				  latency_Arrival());
+
 	switch (evt_id)
 	{
 		/* BTM Gecko boot event. */
@@ -84,38 +88,15 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 		/* BTM hardware software timer event. */
   	  	case gecko_evt_hardware_soft_timer_id:
   	  	{
-			switch (evt->data.evt_hardware_soft_timer.handle)
+			/* The application timers all run on the timer wheel. */
+			if (evt->data.evt_hardware_soft_timer.handle == TIMER_ID_WHEEL)
+			{
+				timerWheel_Run(&app_timer_wheel);
+			}
+
+			else
 			{
-				case TIMER_ID_LCD_UPDATE:
-				{
-					/* Updating the LCD display. */
-					displayUpdate();
-					break;
-				}
-
-				case TIMER_ID_FACTORY_RESET:
-				{
-					/* Perform device (power) reset after factory reset is performed. */
-					gecko_cmd_system_reset(0);
-					break;
-				}
-
-				case TIMER_ID_FRIEND_FIND:
-				{
-					/* Attempt establishing friendship with LPN. */
-					BTSTACK_CHECK_RESPONSE(gecko_cmd_mesh_lpn_establish_friendship(0));
-					break;
-				}
-
-		        case TIMER_ID_RESTART:
-		        {
-		        	/* Perform device reset. */
-		        	gecko_cmd_system_reset(0);
-		        	break;
-		        }
-
-				default:
-					break;
+				handle_ecen5823_timer_event(evt->data.evt_hardware_soft_timer.handle);
 			}
 
 			break;
@@ -179,7 +160,7 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 	    	displayPrintf(DISPLAY_ROW_ACTION, "Provisioning Failed");
 
 	    	/* start a one-shot timer that will trigger soft reset after small delay */
-	    	gecko_cmd_hardware_set_soft_timer(1 * 32768, TIMER_ID_RESTART, 1);
+	    	gecko_set_soft_timer(1 * 32768, TIMER_ID_RESTART, 1);
 
 	    	break;
 	    }
@@ -224,6 +205,8 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 			if (boot_to_dfu)
 			{
 				/* Enter to DFU OTA mode */
+				gecko_flush_alarms();
+				sensorHistory_Flush();
 				gecko_cmd_system_reset(2);
 			}
 
@@ -264,7 +247,7 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
         	displayPrintf(DISPLAY_ROW_CONNECTION, "Friend FAILED");
 
         	/* Trigger timer to attempt establishing the friendship again. */
-			gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(2000), TIMER_ID_FRIEND_FIND, 1);
+			gecko_set_soft_timer(TIMER_MS_2_TIMERTICK(2000), TIMER_ID_FRIEND_FIND, 1);
 
 			break;
         }
@@ -275,7 +258,7 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
         	displayPrintf(DISPLAY_ROW_CONNECTION, "Friend TERM.");
 
         	/* Trigger timer to attempt establishing the friendship again. */
-			gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(2000), TIMER_ID_FRIEND_FIND, 1);
+			gecko_set_soft_timer(TIMER_MS_2_TIMERTICK(2000), TIMER_ID_FRIEND_FIND, 1);
 
 			break;
         }
@@ -283,37 +266,9 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
         /* External signals event. */
 		case gecko_evt_system_external_signal_id:
 		{
-			uint32_t ext_signal;
-			ext_signal = evt->data.evt_system_external_signal.extsignals;
-
-			/* If PB0 pushbutton is pressed, the FN would clear the alarm statuses and refresh the alarm buffer. */
-			if(ext_signal == EXT_SIGNAL_PB0_PRESSED)
-			{
-				/* Clear alarm buffer */
-				alarm_buffer = 0;
-				gecko_store_alarms();
-				reset_print_alarm_buffer();
-			}
-
-			/* If PB1 pushbutton is pressed, the FN would toggle the LCD display (turn on/off) based on its previous state. */
-			if(ext_signal == EXT_SIGNAL_PB1_PRESSED)
-			{
-				static uint8_t LCD_flag = 1;
-
-				if(LCD_flag)
-				{
-					LCD_flag = 0;
-					gpioDisableDisplay();
-				}
-
-				else if(!LCD_flag)
-				{
-					LCD_flag = 1;
-					gpioEnableDisplay();
-					reset_print_alarm_buffer();
-				}
-			}
-
+			/* Only wakes the main loop; gecko_external_evt_handler() takes the
+			 * interrupt events from isr_event_ring one by one, displayFlush()
+			 * the end of an LCD frame. */
 			break;
 		}
 
@@ -337,4 +292,51 @@ void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt)
 			break;
 		}
 	}
+
+	latency_End();
+}
+
+/***************************************************************************//**
+ * Handling of application timer expiry. The timers started with
+ * gecko_set_soft_timer() expire here from the timer wheel.
+ * @param[in] handle  Timer handle (TIMER_ID_*).
+ ******************************************************************************/
+
+void handle_ecen5823_timer_event(uint8_t handle)
+{
+	switch (handle)
+	{
+		case TIMER_ID_FACTORY_RESET:
+		{
+			/* Perform device (power) reset after factory reset is performed. */
+			gecko_cmd_system_reset(0);
+			break;
+		}
+
+		case TIMER_ID_FRIEND_FIND:
+		{
+			/* Attempt establishing friendship with LPN. */
+			BTSTACK_CHECK_RESPONSE(gecko_cmd_mesh_lpn_establish_friendship(0));
+			break;
+		}
+
+		case TIMER_ID_ALARM_FLUSH:
+		{
+			/* Write the coalesced alarm changes to flash memory. */
+			gecko_flush_alarms();
+			break;
+		}
+
+		case TIMER_ID_RESTART:
+		{
+			/* Perform device reset. */
+			gecko_flush_alarms();
+			sensorHistory_Flush();
+			gecko_cmd_system_reset(0);
+			break;
+		}
+
+		default:
+			break;
+	}
 }
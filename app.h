@@ -90,25 +90,21 @@ extern "C" {
 #define TIMER_ID_RETRANS_SCENE      13
 #define TIMER_ID_FRIEND_FIND        20
 #define TIMER_ID_NODE_CONFIGURED    30
-#define TIMER_ID_LCD_UPDATE			99
+#define TIMER_ID_ALARM_FLUSH		40
+#define TIMER_ID_WHEEL				50			// Stack soft timer behind app_timer_wheel
 
 /*******************************************************************************
  * LPN addresses/indexes.
  ******************************************************************************/
 /* Address 0x01 will be given to the FN. */
 
+/* These three LPNs have an LCD row each and are registered first, in this
+ * order, so that slots 0-2 keep the bit layout of the old alarm byte. Any
+ * other LPN is registered on its first message. */
 #define LPN_MOISTURE_ADDR				0x02
 #define LPN_ALIGHT_ADDR					0x03
 #define LPN_UVLIGHT_ADDR				0x04
 
-#define LPN_MOISTURE_SET_ALARM_FLAG		0x01
-#define LPN_ALIGHT_SET_ALARM_FLAG		0x02
-#define LPN_UVLIGHT_SET_ALARM_FLAG		0x04
-
-#define LPN_MOISTURE_CLEAR_ALARM_FLAG	0xFE
-#define LPN_ALIGHT_CLEAR_ALARM_FLAG		0xFD
-#define LPN_UVLIGHT_CLEAR_ALARM_FLAG	0xFB
-
 /*******************************************************************************
  * Alarm definitions.
  ******************************************************************************/
@@ -118,10 +114,18 @@ extern "C" {
 /*******************************************************************************
  * Flash (Persistent Data) definitions.
  ******************************************************************************/
-#define FLASH_ADDR			0x4000
-#define FLASH_DATA_LENGTH	1
+#define FLASH_ADDR			0x4000		// Alarm bitset, one bit per LPN slot
+#define FLASH_LPN_ADDR		0x4001		// First key of the registered LPN addresses
+#define FLASH_LPN_CHUNK		28			// LPN addresses per key (56 byte PS value)
+#define FLASH_LPN_KEYS		((LPN_REGISTRY_MAX + FLASH_LPN_CHUNK - 1) / FLASH_LPN_CHUNK)
 #define FLASH_OP_FAILED		0x0502
 
+/* Alarm changes are written behind: the first change arms a one-shot timer
+ * and every change until it fires goes out in the same flash write. */
+#ifndef ALARM_FLUSH_DELAY_MS
+#define ALARM_FLUSH_DELAY_MS	5000
+#endif
+
 /*******************************************************************************
  * General defines.
  ******************************************************************************/
@@ -144,8 +148,8 @@ uint8_t num_connections;
 /// Flag for indicating that initialization was performed
 uint8_t boot_to_dfu;
 
-/// Alarm buffers that keeps a record of the alarms since last provisioning.
-uint8_t alarm_buffer;
+/// LPNs served by the friend node and their alarms since last provisioning.
+lpn_registry_t lpn_registry;
 
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION PROTOTYPES
@@ -159,6 +163,13 @@ uint8_t alarm_buffer;
  ******************************************************************************/
 void handle_ecen5823_gecko_event(uint32_t evt_id, struct gecko_cmd_packet *evt);
 
+/***************************************************************************//**
+ * Handling of application timer expiry, for the timers started with
+ * gecko_set_soft_timer().
+ * @param[in] handle  Timer handle (TIMER_ID_*).
+ ******************************************************************************/
+void handle_ecen5823_timer_event(uint8_t handle);
+
 #ifdef __cplusplus
 };
 #endif
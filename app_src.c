@@ -45,6 +45,51 @@
 
 #include "app_src.h"
 
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* LPNs with an LCD row, registered into slots 0-2 in this order. */
+static const struct
+{
+	uint16_t addr;
+	uint8_t row;
+	const char *label;
+} lpn_displays[] =
+{
+	{ LPN_MOISTURE_ADDR,	DISPLAY_ROW_LPN_MOISTURE,	"MOT" },
+	{ LPN_ALIGHT_ADDR,		DISPLAY_ROW_LPN_ALIGHT,		"ALT" },
+	{ LPN_UVLIGHT_ADDR,		DISPLAY_ROW_LPN_UVLIGHT,	"UVLT" },
+};
+
+#define LPN_DISPLAY_COUNT	(sizeof(lpn_displays) / sizeof(lpn_displays[0]))
+
+alarm_store_stats_t alarm_store_stats;
+bool alarms_dirty;
+
+/* Event that first made the pending alarm write dirty, for the latency histograms. */
+static latency_mark_t alarm_store_mark;
+
+timer_wheel_t app_timer_wheel;
+
+/* Handles of the application timers, each a timer on app_timer_wheel. */
+static const uint8_t app_timer_handles[] =
+{
+	TIMER_ID_FACTORY_RESET,
+	TIMER_ID_FRIEND_FIND,
+	TIMER_ID_ALARM_FLUSH,
+	TIMER_ID_RESTART,
+};
+
+#define APP_TIMER_COUNT		(sizeof(app_timer_handles) / sizeof(app_timer_handles[0]))
+
+static timer_wheel_timer_t app_timers[APP_TIMER_COUNT];
+
+/* LCD EXTCOMIN toggle and energy mode report, sharing the sampling wakeups.
+ * The report has an activity of its own so that it goes on with the LCD off. */
+static wakeup_activity_t lcd_activity;
+static wakeup_activity_t profile_activity;
+
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
@@ -79,70 +124,45 @@ void Friend_RequestHandler(uint16_t model_id,
                           uint8_t request_flags)
 {
 	uint16_t level;
+	uint16_t slot;
 	level = (uint16_t) (request->level);
 
+	/* Look up the LPN, registering it on its first message. */
+	slot = mesh_friend_RegisterLPN(client_addr);
+
 	if(level == ALARM_SET)
-		alarm_buffer = mesh_friend_AlarmHandler(client_addr, TRUE);
+		mesh_friend_AlarmHandler(client_addr, TRUE);
 
 	else if(level == ALARM_CLEARED)
-		alarm_buffer = mesh_friend_AlarmHandler(client_addr, FALSE);
+		mesh_friend_AlarmHandler(client_addr, FALSE);
 
 	else
-		gecko_store_alarms();
-
-	switch(client_addr)
 	{
-		case LPN_MOISTURE_ADDR:
-		{
-			if(!(alarm_buffer & LPN_MOISTURE_SET_ALARM_FLAG))
-			{
-				if(level == ALARM_CLEARED)
-					displayPrintf(DISPLAY_ROW_LPN_MOISTURE, "MOT: ALARM CLEARED");
-				else
-					displayPrintf(DISPLAY_ROW_LPN_MOISTURE, "MOT (%): %d", level);
-			}
-			else
-			{
-				displayPrintf(DISPLAY_ROW_LPN_MOISTURE, "MOT: ALARM");
-			}
-			break;
-		}
+		gecko_schedule_alarm_store(FALSE);
 
-		case LPN_ALIGHT_ADDR:
+		/* Keep the reading; LPN slots past the tracked channels are counted as dropped. */
+		if(slot != LPN_SLOT_INVALID)
+			timeSeries_Insert(&sensor_series, SENSOR_SERIES_LPN(slot), SENSOR_SERIES_NOW(), (int16_t) level);
+		sensorHistory_Append(client_addr, SENSOR_SERIES_NOW(), (int16_t) level);
+	}
+
+	/* Only the first LPNs have an LCD row. */
+	if(slot < LPN_DISPLAY_COUNT)
+	{
+		if(!lpnRegistry_AlarmGet(&lpn_registry, slot))
 		{
-			if(!(alarm_buffer & LPN_ALIGHT_SET_ALARM_FLAG))
-			{
-				if(level == ALARM_CLEARED)
-					displayPrintf(DISPLAY_ROW_LPN_ALIGHT, "ALT: ALARM CLEARED");
-				else
-					displayPrintf(DISPLAY_ROW_LPN_ALIGHT, "ALT (%): %d", level);
-			}
+			if(level == ALARM_CLEARED)
+				displayPrintf(lpn_displays[slot].row, "%s: ALARM CLEARED", lpn_displays[slot].label);
 			else
-			{
-				displayPrintf(DISPLAY_ROW_LPN_ALIGHT, "ALT: ALARM");
-			}
-			break;
+				displayPrintf(lpn_displays[slot].row, "%s (%%): %d", lpn_displays[slot].label, level);
 		}
-
-		case LPN_UVLIGHT_ADDR:
+		else
 		{
-			if(!(alarm_buffer & LPN_UVLIGHT_SET_ALARM_FLAG))
-			{
-				if(level == ALARM_CLEARED)
-					displayPrintf(DISPLAY_ROW_LPN_UVLIGHT, "UVLT: ALARM CLEARED");
-				else
-					displayPrintf(DISPLAY_ROW_LPN_UVLIGHT, "UVLT (%): %d", level);
-			}
-			else
-			{
-				displayPrintf(DISPLAY_ROW_LPN_UVLIGHT, "UVLT: ALARM");
-			}
-			break;
+			displayPrintf(lpn_displays[slot].row, "%s: ALARM", lpn_displays[slot].label);
 		}
-
-		default:
-			break;
 	}
+
+	latency_Complete(LATENCY_REQUEST_DONE);
 }
 
 /***************************************************************************//**
@@ -151,76 +171,141 @@ void Friend_RequestHandler(uint16_t model_id,
 
 void reset_print_alarm_buffer(void)
 {
-	if(alarm_buffer & LPN_MOISTURE_SET_ALARM_FLAG)
-		displayPrintf(DISPLAY_ROW_LPN_MOISTURE, "MOT: ALARM");
-	else
-		displayPrintf(DISPLAY_ROW_LPN_MOISTURE, "-");
-
-
-	if(alarm_buffer & LPN_ALIGHT_SET_ALARM_FLAG)
-		displayPrintf(DISPLAY_ROW_LPN_ALIGHT, "ALT: ALARM");
-	else
-		displayPrintf(DISPLAY_ROW_LPN_ALIGHT, "-");
-
+	for(uint8_t i = 0; i < LPN_DISPLAY_COUNT; i++)
+	{
+		uint16_t slot = lpnRegistry_Find(&lpn_registry, lpn_displays[i].addr);
 
-	if(alarm_buffer & LPN_UVLIGHT_SET_ALARM_FLAG)
-		displayPrintf(DISPLAY_ROW_LPN_UVLIGHT, "UVLT: ALARM");
-	else
-		displayPrintf(DISPLAY_ROW_LPN_UVLIGHT, "-");
+		if(lpnRegistry_AlarmGet(&lpn_registry, slot))
+			displayPrintf(lpn_displays[i].row, "%s: ALARM", lpn_displays[i].label);
+		else
+			displayPrintf(lpn_displays[i].row, "-");
+	}
 }
 
 /***************************************************************************//**
- * This function is a handler for generic level alarm statuses. It handles
- * the acquired alarms and updates persistent data and the LCD display.
+ * This function handles a push button edge queued by the GPIO interrupt.
  *
- * @param[in] client_addr    Address of the BTM LPN client.
- * @param[in] alarm  		 Boolean variable stating if alarm needs to
- * 							 be set or cleared.
+ * PB0 released: the FN clears the alarm statuses and refreshes the alarm buffer.
+ * PB1 pressed: the FN toggles the LCD display (turn on/off).
+ * PB1 pressed while PB0 is held: the FN dumps the latency histograms to the log,
+ * and the release of PB0 then does nothing.
+ *
+ * @param[in] event      ISR_EVENT_PB0 or ISR_EVENT_PB1.
+ * @param[in] pressed    True for the press, false for the release.
  ******************************************************************************/
 
-uint8_t mesh_friend_AlarmHandler(uint16_t client_addr, bool alarm)
+void gecko_button_handler(uint8_t event, bool pressed)
 {
-	uint8_t temp_alarm_flag;
-	temp_alarm_flag = alarm_buffer;
+	/* Set when PB1 was pressed while PB0 was held. */
+	static bool pb0_chord = false;
 
-	switch(client_addr)
+	if(event == ISR_EVENT_PB0)
 	{
-		case LPN_MOISTURE_ADDR:
+		if(pressed)
 		{
-			if(alarm)
-				temp_alarm_flag |= LPN_MOISTURE_SET_ALARM_FLAG;
-			else
-				temp_alarm_flag &= LPN_MOISTURE_CLEAR_ALARM_FLAG;
-
-			break;
+			pb0_chord = false;
+			return;
 		}
 
-		case LPN_ALIGHT_ADDR:
+		if(pb0_chord)
 		{
-			if(alarm)
-				temp_alarm_flag |= LPN_ALIGHT_SET_ALARM_FLAG;
-			else
-				temp_alarm_flag &= LPN_ALIGHT_CLEAR_ALARM_FLAG;
-
-			break;
+			pb0_chord = false;
+			return;
 		}
 
-		case LPN_UVLIGHT_ADDR:
+		/* Clear alarm buffer */
+		uint16_t cleared = lpnRegistry_AlarmCount(&lpn_registry);
+		lpnRegistry_AlarmClearAll(&lpn_registry);
+		gecko_schedule_alarm_store(cleared != 0);
+
+		if(cleared)
+			alarmJournal_Append(0, cleared, ALARM_JOURNAL_RESET);
+		reset_print_alarm_buffer();
+		return;
+	}
+
+	if(!pressed)
+		return;
+
+	/* PB1 pressed while PB0 is held dumps the latency histograms instead. */
+	if(event == ISR_EVENT_PB1 && PB0_val == BUTTON_PRESSED)
+	{
+		pb0_chord = true;
+		logLatency();
+		return;
+	}
+
+	/* PB1 powers the LCD down or up. While it is down the rows are only
+	 * kept as text and EXTCOMIN is left alone. */
+	if(event == ISR_EVENT_PB1)
+	{
+		if(displayPowered())
 		{
-			if(alarm)
-				temp_alarm_flag |= LPN_UVLIGHT_SET_ALARM_FLAG;
-			else
-				temp_alarm_flag &= LPN_UVLIGHT_CLEAR_ALARM_FLAG;
+			displaySetPower(false);
+			wakeup_Stop(&lcd_activity);
+		}
 
-			break;
+		else
+		{
+			displaySetPower(true);
+			if(timerEnabled1HzSchedulerEvent)
+				wakeup_Start(&lcd_activity);
+			reset_print_alarm_buffer();
 		}
+	}
+}
 
-		default:
-			break;
+/***************************************************************************//**
+ * This function looks up the registry slot of an LPN. LPNs are registered on
+ * their first message and their address is stored to the flash memory so
+ * that the slot, and with it the alarm bit, survives a power cycle.
+ *
+ * @param[in] client_addr    Address of the BTM LPN client.
+ * @return Registry slot or LPN_SLOT_INVALID if the registry is full.
+ ******************************************************************************/
+
+uint16_t mesh_friend_RegisterLPN(uint16_t client_addr)
+{
+	uint16_t slot;
+
+	slot = lpnRegistry_Find(&lpn_registry, client_addr);
+	if(slot != LPN_SLOT_INVALID)
+		return slot;
+
+	slot = lpnRegistry_Add(&lpn_registry, client_addr);
+	if(slot == LPN_SLOT_INVALID)
+	{
+		LOG_WARN("LPN registry full, 0x%04x not tracked.", client_addr);
 	}
+	else
+		gecko_store_lpn(slot);
 
-	gecko_store_alarms();
-	return temp_alarm_flag;
+	return slot;
+}
+
+/***************************************************************************//**
+ * This function is a handler for generic level alarm statuses. It handles
+ * the acquired alarms, journals every change and schedules a persistent
+ * data update.
+ *
+ * @param[in] client_addr    Address of the BTM LPN client.
+ * @param[in] alarm  		 Boolean variable stating if alarm needs to
+ * 							 be set or cleared.
+ * @return True if the alarm status of the LPN changed.
+ ******************************************************************************/
+
+bool mesh_friend_AlarmHandler(uint16_t client_addr, bool alarm)
+{
+	bool changed;
+	changed = lpnRegistry_AlarmSet(&lpn_registry, lpnRegistry_Find(&lpn_registry, client_addr), alarm);
+
+	/* Only transitions are journaled, repeated alarm messages are not. */
+	if(changed)
+		alarmJournal_Append(client_addr, alarm ? ALARM_SET : ALARM_CLEARED,
+							alarm ? ALARM_JOURNAL_SET : ALARM_JOURNAL_CLEARED);
+
+	gecko_schedule_alarm_store(changed);
+	return changed;
 }
 
 /***************************************************************************//**
@@ -292,11 +377,15 @@ void initiate_factory_reset(void)
 		gecko_cmd_le_connection_close(conn_handle);
 	}
 
+	/* The alarms are erased along with everything else, do not write them back. */
+	gecko_discard_alarm_store();
+	alarmJournal_Erase();
+
 	/* Perform flash memory erase for device factory reset by removing provisioning information. */
 	BTSTACK_CHECK_RESPONSE(gecko_cmd_flash_ps_erase_all());
 
 	// reboot after a small delay
-	gecko_cmd_hardware_set_soft_timer(2 * 32768, TIMER_ID_FACTORY_RESET, 1);
+	gecko_set_soft_timer(2 * 32768, TIMER_ID_FACTORY_RESET, 1);
 }
 
 /***************************************************************************//**
@@ -322,10 +411,10 @@ void LCD_clearData(void)
 
 void set_device_name(bd_addr *pAddr)
 {
-	char name[20];
+	char name[32];
 
 	// create unique device name using the last two bytes of the Bluetooth address
-	sprintf(name, "Friend Node (Rushi) - %02x:%02x", pAddr->addr[1], pAddr->addr[0]);
+	snprintf(name, sizeof(name), "Friend Node (Rushi) - %02x:%02x", pAddr->addr[1], pAddr->addr[0]);
 
 	// write device name to the GATT database
 	BTSTACK_CHECK_RESPONSE(gecko_cmd_gatt_server_write_attribute_value(gattdb_device_name, 0, strlen(name), (uint8_t *)name));
@@ -354,8 +443,91 @@ void gecko_MeshInit(void)
 
 void gecko_store_alarms(void)
 {
+	uint8_t data[LPN_ALARM_BYTES(LPN_REGISTRY_MAX)];
+	uint16_t len;
+
+	/* Only the bytes covering registered LPNs are stored, at least one. */
+	len = lpnRegistry_AlarmExport(&lpn_registry, data, sizeof(data));
+	if(!len)
+	{
+		data[0] = 0;
+		len = 1;
+	}
+
 	/* Save persistent data (alarm buffer) to flash memory. */
-	BTSTACK_CHECK_RESPONSE(gecko_cmd_flash_ps_save(FLASH_ADDR, FLASH_DATA_LENGTH, &alarm_buffer));
+	BTSTACK_CHECK_RESPONSE(gecko_cmd_flash_ps_save(FLASH_ADDR, len, data));
+
+	alarm_store_stats.writes++;
+	alarm_store_stats.bytes += len;
+
+	/* Charged to the LPN message that made the alarms dirty, if any. */
+	if(alarm_store_mark.valid)
+	{
+		latency_CompleteMark(LATENCY_ALARMS_STORED, &alarm_store_mark);
+		alarm_store_mark.valid = false;
+	}
+	else
+		latency_Complete(LATENCY_ALARMS_STORED);
+}
+
+/***************************************************************************//**
+ * This function requests a persistent data update after an LPN message.
+ * Requests that changed nothing are dropped. The first change marks the
+ * alarms dirty and arms the flush timer; later changes ride along with the
+ * pending write, so a burst costs one flash write per ALARM_FLUSH_DELAY_MS.
+ *
+ * @param[in] changed    True if the alarms in RAM changed.
+ ******************************************************************************/
+
+void gecko_schedule_alarm_store(bool changed)
+{
+	alarm_store_stats.requests++;
+
+	if(!changed)
+	{
+		alarm_store_stats.unchanged++;
+		return;
+	}
+
+	if(alarms_dirty)
+	{
+		alarm_store_stats.coalesced++;
+		return;
+	}
+
+	alarms_dirty = TRUE;
+	latency_Current(&alarm_store_mark);
+	gecko_set_soft_timer(TIMER_MS_2_TIMERTICK(ALARM_FLUSH_DELAY_MS), TIMER_ID_ALARM_FLUSH, 1);
+}
+
+/***************************************************************************//**
+ * This function writes dirty alarms to the flash memory. It runs when the
+ * flush timer expires and before every device reset.
+ ******************************************************************************/
+
+void gecko_flush_alarms(void)
+{
+	if(!alarms_dirty)
+		return;
+
+	gecko_set_soft_timer(TIMER_STOP, TIMER_ID_ALARM_FLUSH, 1);
+	alarms_dirty = FALSE;
+	gecko_store_alarms();
+
+	LOG_INFO("Alarms stored: %lu writes, %lu requests avoided", (unsigned long) alarm_store_stats.writes,
+			 (unsigned long) (alarm_store_stats.unchanged + alarm_store_stats.coalesced));
+}
+
+/***************************************************************************//**
+ * This function drops a pending alarm write, e.g. when the flash memory is
+ * being erased for a factory reset.
+ ******************************************************************************/
+
+void gecko_discard_alarm_store(void)
+{
+	gecko_set_soft_timer(TIMER_STOP, TIMER_ID_ALARM_FLUSH, 1);
+	alarms_dirty = FALSE;
+	alarm_store_mark.valid = false;
 }
 
 /***************************************************************************//**
@@ -364,6 +536,9 @@ void gecko_store_alarms(void)
 
 void gecko_load_alarms(void)
 {
+	/* Restore the LPN slots first so that the stored alarm bits line up. */
+	gecko_load_lpns();
+
 	/* Load persistent data (alarm buffer) from flash memory. */
 
     uint16_t result;
@@ -371,22 +546,90 @@ void gecko_load_alarms(void)
 	struct gecko_msg_flash_ps_load_rsp_t* flash_result;
     flash_result = gecko_cmd_flash_ps_load(FLASH_ADDR);
 
-    alarm_buffer = flash_result->value.data[0];
-
     result = flash_result->result;
     if(result)
 	{
+		lpnRegistry_AlarmClearAll(&lpn_registry);
+
 		if(result == FLASH_OP_FAILED)
 		{
-			alarm_buffer = 0;
 			gecko_store_alarms();
-			gecko_load_alarms();
 		}
 		else
 		{
 			LOG_ERROR("Flash operation failed.");
 		}
 	}
+    else
+    {
+    	lpnRegistry_AlarmImport(&lpn_registry, flash_result->value.data, flash_result->value.len);
+    }
+}
+
+/***************************************************************************//**
+ * This function stores the address of a registered LPN to the flash memory.
+ * Addresses are kept in slot order, FLASH_LPN_CHUNK per key, starting after
+ * the LPNs with an LCD row; only the key holding the slot is rewritten.
+ *
+ * @param[in] slot       Registry slot of the LPN.
+ ******************************************************************************/
+
+void gecko_store_lpn(uint16_t slot)
+{
+	uint8_t data[FLASH_LPN_CHUNK * 2];
+	uint16_t chunk, first, count;
+
+	if(slot < LPN_DISPLAY_COUNT || slot >= lpn_registry.count)
+		return;
+
+	chunk = (slot - LPN_DISPLAY_COUNT) / FLASH_LPN_CHUNK;
+	first = LPN_DISPLAY_COUNT + chunk * FLASH_LPN_CHUNK;
+	count = lpn_registry.count - first;
+	if(count > FLASH_LPN_CHUNK)
+		count = FLASH_LPN_CHUNK;
+
+	for(uint16_t i = 0; i < count; i++)
+	{
+		uint16_t addr = lpnRegistry_Addr(&lpn_registry, first + i);
+
+		data[2 * i] = (uint8_t) addr;
+		data[2 * i + 1] = (uint8_t) (addr >> 8);
+	}
+
+	BTSTACK_CHECK_RESPONSE(gecko_cmd_flash_ps_save(FLASH_LPN_ADDR + chunk, count * 2, data));
+}
+
+/***************************************************************************//**
+ * This function rebuilds the LPN registry: the LPNs with an LCD row first,
+ * then the LPNs stored by gecko_store_lpn() in their original slot order.
+ ******************************************************************************/
+
+void gecko_load_lpns(void)
+{
+	struct gecko_msg_flash_ps_load_rsp_t* flash_result;
+
+	lpnRegistry_Init(&lpn_registry);
+
+	for(uint8_t i = 0; i < LPN_DISPLAY_COUNT; i++)
+	{
+		lpnRegistry_Add(&lpn_registry, lpn_displays[i].addr);
+	}
+
+	for(uint16_t chunk = 0; chunk < FLASH_LPN_KEYS; chunk++)
+	{
+		flash_result = gecko_cmd_flash_ps_load(FLASH_LPN_ADDR + chunk);
+		if(flash_result->result)
+			break;
+
+		for(uint8_t i = 0; i + 1 < flash_result->value.len; i += 2)
+		{
+			lpnRegistry_Add(&lpn_registry, flash_result->value.data[i] | (flash_result->value.data[i + 1] << 8));
+		}
+
+		/* A partly filled key is the last one. */
+		if(flash_result->value.len < FLASH_LPN_CHUNK * 2)
+			break;
+	}
 }
 
 /***************************************************************************//**
@@ -419,5 +662,98 @@ void gecko_device_reset(void)
 	gecko_ecen5823_PrintDeviceAddress();
 
 	if(timerEnabled1HzSchedulerEvent)
-		gecko_cmd_hardware_set_soft_timer(32768, TIMER_ID_LCD_UPDATE, 0);
+	{
+		wakeup_Start(&profile_activity);
+		if(displayPowered())
+			wakeup_Start(&lcd_activity);
+	}
+}
+
+/***************************************************************************//**
+ * This function programs the stack soft timer behind the timer wheel.
+ ******************************************************************************/
+
+static void gecko_timer_wheel_arm(uint32_t ticks)
+{
+	gecko_cmd_hardware_set_soft_timer(TIMER_WHEEL_TO_RTCC(ticks), TIMER_ID_WHEEL, 1);
+}
+
+/***************************************************************************//**
+ * This function hands an expired application timer to the event handler.
+ ******************************************************************************/
+
+static void gecko_timer_expired(timer_wheel_timer_t *timer)
+{
+	handle_ecen5823_timer_event((uint8_t) (uintptr_t) timer->context);
+}
+
+/***************************************************************************//**
+ * This function runs the LCD activity: it toggles EXTCOMIN about once a
+ * second.
+ ******************************************************************************/
+
+static void gecko_lcd_tick(void *context)
+{
+	/* Updating the LCD display. */
+	displayUpdate();
+}
+
+/***************************************************************************//**
+ * This function runs the energy mode profile activity once a minute, whether
+ * the LCD is powered or not.
+ ******************************************************************************/
+
+static void gecko_profile_tick(void *context)
+{
+	/* Periodic energy mode residency report over the log. */
+	sleepProfile_Tick();
+}
+
+/***************************************************************************//**
+ * This function sets up the timer wheel on the RTCC and the LCD and energy
+ * mode profile activities on the wakeup coordinator, before any application
+ * timer is started.
+ ******************************************************************************/
+
+void gecko_timers_init(void)
+{
+	timerWheel_Init(&app_timer_wheel, NULL, gecko_timer_wheel_arm);
+
+	for(uint8_t i = 0; i < APP_TIMER_COUNT; i++)
+		timerWheel_Setup(&app_timers[i], gecko_timer_expired, (void *) (uintptr_t) app_timer_handles[i]);
+
+	wakeup_Setup(&lcd_activity, "lcd extcomin", gecko_lcd_tick, NULL, WAKEUP_LCD_PERIOD_MS, WAKEUP_LCD_SLACK_MS, false);
+	wakeup_Setup(&profile_activity, "sleep profile", gecko_profile_tick, NULL, WAKEUP_PROFILE_PERIOD_MS,
+				 WAKEUP_PROFILE_SLACK_MS, false);
+}
+
+/***************************************************************************//**
+ * This function starts or stops an application timer. It takes the same
+ * arguments as gecko_cmd_hardware_set_soft_timer() but runs the timer on
+ * the timer wheel, so that all of them share one stack soft timer; it
+ * expires into handle_ecen5823_timer_event(). A handle with no wheel timer
+ * goes to the stack as before.
+ *
+ * @param[in] time         Delay in 32768 Hz ticks, TIMER_STOP to stop.
+ * @param[in] handle       Timer handle (TIMER_ID_*).
+ * @param[in] single_shot  Zero for a periodic timer.
+ ******************************************************************************/
+
+void gecko_set_soft_timer(uint32_t time, uint8_t handle, uint8_t single_shot)
+{
+	uint32_t ticks = TIMER_WHEEL_FROM_RTCC(time);
+
+	for(uint8_t i = 0; i < APP_TIMER_COUNT; i++)
+	{
+		if(app_timer_handles[i] != handle)
+			continue;
+
+		if(time == TIMER_STOP)
+			timerWheel_Stop(&app_timer_wheel, &app_timers[i]);
+		else
+			timerWheel_Start(&app_timer_wheel, &app_timers[i], ticks, single_shot ? 0 : ticks);
+		return;
+	}
+
+	gecko_cmd_hardware_set_soft_timer(time, handle, single_shot);
 }
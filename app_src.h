@@ -65,8 +65,26 @@ extern uint8_t num_connections;
 /// Flag for indicating that initialization was performed
 extern uint8_t boot_to_dfu;
 
-/// Alarm buffers that keeps a record of the alarms since last provisioning.
-extern uint8_t alarm_buffer;
+/// LPNs served by the friend node and their alarms since last provisioning.
+extern lpn_registry_t lpn_registry;
+
+/// Alarm persistence counters (write-behind cache).
+typedef struct
+{
+	uint32_t requests;				// Level messages and alarm clears seen
+	uint32_t unchanged;				// ... that left the alarms as they were
+	uint32_t coalesced;				// ... that changed them while a write was pending
+	uint32_t writes;				// flash_ps_save calls for the alarm key
+	uint32_t bytes;					// Alarm bytes written (flash wear)
+} alarm_store_stats_t;
+
+extern alarm_store_stats_t alarm_store_stats;
+
+/// Set while the alarms in RAM are newer than the ones in flash.
+extern bool alarms_dirty;
+
+/// Application software timers, all on the TIMER_ID_WHEEL stack soft timer.
+extern timer_wheel_t app_timer_wheel;
 
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION PROTOTYPES
@@ -80,11 +98,23 @@ void gecko_device_reset(void);
 void LCD_clearData(void);
 void gecko_load_alarms(void);
 void gecko_store_alarms(void);
-uint8_t mesh_friend_AlarmHandler(uint16_t client_addr, bool alarm);
+void gecko_schedule_alarm_store(bool changed);
+void gecko_flush_alarms(void);
+void gecko_discard_alarm_store(void);
+void gecko_load_lpns(void);
+void gecko_store_lpn(uint16_t slot);
+uint16_t mesh_friend_RegisterLPN(uint16_t client_addr);
+bool mesh_friend_AlarmHandler(uint16_t client_addr, bool alarm);
 void reset_print_alarm_buffer(void);
+void gecko_button_handler(uint8_t event, bool pressed);
+void gecko_timers_init(void);
+void gecko_set_soft_timer(uint32_t time, uint8_t handle, uint8_t single_shot);
 void gecko_UpdateConnections(void);
 void gecko_MeshInit(void);
 
+struct mesh_generic_request;
+struct mesh_generic_state;
+
 void Friend_RequestHandler	(uint16_t model_id,
                           	 uint16_t element_index,
 							 uint16_t client_addr,
@@ -37,7 +37,17 @@
 /* Specify the size of the static pixel matrix pool. For the weatherstation demo
  *  we need one pixel matrix (framebuffer) covering the whole display.
  */
-#define PIXEL_MATRIX_POOL_SIZE   (DISPLAY0_HEIGHT * DISPLAY0_WIDTH / 8)
+#define PIXEL_MATRIX_POOL_SIZE   (DISPLAY0_HEIGHT * (DISPLAY0_WIDTH / 8 + 2))
+
+/* Keep the 2 control bytes of every line (dummy byte and address of the
+ * next line) in the frame buffer, so a run of dirty lines is one block of
+ * memory, ready to send as it is. */
+#define USE_CONTROL_BYTES
+
+/* Send the frames by LDMA: DMD_updateDisplay() only queues the dirty lines
+ * and DISPLAY_Ls013b7dh03Flush() sends them in the background. The channel
+ * and descriptors are set in dmadrv_config.h. */
+#define PAL_SPI_USE_DMA
 
 /* On EFM32ZG_STK3200, the DISPLAY driver Platform Abstraction Layer (PAL)
  * uses the RTC to time and toggle the EXTCOMIN pin of the Sharp memory
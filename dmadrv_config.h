@@ -69,6 +69,23 @@
 #define EMDRV_DMADRV_DMA_CH_COUNT DMA_CHAN_COUNT
 #endif
 
+/// Display PAL LDMA channel configuration option.
+/// Channel that streams LCD frames to the display USART
+/// (PAL_SpiTransmitList()). Range 0..EMDRV_DMADRV_DMA_CH_COUNT - 1; the
+/// last channel is left to the display so DMADRV hands out the others first.
+#ifndef PAL_SPI_DMA_CHANNEL
+#define PAL_SPI_DMA_CHANNEL (EMDRV_DMADRV_DMA_CH_COUNT - 1)
+#endif
+
+/// Display PAL LDMA descriptor count configuration option.
+/// Linked descriptors for one LCD frame: one per block of the list, more
+/// for blocks over 2048 bytes. The LS013B7DH03 needs one for its command
+/// and one per run of dirty lines, at most 1 + 128 / 2. Each takes 16 bytes
+/// of RAM.
+#ifndef PAL_SPI_DMA_DESCRIPTORS
+#define PAL_SPI_DMA_DESCRIPTORS 66
+#endif
+
 /** @} (end addtogroup DMADRV) */
 /** @} (end addtogroup emdrv) */
 
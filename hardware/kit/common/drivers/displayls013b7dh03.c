@@ -79,6 +79,18 @@
 
 #endif /*  PIXEL_MATRIX_ALLOC_SUPPORT  */
 
+#ifdef PAL_SPI_USE_DMA
+  #ifndef USE_CONTROL_BYTES
+    #error PAL_SPI_USE_DMA sends runs of lines with their control bytes, define USE_CONTROL_BYTES.
+  #endif
+  #ifdef EMWIN_WORKAROUND
+    #error PAL_SPI_USE_DMA needs lines without a stride gap.
+  #endif
+
+/* Update command, then at most one run of dirty lines in every other line. */
+#define LS013B7DH03_FRAME_BLOCKS  (1 + LS013B7DH03_HEIGHT / 2)
+#endif
+
 /*******************************************************************************
  *********************************  TYPEDEFS  **********************************
  ******************************************************************************/
@@ -116,6 +128,19 @@ static PixelMatrixAlign_t* pixelMatrixPool = pixelMatrixPoolBase;
 #endif
 #endif
 
+#ifdef PAL_SPI_USE_DMA
+/* The frame queued by PixelMatrixDraw(): the update command and first line
+   address, then one block per run of dirty lines. */
+static uint16_t        frameCmd;
+static PAL_SpiBlock_t  frameBlocks[LS013B7DH03_FRAME_BLOCKS];
+static unsigned int    frameBlockCount;
+/* Next line address byte of the last line queued. */
+static uint8_t*        frameLastAddress;
+static volatile bool   frameBusy;
+static void          (*frameDone)(void*, EMSTATUS);
+static void*           frameDoneArg;
+#endif
+
 /*******************************************************************************
  ************************   STATIC FUNCTION PROTOTYPES   ***********************
  ******************************************************************************/
@@ -152,6 +177,9 @@ static EMSTATUS PixelMatrixClear(DISPLAY_Device_t*      device,
                                  unsigned int           width,
                                  unsigned int           height);
 static EMSTATUS DriverRefresh (DISPLAY_Device_t* device);
+#ifdef PAL_SPI_USE_DMA
+static void FrameSent(void* arg, EMSTATUS status);
+#endif
 
 /*******************************************************************************
  **************************     GLOBAL FUNCTIONS      **************************
@@ -248,6 +276,81 @@ EMSTATUS DISPLAY_Ls013b7dh03Init(void)
   return status;
 }
 
+/**************************************************************************//**
+ * @brief  Send the lines queued since the last flush.
+ *
+ * @detail With PAL_SPI_USE_DMA, DMD_updateDisplay() only queues the runs of
+ *         dirty lines (PixelMatrixDraw()). They go out here in a single
+ *         SCS session: SCS is asserted, the list is handed to the LDMA and
+ *         the function returns. SCS is released from the interrupt that
+ *         ends the transfer, which then calls done with its status; on a
+ *         DMA error the lines were not all sent and should be drawn again. Until then the frame buffer must not be
+ *         written and USART1 must not be used. If the LDMA cannot take the
+ *         list, it is sent with the CPU before returning.
+ *
+ *         Without PAL_SPI_USE_DMA the lines were sent by PixelMatrixDraw()
+ *         already and done is called at once.
+ *
+ * @param[in] done  Called when the lines are out, may be NULL.
+ * @param[in] arg   Argument given to done.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS DISPLAY_Ls013b7dh03Flush(void (*done)(void*, EMSTATUS), void* arg)
+{
+#ifdef PAL_SPI_USE_DMA
+  unsigned int i;
+
+  if (frameBusy) {
+    return DISPLAY_EMSTATUS_NOT_SUPPORTED;
+  }
+
+  frameDone    = done;
+  frameDoneArg = arg;
+
+  if (frameBlockCount == 0) {
+    FrameSent(NULL, PAL_EMSTATUS_OK);
+    return DISPLAY_EMSTATUS_OK;
+  }
+
+  frameBusy = true;
+
+  /* Assert SCS */
+  PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
+
+  /* SCS setup time: min 6us */
+  PAL_TimerMicroSecondsDelay(6);
+
+  if (PAL_EMSTATUS_OK != PAL_SpiTransmitList(frameBlocks, frameBlockCount,
+                                             FrameSent, NULL)) {
+    for (i = 0; i < frameBlockCount; i++) {
+      PAL_SpiTransmit((uint8_t*) frameBlocks[i].data, frameBlocks[i].len);
+    }
+    FrameSent(NULL, PAL_EMSTATUS_OK);
+  }
+#else
+  if (done) {
+    done(arg, PAL_EMSTATUS_OK);
+  }
+#endif
+
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief  A frame is being sent by DISPLAY_Ls013b7dh03Flush().
+ *
+ * @return  true until its done callback has been called.
+ *****************************************************************************/
+bool DISPLAY_Ls013b7dh03Busy(void)
+{
+#ifdef PAL_SPI_USE_DMA
+  return frameBusy;
+#else
+  return false;
+#endif
+}
+
 /*******************************************************************************
  *****************************   STATIC FUNCTIONS   ****************************
  ******************************************************************************/
@@ -652,6 +755,19 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
      from 1, while the DISPLAY interface starts from 0. */
   startRow++;
 
+#ifdef PAL_SPI_USE_DMA
+  (void) i;
+  (void) p;
+  (void) cmd;
+
+  if (frameBusy) {
+    return DISPLAY_EMSTATUS_NOT_SUPPORTED;
+  }
+  if (frameBlockCount == LS013B7DH03_FRAME_BLOCKS) {
+    return DISPLAY_EMSTATUS_OUT_OF_RANGE;
+  }
+#endif
+
 #ifdef USE_CONTROL_BYTES
   /* Setup line addressing in control words. */
   pixelMatrixSetup(pixelMatrix, startRow, height
@@ -661,6 +777,28 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
                    );
 #endif
 
+#ifdef PAL_SPI_USE_DMA
+  /* Queue the run for DISPLAY_Ls013b7dh03Flush(). The first one opens the
+     frame with the update command; a later one is chained to the run
+     before it through the address byte of that run's last line, which
+     pixelMatrixSetup() left as the final dummy byte. */
+  if (frameBlockCount == 0) {
+    frameCmd = LS013B7DH03_CMD_UPDATE | (startRow << 8);
+    frameBlocks[frameBlockCount].data = (uint8_t*) &frameCmd;
+    frameBlocks[frameBlockCount].len  = 2;
+    frameBlockCount++;
+  } else {
+    *frameLastAddress = startRow;
+  }
+  frameBlocks[frameBlockCount].data =  (uint8_t*) pixelMatrix;
+  frameBlocks[frameBlockCount].len  =
+    height * (LS013B7DH03_WIDTH / 8 + LS013B7DH03_CONTROL_BYTES);
+  frameLastAddress = (uint8_t*) pixelMatrix + frameBlocks[frameBlockCount].len - 1;
+  frameBlockCount++;
+
+  return DISPLAY_EMSTATUS_OK;
+#endif
+
   /* Assert SCS */
   PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
 
@@ -701,4 +839,35 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
   return DISPLAY_EMSTATUS_OK;
 }
 
+#ifdef PAL_SPI_USE_DMA
+/**************************************************************************//**
+ * @brief  The queued frame is out: release SCS and hand back the buffer.
+ *
+ * @detail Called from the interrupt that ends the transfer, or from
+ *         DISPLAY_Ls013b7dh03Flush() when the CPU sent the frame.
+ *
+ * @param[in] arg     Unused.
+ * @param[in] status  PAL_EMSTATUS_OK, or PAL_EMSTATUS_DMA_ERROR.
+ *****************************************************************************/
+static void FrameSent(void* arg, EMSTATUS status)
+{
+  (void) arg;
+
+  if (frameBusy) {
+    /* SCS hold time: min 2us */
+    PAL_TimerMicroSecondsDelay(2);
+
+    /* De-assert SCS */
+    PAL_GpioPinOutClear(LCD_PORT_SCS, LCD_PIN_SCS);
+  }
+
+  frameBlockCount = 0;
+  frameBusy       = false;
+
+  if (frameDone) {
+    frameDone(frameDoneArg, status);
+  }
+}
+#endif
+
 /** @endcond */
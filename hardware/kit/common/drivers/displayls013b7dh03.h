@@ -32,6 +32,7 @@
 #ifndef _DISPLAY_LS013B7DH03_H_
 #define _DISPLAY_LS013B7DH03_H_
 
+#include <stdbool.h>
 #include "emstatus.h"
 
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
@@ -55,6 +56,14 @@ extern "C" {
 /* Initialization function for the LS013B7DH03 device driver. */
 EMSTATUS DISPLAY_Ls013b7dh03Init(void);
 
+/* Send the lines queued by DMD_updateDisplay(); done is called once they
+   are out, from interrupt context (at once without PAL_SPI_USE_DMA), with
+   PAL_EMSTATUS_DMA_ERROR if they may not all have been sent. */
+EMSTATUS DISPLAY_Ls013b7dh03Flush(void (*done)(void*, EMSTATUS), void* arg);
+
+/* A frame is on its way: the frame buffer and the SPI bus are in use. */
+bool DISPLAY_Ls013b7dh03Busy(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,7 @@ extern "C" {
 #define PAL_EMSTATUS_OK                                  (0) /**< Operation successful. */
 #define PAL_EMSTATUS_INVALID_PARAM (PAL_EMSTATUS_BASE   | 1) /**< Invalid parameter. */
 #define PAL_EMSTATUS_REPEAT_FAILED (PAL_EMSTATUS_BASE   | 2) /**< Repeat failed. */
+#define PAL_EMSTATUS_DMA_ERROR     (PAL_EMSTATUS_BASE   | 3) /**< DMA transfer failed. */
 
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
 
@@ -199,6 +200,40 @@ EMSTATUS PAL_SpiShutdown (void);
  *****************************************************************************/
 EMSTATUS PAL_SpiTransmit (uint8_t* data, unsigned int len);
 
+#ifdef PAL_SPI_USE_DMA
+/** One block of a PAL_SpiTransmitList() scatter-gather list. */
+typedef struct {
+  const uint8_t* data;   /**< First byte of the block. */
+  unsigned int   len;    /**< Bytes in the block. */
+} PAL_SpiBlock_t;
+
+/**************************************************************************//**
+ * @brief      Transmit a list of blocks on the SPI interface by DMA.
+ *
+ * @detail     The blocks go out back-to-back, in list order, without the
+ *             core. The function returns once the transfer is started; the
+ *             list and the data must stay untouched until done is called,
+ *             from interrupt context, after the last bit has left the
+ *             USART. Only one list is sent at a time. If the DMA fails,
+ *             done is called with PAL_EMSTATUS_DMA_ERROR and part of the
+ *             list may not have been sent.
+ *
+ * @param[in]  blocks  Scatter-gather list.
+ * @param[in]  count   Number of blocks in the list.
+ * @param[in]  done    Called when the transfer is over, in interrupt context,
+ *                     with PAL_EMSTATUS_OK or PAL_EMSTATUS_DMA_ERROR.
+ * @param[in]  arg     Argument given to done.
+ *
+ * @return     EMSTATUS code of the operation. PAL_EMSTATUS_INVALID_PARAM if
+ *             the list does not fit the DMA descriptors, in which case
+ *             nothing is sent and done is not called.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitList (const PAL_SpiBlock_t* blocks,
+                              unsigned int          count,
+                              void(*done)(void*, EMSTATUS),
+                              void*                 arg);
+#endif
+
 /**************************************************************************//**
  * @brief   Initialize the PAL Timer interface
  *
@@ -38,6 +38,7 @@
 #include "em_cmu.h"
 #include "em_gpio.h"
 #include "em_usart.h"
+#include "em_bus.h"
 #include "bsp.h"
 #include "udelay.h"
 
@@ -61,12 +62,40 @@
 
 #endif
 
+#ifdef PAL_SPI_USE_DMA
+#include "dmadrv_config.h"
+#endif
+
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
 
 /*******************************************************************************
  ********************************  STATICS  ************************************
  ******************************************************************************/
 
+#ifdef PAL_SPI_USE_DMA
+/* LDMA moves at most 2048 units per descriptor. */
+#define PAL_SPI_DMA_XFER_MAX     (2048)
+
+#if PAL_SPI_USART_INDEX == 0
+#define PAL_SPI_DMA_REQSEL       (LDMA_CH_REQSEL_SOURCESEL_USART0 \
+                                  | LDMA_CH_REQSEL_SIGSEL_USART0TXBL)
+#define PAL_SPI_TX_IRQn          USART0_TX_IRQn
+#define PAL_SPI_TX_IRQHandler    USART0_TX_IRQHandler
+#elif PAL_SPI_USART_INDEX == 1
+#define PAL_SPI_DMA_REQSEL       (LDMA_CH_REQSEL_SOURCESEL_USART1 \
+                                  | LDMA_CH_REQSEL_SIGSEL_USART1TXBL)
+#define PAL_SPI_TX_IRQn          USART1_TX_IRQn
+#define PAL_SPI_TX_IRQHandler    USART1_TX_IRQHandler
+#else
+#error "Display PAL: no LDMA request for the SPI USART"
+#endif
+
+/* Linked LDMA descriptors of the list being sent. */
+static DMA_DESCRIPTOR_TypeDef spiDmaDescriptors[PAL_SPI_DMA_DESCRIPTORS];
+static void (*spiDmaDone)(void*, EMSTATUS);
+static void* spiDmaArg;
+#endif
+
 #ifdef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE
 #ifndef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE_HW_ONLY
 /* GPIO port and pin used for the PAL_GpioPinAutoToggle function. */
@@ -189,6 +218,155 @@ EMSTATUS PAL_SpiTransmit(uint8_t* data, unsigned int len)
   return status;
 }
 
+#ifdef PAL_SPI_USE_DMA
+/**************************************************************************//**
+ * @brief      Transmit a list of blocks on the SPI interface by DMA.
+ *
+ * @detail     Each block becomes one or more linked LDMA descriptors, bytes
+ *             from the block to the USART TXDATA register on TXBL; only the
+ *             last one raises the done interrupt.
+ *
+ * @param[in]  blocks  Scatter-gather list.
+ * @param[in]  count   Number of blocks in the list.
+ * @param[in]  done    Called when the transfer is over, in interrupt context,
+ *                     with its status.
+ * @param[in]  arg     Argument given to done.
+ *
+ * @return     EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_SpiTransmitList(const PAL_SpiBlock_t* blocks,
+                             unsigned int          count,
+                             void(*done)(void*, EMSTATUS),
+                             void*                 arg)
+{
+  DMA_DESCRIPTOR_TypeDef* desc = spiDmaDescriptors;
+  unsigned int            i;
+  unsigned int            n    = 0;
+  uint32_t                chMask = 1UL << PAL_SPI_DMA_CHANNEL;
+
+  for (i = 0; i < count; i++) {
+    n += (blocks[i].len + PAL_SPI_DMA_XFER_MAX - 1) / PAL_SPI_DMA_XFER_MAX;
+  }
+  if ((n == 0) || (n > PAL_SPI_DMA_DESCRIPTORS)) {
+    return PAL_EMSTATUS_INVALID_PARAM;
+  }
+
+  for (i = 0; i < count; i++) {
+    const uint8_t* data = blocks[i].data;
+    unsigned int   len  = blocks[i].len;
+
+    while (len > 0) {
+      unsigned int xfer = (len > PAL_SPI_DMA_XFER_MAX) ? PAL_SPI_DMA_XFER_MAX : len;
+
+      desc->CTRL = LDMA_CH_CTRL_STRUCTTYPE_TRANSFER
+                   | ((xfer - 1) << _LDMA_CH_CTRL_XFERCNT_SHIFT)
+                   | LDMA_CH_CTRL_BLOCKSIZE_UNIT1
+                   | LDMA_CH_CTRL_REQMODE_BLOCK
+                   | LDMA_CH_CTRL_SRCINC_ONE
+                   | LDMA_CH_CTRL_SIZE_BYTE
+                   | LDMA_CH_CTRL_DSTINC_NONE;
+      desc->SRC  = (void*) data;
+      desc->DST  = (void*) &PAL_SPI_USART_UNIT->TXDATA;
+      desc->LINK = (void*) (((uint32_t) (desc + 1) & _LDMA_CH_LINK_LINKADDR_MASK)
+                            | LDMA_CH_LINK_LINK);
+      data += xfer;
+      len  -= xfer;
+      desc++;
+    }
+  }
+  desc--;
+  desc->CTRL |= LDMA_CH_CTRL_DONEIFSEN;
+  desc->LINK  = 0;
+
+  spiDmaDone = done;
+  spiDmaArg  = arg;
+
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  NVIC_SetPriority(LDMA_IRQn, EMDRV_DMADRV_DMA_IRQ_PRIORITY);
+  NVIC_EnableIRQ(LDMA_IRQn);
+  NVIC_ClearPendingIRQ(PAL_SPI_TX_IRQn);
+  NVIC_SetPriority(PAL_SPI_TX_IRQn, EMDRV_DMADRV_DMA_IRQ_PRIORITY);
+  NVIC_EnableIRQ(PAL_SPI_TX_IRQn);
+
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].REQSEL = PAL_SPI_DMA_REQSEL;
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].CFG    = 0;
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].LOOP   = 0;
+  LDMA->CH[PAL_SPI_DMA_CHANNEL].LINK   = (uint32_t) spiDmaDescriptors
+                                         & _LDMA_CH_LINK_LINKADDR_MASK;
+  /* Other channels may be in use: set and clear only the bits of this
+     one, through the peripheral bit set/clear aliases. */
+  LDMA->IFC      = chMask;
+  BUS_RegMaskedSet(&LDMA->IEN, chMask | LDMA_IEN_ERROR);
+  LDMA->REQCLEAR = chMask;
+  BUS_RegMaskedClear(&LDMA->CHDONE, chMask);
+  /* Load the first descriptor and start. */
+  LDMA->LINKLOAD = chMask;
+
+  return PAL_EMSTATUS_OK;
+}
+
+/**************************************************************************//**
+ * @brief   Call the done callback of the list in flight, once.
+ *
+ * @param[in]  status  PAL_EMSTATUS_OK, or PAL_EMSTATUS_DMA_ERROR.
+ *****************************************************************************/
+static void SpiDmaFinish(EMSTATUS status)
+{
+  void (*done)(void*, EMSTATUS) = spiDmaDone;
+
+  spiDmaDone = NULL;
+  if (done) {
+    done(spiDmaArg, status);
+  }
+}
+
+/**************************************************************************//**
+ * @brief   LDMA interrupt: the last descriptor of the list is done.
+ *
+ * @detail  The LDMA is done once the last byte is in the USART; the 2 bytes
+ *          still shifting out (16 us at 1 MHz) are left to the USART TXC
+ *          interrupt, which calls done so the caller can release the chip
+ *          select. On an LDMA error done is called at once, with
+ *          PAL_EMSTATUS_DMA_ERROR.
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  uint32_t chMask  = 1UL << PAL_SPI_DMA_CHANNEL;
+  uint32_t pending = LDMA->IF & LDMA->IEN;
+
+  LDMA->IFC = pending & (chMask | LDMA_IF_ERROR);
+
+  if (pending & LDMA_IF_ERROR) {
+    LDMA->CHDIS = chMask;
+    SpiDmaFinish(PAL_EMSTATUS_DMA_ERROR);
+  } else if (pending & chMask) {
+    LDMA->CHDIS = chMask;
+    /* TXC may have been set by an earlier gap in the transfer, or already
+       by the last byte: start from a clear flag and raise it again if the
+       shift register is empty by now. */
+    USART_IntClear(PAL_SPI_USART_UNIT, USART_IFC_TXC);
+    BUS_RegMaskedSet(&PAL_SPI_USART_UNIT->IEN, USART_IEN_TXC);
+    if (PAL_SPI_USART_UNIT->STATUS & USART_STATUS_TXC) {
+      USART_IntSet(PAL_SPI_USART_UNIT, USART_IFS_TXC);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * @brief   USART TX interrupt: the last bit of the list has left the USART.
+ *****************************************************************************/
+void PAL_SPI_TX_IRQHandler(void)
+{
+  uint32_t pending = PAL_SPI_USART_UNIT->IF & PAL_SPI_USART_UNIT->IEN;
+
+  if (pending & USART_IF_TXC) {
+    BUS_RegMaskedClear(&PAL_SPI_USART_UNIT->IEN, USART_IEN_TXC);
+    USART_IntClear(PAL_SPI_USART_UNIT, USART_IFC_TXC);
+    SpiDmaFinish(PAL_EMSTATUS_OK);
+  }
+}
+#endif
+
 /**************************************************************************//**
  * @brief   Initialize the PAL Timer interface
  *
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file bench_util.c
+ *
+ * @brief Timing, random number and allocation helpers shared by the
+ * host benchmarks.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bench_util.h"
+#ifdef BENCH_HAVE_TSC
+#include <x86intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t bench_state = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Monotonic wall-clock time.
+ *
+ * @param void
+ * @return uint64_t Nanoseconds.
+ */
+uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Host cycle counter.
+ *
+ * @param void
+ * @return uint64_t TSC, 0 without BENCH_HAVE_TSC.
+ */
+uint64_t bench_cycles(void)
+{
+#ifdef BENCH_HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Start timing a run.
+ *
+ * @param bench_time_t *time
+ * @return void.
+ */
+void bench_start(bench_time_t *time)
+{
+	time->ns = bench_now_ns();
+	time->cycles = bench_cycles();
+}
+
+/**
+ * @brief Stop timing a run; time then holds its duration.
+ *
+ * @param bench_time_t *time
+ * @return void.
+ */
+void bench_stop(bench_time_t *time)
+{
+	time->cycles = bench_cycles() - time->cycles;
+	time->ns = bench_now_ns() - time->ns;
+}
+
+/**
+ * @brief Print a run as nanoseconds and cycles per call.
+ *
+ * @param const char *name, const bench_time_t *time, unsigned long calls
+ * @return void.
+ */
+void bench_print(const char *name, const bench_time_t *time, unsigned long calls)
+{
+	printf("  %-30s %9.1f", name, (double) time->ns / calls);
+#ifdef BENCH_HAVE_TSC
+	printf(" %9.1f\n", (double) time->cycles / calls);
+#else
+	printf(" %9s\n", "n/a");
+#endif
+}
+
+/**
+ * @brief Seed bench_rand(); 0 is taken as 1, xorshift never leaves 0.
+ *
+ * @param uint32_t seed
+ * @return void.
+ */
+void bench_seed(uint32_t seed)
+{
+	bench_state = seed ? seed : 1;
+}
+
+/**
+ * @brief Next 32 bit xorshift number.
+ *
+ * @param void
+ * @return uint32_t
+ */
+uint32_t bench_rand(void)
+{
+	bench_state ^= bench_state << 13;
+	bench_state ^= bench_state >> 17;
+	bench_state ^= bench_state << 5;
+	return bench_state;
+}
+
+/**
+ * @brief Roughly normal number, mean 0 and deviation 1 (sum of twelve
+ * uniform numbers).
+ *
+ * @param void
+ * @return double
+ */
+double bench_gauss(void)
+{
+	double sum = 0;
+
+	for(int i = 0; i < 12; i++)
+		sum += (bench_rand() & 0xFFFF) / 65536.0;
+	return sum - 6.0;
+}
+
+/**
+ * @brief malloc() that ends the benchmark when the host is out of memory.
+ *
+ * @param size_t size
+ * @return void * Never NULL.
+ */
+void *bench_alloc(size_t size)
+{
+	void *block = malloc(size);
+
+	if(block == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+	return block;
+}
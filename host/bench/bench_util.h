@@ -0,0 +1,72 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file bench_util.h
+ *
+ * @brief Timing, random number and allocation helpers shared by the
+ * host benchmarks.
+ *
+ * Wall-clock nanoseconds come from CLOCK_MONOTONIC and host cycles from
+ * the TSC where there is one (BENCH_HAVE_TSC); elsewhere the cycle
+ * counts read 0 and are printed as n/a. The random numbers are a 32 bit
+ * xorshift, so a seed gives the same data on every host.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_BENCH_BENCH_UTIL_H_
+#define HOST_BENCH_BENCH_UTIL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_HAVE_TSC		1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint64_t ns;
+	uint64_t cycles;
+} bench_time_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t bench_now_ns(void);
+uint64_t bench_cycles(void);
+void bench_start(bench_time_t *time);
+void bench_stop(bench_time_t *time);
+void bench_print(const char *name, const bench_time_t *time, unsigned long calls);
+
+void bench_seed(uint32_t seed);
+uint32_t bench_rand(void);
+double bench_gauss(void);
+
+void *bench_alloc(size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BENCH_BENCH_UTIL_H_ */
@@ -0,0 +1,232 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file blit_bench.c
+ *
+ * @brief Text blitter against GLIB_drawString() benchmark.
+ *
+ * Draws strings into the DMD frame buffer of the LS013B7DH03 model with
+ * GLIB_drawString() (opaque false, a GLIB_drawPixel() per set pixel) and
+ * with textBlit_String() (glyph rows shifted into 32 bit words and
+ * combined with the frame buffer a word at a time), in the narrow 6x8
+ * and the normal 8x8 font. First every printable character, at every
+ * length that fits and at every bit offset of a byte and across word
+ * boundaries, is drawn both ways over a cleared frame and over a frame
+ * of noise, and the frames compared. Then the LCD rows of the firmware
+ * are timed both ways; reports host cycles (TSC) and nanoseconds per
+ * string.
+ *
+ * Usage: blit_bench [-r rounds]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "dmd.h"
+#include "src/headers/header.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_TEXT_MAX			32
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* The rows the node shows. */
+static const char *const bench_rows[] =
+{
+	"Friend Node (Rushi)",
+	"00:0B:57:A1:B2:C3",
+	"Friend EST.",
+	"Provisioned",
+	"LPN-1 (%): 41",
+	"LPN-2: ALARM",
+	"LPN-3 (%): 7",
+	"Temp(C): 23.125",
+	"Connections: 1",
+};
+
+#define BENCH_ROWS				(sizeof(bench_rows) / sizeof(bench_rows[0]))
+
+static text_blit_t bench_blit;
+
+/* Results go here so the loops are not optimised away. */
+static volatile uint32_t bench_sink;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t bench_frame_len(void)
+{
+	return (size_t) bench_blit.height * bench_blit.bytes_per_line;
+}
+
+/* Noise in the frame, as what was drawn before; both draw over it. */
+static void bench_fill(GLIB_Context_t *context, bool noise, uint32_t seed)
+{
+	GLIB_clear(context);
+	if(!noise)
+		return;
+	for(size_t i = 0; i < bench_frame_len(); i++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		bench_blit.frame[i] = (uint8_t) (seed >> 16);
+	}
+}
+
+/**
+ * @brief Draw a string both ways from the same frame and compare.
+ *
+ * @return unsigned long 1 if the frames differ or the blitter refused.
+ */
+static unsigned long bench_check(GLIB_Context_t *context, uint8_t *expect, const char *text, uint8_t len,
+								 uint16_t x, uint16_t y, bool noise)
+{
+	bench_fill(context, noise, x * 131u + y * 7u + len);
+	GLIB_drawString(context, text, len, x, y, 0);
+	memcpy(expect, bench_blit.frame, bench_frame_len());
+
+	bench_fill(context, noise, x * 131u + y * 7u + len);
+	if(!textBlit_String(&bench_blit, context, text, len, x, y))
+		return 1;
+	return memcmp(expect, bench_blit.frame, bench_frame_len()) != 0;
+}
+
+/**
+ * @brief Check and time one font.
+ *
+ * @return unsigned long Strings drawn differently.
+ */
+static unsigned long bench_font(GLIB_Context_t *context, const GLIB_Font_t *font, const char *name,
+								unsigned long rounds, uint8_t *expect)
+{
+	char text[BENCH_TEXT_MAX];
+	uint16_t advance = font->fontWidth + font->charSpacing;
+	uint16_t line = font->fontHeight + font->lineSpacing;
+	unsigned long checked = 0, mismatched = 0, calls;
+	bench_time_t time;
+
+	GLIB_setFont(context, (GLIB_Font_t *) font);
+
+	/* Every printable character, in every position of every string that
+	 * fits, at every offset in a byte and a word. */
+	for(uint8_t len = 1; len < BENCH_TEXT_MAX && len * advance - font->charSpacing <= bench_blit.width; len++)
+	{
+		for(uint8_t start = 0; start < '~' - ' ' + 1; start += len)
+		{
+			for(uint8_t i = 0; i < len; i++)
+				text[i] = (char) (' ' + (start + i) % ('~' - ' ' + 1));
+
+			for(uint16_t x = 0; x + len * advance - font->charSpacing <= bench_blit.width; x += (x < 40) ? 1 : 13)
+			{
+				uint16_t y = (uint16_t) ((x + len) % (bench_blit.height - font->fontHeight));
+
+				mismatched += bench_check(context, expect, text, len, x, y, false);
+				mismatched += bench_check(context, expect, text, len, x, y, true);
+				checked += 2;
+			}
+		}
+	}
+
+	calls = rounds * BENCH_ROWS;
+	printf("%s: %lu strings checked, %lu differ; LCD rows, %lu strings\n", name, checked, mismatched, calls);
+	printf("  %-30s %9s %9s\n", "path", "ns/str", "cyc/str");
+
+	GLIB_clear(context);
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint16_t row = 0; row < BENCH_ROWS; row++)
+		{
+			uint8_t len = (uint8_t) strlen(bench_rows[row]);
+
+			bench_sink += GLIB_drawString(context, bench_rows[row], len,
+										  (bench_blit.width - len * font->fontWidth) >> 1,
+										  line * row + font->lineSpacing, 0);
+		}
+	bench_stop(&time);
+	bench_print("GLIB_drawString (before)", &time, calls);
+
+	GLIB_clear(context);
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint16_t row = 0; row < BENCH_ROWS; row++)
+		{
+			uint8_t len = (uint8_t) strlen(bench_rows[row]);
+
+			bench_sink += textBlit_String(&bench_blit, context, bench_rows[row], len,
+										  (bench_blit.width - len * font->fontWidth) >> 1,
+										  line * row + font->lineSpacing);
+		}
+	bench_stop(&time);
+	bench_print("textBlit_String", &time, calls);
+
+	return mismatched;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long rounds = 20000, mismatched = 0;
+	GLIB_Context_t context;
+	uint8_t *expect;
+	int opt;
+
+	while((opt = getopt(argc, argv, "r:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'r': rounds = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-r rounds]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(rounds == 0)
+		rounds = 1;
+
+	/* The display driver and DMD, as the firmware brings them up. */
+	displayInit();
+	if(!textBlit_Init(&bench_blit))
+	{
+		fprintf(stderr, "no 1 bpp frame buffer to blit into\n");
+		return 2;
+	}
+	GLIB_contextInit(&context);
+	context.backgroundColor = White;
+	context.foregroundColor = Black;
+
+	expect = malloc(bench_frame_len());
+	if(expect == NULL)
+		return 2;
+
+	mismatched += bench_font(&context, &GLIB_FontNarrow6x8, "narrow 6x8", rounds, expect);
+	mismatched += bench_font(&context, &GLIB_FontNormal8x8, "normal 8x8", rounds, expect);
+
+	/* White text over black, the other way the bits go. */
+	context.backgroundColor = Black;
+	context.foregroundColor = White;
+	GLIB_setFont(&context, (GLIB_Font_t *) &GLIB_FontNarrow6x8);
+	for(uint16_t row = 0; row < BENCH_ROWS; row++)
+		mismatched += bench_check(&context, expect, bench_rows[row], (uint8_t) strlen(bench_rows[row]),
+								  (uint16_t) (row * 5), (uint16_t) (row * 13), true);
+	printf("strings drawn differently %lu\n", mismatched);
+
+	free(expect);
+	return mismatched ? 1 : 0;
+}
@@ -0,0 +1,282 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file codec_bench.c
+ *
+ * @brief Sensor sample codec benchmark.
+ *
+ * Compresses sample traces with the codec (src/main-src/series_codec.c)
+ * into blocks the size of an MX25 history page payload and reports the
+ * compression ratio, bits per sample and encode/decode cost, then decodes
+ * every block and checks it against the input.
+ *
+ * Without -f the traces are generated to look like a greenhouse node:
+ * - temperature at 1 Hz in centi-degrees, quantised to the MCP9808's
+ *   0.0625 C steps, following a daily cycle plus drift and noise, with
+ *   the odd 0 or 2 s interval from rounding the sleeptimer time stamp;
+ * - an LPN moisture level reported every 20 s with jitter, mostly
+ *   unchanged, stepping slowly, with alarm set/clear readings in between;
+ * - uniformly random values and intervals, as a worst case.
+ * With -f, one trace is read from a text file of "time value" lines.
+ *
+ * Usage: codec_bench [-n samples] [-b block_bytes] [-f trace.txt]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/series_codec.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_BLOCK_MAX			4096
+#define BENCH_RAW_BYTES			6			// 32 bit time and 16 bit value
+#define BENCH_BLOCK_HEADER		2			// Sample count kept beside each block
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *name;
+	size_t count;
+	uint32_t *time;
+	int16_t *value;
+} bench_trace_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static void bench_trace_alloc(bench_trace_t *trace, const char *name, size_t count)
+{
+	trace->name = name;
+	trace->count = count;
+	trace->time = bench_alloc(count * sizeof(*trace->time));
+	trace->value = bench_alloc(count * sizeof(*trace->value));
+}
+
+static void bench_temperature(bench_trace_t *trace, size_t count)
+{
+	uint32_t ms = 0;
+	double drift = 0;
+
+	bench_trace_alloc(trace, "temperature 1 Hz", count);
+	for(size_t i = 0; i < count; i++)
+	{
+		double t = ms / 1000.0;
+		double celsius;
+
+		/* The time stamp is sleeptimer seconds since boot, and the period is not exactly 1 s. */
+		ms += 1000 + (int32_t) (bench_gauss() * 3);
+		drift += bench_gauss() * 0.002;
+		celsius = 22.0 + 6.0 * sin(2 * M_PI * t / 86400.0) + drift + bench_gauss() * 0.03;
+
+		trace->time[i] = ms / 1000;
+		trace->value[i] = (int16_t) (floor(celsius / 0.0625) * 6.25);
+	}
+}
+
+static void bench_level(bench_trace_t *trace, size_t count)
+{
+	uint32_t time = 0;
+	int32_t level = 12000;
+
+	bench_trace_alloc(trace, "lpn level 20 s", count);
+	for(size_t i = 0; i < count; i++)
+	{
+		uint32_t r = bench_rand();
+
+		time += 20 + ((r & 0x7) == 0 ? (int32_t) (r >> 8) % 5 - 2 : 0);
+		if((r >> 3) % 16 == 0)
+			level += (int32_t) ((r >> 12) % 9) - 4;
+
+		trace->time[i] = time;
+		/* Now and then the LPN reports an alarm level instead. */
+		trace->value[i] = ((r >> 20) % 200 == 0) ? (int16_t) 0x7FFF : (int16_t) level;
+	}
+}
+
+static void bench_random(bench_trace_t *trace, size_t count)
+{
+	uint32_t time = 0;
+
+	bench_trace_alloc(trace, "random (worst case)", count);
+	for(size_t i = 0; i < count; i++)
+	{
+		time += bench_rand() % 4000;
+		trace->time[i] = time;
+		trace->value[i] = (int16_t) bench_rand();
+	}
+}
+
+static int bench_load(bench_trace_t *trace, const char *path)
+{
+	FILE *file = fopen(path, "r");
+	size_t size = 1024, count = 0;
+	unsigned long time;
+	long value;
+
+	if(!file)
+	{
+		perror(path);
+		return -1;
+	}
+
+	bench_trace_alloc(trace, path, size);
+	while(fscanf(file, "%lu %ld", &time, &value) == 2)
+	{
+		if(count == size)
+		{
+			size *= 2;
+			trace->time = realloc(trace->time, size * sizeof(*trace->time));
+			trace->value = realloc(trace->value, size * sizeof(*trace->value));
+			if(!trace->time || !trace->value)
+			{
+				fprintf(stderr, "out of memory\n");
+				exit(2);
+			}
+		}
+		trace->time[count] = (uint32_t) time;
+		trace->value[count++] = (int16_t) value;
+	}
+	fclose(file);
+	trace->count = count;
+	return 0;
+}
+
+/**
+ * @brief Compress a trace block by block, decode it back and report.
+ *
+ * @param const bench_trace_t *trace, uint16_t block_size
+ * @return unsigned long Samples that did not decode to the input.
+ */
+static unsigned long bench_run(const bench_trace_t *trace, uint16_t block_size)
+{
+	static uint8_t block[BENCH_BLOCK_MAX];
+	series_codec_encoder_t encoder;
+	series_codec_decoder_t decoder;
+	uint64_t encode_ns = 0, decode_ns = 0, encode_cycles = 0, start, cycles;
+	uint64_t bytes = 0;
+	unsigned long blocks = 0, errors = 0;
+	size_t i = 0;
+
+	while(i < trace->count)
+	{
+		size_t first = i;
+		uint32_t time;
+		int16_t value;
+
+		/* Fill one block. */
+		start = bench_now_ns();
+		cycles = bench_cycles();
+		seriesCodec_EncoderInit(&encoder, block, block_size);
+		while(i < trace->count && seriesCodec_Encode(&encoder, trace->time[i], trace->value[i]))
+			i++;
+		encode_cycles += bench_cycles() - cycles;
+		encode_ns += bench_now_ns() - start;
+
+		if(i == first)
+		{
+			fprintf(stderr, "block of %u bytes too small for one sample\n", block_size);
+			return 1;
+		}
+
+		bytes += seriesCodec_EncodedSize(&encoder) + BENCH_BLOCK_HEADER;
+		blocks++;
+
+		/* Decode it and compare. */
+		start = bench_now_ns();
+		seriesCodec_DecoderInit(&decoder, block, seriesCodec_EncodedSize(&encoder), encoder.count);
+		for(size_t j = first; j < i; j++)
+		{
+			if(!seriesCodec_Decode(&decoder, &time, &value) || time != trace->time[j] || value != trace->value[j])
+				errors++;
+		}
+		if(seriesCodec_Decode(&decoder, &time, &value))
+			errors++;
+		decode_ns += bench_now_ns() - start;
+	}
+
+	printf("%-22s %8zu %9.2f %7.2f %9.1f %7.1f", trace->name, trace->count,
+		   (double) trace->count * BENCH_RAW_BYTES / (double) bytes,
+		   (double) bytes * 8 / (double) trace->count,
+		   (double) trace->count / (double) blocks,
+		   (double) encode_ns / (double) trace->count);
+#ifdef BENCH_HAVE_TSC
+	printf(" %7.1f", (double) encode_cycles / (double) trace->count);
+#else
+	printf(" %7s", "n/a");
+#endif
+	printf(" %7.1f %6lu\n", (double) decode_ns / (double) trace->count, errors);
+	return errors;
+}
+
+int main(int argc, char **argv)
+{
+	size_t samples = 1000000;
+	unsigned long block_size = 248;
+	const char *path = NULL;
+	bench_trace_t traces[3];
+	int count = 0, opt;
+	unsigned long errors = 0;
+
+	while((opt = getopt(argc, argv, "n:b:f:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n': samples = strtoul(optarg, NULL, 0); break;
+			case 'b': block_size = strtoul(optarg, NULL, 0); break;
+			case 'f': path = optarg; break;
+			default:
+				fprintf(stderr, "usage: %s [-n samples] [-b block_bytes] [-f trace.txt]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(block_size < 8 || block_size > BENCH_BLOCK_MAX)
+	{
+		fprintf(stderr, "block size must be 8..%d bytes\n", BENCH_BLOCK_MAX);
+		return 2;
+	}
+
+	if(path)
+	{
+		if(bench_load(&traces[count++], path))
+			return 2;
+	}
+	else
+	{
+		bench_temperature(&traces[count++], samples);
+		bench_level(&traces[count++], samples);
+		bench_random(&traces[count++], samples);
+	}
+
+	printf("block %lu bytes, raw sample %d bytes, %d byte count per block\n", block_size, BENCH_RAW_BYTES,
+		   BENCH_BLOCK_HEADER);
+	printf("%-22s %8s %9s %7s %9s %7s %7s %7s %6s\n", "trace", "samples", "ratio", "bits/s", "per block",
+		   "enc ns", "enc cyc", "dec ns", "errors");
+	for(int t = 0; t < count; t++)
+	{
+		errors += bench_run(&traces[t], (uint16_t) block_size);
+		free(traces[t].time);
+		free(traces[t].value);
+	}
+
+	return errors ? 1 : 0;
+}
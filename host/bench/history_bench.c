@@ -0,0 +1,231 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file history_bench.c
+ *
+ * @brief MX25 sensor history benchmark.
+ *
+ * Streams samples into the history store (src/main-src/sensor_history.c)
+ * on top of the MX25 flash model, running the idle hook between samples
+ * as the main loop does, and rebooting now and then (flush, then boot
+ * scan). Reports write amplification, erases and wear spread, flash bytes
+ * and busy time per sample, and deep power-down behaviour. At the end every
+ * page still on flash is read back and checked record by record.
+ *
+ * Usage: history_bench [-n samples] [-i samples_per_idle] [-r samples_per_reboot]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/sensor_history.h"
+#include "displaypal.h"
+#include "host_mx25.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Stats of earlier boots; sensorHistory_Init() starts them over. */
+static sensor_history_stats_t bench_total;
+
+/* Times USART1 was handed back to the LCD. */
+static uint32_t bench_lcd_handovers;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* The LCD is not linked in; only count the bus handovers. */
+EMSTATUS PAL_SpiInit(void)
+{
+	bench_lcd_handovers++;
+	return PAL_EMSTATUS_OK;
+}
+
+/* ... and no frame is ever in flight. */
+bool displayWaitSent(void)
+{
+	return false;
+}
+
+/* Sample i: one temperature reading, then LPN readings, all derived from i. */
+static uint16_t bench_source(uint32_t i)
+{
+	return (i % 4) ? (uint16_t) (0x0100 + i % 3) : SENSOR_HISTORY_TEMPERATURE;
+}
+
+static int16_t bench_value(uint32_t i)
+{
+	return (int16_t) ((i * 2654435761u) >> 16);
+}
+
+/**
+ * @brief Add the counters of the boot that is ending to the totals.
+ *
+ * @param void
+ * @return void.
+ */
+static void bench_accumulate(void)
+{
+	sensor_history_stats_t stats;
+
+	sensorHistory_GetStats(&stats);
+	bench_total.appends += stats.appends;
+	bench_total.dropped += stats.dropped;
+	bench_total.pages += stats.pages;
+	bench_total.partial_pages += stats.partial_pages;
+	bench_total.erases += stats.erases;
+	bench_total.sessions += stats.sessions;
+	bench_total.inline_writes += stats.inline_writes;
+	bench_total.inline_erases += stats.inline_erases;
+	bench_total.errors += stats.errors;
+}
+
+/**
+ * @brief Read every page on flash back, newest first, and check that the
+ * records are the samples that went in, without gaps.
+ *
+ * @param uint32_t samples
+ * @return unsigned long Records that do not match.
+ */
+static unsigned long bench_verify(uint32_t samples, uint32_t *records)
+{
+	sensor_history_page_t page;
+	uint32_t expect = samples;
+	unsigned long errors = 0;
+
+	*records = 0;
+	for(uint32_t age = 0; age < sensorHistory_PageCount(); age++)
+	{
+		if(!sensorHistory_ReadPage(age, &page))
+		{
+			errors++;
+			continue;
+		}
+		for(int r = page.count - 1; r >= 0; r--)
+		{
+			const sensor_history_record_t *record = &page.record[r];
+
+			expect--;
+			if(record->time != expect || record->source != bench_source(expect)
+				|| record->value != bench_value(expect))
+				errors++;
+			(*records)++;
+		}
+	}
+	return errors;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long samples = 1000000;
+	unsigned long per_idle = 1;
+	unsigned long per_reboot = 100000;
+	unsigned long boots = 1, errors;
+	uint32_t records, wear_min = UINT32_MAX, wear_max = 0;
+	uint64_t start, append_ns, payload;
+	host_mx25_stats_t flash;
+	uint32_t handovers;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:i:r:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n': samples = strtoul(optarg, NULL, 0); break;
+			case 'i': per_idle = strtoul(optarg, NULL, 0); break;
+			case 'r': per_reboot = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n samples] [-i samples_per_idle] [-r samples_per_reboot]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(!per_idle)
+		per_idle = 1;
+
+	host_mx25_reset();
+	if(!sensorHistory_Init())
+	{
+		fprintf(stderr, "history: flash not found\n");
+		return 1;
+	}
+
+	append_ns = 0;
+	for(uint32_t i = 0; i < samples; i++)
+	{
+		start = bench_now_ns();
+		sensorHistory_Append(bench_source(i), i, bench_value(i));
+		append_ns += bench_now_ns() - start;
+
+		if((i + 1) % per_idle == 0)
+			sensorHistory_Idle();
+
+		if(per_reboot && (i + 1) % per_reboot == 0 && i + 1 < samples)
+		{
+			sensorHistory_Flush();
+			bench_accumulate();
+			sensorHistory_Init();
+			boots++;
+		}
+	}
+	sensorHistory_Flush();
+	bench_accumulate();
+
+	/* The read back wakes the flash too, keep it out of the figures. */
+	flash = host_mx25_stats;
+	handovers = bench_lcd_handovers;
+	errors = bench_verify((uint32_t) samples, &records);
+	if(bench_total.dropped || bench_total.errors || flash.overwrites)
+		errors++;
+
+	for(uint32_t s = SENSOR_HISTORY_FLASH_BASE / SENSOR_HISTORY_SECTOR_SIZE;
+		s < (SENSOR_HISTORY_FLASH_BASE + SENSOR_HISTORY_FLASH_SIZE) / SENSOR_HISTORY_SECTOR_SIZE; s++)
+	{
+		uint32_t wear = host_mx25_sector_erases(s);
+
+		if(wear < wear_min)
+			wear_min = wear;
+		if(wear > wear_max)
+			wear_max = wear;
+	}
+
+	payload = (uint64_t) samples * sizeof(sensor_history_record_t);
+
+	printf("history region           %u KB, %u pages of %u records\n", SENSOR_HISTORY_FLASH_SIZE / 1024,
+		   SENSOR_HISTORY_PAGES, SENSOR_HISTORY_PAGE_RECORDS);
+	printf("samples                  %lu over %lu boots (idle hook every %lu)\n", samples, boots, per_idle);
+	printf("pages programmed         %" PRIu32 " (%" PRIu32 " partial, %" PRIu32 " inline)\n", bench_total.pages,
+		   bench_total.partial_pages, bench_total.inline_writes);
+	printf("sector erases            %" PRIu32 " (%" PRIu32 " inline), wear %" PRIu32 "..%" PRIu32 " per sector\n",
+		   bench_total.erases, bench_total.inline_erases, wear_min, wear_max);
+	printf("flash bytes / sample     %.2f programmed, %.2f erased\n",
+		   (double) flash.program_bytes / (double) samples,
+		   (double) bench_total.erases * SENSOR_HISTORY_SECTOR_SIZE / (double) samples);
+	printf("write amplification      %.3f\n", (double) flash.program_bytes / (double) payload);
+	printf("MX25_PP / sample         %.4f (unbatched: 1)\n", (double) flash.programs / (double) samples);
+	printf("flash busy / sample      %.1f us (unbatched: %u us)\n", (double) flash.busy_us / (double) samples,
+		   HOST_MX25_PP_US + HOST_MX25_SE_US * (unsigned) sizeof(sensor_history_record_t) / SENSOR_HISTORY_SECTOR_SIZE);
+	printf("wake-ups / power-downs   %" PRIu32 " / %" PRIu32 " (%" PRIu32 " commands lost to deep power-down)\n",
+		   flash.wakeups, flash.power_downs, flash.ignored);
+	printf("USART1 handovers         %" PRIu32 "\n", handovers);
+	printf("left powered down        %s\n", host_mx25_powered_down() ? "yes" : "NO");
+	printf("append ns                %.1f\n", (double) append_ns / (double) samples);
+	printf("read back                %" PRIu32 " records in %" PRIu32 " pages, %lu errors\n", records,
+		   sensorHistory_PageCount(), errors);
+
+	return (errors || !host_mx25_powered_down()) ? 1 : 0;
+}
@@ -0,0 +1,304 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file i2c_bench.c
+ *
+ * @brief I2C transfer queue benchmark.
+ *
+ * Runs the I2C transfer queue (src/main-src/i2c_queue.c) against the I2C0
+ * bus model with a dozen register file devices on it, each with its own
+ * slave latency, NACK and bus error rate. Every device has a driver that
+ * wakes at random intervals and queues a burst: a register write, then a
+ * write-read of the same register after a repeated start. The write's
+ * callback records the value the device now holds and the read's callback
+ * checks it, so a transfer that ran out of order, against the wrong device
+ * or with another request's buffers shows up as a mismatch. One read in
+ * four queues a further read of the next register from its callback.
+ *
+ * The bursts of different devices overlap, so transfers queue up behind
+ * each other and are started from the interrupt of the one before. The
+ * report has the per-device counts and latencies kept by the queue, which
+ * are checked against what the bus model saw, the starts that were chained
+ * from the interrupt, the pool high water mark and rejections, and the
+ * bus utilisation.
+ *
+ * Usage: i2c_bench [-d devices] [-t seconds] [-N nack_permille] [-E bus_error_permille] [-s seed]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "host_device.h"
+#include "host_i2c.h"
+#include "host_sim.h"
+#include "i2cspm.h"
+#include "src/headers/i2c_queue.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_FIRST_ADDR		0x40
+#define BENCH_DEVICES_MAX		I2C_QUEUE_DEVICES_MAX
+#define BENCH_REGS				16
+
+/* Time between the bursts of one driver, and the slave latency range. */
+#define BENCH_PERIOD_MIN_MS		10
+#define BENCH_PERIOD_MAX_MS		40
+#define BENCH_LATENCY_MAX_US	300
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint8_t addr;
+	uint64_t next;							// Virtual tick of the next burst
+	uint16_t expect[BENCH_REGS];			// Register contents after the writes that went through
+	uint32_t bursts;
+	uint32_t verified;
+	uint32_t mismatches;
+	uint32_t follow_ups;					// Reads queued from a completion callback
+} bench_device_t;
+
+static i2c_queue_t bench_queue;
+static bench_device_t bench_devices[BENCH_DEVICES_MAX];
+static uint64_t bench_busy_since;
+static uint64_t bench_busy_ticks;			// Queue held the bus (EM2 blocked)
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t bench_range(uint32_t lo, uint32_t hi)
+{
+	return lo + (bench_rand() % (hi - lo + 1));
+}
+
+void I2C0_IRQHandler(void)
+{
+	i2cQueue_Irq(&bench_queue);
+}
+
+/* Busy hook, as i2c.c: the interrupt is only enabled while the queue holds the bus. */
+static void bench_busy(bool busy)
+{
+	if(busy)
+	{
+		bench_busy_since = host_clock_now();
+		NVIC_ClearPendingIRQ(I2C0_IRQn);
+		NVIC_EnableIRQ(I2C0_IRQn);
+	}
+	else
+	{
+		NVIC_DisableIRQ(I2C0_IRQn);
+		bench_busy_ticks += host_clock_now() - bench_busy_since;
+	}
+}
+
+static void bench_write_done(const i2c_request_t *request)
+{
+	bench_device_t *device = request->context;
+
+	if(request->status == i2cTransferDone)
+		device->expect[request->write[0]] = (uint16_t) ((request->write[1] << 8) | request->write[2]);
+}
+
+/**
+ * @brief Check a register read against the writes that went through; now
+ * and then queue a read of the next register from here.
+ *
+ * @param const i2c_request_t *request
+ * @return void.
+ */
+static void bench_read_done(const i2c_request_t *request)
+{
+	bench_device_t *device = request->context;
+	uint8_t reg = request->write[0];
+	uint16_t value = (uint16_t) ((request->read[0] << 8) | request->read[1]);
+
+	if(request->status != i2cTransferDone)
+		return;
+
+	if(value == device->expect[reg])
+		device->verified++;
+	else
+		device->mismatches++;
+
+	if((bench_rand() & 3) == 0)
+	{
+		uint8_t next = (reg + 1) % BENCH_REGS;
+
+		if(i2cQueue_Transfer(&bench_queue, device->addr, &next, 1, 2, bench_read_done, device))
+			device->follow_ups++;
+	}
+}
+
+/**
+ * @brief One burst of a driver: write a register, then read it back.
+ *
+ * @param bench_device_t *device
+ * @return void.
+ */
+static void bench_burst(bench_device_t *device)
+{
+	uint8_t reg = (uint8_t) bench_range(0, BENCH_REGS - 1);
+	uint16_t value = (uint16_t) bench_rand();
+	uint8_t write[3] = { reg, (uint8_t) (value >> 8), (uint8_t) value };
+
+	device->bursts++;
+	i2cQueue_Transfer(&bench_queue, device->addr, write, sizeof(write), 0, bench_write_done, device);
+	i2cQueue_Transfer(&bench_queue, device->addr, &reg, 1, 2, bench_read_done, device);
+
+	device->next += HOST_MS_TO_TICKS(bench_range(BENCH_PERIOD_MIN_MS, BENCH_PERIOD_MAX_MS));
+}
+
+int main(int argc, char **argv)
+{
+	I2CSPM_Init_TypeDef init = { .port = I2C0, .i2cMaxFreq = HOST_I2C_DEFAULT_HZ };
+	host_i2c_config_t mcp9808_config = { 0, 0, 1 };
+	unsigned long devices = 12, seconds = 60;
+	uint16_t nack_permille = 10, bus_error_permille = 2;
+	uint32_t seed = 1;
+	int opt;
+
+	while((opt = getopt(argc, argv, "d:t:N:E:s:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'd': devices = strtoul(optarg, NULL, 0); break;
+			case 't': seconds = strtoul(optarg, NULL, 0); break;
+			case 'N': nack_permille = (uint16_t) strtoul(optarg, NULL, 0); break;
+			case 'E': bus_error_permille = (uint16_t) strtoul(optarg, NULL, 0); break;
+			case 's': seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-d devices] [-t seconds] [-N nack_permille] [-E bus_error_permille] [-s seed]\n",
+						argv[0]);
+				return 2;
+		}
+	}
+	if(devices == 0 || devices > BENCH_DEVICES_MAX)
+	{
+		fprintf(stderr, "devices must be 1 to %d\n", BENCH_DEVICES_MAX);
+		return 2;
+	}
+
+	bench_seed(seed);
+	mcp9808_config.seed = seed ? seed : 1;
+
+	host_device_reset();
+	host_i2c_configure(&mcp9808_config);
+	host_i2c_detach_all();
+	for(unsigned long i = 0; i < devices; i++)
+	{
+		host_i2c_device_config_t config =
+		{
+			.addr = (uint8_t) (BENCH_FIRST_ADDR + i),
+			.latency_us = bench_range(0, BENCH_LATENCY_MAX_US),
+			.nack_permille = nack_permille,
+			.bus_error_permille = bus_error_permille,
+		};
+
+		host_i2c_attach(&config);
+		bench_devices[i].addr = config.addr;
+		for(uint32_t reg = 0; reg < BENCH_REGS; reg++)
+			bench_devices[i].expect[reg] = (uint16_t) ((config.addr << 8) | reg);
+		bench_devices[i].next = HOST_MS_TO_TICKS(bench_range(0, BENCH_PERIOD_MAX_MS));
+	}
+	host_sim_reset();
+	I2CSPM_Init(&init);
+	i2cQueue_Init(&bench_queue, I2C0, NULL, bench_busy);
+
+	/* Every transfer runs from the bus model and the I2C0 interrupt while time moves on. */
+	uint64_t end = HOST_MS_TO_TICKS((uint64_t) seconds * 1000);
+
+	for(;;)
+	{
+		bench_device_t *due = &bench_devices[0];
+
+		for(unsigned long i = 1; i < devices; i++)
+		{
+			if(bench_devices[i].next < due->next)
+				due = &bench_devices[i];
+		}
+		if(due->next >= end)
+			break;
+
+		host_sim_advance_to(due->next);
+		bench_burst(due);
+	}
+	host_sim_advance_to(end);
+	while(i2cQueue_Pending(&bench_queue))
+		host_sim_advance_to(host_sim_next_event());
+
+	/* Report */
+	const i2c_queue_stats_t *stats = &bench_queue.stats;
+	uint32_t transfers = 0, nacks = 0, bus_errors = 0, bursts = 0, verified = 0, mismatches = 0, follow_ups = 0;
+
+	printf("I2C transfer queue, %lu devices at %u Hz, %lu s, pool %d, NACK %u/1000, bus error %u/1000\n\n",
+		   devices, HOST_I2C_DEFAULT_HZ, seconds, I2C_QUEUE_POOL_SIZE, nack_permille, bus_error_permille);
+	printf("%-6s %8s %8s %6s %7s %10s %10s %8s %8s\n",
+		   "device", "xfers", "done", "nack", "buserr", "lat mean", "lat max", "verified", "mismatch");
+
+	for(unsigned long i = 0; i < devices; i++)
+	{
+		const bench_device_t *device = &bench_devices[i];
+		const i2c_device_stats_t *dev = i2cQueue_DeviceStats(&bench_queue, device->addr);
+
+		if(!dev)
+			continue;
+
+		printf("0x%02x   %8" PRIu32 " %8" PRIu32 " %6" PRIu32 " %7" PRIu32 " %7.0f us %7" PRIu64 " us %8" PRIu32 " %8" PRIu32 "\n",
+			   device->addr, dev->transfers, dev->done, dev->nacks, dev->bus_errors,
+			   dev->transfers ? (double) HOST_TICKS_TO_US(dev->latency_total) / dev->transfers : 0.0,
+			   (uint64_t) HOST_TICKS_TO_US(dev->latency_max), device->verified, device->mismatches);
+
+		transfers += dev->transfers;
+		nacks += dev->nacks;
+		bus_errors += dev->bus_errors;
+		bursts += device->bursts;
+		verified += device->verified;
+		mismatches += device->mismatches;
+		follow_ups += device->follow_ups;
+	}
+
+	printf("\nbursts                   %" PRIu32 " (+%" PRIu32 " reads queued from callbacks)\n", bursts, follow_ups);
+	printf("submitted                %" PRIu32 " (%" PRIu32 " rejected, pool empty)\n", stats->submitted, stats->rejected);
+	printf("transfers                %" PRIu32 " (%" PRIu32 " nack, %" PRIu32 " bus error)\n", transfers, nacks, bus_errors);
+	printf("chained from irq         %" PRIu32 " (%.1f%% of starts)\n", stats->chained,
+		   transfers ? 100.0 * stats->chained / transfers : 0.0);
+	printf("queue high water         %" PRIu32 " of %d\n", stats->high_water, I2C_QUEUE_POOL_SIZE);
+	printf("busy periods             %" PRIu32 " (%.2f transfers each)\n", stats->busy_periods,
+		   stats->busy_periods ? (double) transfers / stats->busy_periods : 0.0);
+	printf("bus utilisation          %.1f%% on the wire, %.1f%% held by the queue\n",
+		   100.0 * host_i2c_stats.busy_ticks / end, 100.0 * bench_busy_ticks / end);
+	printf("read-back                %" PRIu32 " verified, %" PRIu32 " mismatched\n", verified, mismatches);
+
+	/* The queue must account for every transfer the bus model saw. */
+	if(transfers != host_i2c_stats.transfers || nacks != host_i2c_stats.nacks || bus_errors != host_i2c_stats.bus_errors
+	   || stats->other_devices || stats->submitted != transfers)
+	{
+		printf("FAIL: queue counted %" PRIu32 "/%" PRIu32 "/%" PRIu32 ", bus saw %" PRIu32 "/%" PRIu32 "/%" PRIu32 "\n",
+			   transfers, nacks, bus_errors, host_i2c_stats.transfers, host_i2c_stats.nacks, host_i2c_stats.bus_errors);
+		return 1;
+	}
+	if(mismatches || !verified)
+	{
+		printf("FAIL: read-back mismatches\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,343 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file lcd_bench.c
+ *
+ * @brief LCD row-diff rendering benchmark.
+ *
+ * Plays a script of display updates as the firmware issues them (the
+ * temperature row every second, LPN level and alarm rows, connection
+ * and action rows, the bursts of a node reset and of clearing the
+ * alarms, rewrites of unchanged text) through the full redraw of every
+ * update that display.c did first: GLIB_clear(), every row drawn and the
+ * whole frame pushed with DMD_updateDisplay(). Then through displayPrintf()
+ * and displayFlush(), which only clear and draw the rows whose text
+ * changed, once with a frame after every write and once with a frame
+ * per event as the main loop renders them. All run on the DMD frame
+ * buffer over the host display PAL, which counts the bytes the
+ * LS013B7DH03 driver hands to the LDMA; every frame is waited out on
+ * the simulated clock before the next update. Reports SPI bytes and host cycles (TSC)
+ * per update and checks after every event that the row diff leaves the
+ * frame buffer the full redraw does, that a frame the LDMA fails is
+ * sent again in full, and that powering the LCD down under a frame cuts
+ * its power only once the frame is out.
+ *
+ * Usage: lcd_bench [-r rounds]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "host_device.h"
+#include "host_display.h"
+#include "dmd.h"
+#include "hardware/kit/common/drivers/display.h"
+#include "displayls013b7dh03.h"
+#include "src/headers/header.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_ROW_LEN			32			// DISPLAY_ROW_LEN of display.c
+#define BENCH_SPI_US_PER_BYTE	8			// 1 MHz SPI clock
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	enum display_row row;
+	const char *text;
+	bool last;								// Last write of its event
+} bench_update_t;
+
+typedef struct
+{
+	bench_time_t time;
+	uint64_t spi_bytes;
+	uint64_t delay_us;
+} bench_lcd_time_t;
+
+/* One minute or so of a provisioned node: the temperature every second,
+ * LPN readings and alarms, friendships, a node reset (LCD_clearData() and
+ * the name and address) and a button clearing the alarms. The writes of
+ * one event end with the one marked last. */
+static const bench_update_t bench_script[] =
+{
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.125",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.187",		true },
+	{ DISPLAY_ROW_LPN_MOISTURE,	"LPN-1 (%): 41",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.187",		true },
+	{ DISPLAY_ROW_CONNECTION,	"Friend EST.",			false },
+	{ DISPLAY_ROW_CONNECTIONS,	"Connections: 1",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.250",		true },
+	{ DISPLAY_ROW_LPN_ALIGHT,	"LPN-2 (%): 67",		true },
+	{ DISPLAY_ROW_LPN_MOISTURE,	"LPN-1 (%): 41",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.312",		true },
+	{ DISPLAY_ROW_LPN_UVLIGHT,	"LPN-3: ALARM",			true },
+	{ DISPLAY_ROW_ACTION,		"Provisioned",			true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.312",		true },
+	{ DISPLAY_ROW_LPN_MOISTURE,	"LPN-1 (%): 44",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.375",		true },
+	/* gecko_device_reset() */
+	{ DISPLAY_ROW_CONNECTION,	"",						false },
+	{ DISPLAY_ROW_ACTION,		"",						false },
+	{ DISPLAY_ROW_LPN_MOISTURE,	"",						false },
+	{ DISPLAY_ROW_LPN_ALIGHT,	"",						false },
+	{ DISPLAY_ROW_LPN_UVLIGHT,	"",						false },
+	{ DISPLAY_ROW_TEMPERATURE,	"",						false },
+	{ DISPLAY_ROW_CONNECTIONS,	"",						false },
+	{ DISPLAY_ROW_NAME,			"Friend Node (Rushi)",	false },
+	{ DISPLAY_ROW_BTADDR,		"00:0B:57:A1:B2:C3",	true },
+	/* PB0, alarms cleared */
+	{ DISPLAY_ROW_LPN_MOISTURE,	"-",					false },
+	{ DISPLAY_ROW_LPN_ALIGHT,	"-",					false },
+	{ DISPLAY_ROW_LPN_UVLIGHT,	"-",					true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.375",		true },
+	{ DISPLAY_ROW_CONNECTIONS,	"Connections: 1",		true },
+	{ DISPLAY_ROW_TEMPERATURE,	"Temp(C): 23.437",		true },
+};
+
+#define BENCH_SCRIPT_LEN		(sizeof(bench_script) / sizeof(bench_script[0]))
+
+/* What the full redraw draws: the rows as displayPrintf() left them. */
+static char bench_rows[DISPLAY_ROW_MAX][BENCH_ROW_LEN + 1];
+static GLIB_Context_t bench_context;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static void bench_lcd_start(bench_lcd_time_t *time)
+{
+	host_display_reset();
+	bench_start(&time->time);
+}
+
+static void bench_lcd_stop(bench_lcd_time_t *time)
+{
+	bench_stop(&time->time);
+	time->spi_bytes = host_display_stats.spi_bytes;
+	time->delay_us = host_display_stats.delay_us;
+}
+
+/* Run the LDMA model until the frame in flight is out. */
+static void bench_wait_frame(void)
+{
+	while(displayBusy())
+		host_sim_advance_to(host_sim_next_event());
+}
+
+/* The update of display.c as it was: clear everything, draw every row,
+ * push every line. */
+static void bench_full_redraw(void)
+{
+	GLIB_clear(&bench_context);
+	for(int row = DISPLAY_ROW_NAME; row < DISPLAY_ROW_MAX; row++)
+	{
+		uint8_t len = (uint8_t) strlen(bench_rows[row]);
+
+		GLIB_drawString(&bench_context, bench_rows[row], len,
+						(bench_context.pDisplayGeometry->xSize - len * bench_context.font.fontWidth) >> 1,
+						(bench_context.font.lineSpacing + bench_context.font.fontHeight) * row
+						+ bench_context.font.lineSpacing, 0);
+	}
+	DMD_updateDisplay();
+	DISPLAY_Ls013b7dh03Flush(NULL, NULL);
+	bench_wait_frame();
+}
+
+/* One frame per write, as before frames were batched, or only on
+ * the last write of an event, as the main loop does. */
+static void bench_row_diff(const bench_update_t *update, bool per_write)
+{
+	displayPrintf(update->row, "%s", update->text);
+	if(per_write || update->last)
+	{
+		displayFlush();
+		bench_wait_frame();
+	}
+}
+
+static size_t bench_frame(uint8_t **frame)
+{
+	DISPLAY_Device_t device;
+
+	DMD_getFrameBuffer((void **) frame);
+	DISPLAY_DeviceGet(0, &device);
+	return device.geometry.height * (device.geometry.stride / 8);
+}
+
+/* Pixels only: the control bytes after every line carry the line
+ * addresses of whatever run was last sent. */
+static bool bench_frame_equal(const uint8_t *a, const uint8_t *b)
+{
+	DISPLAY_Device_t device;
+
+	DISPLAY_DeviceGet(0, &device);
+	for(unsigned int line = 0; line < device.geometry.height; line++)
+	{
+		size_t offset = line * (device.geometry.stride / 8);
+
+		if(memcmp(a + offset, b + offset, device.geometry.width / 8) != 0)
+			return false;
+	}
+	return true;
+}
+
+static void bench_lcd_print(const char *name, const bench_lcd_time_t *time, unsigned long updates)
+{
+	printf("  %-22s %9.1f %9.1f", name, (double) time->spi_bytes / updates,
+		   ((double) time->spi_bytes * BENCH_SPI_US_PER_BYTE + time->delay_us) / updates);
+#ifdef BENCH_HAVE_TSC
+	printf(" %11.0f", (double) time->time.cycles / updates);
+#else
+	printf(" %11s", "n/a");
+#endif
+	printf(" %9.0f\n", (double) time->time.ns / updates);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long rounds = 2000, updates, mismatched = 0;
+	uint32_t sent;
+	bool resent, held;
+	bench_lcd_time_t full, diff, batched;
+	const struct display_stats *stats = displayStats();
+	uint32_t frames, drawn, skipped, unchanged;
+	uint8_t *frame, *expect;
+	size_t frame_len;
+	int opt;
+
+	while((opt = getopt(argc, argv, "r:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'r': rounds = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-r rounds]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(rounds == 0)
+		rounds = 1;
+
+	/* The LDMA model sends the frames, on the simulated clock. */
+	host_device_reset();
+	host_sim_reset();
+	displayInit();
+	for(int row = DISPLAY_ROW_NAME; row < DISPLAY_ROW_MAX; row++)
+		strcpy(bench_rows[row], " ");
+
+	GLIB_contextInit(&bench_context);
+	bench_context.backgroundColor = White;
+	bench_context.foregroundColor = Black;
+	GLIB_setFont(&bench_context, (GLIB_Font_t *) &GLIB_FontNarrow6x8);
+
+	/* Both leave the same frame buffer after every event. */
+	frame_len = bench_frame(&frame);
+	expect = malloc(frame_len);
+	if(expect == NULL)
+		return 2;
+	for(size_t i = 0; i < BENCH_SCRIPT_LEN; i++)
+	{
+		strcpy(bench_rows[bench_script[i].row], bench_script[i].text);
+		bench_row_diff(&bench_script[i], false);
+		if(!bench_script[i].last)
+			continue;
+		memcpy(expect, frame, frame_len);
+		bench_full_redraw();
+		if(!bench_frame_equal(expect, frame))
+			mismatched++;
+	}
+
+	/* A frame the LDMA fails half way is drawn and sent whole again. */
+	sent = stats->frames_sent;
+	strcpy(bench_rows[DISPLAY_ROW_ACTION], "LDMA error");
+	host_display_fail_next();
+	displayPrintf(DISPLAY_ROW_ACTION, "%s", bench_rows[DISPLAY_ROW_ACTION]);
+	displayFlush();
+	bench_wait_frame();
+	displayFlush();
+	bench_wait_frame();
+	memcpy(expect, frame, frame_len);
+	bench_full_redraw();
+	resent = stats->frames_failed == 1 && stats->frames_sent - sent == 2 && bench_frame_equal(expect, frame);
+
+	/* The LCD keeps its power until the frame in flight is out. */
+	displayPrintf(DISPLAY_ROW_ACTION, "%s", "Power down");
+	displayFlush();
+	displaySetPower(false);
+	held = displayBusy() && GPIO_PinOutGet(LCD_port, LCD_pin);
+	bench_wait_frame();
+	displayFlush();
+	held = held && !GPIO_PinOutGet(LCD_port, LCD_pin);
+	displaySetPower(true);
+	displayFlush();
+	bench_wait_frame();
+
+	updates = rounds * BENCH_SCRIPT_LEN;
+	printf("LCD updates, %lu of them (%zu in the script)\n", updates, BENCH_SCRIPT_LEN);
+	printf("  %-22s %9s %9s %11s %9s\n", "path", "spi B/upd", "us/upd", "cyc/upd", "ns/upd");
+
+	bench_lcd_start(&full);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(size_t i = 0; i < BENCH_SCRIPT_LEN; i++)
+		{
+			strcpy(bench_rows[bench_script[i].row], bench_script[i].text);
+			bench_full_redraw();
+		}
+	bench_lcd_stop(&full);
+	bench_lcd_print("full redraw (before)", &full, updates);
+
+	/* display.c and the full redraw end on the same text. */
+	bench_lcd_start(&diff);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(size_t i = 0; i < BENCH_SCRIPT_LEN; i++)
+			bench_row_diff(&bench_script[i], true);
+	bench_lcd_stop(&diff);
+	bench_lcd_print("row diff, every write", &diff, updates);
+
+	frames = stats->frames;
+	drawn = stats->rows_drawn;
+	skipped = stats->rows_skipped;
+	unchanged = stats->frames_unchanged;
+
+	bench_lcd_start(&batched);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(size_t i = 0; i < BENCH_SCRIPT_LEN; i++)
+			bench_row_diff(&bench_script[i], false);
+	bench_lcd_stop(&batched);
+	bench_lcd_print("row diff, every event", &batched, updates);
+
+	printf("frames per update        %.2f, %.2f rows drawn of %d (%.2f skipped), %" PRIu32 " frames changed nothing\n",
+		   (double) (stats->frames - frames) / updates, (double) (stats->rows_drawn - drawn) / updates, DISPLAY_ROW_MAX,
+		   (double) (stats->rows_skipped - skipped) / updates, stats->frames_unchanged - unchanged);
+	printf("spi bytes saved          %.1f%% every write, %.1f%% every event\n",
+		   full.spi_bytes ? 100.0 - 100.0 * diff.spi_bytes / full.spi_bytes : 0.0,
+		   full.spi_bytes ? 100.0 - 100.0 * batched.spi_bytes / full.spi_bytes : 0.0);
+	printf("cycles saved             %.1f%% every write, %.1f%% every event\n",
+		   full.time.cycles ? 100.0 - 100.0 * diff.time.cycles / full.time.cycles : 0.0,
+		   full.time.cycles ? 100.0 - 100.0 * batched.time.cycles / full.time.cycles : 0.0);
+	printf("frame buffer mismatches  %lu\n", mismatched);
+	printf("failed frame sent again  %s\n", resent ? "yes" : "NO");
+	printf("power held under frame   %s\n", held ? "yes" : "NO");
+
+	free(expect);
+	return (mismatched || !resent || !held) ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file lpn_bench.c
+ *
+ * @brief LPN registry lookup benchmark.
+ *
+ * Fills the registry (src/main-src/lpn_registry.c) with a growing number of
+ * random unicast addresses and times lookups of registered addresses (hits)
+ * and of unregistered ones (misses). A linear scan over the slot table is
+ * timed alongside as the baseline the fixed switch statements grew into
+ * once the node had to serve more than a handful of LPNs. Every lookup
+ * result is checked.
+ *
+ * Usage: lpn_bench [-q lookups] [-s seed]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/lpn_registry.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Mesh unicast addresses; 0x0001 is the friend node itself. */
+#define BENCH_ADDR_MIN			0x0002
+#define BENCH_ADDR_MAX			0x7FFF
+
+#define BENCH_QUERY_MASK		4095		// Query table size - 1
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static lpn_registry_t registry;
+static uint16_t hits[BENCH_QUERY_MASK + 1];
+static uint16_t misses[BENCH_QUERY_MASK + 1];
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t bench_addr(void)
+{
+	return (uint16_t) (BENCH_ADDR_MIN + bench_rand() % (BENCH_ADDR_MAX - BENCH_ADDR_MIN + 1));
+}
+
+/**
+ * @brief Baseline: scan the slot table front to back.
+ *
+ * @param uint16_t addr
+ * @return uint16_t Slot or LPN_SLOT_INVALID.
+ */
+static uint16_t bench_linear_find(uint16_t addr)
+{
+	for(uint16_t slot = 0; slot < registry.count; slot++)
+	{
+		if(registry.slot_addr[slot] == addr)
+			return slot;
+	}
+	return LPN_SLOT_INVALID;
+}
+
+/**
+ * @brief Time lookups of a query table, checking each result.
+ *
+ * @param const uint16_t *queries, unsigned long lookups, bool linear, bool expect_hit
+ * @return double Nanoseconds per lookup, negative on a wrong result.
+ */
+static double bench_run(const uint16_t *queries, unsigned long lookups, bool linear, bool expect_hit)
+{
+	uint64_t start = bench_now_ns();
+	unsigned long errors = 0;
+
+	for(unsigned long i = 0; i < lookups; i++)
+	{
+		uint16_t addr = queries[i & BENCH_QUERY_MASK];
+		uint16_t slot = linear ? bench_linear_find(addr) : lpnRegistry_Find(&registry, addr);
+
+		if(expect_hit ? lpnRegistry_Addr(&registry, slot) != addr : slot != LPN_SLOT_INVALID)
+			errors++;
+	}
+
+	if(errors)
+		return -1.0;
+	return (double) (bench_now_ns() - start) / (double) lookups;
+}
+
+int main(int argc, char **argv)
+{
+	static const uint16_t sizes[] = { 3, 8, 16, 32, 64, 128, LPN_REGISTRY_MAX };
+	unsigned long lookups = 4000000;
+	uint32_t seed = 1;
+	int opt;
+
+	while((opt = getopt(argc, argv, "q:s:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'q': lookups = strtoul(optarg, NULL, 0); break;
+			case 's': seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-q lookups] [-s seed]\n", argv[0]);
+				return 2;
+		}
+	}
+
+	bench_seed(seed);
+
+	printf("registry size %u bytes, %lu lookups per cell\n", (unsigned) sizeof(registry), lookups);
+	printf("%6s %14s %14s %14s %14s\n", "lpns", "find hit ns", "find miss ns", "linear hit ns", "linear miss ns");
+
+	for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		double cells[4];
+
+		lpnRegistry_Init(&registry);
+		while(registry.count < sizes[s])
+		{
+			lpnRegistry_Add(&registry, bench_addr());
+		}
+
+		for(int i = 0; i <= BENCH_QUERY_MASK; i++)
+		{
+			hits[i] = registry.slot_addr[bench_rand() % registry.count];
+			do
+			{
+				misses[i] = bench_addr();
+			} while(lpnRegistry_Find(&registry, misses[i]) != LPN_SLOT_INVALID);
+		}
+
+		cells[0] = bench_run(hits, lookups, false, true);
+		cells[1] = bench_run(misses, lookups, false, false);
+		cells[2] = bench_run(hits, lookups, true, true);
+		cells[3] = bench_run(misses, lookups, true, false);
+
+		for(int i = 0; i < 4; i++)
+		{
+			if(cells[i] < 0)
+			{
+				fprintf(stderr, "wrong lookup result with %u lpns\n", sizes[s]);
+				return 1;
+			}
+		}
+
+		printf("%6u %14.2f %14.2f %14.2f %14.2f\n", sizes[s], cells[0], cells[1], cells[2], cells[3]);
+	}
+
+	return 0;
+}
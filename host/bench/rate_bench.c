@@ -0,0 +1,367 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file rate_bench.c
+ *
+ * @brief Adaptive sampling benchmark: samples saved against reconstruction
+ * error.
+ *
+ * Each trace is a temperature known every second. A policy
+ * (src/main-src/sample_rate.c) samples it: the first reading at time 0,
+ * each next one a period later, as the state machine does on the wakeup
+ * coordinator. The readings are then checked against the trace at every
+ * second, both as the node shows them (the last reading held) and as the
+ * history can be read back (readings joined by straight lines), and every
+ * upward crossing of T_CRIT in the trace is timed until a reading sees it,
+ * or counted as missed if the temperature falls back first.
+ *
+ * Traces:
+ * - the MCP9808 temperatures of a host event trace (-t, the bench trace),
+ *   held between records;
+ * - a generated greenhouse: a daily cycle with drift and noise, quantised
+ *   to the MCP9808's 0.0625 C steps, with vents opening now and then and a
+ *   heat excursion past T_CRIT on the second afternoon;
+ * - with -f, a text file of "seconds milli-degrees" lines, held between
+ *   lines.
+ *
+ * Usage: rate_bench [-t host.trace] [-f trace.txt] [-d days]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "host_trace.h"
+#include "src/headers/sample_rate.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_T_CRIT_MC			45000		// MCP9808_T_CRIT_MC
+#define BENCH_SECONDS_PER_DAY	86400
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *name;
+	size_t seconds;
+	int32_t *value;							// Milli-degrees, one per second
+} bench_trace_t;
+
+typedef struct
+{
+	const char *name;
+	sample_rate_config_t config;
+} bench_policy_t;
+
+/* The firmware policy first; the others vary one setting each. */
+static const bench_policy_t bench_policies[] =
+{
+	{ "fixed 1 s",				{ 1000, 1000, 1000, 1000, SAMPLE_RATE_STEP_MC, SAMPLE_RATE_STABLE_MC,
+								  SAMPLE_RATE_MARGIN_MC, 1, { BENCH_T_CRIT_MC } } },
+	{ "adaptive (firmware)",	{ SAMPLE_RATE_MIN_MS, SAMPLE_RATE_MAX_MS, SAMPLE_RATE_BASE_MS, SAMPLE_RATE_BASE_MS,
+								  SAMPLE_RATE_STEP_MC, SAMPLE_RATE_STABLE_MC, SAMPLE_RATE_MARGIN_MC, 1,
+								  { BENCH_T_CRIT_MC } } },
+	{ "adaptive, step 0.125 C",	{ SAMPLE_RATE_MIN_MS, SAMPLE_RATE_MAX_MS, SAMPLE_RATE_BASE_MS, SAMPLE_RATE_BASE_MS,
+								  125, SAMPLE_RATE_STABLE_MC, SAMPLE_RATE_MARGIN_MC, 1, { BENCH_T_CRIT_MC } } },
+	{ "adaptive, step 0.5 C",	{ SAMPLE_RATE_MIN_MS, SAMPLE_RATE_MAX_MS, SAMPLE_RATE_BASE_MS, SAMPLE_RATE_BASE_MS,
+								  500, SAMPLE_RATE_STABLE_MC, SAMPLE_RATE_MARGIN_MC, 1, { BENCH_T_CRIT_MC } } },
+	{ "adaptive, max 10 s",		{ SAMPLE_RATE_MIN_MS, 10000, SAMPLE_RATE_BASE_MS, SAMPLE_RATE_BASE_MS,
+								  SAMPLE_RATE_STEP_MC, SAMPLE_RATE_STABLE_MC, SAMPLE_RATE_MARGIN_MC, 1,
+								  { BENCH_T_CRIT_MC } } },
+	{ "adaptive, no threshold",	{ SAMPLE_RATE_MIN_MS, SAMPLE_RATE_MAX_MS, SAMPLE_RATE_BASE_MS, SAMPLE_RATE_BASE_MS,
+								  SAMPLE_RATE_STEP_MC, SAMPLE_RATE_STABLE_MC, SAMPLE_RATE_MARGIN_MC, 0, { 0 } } },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static void bench_trace_alloc(bench_trace_t *trace, const char *name, size_t seconds)
+{
+	trace->name = name;
+	trace->seconds = seconds;
+	trace->value = bench_alloc(seconds * sizeof(*trace->value));
+}
+
+/* Hold value from second first to the end of the trace. */
+static void bench_hold(bench_trace_t *trace, size_t first, int32_t value)
+{
+	for(size_t i = first; i < trace->seconds; i++)
+		trace->value[i] = value;
+}
+
+/**
+ * @brief The MCP9808 temperatures of a host event trace, from its first
+ * temp record to its last.
+ *
+ * @param bench_trace_t *trace, const char *path
+ * @return int 0, or -1 if the trace does not load or has no temperature.
+ */
+static int bench_load_host(bench_trace_t *trace, const char *path)
+{
+	host_trace_t events;
+	uint32_t first = 0, last = 0;
+	size_t temps = 0;
+
+	if(!host_trace_load(path, &events))
+		return -1;
+
+	for(size_t i = 0; i < events.count; i++)
+	{
+		if(events.records[i].kind != HOST_TRACE_TEMP)
+			continue;
+		if(temps++ == 0)
+			first = events.records[i].time_ms;
+		last = events.records[i].time_ms;
+	}
+	if(temps < 2)
+	{
+		fprintf(stderr, "%s: fewer than 2 temp records\n", path);
+		host_trace_free(&events);
+		return -1;
+	}
+
+	bench_trace_alloc(trace, path, (last - first) / 1000 + 1);
+	for(size_t i = 0; i < events.count; i++)
+	{
+		if(events.records[i].kind == HOST_TRACE_TEMP)
+			bench_hold(trace, (events.records[i].time_ms - first) / 1000, events.records[i].arg0);
+	}
+
+	host_trace_free(&events);
+	return 0;
+}
+
+static int bench_load_text(bench_trace_t *trace, const char *path)
+{
+	FILE *file = fopen(path, "r");
+	unsigned long time, first = 0, last = 0;
+	long value;
+	size_t lines = 0;
+
+	if(!file)
+	{
+		perror(path);
+		return -1;
+	}
+
+	while(fscanf(file, "%lu %ld", &time, &value) == 2)
+	{
+		if(lines++ == 0)
+			first = time;
+		last = time;
+	}
+	if(lines < 2 || last <= first)
+	{
+		fprintf(stderr, "%s: needs 2 or more lines, in time order\n", path);
+		fclose(file);
+		return -1;
+	}
+
+	bench_trace_alloc(trace, path, last - first + 1);
+	rewind(file);
+	while(fscanf(file, "%lu %ld", &time, &value) == 2)
+	{
+		if(time >= first && time - first < trace->seconds)
+			bench_hold(trace, time - first, (int32_t) value);
+	}
+	fclose(file);
+	return 0;
+}
+
+/**
+ * @brief Greenhouse temperature: 22 C +- 6 C over the day, drift and
+ * sensor noise, vents opening about six times a day (a drop of 3 to 6 C
+ * that recovers over some 20 minutes) and on the second afternoon a heat
+ * excursion to 48 C that takes an hour there and back.
+ *
+ * @param bench_trace_t *trace, unsigned int days
+ * @return void.
+ */
+static void bench_greenhouse(bench_trace_t *trace, unsigned int days)
+{
+	double drift = 0, vent = 0;
+	size_t excursion = BENCH_SECONDS_PER_DAY + 14 * 3600;
+
+	bench_trace_alloc(trace, "greenhouse (generated)", (size_t) days * BENCH_SECONDS_PER_DAY);
+	for(size_t i = 0; i < trace->seconds; i++)
+	{
+		double celsius;
+
+		drift += bench_gauss() * 0.002;
+		if(bench_rand() % (BENCH_SECONDS_PER_DAY / 6) == 0)
+			vent -= 3.0 + (bench_rand() % 300) / 100.0;
+		vent *= 0.999;
+
+		celsius = 22.0 + 6.0 * sin(2 * M_PI * i / BENCH_SECONDS_PER_DAY - M_PI / 2) + drift + vent
+				  + bench_gauss() * 0.03;
+		if(i >= excursion && i < excursion + 3600)
+			celsius += 20.0 * sin(M_PI * (i - excursion) / 3600.0);
+
+		trace->value[i] = (int32_t) (floor(celsius / 0.0625) * 62.5);
+	}
+}
+
+/**
+ * @brief Sample a trace under a policy and report the readings taken
+ * against the errors.
+ *
+ * @param const bench_trace_t *trace, const bench_policy_t *policy
+ * @return void.
+ */
+static void bench_run(const bench_trace_t *trace, const bench_policy_t *policy)
+{
+	static uint64_t *taken;
+	static size_t taken_size;
+	sample_rate_t rate;
+	uint64_t now = 0, end = (uint64_t) trace->seconds * 1000;
+	size_t count = 0, next = 0;
+	double hold_sq = 0, line_sq = 0;
+	int32_t hold_max = 0, line_max = 0;
+	unsigned long crossings = 0, missed = 0;
+	uint64_t delay_total = 0, delay_max = 0;
+
+	/* Reading times, in ms. */
+	sampleRate_Init(&rate, &policy->config);
+	while(now < end)
+	{
+		if(count == taken_size)
+		{
+			taken_size = taken_size ? taken_size * 2 : 4096;
+			taken = realloc(taken, taken_size * sizeof(*taken));
+			if(!taken)
+			{
+				fprintf(stderr, "out of memory\n");
+				exit(2);
+			}
+		}
+		taken[count++] = now;
+		now += sampleRate_Update(&rate, (uint32_t) now, trace->value[now / 1000]);
+	}
+
+	/* Errors at every second. */
+	for(size_t i = 0; i < trace->seconds; i++)
+	{
+		uint64_t t = (uint64_t) i * 1000;
+		int32_t truth = trace->value[i], held, line;
+
+		while(next + 1 < count && taken[next + 1] <= t)
+			next++;
+		held = trace->value[taken[next] / 1000];
+		line = held;
+		if(next + 1 < count)
+		{
+			int32_t after = trace->value[taken[next + 1] / 1000];
+
+			line = held + (int32_t) (((int64_t) (after - held) * (int64_t) (t - taken[next]))
+									 / (int64_t) (taken[next + 1] - taken[next]));
+		}
+
+		hold_sq += (double) (held - truth) * (held - truth);
+		line_sq += (double) (line - truth) * (line - truth);
+		if(abs(held - truth) > hold_max)
+			hold_max = abs(held - truth);
+		if(abs(line - truth) > line_max)
+			line_max = abs(line - truth);
+	}
+
+	/* Upward crossings of T_CRIT: time until a reading sees it, before the
+	 * temperature falls back. */
+	next = 0;
+	for(size_t i = 1; i < trace->seconds; i++)
+	{
+		size_t fall = i;
+
+		if(!(trace->value[i - 1] < BENCH_T_CRIT_MC && trace->value[i] >= BENCH_T_CRIT_MC))
+			continue;
+
+		while(fall < trace->seconds && trace->value[fall] >= BENCH_T_CRIT_MC)
+			fall++;
+		while(next < count && taken[next] < (uint64_t) i * 1000)
+			next++;
+
+		crossings++;
+		if(next < count && taken[next] < (uint64_t) fall * 1000)
+		{
+			uint64_t delay = taken[next] - (uint64_t) i * 1000;
+
+			delay_total += delay;
+			if(delay > delay_max)
+				delay_max = delay;
+		}
+		else
+			missed++;
+	}
+
+	printf("  %-24s %8zu %6.1f%% %8.1f %8.1f %8.1f %8.1f", policy->name, count,
+		   100.0 * (1.0 - (double) count / (double) trace->seconds),
+		   sqrt(hold_sq / trace->seconds), (double) hold_max,
+		   sqrt(line_sq / trace->seconds), (double) line_max);
+	if(crossings)
+		printf(" %4lu/%-4lu %7.1f %7.1f\n", crossings - missed, crossings,
+			   crossings > missed ? (double) delay_total / (crossings - missed) / 1000.0 : 0.0,
+			   (double) delay_max / 1000.0);
+	else
+		printf(" %9s\n", "-");
+}
+
+int main(int argc, char **argv)
+{
+	const char *host_path = NULL, *text_path = NULL;
+	unsigned int days = 3;
+	bench_trace_t traces[3];
+	int count = 0, opt;
+
+	while((opt = getopt(argc, argv, "t:f:d:")) != -1)
+	{
+		switch(opt)
+		{
+			case 't': host_path = optarg; break;
+			case 'f': text_path = optarg; break;
+			case 'd': days = (unsigned int) strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-t host.trace] [-f trace.txt] [-d days]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(days < 2)
+	{
+		fprintf(stderr, "at least 2 days, for the heat excursion\n");
+		return 2;
+	}
+
+	if(host_path && bench_load_host(&traces[count++], host_path))
+		return 2;
+	if(text_path && bench_load_text(&traces[count++], text_path))
+		return 2;
+	bench_greenhouse(&traces[count++], days);
+
+	printf("readings against the trace at every second; T_CRIT %.1f C\n", BENCH_T_CRIT_MC / 1000.0);
+	for(int t = 0; t < count; t++)
+	{
+		printf("%s, %.1f h, %zu s at 1 Hz\n", traces[t].name, traces[t].seconds / 3600.0, traces[t].seconds);
+		printf("  %-24s %8s %7s %8s %8s %8s %8s %9s %7s %7s\n", "policy", "readings", "saved",
+			   "hold rms", "max mC", "line rms", "max mC", "crit seen", "mean s", "max s");
+		for(size_t p = 0; p < sizeof(bench_policies) / sizeof(bench_policies[0]); p++)
+			bench_run(&traces[t], &bench_policies[p]);
+		free(traces[t].value);
+	}
+
+	return 0;
+}
@@ -0,0 +1,726 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file replay.c
+ *
+ * @brief Trace replay benchmark.
+ *
+ * Runs the unmodified firmware main loop (src/main.c) on the host against
+ * a recorded or generated event trace and reports the host cost of the
+ * application event path together with the BGAPI, I2C and display
+ * traffic the trace caused. Per event class handling latency (host time
+ * from gecko_wait_event() returning an event to the firmware asking for
+ * the next one) is reported as percentiles over all iterations.
+ *
+ * The sleeptimer and I2C0 run as virtual-time models (host_sim.h); their
+ * wakeups per hour, ISR cost and the resulting temperature sampling
+ * jitter are reported as well.
+ *
+ * Built with SENSOR_EXTRAS_ENABLED (make SENSORS=1), models of the SHT3x,
+ * SCD4x and OPT3001 are attached to the bus for the firmware to batch
+ * with the MCP9808.
+ *
+ * Usage: replay [-L i2c_latency_us] [-N i2c_nack_permille] [-S seed] <trace> [iterations]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "host_device.h"
+#include "host_display.h"
+#include "host_gecko.h"
+#include "host_i2c.h"
+#include "host_mx25.h"
+#include "host_nvm3.h"
+#include "host_sim.h"
+#include "host_sleeptimer.h"
+#include "host_trace.h"
+#include "src/headers/sleep_profile.h"
+#include "app_src.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* PS key and maximum length used by gecko_store_alarms() (app.h). */
+#define REPLAY_ALARM_PS_KEY		0x4000
+#define REPLAY_ALARM_PS_MAX		LPN_ALARM_BYTES(LPN_REGISTRY_MAX)
+
+#define REPLAY_MS_PER_HOUR		3600000.0
+#define REPLAY_LCD_SPI_US_PER_BYTE	8			// HAL_SPIDISPLAY_FREQUENCY 1 MHz
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* src/main.c main(), renamed by the host Makefile. */
+int firmware_main(void);
+
+static struct
+{
+	uint64_t *ns;
+	size_t count;
+	size_t capacity;
+} latency[HOST_EVT_COUNT];
+
+#ifdef SENSOR_EXTRAS_ENABLED
+/* The other sensors of the node: SHT3x at 25 C and 50 %RH, SCD4x at
+ * 500 ppm, each word with its CRC-8, and the OPT3001 result register as
+ * it powers up in the model (0x4500, 204.80 lux). */
+static const uint8_t replay_sht3x_response[] = { 0x66, 0x66, 0x93, 0x80, 0x00, 0xA2 };
+static const uint8_t replay_scd4x_response[] = { 0x01, 0xF4, 0x33 };
+
+static const host_i2c_device_config_t replay_extra_devices[] =
+{
+	{ .addr = SHT3X_ADDR, .response = replay_sht3x_response, .response_len = sizeof(replay_sht3x_response) },
+	{ .addr = SCD4X_ADDR, .response = replay_scd4x_response, .response_len = sizeof(replay_scd4x_response) },
+	{ .addr = OPT3001_ADDR },
+};
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t replay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+static void replay_latency_hook(host_gecko_evt_t evt, uint64_t ns)
+{
+	if(latency[evt].count == latency[evt].capacity)
+	{
+		size_t capacity = latency[evt].capacity ? latency[evt].capacity * 2 : 1024;
+		uint64_t *grown = realloc(latency[evt].ns, capacity * sizeof(*grown));
+
+		if(!grown)
+			return;
+		latency[evt].ns = grown;
+		latency[evt].capacity = capacity;
+	}
+	latency[evt].ns[latency[evt].count++] = ns;
+}
+
+/**
+ * @brief Fake clock for the firmware latency histograms, in RTCC ticks
+ * like the target one.
+ *
+ * The virtual clock stands still while the firmware runs, so the time the
+ * target would spend blocked is added on top: display busy-waits, the LCD
+ * SPI bytes the CPU sends at 1 MHz and the MX25 program/erase busy time.
+ * Frames sent by the LDMA take their time on the virtual clock instead.
+ * The result is deterministic for a given trace.
+ *
+ * @param void
+ * @return uint32_t.
+ */
+static uint32_t replay_latency_clock(void)
+{
+	uint64_t blocked_us = host_display_stats.delay_us
+						  + (host_display_stats.spi_bytes - host_display_stats.dma_bytes) * REPLAY_LCD_SPI_US_PER_BYTE
+						  + host_mx25_stats.busy_us;
+
+	return (uint32_t) (host_clock_now() + (blocked_us * HOST_CLOCK_HZ) / 1000000ULL);
+}
+
+static int replay_cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *) a;
+	uint64_t y = *(const uint64_t *) b;
+
+	return (x > y) - (x < y);
+}
+
+static uint64_t replay_percentile(const uint64_t *sorted, size_t count, unsigned pct)
+{
+	size_t rank = (count * pct + 99) / 100;
+
+	return sorted[rank ? rank - 1 : 0];
+}
+
+/**
+ * @brief Print handling latency percentiles per event class (host ns).
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_latency_report(void)
+{
+	printf("event latency (ns)       %10s %8s %8s %8s %8s\n", "count", "p50", "p90", "p99", "max");
+	for(int i = 0; i < HOST_EVT_COUNT; i++)
+	{
+		size_t n = latency[i].count;
+
+		if(n == 0)
+			continue;
+
+		qsort(latency[i].ns, n, sizeof(uint64_t), replay_cmp_u64);
+		printf("  %-36s %10zu %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n",
+			   host_gecko_evt_name((host_gecko_evt_t) i), n,
+			   replay_percentile(latency[i].ns, n, 50), replay_percentile(latency[i].ns, n, 90),
+			   replay_percentile(latency[i].ns, n, 99), latency[i].ns[n - 1]);
+		free(latency[i].ns);
+		latency[i].ns = NULL;
+	}
+}
+
+static void replay_reset(void)
+{
+	/* The display driver survives into the next iteration: let the frame
+	 * the last one left on the LDMA go out, or the driver stays busy. */
+	while(host_display_busy())
+		host_sim_advance_to(host_sim_next_event());
+
+	host_device_reset();
+	host_sim_reset();
+	host_display_reset();
+	host_nvm3_reset();
+	host_mx25_reset();
+	host_gecko_reset();
+}
+
+/**
+ * @brief Print the alarm journal and NVM3 counters, then recover the
+ * journal as a reboot would and check that nothing was lost.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_journal_report(void)
+{
+	alarm_journal_stats_t stats;
+	alarm_journal_record_t before, after;
+	uint32_t count = alarmJournal_Count();
+	bool newest = alarmJournal_Read(0, &before);
+
+	alarmJournal_GetStats(&stats);
+	printf("journal appends          %" PRIu32 " (%" PRIu32 " kept, %" PRIu32 " write errors)\n",
+		   stats.appends, count, stats.write_errors);
+	printf("journal idle repacks     %" PRIu32 " (%" PRIu32 " errors)\n", stats.repacks, stats.repack_errors);
+	printf("nvm3 writes              %" PRIu32 " (%" PRIu64 " data bytes, %" PRIu64 " flash bytes)\n",
+		   host_nvm3_stats.writes, host_nvm3_stats.data_bytes, host_nvm3_stats.flash_bytes);
+	printf("nvm3 page erases         %" PRIu32 " (%" PRIu32 " user repacks, %" PRIu32 " forced in a write)\n",
+		   host_nvm3_stats.page_erases, host_nvm3_stats.user_repacks, host_nvm3_stats.forced_repacks);
+
+	alarmJournal_Init();
+	alarmJournal_GetStats(&stats);
+	if(!newest)
+		printf("journal recovery         %" PRIu32 " records\n", stats.recovered);
+	else if(alarmJournal_Read(0, &after) && after.seq == before.seq && stats.recovered == count)
+		printf("journal recovery         %" PRIu32 " records, newest seq %" PRIu32 " (ok)\n", stats.recovered, after.seq);
+	else
+		printf("journal recovery         %" PRIu32 " records (MISMATCH)\n", stats.recovered);
+}
+
+/**
+ * @brief Print the MX25 history and flash counters, flush what is still in
+ * RAM as a restart would and check that the boot scan finds every page.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_history_report(void)
+{
+	sensor_history_stats_t stats;
+	uint32_t pages;
+
+	sensorHistory_GetStats(&stats);
+	printf("history samples          %" PRIu32 " (%" PRIu32 " dropped), %" PRIu32 " pages, %" PRIu32 " inline\n",
+		   stats.appends, stats.dropped, stats.pages, stats.inline_writes);
+	printf("mx25 programs / erases   %" PRIu32 " / %" PRIu32 " (%" PRIu32 " inline erases, %" PRIu64 " overwrites)\n",
+		   host_mx25_stats.programs, host_mx25_stats.erases, stats.inline_erases, host_mx25_stats.overwrites);
+	if(stats.appends)
+		printf("mx25 bytes / sample      %.2f programmed (write amplification %.3f), %.1f us busy\n",
+			   (double) host_mx25_stats.program_bytes / stats.appends,
+			   (double) host_mx25_stats.program_bytes / ((double) stats.appends * sizeof(sensor_history_record_t)),
+			   (double) host_mx25_stats.busy_us / stats.appends);
+	printf("mx25 wake-ups            %" PRIu32 " (%" PRIu32 " behind an LCD frame, %s)\n", host_mx25_stats.wakeups,
+		   stats.display_waits, host_mx25_powered_down() ? "in deep power-down" : "left AWAKE");
+
+	sensorHistory_Flush();
+	pages = sensorHistory_PageCount();
+	sensorHistory_Init();
+	sensorHistory_GetStats(&stats);
+	printf("history recovery         %" PRIu32 " pages (%s)\n", stats.recovered,
+		   (stats.recovered == pages) ? "ok" : "MISMATCH");
+}
+
+/**
+ * @brief Print the sensor history the node could answer trend queries
+ * from: the last minute rollups of the temperature and of the first LPN.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_series_report(void)
+{
+	static const struct { uint16_t channel; const char *name; } channels[] =
+	{
+		{ SENSOR_SERIES_TEMPERATURE, "temperature (cC)" },
+		{ SENSOR_SERIES_LPN(0), "lpn slot 0 level" },
+	};
+
+	printf("sensor series            %" PRIu32 " samples (%" PRIu32 " dropped), %zu bytes\n",
+		   sensor_series.inserts, sensor_series.dropped, sizeof(sensor_series));
+
+	for(size_t i = 0; i < sizeof(channels) / sizeof(channels[0]); i++)
+	{
+		uint32_t now = sensor_series.channel[channels[i].channel].last_time;
+
+		printf("  %-22s", channels[i].name);
+		for(uint16_t age = 0; age < 3; age++)
+		{
+			time_series_rollup_t rollup;
+
+			if(timeSeries_Rollup(&sensor_series, channels[i].channel, TIME_SERIES_MINUTE, now, age, &rollup)
+				&& rollup.count)
+				printf(" [%" PRId16 " %" PRId16 " %" PRId16 " n=%" PRIu16 "]", rollup.min, rollup.mean, rollup.max,
+					   rollup.count);
+			else
+				printf(" [-]");
+		}
+		printf("\n");
+	}
+}
+
+/**
+ * @brief Upper limit (us) of the bucket holding the given share of a
+ * firmware latency histogram.
+ *
+ * @param const uint32_t *buckets, uint64_t total, unsigned pct, char *text, size_t size
+ * @return const char * "<limit", or ">limit" for the open last bucket.
+ */
+static const char *replay_histogram_percentile(const uint32_t *buckets, uint64_t total, unsigned pct, char *text,
+											   size_t size)
+{
+	uint64_t rank = (total * pct + 99) / 100, seen = 0;
+	uint8_t b;
+
+	for(b = 0; b < LATENCY_BUCKETS - 1; b++)
+	{
+		seen += buckets[b];
+		if(seen >= rank)
+			break;
+	}
+	if(b == LATENCY_BUCKETS - 1)
+		snprintf(text, size, ">%" PRIu32, latency_BucketLimitUs(LATENCY_BUCKETS - 2));
+	else
+		snprintf(text, size, "<%" PRIu32, latency_BucketLimitUs(b));
+	return text;
+}
+
+/**
+ * @brief Print the firmware latency histograms (fake clock): count,
+ * bucket of the median and of the 99th percentile, and the worst case.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_histogram_report(void)
+{
+	const latency_histograms_t *histograms = latency_Histograms();
+	char p50[16], p99[16];
+
+	printf("firmware latency (us)    %-24s %10s %8s %8s %8s\n", "stage", "count", "p50", "p99", "max");
+	for(uint8_t event = 0; event < LATENCY_EVT_COUNT; event++)
+	{
+		for(uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++)
+		{
+			const uint32_t *buckets = histograms->count[event][stage];
+			uint64_t total = 0;
+
+			for(uint8_t b = 0; b < LATENCY_BUCKETS; b++)
+				total += buckets[b];
+			if(!total)
+				continue;
+
+			printf("  %-22s %-24s %10" PRIu64 " %8s %8s %8" PRIu32 "\n", latency_EventName(event),
+				   latency_StageName(stage), total, replay_histogram_percentile(buckets, total, 50, p50, sizeof(p50)),
+				   replay_histogram_percentile(buckets, total, 99, p99, sizeof(p99)),
+				   latency_TicksToUs(histograms->max[event][stage]));
+		}
+	}
+}
+
+/**
+ * @brief Print the ISR event ring counters: events queued and dropped per
+ * type, the high-water mark and how long events waited for the main loop.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_ring_report(void)
+{
+	static const char *const names[EVENT_RING_TYPES] =
+	{
+		[ISR_EVENT_SENSORS_READ]	= "sensors read",
+		[ISR_EVENT_PB0]				= "pb0 edge",
+		[ISR_EVENT_PB1]				= "pb1 edge",
+		[ISR_EVENT_WAKEUP]			= "wakeup",
+		[ISR_EVENT_MCP9808_ALERT]	= "mcp9808 alert",
+		[ISR_EVENT_SENSORS_CONVERTED]	= "sensors converted",
+	};
+	const event_ring_stats_t *stats = &isr_event_ring.stats;
+
+	printf("isr event ring           %" PRIu32 " popped, high water %" PRIu16 "/%d, delay max %" PRIu64 " us, mean %.1f us\n",
+		   stats->popped, stats->high_water, EVENT_RING_SIZE, (uint64_t) HOST_TICKS_TO_US(stats->delay_max),
+		   stats->popped ? (double) HOST_TICKS_TO_US(stats->delay_total) / stats->popped : 0.0);
+	for(int type = 0; type < EVENT_RING_TYPES; type++)
+	{
+		if(stats->pushed[type] || stats->dropped[type])
+			printf("  %-22s %10" PRIu32 " queued %6" PRIu32 " dropped\n", names[type] ? names[type] : "?",
+				   stats->pushed[type], stats->dropped[type]);
+	}
+}
+
+/**
+ * @brief Print the sensor batch counters: sensors read per batch and I2C
+ * busy periods (bus power-ups) per batch, then each sensor's readings.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_sensor_report(void)
+{
+	const sensor_batch_stats_t *stats = sensor_Stats();
+
+	printf("sensor batches           %" PRIu32 " (%" PRIu32 " shared, %" PRIu32 " with conversions, "
+		   "%" PRIu32 " failed setups), %.2f sensors and %.2f i2c busy periods per batch\n",
+		   stats->batches, stats->shared, stats->conversions, stats->setup_failures,
+		   stats->batches ? (double) stats->sensors / stats->batches : 0.0,
+		   stats->batches ? (double) i2c0_queue.stats.busy_periods / stats->batches : 0.0);
+	for(const sensor_t *sensor = sensor_List(); sensor; sensor = sensor->next)
+	{
+		printf("  %-10s 0x%02x 0x%04x %8" PRIu32 " reads %6" PRIu32 " failed %6" PRIu32 " bad, last %" PRId32
+			   " at %" PRIu32 " ms\n", sensor->desc->name, sensor->desc->addr, sensor->desc->property_id,
+			   sensor->stats.reads, sensor->stats.failures, sensor->stats.decode_errors, sensor->value,
+			   sensor->time_ms);
+	}
+}
+
+/**
+ * @brief Print the sensor state machine counters: entries, events and
+ * the core cycles spent handling them, per state.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_fsm_report(void)
+{
+	printf("sensor fsm               %" PRIu32 " events ignored, now in %s\n", sensor_fsm.ignored,
+		   fsm_StateName(&sensor_fsm, fsm_State(&sensor_fsm)));
+	for(uint8_t state = 0; state < NUM_STATES; state++)
+	{
+		const fsm_state_stats_t *stats = &sensor_fsm_stats[state];
+
+		printf("  %-26s %8" PRIu32 " entries %8" PRIu32 " events %8.0f cyc/event %8" PRIu32 " max\n",
+			   fsm_StateName(&sensor_fsm, state), stats->entries, stats->events,
+			   stats->events ? (double) stats->cycles / stats->events : 0.0, stats->cycles_max);
+	}
+
+	printf("mcp9808 sample rate      %" PRIu32 " readings: %" PRIu32 " stable, %" PRIu32 " faster, %" PRIu32
+		   " near T_CRIT; period %" PRIu32 " to %" PRIu32 " ms, now %" PRIu32 " ms\n",
+		   mcp9808_sample_rate.stats.readings, mcp9808_sample_rate.stats.stable, mcp9808_sample_rate.stats.faster,
+		   mcp9808_sample_rate.stats.near, mcp9808_sample_rate.stats.period_min,
+		   mcp9808_sample_rate.stats.period_max, sampleRate_Period(&mcp9808_sample_rate));
+#ifdef MCP9808_ALERT_ENABLED
+	printf("mcp9808 alert            %" PRIu32 " edges, %" PRIu32 " still low after rearm, %" PRIu32 " rearms, "
+		   "%" PRIu32 " critical, %" PRIu32 " failed writes\n",
+		   mcp9808_alert_stats.alerts, mcp9808_alert_stats.rechecks, mcp9808_alert_stats.rearms,
+		   mcp9808_alert_stats.critical, mcp9808_alert_stats.write_failures);
+#else
+	printf("mcp9808 alert            off, polled\n");
+#endif
+}
+
+/**
+ * @brief Print the peripheral model view: wakeups, ISR cost and jitter.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_sim_report(void)
+{
+	static const IRQn_Type lines[] = { RTCC_IRQn, I2C0_IRQn, GPIO_EVEN_IRQn, GPIO_ODD_IRQn };
+	double hours = HOST_TICKS_TO_MS(host_clock_now()) / REPLAY_MS_PER_HOUR;
+	uint32_t wakeups = host_gecko_stats.soft_timer_events + host_gecko_stats.trace_events;
+
+	printf("sim events               %" PRIu64 "\n", host_sim_stats.events);
+	printf("sleeptimer               %" PRIu32 " starts, %" PRIu32 " stops, %" PRIu32 " expired\n",
+		   host_sleeptimer_stats.starts, host_sleeptimer_stats.stops, host_sleeptimer_stats.expired);
+	printf("i2c bus busy             %" PRIu64 " us\n", (uint64_t) HOST_TICKS_TO_US(host_i2c_stats.busy_ticks));
+	printf("irq %-20s %10s %12s %10s %10s\n", "", "count", "per hour", "isr ns", "isr max");
+	for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+	{
+		const host_isr_stats_t *isr = host_isr_stats(lines[i]);
+
+		wakeups += isr->count;
+		printf("  %-22s %10" PRIu32 " %12.1f %10.1f %10" PRIu64 "\n", host_irq_name(lines[i]), isr->count,
+			   hours > 0 ? isr->count / hours : 0.0,
+			   isr->count ? (double) isr->ns_total / isr->count : 0.0, isr->ns_max);
+	}
+	printf("wakeups per hour         %.1f (irq, soft timer and stack events)\n", hours > 0 ? wakeups / hours : 0.0);
+
+	if(host_i2c_stats.samples > 1)
+	{
+		double n = host_i2c_stats.samples - 1;
+		double mean = host_i2c_stats.interval_sum / n;
+		double var = host_i2c_stats.interval_sumsq / n - mean * mean;
+		double to_us = 1e6 / HOST_CLOCK_HZ;
+
+		printf("samples                  %" PRIu32 "\n", host_i2c_stats.samples);
+		printf("sample interval          mean %.1f us, min %.1f us, max %.1f us\n",
+			   mean * to_us, host_i2c_stats.interval_min * to_us, host_i2c_stats.interval_max * to_us);
+		printf("sample jitter            stddev %.1f us, peak-to-peak %.1f us\n",
+			   (var > 0 ? sqrt(var) : 0.0) * to_us,
+			   (double) (host_i2c_stats.interval_max - host_i2c_stats.interval_min) * to_us);
+	}
+}
+
+/**
+ * @brief Print the wakeup coordinator counters: wakeups taken against the
+ * activity runs, each of which would be a wakeup of its own on separate
+ * timers, and how far each activity ran off its due time.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_wakeup_report(void)
+{
+	const wakeup_stats_t *stats = wakeup_Stats();
+	double hours = HOST_TICKS_TO_MS(host_clock_now()) / REPLAY_MS_PER_HOUR;
+
+	printf("periodic wakeups         %" PRIu32 " (%.1f per hour, %" PRIu32 " empty, %" PRIu32 " arms)\n",
+		   stats->wakeups, hours > 0 ? stats->wakeups / hours : 0.0, stats->empty_wakeups, stats->arms);
+	printf("  uncoordinated          %" PRIu32 " (%.1f per hour, one wakeup per activity run)\n",
+		   stats->runs, hours > 0 ? stats->runs / hours : 0.0);
+	for(const wakeup_activity_t *activity = wakeup_Activities(); activity; activity = activity->next)
+	{
+		printf("  %-22s %10" PRIu32 " runs %8" PRIu32 " shared, early max %" PRIu64 " us, late max %" PRIu64 " us\n",
+			   activity->name, activity->stats.runs, activity->stats.shared,
+			   (uint64_t) HOST_TICKS_TO_US(activity->stats.early_max),
+			   (uint64_t) HOST_TICKS_TO_US(activity->stats.late_max));
+	}
+}
+
+/**
+ * @brief Print the firmware's energy mode profile, measured on the virtual
+ * RTCC through the same SLEEP driver callbacks as on the target.
+ *
+ * @param void
+ * @return void.
+ */
+static void replay_sleep_report(void)
+{
+	sleep_profile_t profile;
+	double total;
+
+	sleepProfile_Get(&profile);
+	total = profile.total ? (double) profile.total : 1.0;
+
+	printf("sleep calls              %" PRIu32 " (%" PRIu64 " idles, %" PRIu64 " ended by irq)\n",
+		   host_gecko_stats.sleeps, host_sim_stats.idles, host_sim_stats.idle_irq_wakeups);
+	printf("energy mode %-12s %10s %12s %8s\n", "", "entries", "ms", "share");
+	for(int em = 0; em < SLEEP_PROFILE_EM_COUNT; em++)
+	{
+		printf("  EM%-21d %10" PRIu32 " %12" PRIu64 " %7.3f%%\n", em, profile.entries[em],
+			   (uint64_t) HOST_TICKS_TO_MS(profile.residency[em]), 100.0 * profile.residency[em] / total);
+	}
+	printf("sleep blocker %-10s %10s %12s %8s\n", "", "blocks", "ms above EM3", "share");
+	for(int i = 0; i < SLEEP_BLOCKER_COUNT; i++)
+	{
+		printf("  %-22s %10" PRIu32 " %12" PRIu64 " %7.3f%%\n", sleepProfile_BlockerName((sleep_blocker_t) i),
+			   profile.block_begins[i], (uint64_t) HOST_TICKS_TO_MS(profile.blocked[i]),
+			   100.0 * profile.blocked[i] / total);
+	}
+}
+
+/**
+ * @brief Print the deterministic result of the first replay; identical
+ * traces must always produce identical reports.
+ *
+ * @param const host_trace_t *trace
+ * @return void.
+ */
+static void replay_report(const host_trace_t *trace)
+{
+	uint8_t alarms[REPLAY_ALARM_PS_MAX];
+	int alarm_len = host_gecko_ps_get(REPLAY_ALARM_PS_KEY, alarms, sizeof(alarms));
+
+	printf("trace records            %zu\n", trace->count);
+	printf("virtual time             %" PRIu64 " ms\n", (uint64_t) HOST_TICKS_TO_MS(host_clock_now()));
+	printf("events delivered         %" PRIu32 "\n", host_gecko_stats.events);
+	for(int i = 0; i < HOST_EVT_COUNT; i++)
+	{
+		if(host_gecko_stats.event[i])
+		{
+			printf("  %-36s %" PRIu32 "\n", host_gecko_evt_name((host_gecko_evt_t) i), host_gecko_stats.event[i]);
+		}
+	}
+	printf("  from trace             %" PRIu32 "\n", host_gecko_stats.trace_events);
+	printf("  soft timer             %" PRIu32 "\n", host_gecko_stats.soft_timer_events);
+	printf("  external signal        %" PRIu32 "\n", host_gecko_stats.external_signal_events);
+	printf("device records           %" PRIu32 "\n", host_gecko_stats.device_records);
+	printf("irqs raised/serviced     %" PRIu32 "/%" PRIu32 "\n",
+		   host_device_stats.irq_raised, host_device_stats.irq_serviced);
+	printf("critical sections        %" PRIu32 "\n", host_device_stats.critical_sections);
+	printf("bgapi commands           %" PRIu32 "\n", host_gecko_stats.commands);
+	for(int i = 0; i < HOST_CMD_COUNT; i++)
+	{
+		if(host_gecko_stats.command[i])
+		{
+			printf("  %-36s %" PRIu32 "\n", host_gecko_cmd_name((host_gecko_cmd_t) i), host_gecko_stats.command[i]);
+		}
+	}
+	replay_sim_report();
+	replay_wakeup_report();
+	replay_sleep_report();
+	replay_ring_report();
+	replay_fsm_report();
+	replay_sensor_report();
+	replay_histogram_report();
+	printf("ps bytes written         %" PRIu32 "\n", host_gecko_stats.ps_bytes_written);
+	printf("i2c transfers            %" PRIu32 " (%" PRIu32 " done, %" PRIu32 " nack)\n",
+		   host_i2c_stats.transfers, host_i2c_stats.completed, host_i2c_stats.nacks);
+	printf("i2c queue                %" PRIu32 " submitted, %" PRIu32 " rejected, %" PRIu32 " chained, high water %" PRIu32 "\n",
+		   i2c0_queue.stats.submitted, i2c0_queue.stats.rejected, i2c0_queue.stats.chained, i2c0_queue.stats.high_water);
+	for(uint32_t i = 0; i < I2C_QUEUE_DEVICES_MAX && i2c0_queue.stats.device[i].addr; i++)
+	{
+		const i2c_device_stats_t *device = &i2c0_queue.stats.device[i];
+
+		printf("  i2c 0x%02x                 %" PRIu32 " (%" PRIu32 " nack, %" PRIu32 " bus error), latency mean %.0f us, max %" PRIu64 " us\n",
+			   device->addr, device->transfers, device->nacks, device->bus_errors,
+			   device->transfers ? (double) HOST_TICKS_TO_US(device->latency_total) / device->transfers : 0.0,
+			   (uint64_t) HOST_TICKS_TO_US(device->latency_max));
+	}
+	printf("display spi transfers    %" PRIu32 "\n", host_display_stats.spi_transfers);
+	printf("display spi bytes        %" PRIu64 " (%" PRIu64 " in %" PRIu32 " LDMA frames)\n", host_display_stats.spi_bytes,
+		   host_display_stats.dma_bytes, host_display_stats.dma_transfers);
+	printf("display busy-wait        %" PRIu64 " us, %" PRIu64 " us with the CPU on the SPI\n",
+		   host_display_stats.delay_us,
+		   (host_display_stats.spi_bytes - host_display_stats.dma_bytes) * REPLAY_LCD_SPI_US_PER_BYTE);
+	printf("display writes           %" PRIu32 " in %" PRIu32 " frames (%" PRIu32 " unchanged), %" PRIu32 " rows drawn"
+		   " (%" PRIu32 " blitted), %" PRIu32 " skipped\n",
+		   displayStats()->writes, displayStats()->frames, displayStats()->frames_unchanged,
+		   displayStats()->rows_drawn, displayStats()->rows_blitted, displayStats()->rows_skipped);
+	printf("display frames sent      %" PRIu32 " (%" PRIu32 " flushes deferred behind one)\n",
+		   displayStats()->frames_sent, displayStats()->flushes_deferred);
+	printf("display powered down     %" PRIu32 " frames skipped, %" PRIu32 " power ups\n",
+		   displayStats()->frames_skipped, displayStats()->power_ups);
+	printf("alarm store requests     %" PRIu32 " (%" PRIu32 " unchanged, %" PRIu32 " coalesced)\n",
+		   alarm_store_stats.requests, alarm_store_stats.unchanged, alarm_store_stats.coalesced);
+	printf("alarm store writes       %" PRIu32 " (%" PRIu32 " bytes, %.2f%% of requests)%s\n",
+		   alarm_store_stats.writes, alarm_store_stats.bytes,
+		   alarm_store_stats.requests ? 100.0 * alarm_store_stats.writes / alarm_store_stats.requests : 0.0,
+		   alarms_dirty ? ", write pending" : "");
+	printf("lpns registered          %" PRIu16 " (%" PRIu16 " in alarm)\n",
+		   lpn_registry.count, lpnRegistry_AlarmCount(&lpn_registry));
+	if(alarm_len > 0)
+	{
+		/* Most significant byte first, so three LPNs print as before. */
+		printf("stored alarm bitmap      0x");
+		for(int i = SL_MIN(alarm_len, REPLAY_ALARM_PS_MAX) - 1; i >= 0; i--)
+			printf("%02x", alarms[i]);
+		printf(" (%d bytes)\n", alarm_len);
+	}
+	else
+		printf("stored alarm bitmap      (none)\n");
+	replay_journal_report();
+	replay_history_report();
+	replay_series_report();
+}
+
+int main(int argc, char **argv)
+{
+	host_trace_t trace;
+	unsigned long iterations = 1;
+	uint64_t best_ns = UINT64_MAX;
+	uint64_t total_ns = 0;
+	host_i2c_config_t i2c_config = { 0, 0, 1 };
+	int opt;
+
+	while((opt = getopt(argc, argv, "L:N:S:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'L': i2c_config.latency_us = (uint32_t) strtoul(optarg, NULL, 0); break;
+			case 'N': i2c_config.nack_permille = (uint16_t) strtoul(optarg, NULL, 0); break;
+			case 'S': i2c_config.seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			default:
+				optind = argc;
+				break;
+		}
+	}
+	if(opt != -1 || optind >= argc)
+	{
+		fprintf(stderr, "usage: %s [-L i2c_latency_us] [-N i2c_nack_permille] [-S seed] <trace> [iterations]\n", argv[0]);
+		return 2;
+	}
+	if(optind + 1 < argc)
+	{
+		iterations = strtoul(argv[optind + 1], NULL, 0);
+		if(iterations == 0)
+			iterations = 1;
+	}
+
+	host_i2c_configure(&i2c_config);
+#ifdef SENSOR_EXTRAS_ENABLED
+	for(size_t i = 0; i < sizeof(replay_extra_devices) / sizeof(replay_extra_devices[0]); i++)
+		host_i2c_attach(&replay_extra_devices[i]);
+#endif
+
+	if(!host_trace_load(argv[optind], &trace))
+	{
+		return 1;
+	}
+
+	host_gecko_set_latency_hook(replay_latency_hook);
+
+	for(unsigned long i = 0; i < iterations; i++)
+	{
+		uint64_t start, elapsed;
+
+		replay_reset();
+		latency_Init(replay_latency_clock, LATENCY_RTCC_HZ);
+		start = replay_now_ns();
+		host_gecko_run(firmware_main, &trace);
+		elapsed = replay_now_ns() - start;
+
+		total_ns += elapsed;
+		if(elapsed < best_ns)
+			best_ns = elapsed;
+
+		/* Firmware statics (display driver, state machine) survive into
+		 * later iterations, so only the first one is reported. */
+		if(i == 0)
+			replay_report(&trace);
+	}
+
+	printf("iterations               %lu\n", iterations);
+	printf("best wall time           %.3f ms\n", best_ns / 1e6);
+	printf("mean wall time           %.3f ms\n", (total_ns / (double) iterations) / 1e6);
+	printf("best ns/record           %.1f\n", trace.count ? (double) best_ns / trace.count : 0.0);
+	printf("sim seconds per second   %.0f\n", best_ns ? (HOST_TICKS_TO_MS(host_clock_now()) / 1e3) / (best_ns / 1e9) : 0.0);
+	printf("best ns/event            %.1f\n", host_gecko_stats.events ? (double) best_ns / host_gecko_stats.events : 0.0);
+	printf("events/sec               %.0f\n", best_ns ? host_gecko_stats.events * 1e9 / best_ns : 0.0);
+	replay_latency_report();
+
+	host_trace_free(&trace);
+	return 0;
+}
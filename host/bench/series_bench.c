@@ -0,0 +1,232 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file series_bench.c
+ *
+ * @brief Sensor time-series store benchmark.
+ *
+ * Reports the RAM footprint of the store (src/main-src/time_series.c) and
+ * times inserts across all channels with random levels and reporting
+ * periods, so minute and hour buckets roll over as they do on the node.
+ * Inserts after a long gap, which clear whole rollup rings, are timed
+ * separately, as are rollup queries. One channel is checked against a
+ * brute-force rollup of every sample it was given, and the raw window of
+ * a channel sampled every second is checked to still span
+ * TIME_SERIES_RAW_MINUTES.
+ *
+ * Usage: series_bench [-n samples] [-p mean_period_s] [-s seed]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/time_series.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_CHECK_MAX			(1 << 20)	// Samples kept for the reference check
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static time_series_t series;
+
+/* Every sample given to channel 0, for the reference check. */
+static uint32_t check_time[BENCH_CHECK_MAX];
+static int16_t check_value[BENCH_CHECK_MAX];
+static size_t check_count;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Recompute one bucket from the kept samples of channel 0.
+ *
+ * @param uint32_t first, uint32_t width, time_series_rollup_t *rollup
+ * @return void.
+ */
+static void bench_reference(uint32_t first, uint32_t width, time_series_rollup_t *rollup)
+{
+	int32_t sum = 0;
+
+	rollup->count = 0;
+	rollup->min = 0;
+	rollup->max = 0;
+	for(size_t i = 0; i < check_count; i++)
+	{
+		if(check_time[i] < first || check_time[i] >= first + width)
+			continue;
+		if(!rollup->count || check_value[i] < rollup->min)
+			rollup->min = check_value[i];
+		if(!rollup->count || check_value[i] > rollup->max)
+			rollup->max = check_value[i];
+		sum += check_value[i];
+		rollup->count++;
+	}
+	rollup->mean = rollup->count ? (int16_t) (sum / (int32_t) rollup->count) : 0;
+}
+
+/**
+ * @brief Compare every minute and hour rollup of channel 0 with the
+ * brute-force result.
+ *
+ * @param uint32_t now
+ * @return unsigned long Mismatching buckets.
+ */
+static unsigned long bench_check(uint32_t now)
+{
+	static const struct { time_series_resolution_t resolution; uint32_t width; uint16_t length; } levels[] =
+	{
+		{ TIME_SERIES_MINUTE, 60, TIME_SERIES_MINUTES },
+		{ TIME_SERIES_HOUR, 3600, TIME_SERIES_HOURS },
+	};
+	unsigned long errors = 0;
+
+	for(size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++)
+	{
+		for(uint16_t age = 0; age < levels[l].length && age <= now / levels[l].width; age++)
+		{
+			time_series_rollup_t got, want;
+			uint32_t first = (now / levels[l].width - age) * levels[l].width;
+
+			timeSeries_Rollup(&series, 0, levels[l].resolution, now, age, &got);
+			bench_reference(first, levels[l].width, &want);
+
+			if(got.count != want.count || (want.count && (got.min != want.min || got.max != want.max
+				|| got.mean != want.mean)))
+				errors++;
+		}
+	}
+	return errors;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long samples = 2000000;
+	uint32_t period = 20;
+	uint32_t seed = 1;
+	uint32_t clock[TIME_SERIES_CHANNELS] = { 0 };
+	uint32_t now = 0;
+	uint64_t start, insert_ns, gap_ns, query_ns;
+	unsigned long gaps = 0, queries = 0, errors;
+	uint32_t oldest = 0;
+	uint16_t raw;
+	int16_t value;
+	bool covered;
+	volatile uint32_t sink = 0;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:p:s:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n': samples = strtoul(optarg, NULL, 0); break;
+			case 'p': period = (uint32_t) strtoul(optarg, NULL, 0); break;
+			case 's': seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n samples] [-p mean_period_s] [-s seed]\n", argv[0]);
+				return 2;
+		}
+	}
+
+	bench_seed(seed);
+	if(!period)
+		period = 1;
+
+	printf("store size               %zu bytes (%u channels)\n", sizeof(series), TIME_SERIES_CHANNELS);
+	printf("per channel              %zu bytes (%u raw, %u x 1 min, %u x 1 h)\n", sizeof(series.channel[0]),
+		   TIME_SERIES_RAW_SAMPLES, TIME_SERIES_MINUTES, TIME_SERIES_HOURS);
+	printf("raw sample / rollup      %zu / %zu bytes\n", sizeof(time_series_sample_t), sizeof(time_series_rollup_t));
+
+	/* Steady state: channels report at random multiples of the period. */
+	timeSeries_Init(&series);
+	start = bench_now_ns();
+	for(unsigned long i = 0; i < samples; i++)
+	{
+		uint16_t ch = (uint16_t) (bench_rand() % TIME_SERIES_CHANNELS);
+		int16_t value = (int16_t) (bench_rand() % 101);
+
+		clock[ch] += 1 + bench_rand() % (2 * period);
+		if(clock[ch] > now)
+			now = clock[ch];
+		timeSeries_Insert(&series, ch, clock[ch], value);
+
+		if(ch == 0 && check_count < BENCH_CHECK_MAX)
+		{
+			check_time[check_count] = clock[ch];
+			check_value[check_count++] = value;
+		}
+	}
+	insert_ns = bench_now_ns() - start;
+
+	errors = bench_check(series.channel[0].last_time);
+
+	/* Queries: a full day of hourly rollups plus the raw window per channel. */
+	start = bench_now_ns();
+	for(int r = 0; r < 100; r++)
+	{
+		for(uint16_t ch = 0; ch < TIME_SERIES_CHANNELS; ch++)
+		{
+			for(uint16_t age = 0; age < TIME_SERIES_HOURS; age++)
+			{
+				time_series_rollup_t rollup;
+
+				timeSeries_Rollup(&series, ch, TIME_SERIES_HOUR, now, age, &rollup);
+				sink += rollup.count;
+				queries++;
+			}
+			sink += timeSeries_RawCount(&series, ch, now);
+			queries++;
+		}
+	}
+	query_ns = bench_now_ns() - start;
+
+	/* Worst case: every insert follows a gap longer than both rings. */
+	start = bench_now_ns();
+	for(int r = 0; r < 1000; r++)
+	{
+		for(uint16_t ch = 0; ch < TIME_SERIES_CHANNELS; ch++)
+		{
+			clock[ch] += TIME_SERIES_HOURS * 3600 + 1;
+			timeSeries_Insert(&series, ch, clock[ch], 1);
+			gaps++;
+		}
+	}
+	gap_ns = bench_now_ns() - start;
+
+	/* Temperature near a threshold: one sample a second for 10 minutes. */
+	timeSeries_Init(&series);
+	for(uint32_t t = 1; t <= 600; t++)
+		timeSeries_Insert(&series, 0, t, (int16_t) t);
+	raw = timeSeries_RawCount(&series, 0, 600);
+	covered = raw && timeSeries_Raw(&series, 0, raw - 1, &oldest, &value)
+			  && oldest < 600 - TIME_SERIES_RAW_MINUTES * 60 + TIME_SERIES_RAW_STEP;
+
+	printf("inserts                  %lu (mean period %" PRIu32 " s, %.1f h simulated)\n", samples, period,
+		   now / 3600.0);
+	printf("insert ns                %.1f\n", (double) insert_ns / (double) samples);
+	printf("insert after gap ns      %.1f\n", (double) gap_ns / (double) gaps);
+	printf("query ns                 %.1f\n", (double) query_ns / (double) queries);
+	printf("reference check          %lu samples, %lu mismatching buckets\n", (unsigned long) check_count, errors);
+	printf("raw window at 1 Hz       %u samples back to %" PRIu32 " s ago (%s)\n", raw, 600 - oldest,
+		   covered ? "covers the window" : "SHORT");
+
+	(void) sink;
+	return (errors || !covered) ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file temp_bench.c
+ *
+ * @brief MCP9808 temperature conversion and formatting benchmark.
+ *
+ * Runs every Ta register value (13 bit reading, flag bits set and clear)
+ * through the integer conversion of the firmware (mcp9808_TaToMilliC())
+ * and through the float conversion it replaces, as it stood in the I2C
+ * completion, then formats the readings for the LCD with the integer
+ * formatter (mcp9808_FormatMilliC()) and with sprintf("%f") as before.
+ * Reports host cycles (TSC) and nanoseconds per call and checks that:
+ * - the integer conversion matches the float one at and above 0 C, where
+ *   the float one was right, and is exact everywhere;
+ * - the formatter prints what printf prints with "%.3f".
+ *
+ * The host FPU makes the float paths cheap here; on the Cortex-M4 the
+ * float conversion also costs the lazy FPU context stacking of the I2C
+ * interrupt, and "%f" pulls in the float printf.
+ *
+ * Usage: temp_bench [-r rounds]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/mcp9808.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_CODES				0x2000		// 13 bit readings
+#define BENCH_FLAGS				0xE000		// T_CRIT, T_UPPER and T_LOWER flags
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Results go here so the loops are not optimised away. */
+static volatile int32_t bench_sink;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* The float conversion of the I2C completion, as it was. */
+static int32_t bench_float_convert(uint16_t raw, volatile float *reading)
+{
+	uint8_t LSB = (uint8_t) raw;
+	uint8_t MSB = (uint8_t) (raw >> 8);
+
+	MSB &= 0x1F;
+	if((MSB & 0x10) == 0x10)
+	{
+		MSB &= 0x0F;
+		*reading = 256 - (((float) MSB * 16) + ((float) LSB / 16));
+	}
+	else
+	{
+		*reading = (((float) MSB * 16) + ((float) LSB / 16));
+	}
+	return *reading * 1000;
+}
+
+int main(int argc, char **argv)
+{
+	static char text[30];
+	volatile float reading;
+	unsigned long rounds = 200, calls, errors = 0, mismatched = 0, negative_wrong = 0;
+	bench_time_t time;
+	int opt;
+
+	while((opt = getopt(argc, argv, "r:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'r': rounds = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-r rounds]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(rounds == 0)
+		rounds = 1;
+
+	/* Check every register value once. */
+	for(uint32_t code = 0; code < BENCH_CODES; code++)
+	{
+		for(uint32_t flags = 0; flags <= BENCH_FLAGS; flags += 0x2000)
+		{
+			uint16_t raw = (uint16_t) (code | flags);
+			int32_t milli = mcp9808_TaToMilliC(raw);
+			int32_t sixteenths = (code & 0x1000) ? (int32_t) code - 0x2000 : (int32_t) code;
+			char expect[MCP9808_TEXT_MAX + 8];
+
+			/* Exact to the half milli-degree, rounded towards zero. */
+			if(abs(sixteenths * 125 - milli * 2) > 1 || abs(milli * 2) > abs(sixteenths * 125))
+				errors++;
+
+			if(bench_float_convert(raw, &reading) != milli)
+			{
+				if(sixteenths >= 0)
+					mismatched++;
+				else
+					negative_wrong++;
+			}
+
+			mcp9808_FormatMilliC(text, milli);
+			snprintf(expect, sizeof(expect), "%s%" PRId32 ".%03" PRId32, milli < 0 ? "-" : "",
+					 (milli < 0 ? -milli : milli) / 1000, (milli < 0 ? -milli : milli) % 1000);
+			if(strcmp(text, expect) != 0)
+				errors++;
+			snprintf(expect, sizeof(expect), "%.3f", milli / 1000.0);
+			if(strcmp(text, expect) != 0)
+				errors++;
+		}
+	}
+
+	calls = rounds * BENCH_CODES;
+	printf("MCP9808 Ta conversion and LCD text, %lu calls each\n", calls);
+	printf("  %-30s %9s %9s\n", "path", "ns/call", "cyc/call");
+
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint32_t code = 0; code < BENCH_CODES; code++)
+			bench_sink = bench_float_convert((uint16_t) code, &reading);
+	bench_stop(&time);
+	bench_print("convert, float (before)", &time, calls);
+
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint32_t code = 0; code < BENCH_CODES; code++)
+			bench_sink = mcp9808_TaToMilliC((uint16_t) code);
+	bench_stop(&time);
+	bench_print("convert, integer", &time, calls);
+
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint32_t code = 0; code < BENCH_CODES; code++)
+		{
+			bench_float_convert((uint16_t) code, &reading);
+			bench_sink = sprintf(text, "%s %f", "Temp(C): ", reading);
+		}
+	bench_stop(&time);
+	bench_print("text, sprintf %f (before)", &time, calls);
+
+	strcpy(text, "Temp(C): ");
+	bench_start(&time);
+	for(unsigned long r = 0; r < rounds; r++)
+		for(uint32_t code = 0; code < BENCH_CODES; code++)
+			bench_sink = mcp9808_FormatMilliC(&text[sizeof("Temp(C): ") - 1],
+											  mcp9808_TaToMilliC((uint16_t) code));
+	bench_stop(&time);
+	bench_print("text, integer formatter", &time, calls);
+
+	printf("register values          %d, %lu conversion or text errors\n", BENCH_CODES * 8, errors);
+	printf("float conversion         %lu differ at or above 0 C, %lu below 0 C (it read 256 - |Ta|)\n",
+		   mismatched, negative_wrong);
+
+	return (errors || mismatched) ? 1 : 0;
+}
@@ -0,0 +1,379 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file timer_bench.c
+ *
+ * @brief Timer wheel benchmark.
+ *
+ * Runs thousands of concurrent timers on the timer wheel
+ * (src/main-src/timer_wheel.c) against a virtual clock, in the mix the
+ * friend node is heading for: per-LPN poll timeouts that are restarted on
+ * every message from their LPN and expire only when it goes quiet,
+ * write-behind flush deadlines, and periodic sampling schedules.
+ *
+ * Start, restart and stop are timed on a full wheel and on a sorted list,
+ * the baseline a single hardware timer would otherwise need to find its
+ * next deadline. The simulation then counts the wakeups the wheel asks
+ * for against the distinct deadlines the timers had, i.e. the wakeups of
+ * one exact hardware timer per deadline, and checks that every callback
+ * ran at or after its deadline and by how much it was late.
+ *
+ * Usage: timer_bench [-n timers] [-t seconds] [-s seed]
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "src/headers/timer_wheel.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_LPN_TIMEOUT		TIMER_WHEEL_MS(10000)	// Poll timeout after the last message
+#define BENCH_LPN_JITTER		TIMER_WHEEL_MS(2000)
+#define BENCH_LPN_MSG_MEAN		TIMER_WHEEL_MS(8000)	// Mean time between messages of one LPN
+#define BENCH_FLUSH_DELAY		TIMER_WHEEL_MS(5000)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	BENCH_KIND_LPN,
+	BENCH_KIND_FLUSH,
+	BENCH_KIND_SAMPLE,
+	BENCH_KINDS
+} bench_kind_t;
+
+typedef struct
+{
+	timer_wheel_timer_t timer;				// First, the callback gets it back
+	uint8_t kind;
+	uint32_t deadline;						// Exact deadline, wheel ticks
+	uint32_t delay;							// Delay or period it was started with
+} bench_timer_t;
+
+/* Baseline: timers kept in deadline order. */
+typedef struct bench_node
+{
+	struct bench_node *next;
+	struct bench_node *prev;
+	uint32_t expires;
+	bool linked;
+} bench_node_t;
+
+static const char *const bench_kind_names[BENCH_KINDS] =
+{
+	[BENCH_KIND_LPN]		= "lpn timeout",
+	[BENCH_KIND_FLUSH]		= "flush deadline",
+	[BENCH_KIND_SAMPLE]		= "sampling",
+};
+
+static timer_wheel_t wheel;
+static bench_timer_t *timers;
+static bench_node_t *nodes;
+static bench_node_t list_head;
+
+static uint32_t bench_clk;
+static uint32_t bench_armed;
+static bool bench_is_armed;
+
+/* Deadline ticks of the callbacks run, one bit per tick of the simulation. */
+static uint8_t *deadline_map;
+static uint32_t sim_start;
+static uint32_t sim_ticks;
+
+static unsigned long fired[BENCH_KINDS];
+static unsigned long early;
+static uint32_t late_max[BENCH_KINDS];
+static double late_ratio_max[BENCH_KINDS];
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t bench_clock(void)
+{
+	return bench_clk;
+}
+
+static void bench_arm(uint32_t ticks)
+{
+	bench_is_armed = (ticks != 0);
+	bench_armed = bench_clk + ticks;
+}
+
+/**
+ * @brief Timer callback: check the deadline, record it and start the next
+ * round of the timer.
+ *
+ * @param timer_wheel_timer_t *timer
+ * @return void.
+ */
+static void bench_expired(timer_wheel_timer_t *timer)
+{
+	bench_timer_t *t = (bench_timer_t *) timer;
+	uint32_t late = bench_clk - t->deadline;
+	uint32_t offset = t->deadline - sim_start;
+
+	if((int32_t) late < 0)
+	{
+		early++;
+		late = 0;
+	}
+
+	fired[t->kind]++;
+	if(late > late_max[t->kind])
+		late_max[t->kind] = late;
+	if((double) late / (double) t->delay > late_ratio_max[t->kind])
+		late_ratio_max[t->kind] = (double) late / (double) t->delay;
+	if(offset < sim_ticks)
+		deadline_map[offset >> 3] |= (uint8_t) (1 << (offset & 7));
+
+	/* Periodic timers were queued again by the wheel. */
+	if(t->kind == BENCH_KIND_SAMPLE)
+		t->deadline += t->delay;
+}
+
+static void bench_timer_start(bench_timer_t *t, uint32_t delay, uint32_t period)
+{
+	t->deadline = bench_clk + delay;
+	t->delay = delay;
+	timerWheel_Start(&wheel, &t->timer, delay, period);
+}
+
+/**
+ * @brief Baseline insert: walk the list to the first later deadline.
+ *
+ * @param bench_node_t *node, uint32_t expires
+ * @return void.
+ */
+static void bench_list_insert(bench_node_t *node, uint32_t expires)
+{
+	bench_node_t *at = list_head.next;
+
+	while(at != &list_head && (int32_t) (at->expires - expires) <= 0)
+		at = at->next;
+
+	node->expires = expires;
+	node->next = at;
+	node->prev = at->prev;
+	at->prev->next = node;
+	at->prev = node;
+	node->linked = true;
+}
+
+static void bench_list_remove(bench_node_t *node)
+{
+	if(!node->linked)
+		return;
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->linked = false;
+}
+
+/**
+ * @brief Time start, restart and stop of every timer on the wheel and on
+ * the sorted list, with the random delays of the simulation.
+ *
+ * @param uint32_t count
+ * @return void.
+ */
+static void bench_ops(uint32_t count)
+{
+	uint32_t *delays = malloc(count * sizeof(*delays));
+	uint64_t start;
+	double ns[2][3];
+
+	for(uint32_t i = 0; i < count; i++)
+		delays[i] = 1 + bench_rand() % TIMER_WHEEL_MS(60000);
+
+	for(int list = 0; list < 2; list++)
+	{
+		timerWheel_Init(&wheel, bench_clock, bench_arm);
+		list_head.next = list_head.prev = &list_head;
+
+		for(int op = 0; op < 3; op++)
+		{
+			start = bench_now_ns();
+			for(uint32_t i = 0; i < count; i++)
+			{
+				/* Restarts take the delays in reverse, so they move every timer. */
+				uint32_t delay = (op == 1) ? delays[count - 1 - i] : delays[i];
+
+				if(op == 2)
+				{
+					if(list)
+						bench_list_remove(&nodes[i]);
+					else
+						timerWheel_Stop(&wheel, &timers[i].timer);
+				}
+				else if(list)
+				{
+					bench_list_remove(&nodes[i]);
+					bench_list_insert(&nodes[i], bench_clk + delay);
+				}
+				else
+					timerWheel_Start(&wheel, &timers[i].timer, delay, 0);
+			}
+			ns[list][op] = (double) (bench_now_ns() - start) / (double) count;
+		}
+	}
+
+	printf("%-22s %12s %12s %12s\n", "ns per timer", "start", "restart", "stop");
+	printf("%-22s %12.1f %12.1f %12.1f\n", "timer wheel", ns[0][0], ns[0][1], ns[0][2]);
+	printf("%-22s %12.1f %12.1f %12.1f\n", "sorted list", ns[1][0], ns[1][1], ns[1][2]);
+	free(delays);
+}
+
+int main(int argc, char **argv)
+{
+	static const uint32_t periods[] = { TIMER_WHEEL_MS(1000), TIMER_WHEEL_MS(10000), TIMER_WHEEL_MS(60000) };
+	uint32_t count = 3000;
+	uint32_t seconds = 3600;
+	uint32_t seed = 1;
+	uint32_t lpns;
+	uint32_t flushes;
+	uint64_t msg_acc = 0;
+	uint64_t run_ns = 0;
+	unsigned long messages = 0;
+	unsigned long exact = 0;
+	unsigned long total = 0;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:t:s:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n': count = (uint32_t) strtoul(optarg, NULL, 0); break;
+			case 't': seconds = (uint32_t) strtoul(optarg, NULL, 0); break;
+			case 's': seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n timers] [-t seconds] [-s seed]\n", argv[0]);
+				return 2;
+		}
+	}
+
+	bench_seed(seed);
+	if(count < BENCH_KINDS)
+		count = BENCH_KINDS;
+
+	timers = calloc(count, sizeof(*timers));
+	nodes = calloc(count, sizeof(*nodes));
+	sim_ticks = seconds * TIMER_WHEEL_HZ;
+	deadline_map = calloc((sim_ticks + 7) / 8, 1);
+	if(!timers || !nodes || !deadline_map)
+		return 1;
+
+	/* Half LPN timeouts, a sixth flush deadlines, the rest sampling schedules. */
+	lpns = count / 2;
+	flushes = count / 6;
+	for(uint32_t i = 0; i < count; i++)
+	{
+		timerWheel_Setup(&timers[i].timer, bench_expired, NULL);
+		timers[i].kind = (i < lpns) ? BENCH_KIND_LPN : (i < lpns + flushes) ? BENCH_KIND_FLUSH : BENCH_KIND_SAMPLE;
+	}
+
+	printf("wheel size               %zu bytes, %zu per timer\n", sizeof(wheel), sizeof(timer_wheel_timer_t));
+	printf("timers                   %" PRIu32 " (%" PRIu32 " lpn timeouts, %" PRIu32 " flush deadlines, %" PRIu32
+		   " sampling)\n", count, lpns, flushes, count - lpns - flushes);
+
+	bench_ops(count);
+
+	/* Simulation: every timer but the flush deadlines starts running. */
+	for(uint32_t i = 0; i < count; i++)
+		timerWheel_Setup(&timers[i].timer, bench_expired, NULL);
+	bench_clk = bench_rand();
+	timerWheel_Init(&wheel, bench_clock, bench_arm);
+	bench_is_armed = false;
+	sim_start = bench_clk;
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		if(timers[i].kind == BENCH_KIND_LPN)
+			bench_timer_start(&timers[i], BENCH_LPN_TIMEOUT + bench_rand() % BENCH_LPN_JITTER, 0);
+		else if(timers[i].kind == BENCH_KIND_SAMPLE)
+		{
+			uint32_t period = periods[bench_rand() % 3];
+			uint32_t phase = 1 + bench_rand() % period;
+
+			bench_timer_start(&timers[i], phase, period);
+			timers[i].delay = period;
+		}
+	}
+
+	for(uint32_t tick = 0; tick < sim_ticks; tick++)
+	{
+		bench_clk++;
+
+		/* LPN messages restart the poll timeout; one in four changes an alarm and arms a flush. */
+		msg_acc += lpns;
+		while(msg_acc >= BENCH_LPN_MSG_MEAN)
+		{
+			bench_timer_t *lpn = &timers[bench_rand() % lpns];
+
+			msg_acc -= BENCH_LPN_MSG_MEAN;
+			messages++;
+			bench_timer_start(lpn, BENCH_LPN_TIMEOUT + bench_rand() % BENCH_LPN_JITTER, 0);
+
+			if(flushes && (bench_rand() & 3) == 0)
+			{
+				bench_timer_t *flush = &timers[lpns + bench_rand() % flushes];
+
+				if(!timerWheel_Pending(&flush->timer))
+					bench_timer_start(flush, BENCH_FLUSH_DELAY, 0);
+			}
+		}
+
+		if(bench_is_armed && bench_clk == bench_armed)
+		{
+			uint64_t start = bench_now_ns();
+
+			timerWheel_Run(&wheel);
+			run_ns += bench_now_ns() - start;
+		}
+	}
+
+	for(uint32_t i = 0; i < (sim_ticks + 7) / 8; i++)
+		exact += (unsigned long) __builtin_popcount(deadline_map[i]);
+	for(int kind = 0; kind < BENCH_KINDS; kind++)
+		total += fired[kind];
+
+	printf("simulated                %" PRIu32 " s, %lu lpn messages, %" PRIu32 " timers running at most\n",
+		   seconds, messages, wheel.stats.count_max);
+	printf("timers fired             %lu (%lu early)\n", total, early);
+	for(int kind = 0; kind < BENCH_KINDS; kind++)
+		printf("  %-22s %10lu fired, late max %6.1f ms (%4.1f%% of the delay)\n", bench_kind_names[kind], fired[kind],
+			   (double) late_max[kind] * 1000.0 / TIMER_WHEEL_HZ, late_ratio_max[kind] * 100.0);
+	printf("wakeups                  %" PRIu32 " (%" PRIu32 " empty), %lu distinct deadlines, %.1fx fewer\n",
+		   wheel.stats.wakeups, wheel.stats.empty_wakeups, exact,
+		   wheel.stats.wakeups ? (double) exact / (double) wheel.stats.wakeups : 0.0);
+	printf("wakeups per hour         %.1f wheel, %.1f exact\n", (double) wheel.stats.wakeups * 3600.0 / seconds,
+		   (double) exact * 3600.0 / seconds);
+	printf("slots expired            %" PRIu32 ", %" PRIu32 " timers moved on from the top level\n",
+		   wheel.stats.slots, wheel.stats.requeued);
+	printf("hardware timer arms      %" PRIu32 "\n", wheel.stats.arms);
+	printf("run ns                   %.1f per wakeup, %.1f per timer fired\n",
+		   wheel.stats.wakeups ? (double) run_ns / (double) wheel.stats.wakeups : 0.0,
+		   total ? (double) run_ns / (double) total : 0.0);
+
+	free(timers);
+	free(nodes);
+	free(deadline_map);
+	return early ? 1 : 0;
+}
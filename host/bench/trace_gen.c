@@ -0,0 +1,222 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file trace_gen.c
+ *
+ * @brief Synthetic event trace generator for the replay benchmark.
+ *
+ * Produces a deterministic friend node workload: boot and provisioning,
+ * a slowly drifting ambient temperature, generic level reports and alarms
+ * from the LPNs, occasional proxy connections and push button presses.
+ * The MCP9808 measurement cycle itself is not traced; the sleeptimer and
+ * I2C0 models generate it in virtual time.
+ *
+ * Usage: trace_gen [-n records] [-s seed] [-l lpns] [-r report_ms]
+ *
+ *   -n  number of records to emit (default 100000)
+ *   -s  PRNG seed (default 1)
+ *   -l  number of LPNs, addressed from 0x0002 upwards (default 3, may be 0)
+ *   -r  mean LPN report interval in ms (default 2000)
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_trace.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* How often the ambient temperature changes. */
+#define GEN_TEMP_PERIOD_MS		10000
+
+/* Generic level values with special meaning to the friend (app.h). */
+#define GEN_ALARM_SET			((int16_t) 0xFFFF)
+#define GEN_ALARM_CLEARED		((int16_t) 0x7FFF)
+
+#define GEN_FIRST_LPN_ADDR		0x0002
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t gen_state;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* xorshift32; the same seed must always give the same trace. */
+static uint32_t gen_rand(void)
+{
+	gen_state ^= gen_state << 13;
+	gen_state ^= gen_state >> 17;
+	gen_state ^= gen_state << 5;
+	return gen_state;
+}
+
+static uint32_t gen_range(uint32_t lo, uint32_t hi)
+{
+	return lo + (gen_rand() % (hi - lo + 1));
+}
+
+static unsigned long gen_emitted;
+
+static void gen_emit(uint32_t time_ms, host_trace_kind_t kind, int32_t arg0, int32_t arg1)
+{
+	host_trace_record_t record = { time_ms, kind, arg0, arg1 };
+
+	host_trace_write(stdout, &record);
+	gen_emitted++;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long records = 100000;
+	unsigned long lpns = 3;
+	unsigned long report_ms = 2000;
+	uint32_t seed = 1;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:s:l:r:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'n': records = strtoul(optarg, NULL, 0); break;
+			case 's': seed = (uint32_t) strtoul(optarg, NULL, 0); break;
+			case 'l': lpns = strtoul(optarg, NULL, 0); break;
+			case 'r': report_ms = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n records] [-s seed] [-l lpns] [-r report_ms]\n", argv[0]);
+				return 2;
+		}
+	}
+	if(report_ms == 0)
+	{
+		fprintf(stderr, "report interval must be non-zero\n");
+		return 2;
+	}
+
+	gen_state = seed ? seed : 1;
+
+	uint32_t *next_report = calloc(lpns + 1, sizeof(*next_report));
+	uint8_t *alarmed = calloc(lpns + 1, sizeof(*alarmed));
+	if(!next_report || !alarmed)
+	{
+		return 1;
+	}
+
+	printf("# trace_gen -n %lu -s %lu -l %lu -r %lu\n", records, (unsigned long) seed, lpns, report_ms);
+
+	gen_emit(0, HOST_TRACE_BOOT, 0, 0);
+	gen_emit(20, HOST_TRACE_NODE_INIT, 1, 1);
+
+	/* Reports start once every friendship is up, no earlier than 100 ms. */
+	uint32_t first_report = (lpns > 50) ? 50 + (uint32_t) lpns : 100;
+
+	for(unsigned long i = 0; i < lpns; i++)
+	{
+		next_report[i] = first_report + gen_range(0, (uint32_t) report_ms);
+		gen_emit(50 + (uint32_t) i, HOST_TRACE_FRIEND_EST, (int32_t) (GEN_FIRST_LPN_ADDR + i), 0);
+	}
+
+	uint32_t now;
+	uint32_t next_temp = GEN_TEMP_PERIOD_MS;
+	uint32_t next_button = 30000 + gen_range(0, 30000);
+	uint32_t next_conn = 60000 + gen_range(0, 60000);
+	int32_t button = -1;
+	int32_t temp_mC = 22500;
+	bool connected = false;
+
+	while(gen_emitted < records)
+	{
+		/* Pick the earliest pending source; ties go to the LPNs first. */
+		uint32_t next = next_temp;
+		unsigned long lpn = lpns;
+
+		for(unsigned long i = 0; i < lpns; i++)
+		{
+			if(next_report[i] <= next && (lpn == lpns || next_report[i] < next_report[lpn]))
+			{
+				next = next_report[i];
+				lpn = i;
+			}
+		}
+		if(next_button < next)
+			next = next_button;
+		if(next_conn < next)
+			next = next_conn;
+
+		now = next;
+
+		if(lpn < lpns && next_report[lpn] == now)
+		{
+			int32_t level;
+			uint32_t roll = gen_range(0, 99);
+
+			if(!alarmed[lpn] && roll < 3)
+			{
+				level = GEN_ALARM_SET;
+				alarmed[lpn] = 1;
+			}
+			else if(alarmed[lpn] && roll < 20)
+			{
+				level = GEN_ALARM_CLEARED;
+				alarmed[lpn] = 0;
+			}
+			else
+			{
+				level = (int32_t) gen_range(0, 100);
+			}
+
+			gen_emit(now, HOST_TRACE_LEVEL, (int32_t) (GEN_FIRST_LPN_ADDR + lpn), level);
+			next_report[lpn] = now + (uint32_t) gen_range((uint32_t) report_ms / 2, (uint32_t) report_ms * 3 / 2);
+		}
+		else if(now == next_temp)
+		{
+			temp_mC += (int32_t) gen_range(0, 250) - 125;
+			gen_emit(now, HOST_TRACE_TEMP, temp_mC, 0);
+			next_temp = now + GEN_TEMP_PERIOD_MS;
+		}
+		else if(now == next_button)
+		{
+			if(button < 0)
+			{
+				button = (int32_t) gen_range(0, 1);
+				gen_emit(now, HOST_TRACE_BUTTON, button, 1);
+				next_button = now + 150;
+			}
+			else
+			{
+				gen_emit(now, HOST_TRACE_BUTTON, button, 0);
+				button = -1;
+				next_button = now + 30000 + gen_range(0, 60000);
+			}
+		}
+		else
+		{
+			if(connected)
+				gen_emit(now, HOST_TRACE_CONN_CLOSE, 1, 0x0213);
+			else
+				gen_emit(now, HOST_TRACE_CONN_OPEN, 1, 0);
+			connected = !connected;
+			next_conn = now + (connected ? gen_range(5000, 20000) : 60000 + gen_range(0, 60000));
+		}
+	}
+
+	free(next_report);
+	free(alarmed);
+	return 0;
+}
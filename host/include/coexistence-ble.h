@@ -0,0 +1,23 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file coexistence-ble.h
+ *
+ * @brief Host stand-in; there is no radio to arbitrate on the host.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_COEXISTENCE_BLE_H_
+#define HOST_INCLUDE_COEXISTENCE_BLE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void gecko_initCoexHAL(void) { }
+
+#endif /* HOST_INCLUDE_COEXISTENCE_BLE_H_ */
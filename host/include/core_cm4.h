@@ -0,0 +1,142 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file core_cm4.h
+ *
+ * @brief Host stand-in for the CMSIS Cortex-M4 core header.
+ *
+ * The device header (efr32bg13p632f512gm48.h) pulls this file in for the
+ * register qualifiers and the NVIC helpers. On the host the qualifiers are
+ * plain volatile and the NVIC calls are routed to host_device.c so that the
+ * enable state of every IRQ can be inspected by the benchmarks. The DWT
+ * cycle counter counts host time at the core clock rate, see host_dwt().
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_CORE_CM4_H_
+#define HOST_INCLUDE_CORE_CM4_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define __CM4_REV				0x0001U
+
+#define __I						volatile const
+#define __O						volatile
+#define __IO					volatile
+#define __IM					volatile const
+#define __OM					volatile
+#define __IOM					volatile
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE			static inline
+#endif
+#ifndef __INLINE
+#define __INLINE				inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE	static inline
+#endif
+#ifndef __ASM
+#define __ASM					__asm
+#endif
+#ifndef __WEAK
+#define __WEAK					__attribute__((weak))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)			__attribute__((aligned(x)))
+#endif
+#ifndef __PACKED
+#define __PACKED				__attribute__((packed))
+#endif
+#ifndef __UNUSED
+#define __UNUSED				__attribute__((unused))
+#endif
+#ifndef __USED
+#define __USED					__attribute__((used))
+#endif
+
+/* Barrier and hint instructions have no host meaning. */
+#define __NOP()					do { } while (0)
+#define __DSB()					do { } while (0)
+#define __ISB()					do { } while (0)
+#define __DMB()					do { } while (0)
+#define __WFI()					do { } while (0)
+#define __WFE()					do { } while (0)
+#define __SEV()					do { } while (0)
+
+#define __CLZ(x)				((uint8_t)((x) ? __builtin_clz(x) : 32U))
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+	value = ((value >> 1) & 0x55555555U) | ((value & 0x55555555U) << 1);
+	value = ((value >> 2) & 0x33333333U) | ((value & 0x33333333U) << 2);
+	value = ((value >> 4) & 0x0F0F0F0FU) | ((value & 0x0F0F0F0FU) << 4);
+	return __builtin_bswap32(value);
+}
+
+/* Core clock the DWT cycle counter is scaled to (HFXO). */
+#define HOST_CORE_CLOCK_HZ		38400000ULL
+
+#define DWT_CTRL_CYCCNTENA_Msk			(1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk		(1UL << 24)
+
+#define DWT					host_dwt()
+#define CoreDebug			(&host_CoreDebug)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	__IOM uint32_t CTRL;
+	__IOM uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	__IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern CoreDebug_Type host_CoreDebug;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __disable_irq(void);
+void __enable_irq(void);
+
+DWT_Type *host_dwt(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_CORE_CM4_H_ */
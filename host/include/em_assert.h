@@ -0,0 +1,33 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_assert.h
+ *
+ * @brief Host stand-in for the emlib assert macro.
+ *
+ * As on the target, EFM_ASSERT() only checks when DEBUG_EFM is defined;
+ * build with CPPFLAGS=-DDEBUG_EFM to turn emlib/emdrv asserts into host
+ * assert() failures.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_ASSERT_H_
+#define HOST_INCLUDE_EM_ASSERT_H_
+
+#if defined(DEBUG_EFM)
+
+#include <assert.h>
+
+#define EFM_ASSERT(expr)	assert(expr)
+
+#else
+
+#define EFM_ASSERT(expr)	((void)(expr))
+
+#endif /* DEBUG_EFM */
+
+#endif /* HOST_INCLUDE_EM_ASSERT_H_ */
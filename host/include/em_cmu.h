@@ -0,0 +1,98 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_cmu.h
+ *
+ * @brief Host stand-in for the emlib CMU API.
+ *
+ * Only the clocks and selections referenced by the application drivers are
+ * enumerated. Clock enables are recorded in host_emlib.c so a benchmark can
+ * tell which peripheral clocks were left running.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_CMU_H_
+#define HOST_INCLUDE_EM_CMU_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	cmuClock_HF,
+	cmuClock_CORE,
+	cmuClock_CORELE,
+	cmuClock_GPIO,
+	cmuClock_PRS,
+	cmuClock_LDMA,
+	cmuClock_I2C0,
+	cmuClock_USART0,
+	cmuClock_USART1,
+	cmuClock_LFA,
+	cmuClock_LFB,
+	cmuClock_LFE,
+	cmuClock_LETIMER0,
+	cmuClock_RTCC,
+	cmuClock_RTC,
+	cmuClock_CRYOTIMER,
+	cmuClock_COUNT
+} CMU_Clock_TypeDef;
+
+typedef enum
+{
+	cmuSelect_Disabled,
+	cmuSelect_LFXO,
+	cmuSelect_LFRCO,
+	cmuSelect_ULFRCO,
+	cmuSelect_HFXO,
+	cmuSelect_HFRCO
+} CMU_Select_TypeDef;
+
+typedef enum
+{
+	cmuOsc_LFXO,
+	cmuOsc_LFRCO,
+	cmuOsc_ULFRCO,
+	cmuOsc_HFXO,
+	cmuOsc_HFRCO
+} CMU_Osc_TypeDef;
+
+typedef uint32_t CMU_ClkDiv_TypeDef;
+
+#define cmuClkDiv_1		1
+#define cmuClkDiv_2		2
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable);
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref);
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock);
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock);
+void CMU_ClockDivSet(CMU_Clock_TypeDef clock, CMU_ClkDiv_TypeDef div);
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait);
+bool CMU_ClockEnabled(CMU_Clock_TypeDef clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_CMU_H_ */
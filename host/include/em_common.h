@@ -0,0 +1,44 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_common.h
+ *
+ * @brief Host stand-in for the emlib common helper macros.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_COMMON_H_
+#define HOST_INCLUDE_EM_COMMON_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+#include "em_assert.h"
+
+#define SL_MIN(a, b)			((a) < (b) ? (a) : (b))
+#define SL_MAX(a, b)			((a) > (b) ? (a) : (b))
+#define SL_WEAK					__attribute__((weak))
+#define SL_ALIGN(X)				__attribute__((aligned(X)))
+#define SL_ATTRIBUTE_ALIGN(X)	__attribute__((aligned(X)))
+#define SL_PACK_START(x)
+#define SL_PACK_END()
+#define SL_ATTRIBUTE_PACKED		__attribute__((packed))
+#define EFM32_MIN				SL_MIN
+#define EFM32_MAX				SL_MAX
+#define EFM32_ALIGN(X)
+#define EFM32_PACK_START(x)
+#define EFM32_PACK_END()
+#define EFM32_ATTRIBUTE_PACKED	__attribute__((packed))
+
+__STATIC_INLINE uint32_t SL_CTZ(uint32_t value)
+{
+	return value ? (uint32_t)__builtin_ctz(value) : 32U;
+}
+
+#define EFM32_CTZ(value)		SL_CTZ(value)
+
+#endif /* HOST_INCLUDE_EM_COMMON_H_ */
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_core.h
+ *
+ * @brief Host stand-in for the emlib CORE critical section API.
+ *
+ * The host build is single threaded, so a critical section only has to mask
+ * the simulated interrupt sources. host_device.c keeps the mask and counts
+ * how often the application enters a critical section.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_CORE_H_
+#define HOST_INCLUDE_EM_CORE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+#include "em_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef uint32_t CORE_irqState_t;
+
+#define CORE_DECLARE_IRQ_STATE			CORE_irqState_t irqState
+#define CORE_ENTER_CRITICAL()			irqState = CORE_EnterCritical()
+#define CORE_EXIT_CRITICAL()			CORE_ExitCritical(irqState)
+#define CORE_ENTER_ATOMIC()				irqState = CORE_EnterCritical()
+#define CORE_EXIT_ATOMIC()				CORE_ExitCritical(irqState)
+
+#define CORE_CRITICAL_SECTION(yourcode)	\
+{										\
+	CORE_DECLARE_IRQ_STATE;				\
+	CORE_ENTER_CRITICAL();				\
+	{									\
+		yourcode						\
+	}									\
+	CORE_EXIT_CRITICAL();				\
+}
+
+#define CORE_ATOMIC_SECTION(yourcode)	CORE_CRITICAL_SECTION(yourcode)
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+CORE_irqState_t CORE_EnterCritical(void);
+void CORE_ExitCritical(CORE_irqState_t irqState);
+bool CORE_InIrqContext(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_CORE_H_ */
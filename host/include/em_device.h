@@ -0,0 +1,78 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_device.h
+ *
+ * @brief Host stand-in for the EFR32 device header selector.
+ *
+ * The real register layouts from efr32bg13p632f512gm48.h are used as-is.
+ * Only the peripheral base pointers are redirected from their memory-mapped
+ * addresses to RAM instances in host_device.c, so emlib inline accessors and
+ * the application drivers read and write ordinary memory on the host.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_DEVICE_H_
+#define HOST_INCLUDE_EM_DEVICE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EFR32BG13P632F512GM48
+#define EFR32BG13P632F512GM48
+#endif
+
+#include "efr32bg13p632f512gm48.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+extern GPIO_TypeDef		host_GPIO;
+extern CMU_TypeDef		host_CMU;
+extern EMU_TypeDef		host_EMU;
+extern MSC_TypeDef		host_MSC;
+extern LETIMER_TypeDef	host_LETIMER0;
+extern I2C_TypeDef		host_I2C0;
+extern USART_TypeDef	host_USART1;
+extern LDMA_TypeDef		host_LDMA;
+extern RTCC_TypeDef		host_RTCC;
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#undef GPIO
+#undef CMU
+#undef EMU
+#undef MSC
+#undef LETIMER0
+#undef I2C0
+#undef USART1
+#undef LDMA
+#undef RTCC
+
+#define GPIO		(&host_GPIO)
+#define CMU			(&host_CMU)
+#define EMU			(&host_EMU)
+#define MSC			(&host_MSC)
+#define LETIMER0	(&host_LETIMER0)
+#define I2C0		(&host_I2C0)
+#define USART1		(&host_USART1)
+#define LDMA		(&host_LDMA)
+#define RTCC		(&host_RTCC)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_DEVICE_H_ */
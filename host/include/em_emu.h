@@ -0,0 +1,48 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_emu.h
+ *
+ * @brief Host stand-in for the emlib EMU energy mode API.
+ *
+ * Entering EM1 to EM3 records the request and idles the simulator until
+ * the next model interrupt or the armed wake-up deadline (host_sim.h).
+ * EM4 only records the request.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_EMU_H_
+#define HOST_INCLUDE_EM_EMU_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void EMU_EnterEM1(void);
+void EMU_EnterEM2(bool restore);
+void EMU_EnterEM3(bool restore);
+void EMU_EnterEM4(void);
+void EMU_Save(void);
+void EMU_Restore(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_EMU_H_ */
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_gpio.h
+ *
+ * @brief Host stand-in for the emlib GPIO API.
+ *
+ * The enumerations mirror platform/emlib/inc/em_gpio.h for series 1 parts.
+ * Pin accessors operate on the RAM GPIO instance so that pin state (LCD
+ * enable, EXTCOMIN, push buttons) can be driven and observed by the host
+ * harness.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_GPIO_H_
+#define HOST_INCLUDE_EM_GPIO_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	gpioPortA = 0,
+	gpioPortB = 1,
+	gpioPortC = 2,
+	gpioPortD = 3,
+	gpioPortF = 5
+} GPIO_Port_TypeDef;
+
+typedef enum
+{
+	gpioDriveStrengthWeakAlternateWeak     = GPIO_P_CTRL_DRIVESTRENGTH_WEAK | GPIO_P_CTRL_DRIVESTRENGTHALT_WEAK,
+	gpioDriveStrengthWeakAlternateStrong   = GPIO_P_CTRL_DRIVESTRENGTH_WEAK | GPIO_P_CTRL_DRIVESTRENGTHALT_STRONG,
+	gpioDriveStrengthStrongAlternateWeak   = GPIO_P_CTRL_DRIVESTRENGTH_STRONG | GPIO_P_CTRL_DRIVESTRENGTHALT_WEAK,
+	gpioDriveStrengthStrongAlternateStrong = GPIO_P_CTRL_DRIVESTRENGTH_STRONG | GPIO_P_CTRL_DRIVESTRENGTHALT_STRONG
+} GPIO_DriveStrength_TypeDef;
+
+#define gpioDriveStrengthStrong		gpioDriveStrengthStrongAlternateStrong
+#define gpioDriveStrengthWeak		gpioDriveStrengthWeakAlternateWeak
+
+typedef enum
+{
+	gpioModeDisabled                  = _GPIO_P_MODEL_MODE0_DISABLED,
+	gpioModeInput                     = _GPIO_P_MODEL_MODE0_INPUT,
+	gpioModeInputPull                 = _GPIO_P_MODEL_MODE0_INPUTPULL,
+	gpioModeInputPullFilter           = _GPIO_P_MODEL_MODE0_INPUTPULLFILTER,
+	gpioModePushPull                  = _GPIO_P_MODEL_MODE0_PUSHPULL,
+	gpioModePushPullAlternate         = _GPIO_P_MODEL_MODE0_PUSHPULLALT,
+	gpioModeWiredOr                   = _GPIO_P_MODEL_MODE0_WIREDOR,
+	gpioModeWiredOrPullDown           = _GPIO_P_MODEL_MODE0_WIREDORPULLDOWN,
+	gpioModeWiredAnd                  = _GPIO_P_MODEL_MODE0_WIREDAND,
+	gpioModeWiredAndFilter            = _GPIO_P_MODEL_MODE0_WIREDANDFILTER,
+	gpioModeWiredAndPullUp            = _GPIO_P_MODEL_MODE0_WIREDANDPULLUP,
+	gpioModeWiredAndPullUpFilter      = _GPIO_P_MODEL_MODE0_WIREDANDPULLUPFILTER
+} GPIO_Mode_TypeDef;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out);
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port, GPIO_DriveStrength_TypeDef strength);
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo,
+                       bool risingEdge, bool fallingEdge, bool enable);
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+__STATIC_INLINE unsigned int GPIO_PinInGet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+	return (GPIO->P[port].DIN >> pin) & 0x1;
+}
+
+__STATIC_INLINE unsigned int GPIO_PinOutGet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+	return (GPIO->P[port].DOUT >> pin) & 0x1;
+}
+
+__STATIC_INLINE void GPIO_PinOutSet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO->P[port].DOUT |= (1UL << pin);
+}
+
+__STATIC_INLINE void GPIO_PinOutClear(GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO->P[port].DOUT &= ~(1UL << pin);
+}
+
+__STATIC_INLINE void GPIO_PinOutToggle(GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO->P[port].DOUT ^= (1UL << pin);
+}
+
+__STATIC_INLINE uint32_t GPIO_IntGet(void)
+{
+	return GPIO->IF;
+}
+
+__STATIC_INLINE uint32_t GPIO_IntGetEnabled(void)
+{
+	return GPIO->IF & GPIO->IEN;
+}
+
+__STATIC_INLINE void GPIO_IntClear(uint32_t flags)
+{
+	*(volatile uint32_t *)&GPIO->IF &= ~flags;
+}
+
+__STATIC_INLINE void GPIO_IntEnable(uint32_t flags)
+{
+	GPIO->IEN |= flags;
+}
+
+__STATIC_INLINE void GPIO_IntDisable(uint32_t flags)
+{
+	GPIO->IEN &= ~flags;
+}
+
+__STATIC_INLINE void GPIO_IntSet(uint32_t flags)
+{
+	*(volatile uint32_t *)&GPIO->IF |= flags;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_GPIO_H_ */
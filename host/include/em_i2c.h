@@ -0,0 +1,90 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_i2c.h
+ *
+ * @brief Host stand-in for the emlib I2C transfer API.
+ *
+ * Types and return codes mirror platform/emlib/inc/em_i2c.h. The transfer
+ * functions are implemented by the host I2C bus model in host_i2c.c, which
+ * plays the role of the slave devices on I2C0.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_I2C_H_
+#define HOST_INCLUDE_EM_I2C_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define I2C_FREQ_STANDARD_MAX	92000
+#define I2C_FREQ_FAST_MAX		392000
+
+#define I2C_FLAG_WRITE			0x0001
+#define I2C_FLAG_READ			0x0002
+#define I2C_FLAG_WRITE_READ		0x0004
+#define I2C_FLAG_WRITE_WRITE	0x0008
+#define I2C_FLAG_10BIT_ADDR		0x0010
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	i2cClockHLRStandard  = _I2C_CTRL_CLHR_STANDARD,
+	i2cClockHLRAsymetric = _I2C_CTRL_CLHR_ASYMMETRIC,
+	i2cClockHLRFast      = _I2C_CTRL_CLHR_FAST
+} I2C_ClockHLR_TypeDef;
+
+typedef enum
+{
+	i2cTransferInProgress = 1,
+	i2cTransferDone       = 0,
+	i2cTransferNack       = -1,
+	i2cTransferBusErr     = -2,
+	i2cTransferArbLost    = -3,
+	i2cTransferUsageFault = -4,
+	i2cTransferSwFault    = -5
+} I2C_TransferReturn_TypeDef;
+
+typedef struct
+{
+	uint16_t addr;
+	uint16_t flags;
+	struct
+	{
+		uint8_t  *data;
+		uint16_t len;
+	} buf[2];
+} I2C_TransferSeq_TypeDef;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+I2C_TransferReturn_TypeDef I2C_TransferInit(I2C_TypeDef *i2c, I2C_TransferSeq_TypeDef *seq);
+I2C_TransferReturn_TypeDef I2C_Transfer(I2C_TypeDef *i2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_EM_I2C_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_rmu.h
+ *
+ * @brief Host stand-in for the emlib RMU reset cause API. The host always
+ * reports a clean power-on reset.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_RMU_H_
+#define HOST_INCLUDE_EM_RMU_H_
+
+#include <stdint.h>
+#include "em_device.h"
+
+static inline uint32_t RMU_ResetCauseGet(void) { return 0; }
+static inline void RMU_ResetCauseClear(void) { }
+
+#endif /* HOST_INCLUDE_EM_RMU_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file em_rtcc.h
+ *
+ * @brief Host stand-in for the emlib RTCC counter API. host_device.c keeps
+ * RTCC->CNT in step with the 32768 Hz virtual clock, as init_mcu.c sets
+ * the RTCC up on the target (LFXO, no prescaler).
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_EM_RTCC_H_
+#define HOST_INCLUDE_EM_RTCC_H_
+
+#include <stdint.h>
+#include "em_device.h"
+
+static inline uint32_t RTCC_CounterGet(void) { return RTCC->CNT; }
+
+#endif /* HOST_INCLUDE_EM_RTCC_H_ */
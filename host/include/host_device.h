@@ -0,0 +1,92 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_device.h
+ *
+ * @brief Host device model: virtual clock, NVIC and IRQ dispatch.
+ *
+ * The firmware never reads wall-clock time directly; everything is driven
+ * by the virtual clock kept here in 32768 Hz ticks (the LFXO/soft timer
+ * unit used throughout the BGAPI). The harness advances the clock and
+ * raises IRQs; the NVIC model decides whether the firmware handler runs
+ * now or stays pending until interrupts are unmasked again.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_DEVICE_H_
+#define HOST_INCLUDE_HOST_DEVICE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Virtual clock resolution, identical to the BGAPI soft timer clock. */
+#define HOST_CLOCK_HZ				32768ULL
+
+#define HOST_MS_TO_TICKS(ms)		(((uint64_t)(ms) * HOST_CLOCK_HZ) / 1000ULL)
+#define HOST_TICKS_TO_MS(ticks)		(((uint64_t)(ticks) * 1000ULL) / HOST_CLOCK_HZ)
+#define HOST_TICKS_TO_US(ticks)		(((uint64_t)(ticks) * 1000000ULL) / HOST_CLOCK_HZ)
+
+/* IRQ lines tracked by the NVIC model (bitmap width). */
+#define HOST_IRQ_LINES				64
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t irq_raised;			// IRQs raised by the harness
+	uint32_t irq_serviced;			// Firmware handlers actually executed
+	uint32_t irq_deferred;			// Raised while masked, serviced later
+	uint32_t critical_sections;		// CORE_EnterCritical() calls
+	uint32_t em_entries[5];			// EMU_EnterEMx() calls per energy mode
+} host_device_stats_t;
+
+extern host_device_stats_t host_device_stats;
+
+/* Host cost of one firmware IRQ handler. */
+typedef struct
+{
+	uint32_t count;					// Handler executions
+	uint64_t ns_total;				// Host time spent in the handler
+	uint64_t ns_max;
+} host_isr_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_device_reset(void);
+
+uint64_t host_clock_now(void);
+void host_clock_advance_to(uint64_t ticks);
+
+void host_irq_raise(IRQn_Type IRQn);
+bool host_irq_enabled(IRQn_Type IRQn);
+const char *host_irq_name(IRQn_Type IRQn);
+const host_isr_stats_t *host_isr_stats(IRQn_Type IRQn);
+
+void host_gpio_drive(unsigned int port, unsigned int pin, bool high);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_DEVICE_H_ */
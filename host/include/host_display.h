@@ -0,0 +1,73 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_display.h
+ *
+ * @brief Host model of the display PAL (SPI, GPIO and timer services used
+ * by the LS013B7DH03 driver).
+ *
+ * Nothing is drawn; the model only accounts for the traffic the driver
+ * would put on USART1 and the busy-wait time it would spend doing so.
+ * Lists sent with PAL_SpiTransmitList() take their time on the virtual
+ * clock instead: the model completes them (LDMA_IRQn) once their bytes
+ * have gone out at HOST_DISPLAY_SPI_HZ.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_DISPLAY_H_
+#define HOST_INCLUDE_HOST_DISPLAY_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "host_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define HOST_DISPLAY_SPI_HZ			1000000ULL	// HAL_SPIDISPLAY_FREQUENCY
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t spi_transfers;			// PAL_SpiTransmit() calls
+	uint64_t spi_bytes;				// Bytes clocked out to the panel
+	uint32_t dma_transfers;			// PAL_SpiTransmitList() calls started
+	uint64_t dma_bytes;				// Of spi_bytes, sent by the LDMA
+	uint32_t dma_errors;			// Lists failed by host_display_fail_next()
+	uint64_t delay_us;				// Busy-wait requested via PAL timer
+	uint32_t gpio_writes;			// PAL pin set/clear/toggle calls
+} host_display_stats_t;
+
+extern host_display_stats_t host_display_stats;
+
+extern const host_sim_model_t host_display_model;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_display_reset(void);
+bool host_display_busy(void);
+void host_display_fail_next(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_DISPLAY_H_ */
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_gecko.h
+ *
+ * @brief Host stand-in for the Bluetooth mesh stack behind native_gecko.h.
+ *
+ * The static inline BGAPI wrappers from native_gecko.h are used unchanged;
+ * they marshal into gecko_cmd_msg_buf and call sli_bt_cmd_handler_delegate(),
+ * which this module implements. Soft timers, external signals and the
+ * persistent store are emulated because the firmware depends on them.
+ * Every other event comes from a replayed trace.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_GECKO_H_
+#define HOST_INCLUDE_HOST_GECKO_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include "host_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* BGAPI commands the firmware issues; counted individually. */
+typedef enum
+{
+	HOST_CMD_SYSTEM_RESET,
+	HOST_CMD_SYSTEM_GET_BT_ADDRESS,
+	HOST_CMD_HARDWARE_SET_SOFT_TIMER,
+	HOST_CMD_FLASH_PS_SAVE,
+	HOST_CMD_FLASH_PS_LOAD,
+	HOST_CMD_FLASH_PS_ERASE_ALL,
+	HOST_CMD_GATT_SERVER_WRITE_ATTRIBUTE_VALUE,
+	HOST_CMD_GATT_SERVER_SEND_USER_WRITE_RESPONSE,
+	HOST_CMD_LE_CONNECTION_CLOSE,
+	HOST_CMD_MESH_NODE_INIT,
+	HOST_CMD_MESH_NODE_START_UNPROV_BEACONING,
+	HOST_CMD_MESH_FRIEND_INIT,
+	HOST_CMD_MESH_LPN_ESTABLISH_FRIENDSHIP,
+	HOST_CMD_MESH_GENERIC_SERVER_INIT,
+	HOST_CMD_MESH_GENERIC_SERVER_RESPONSE,
+	HOST_CMD_MESH_GENERIC_SERVER_UPDATE,
+	HOST_CMD_MESH_GENERIC_SERVER_PUBLISH,
+	HOST_CMD_MESH_GENERIC_CLIENT_GET,
+	HOST_CMD_MESH_GENERIC_CLIENT_SET,
+	HOST_CMD_MESH_GENERIC_CLIENT_PUBLISH,
+	HOST_CMD_COUNT
+} host_gecko_cmd_t;
+
+/* Stack events the host delivers; latencies are collected per class. */
+typedef enum
+{
+	HOST_EVT_SYSTEM_BOOT,
+	HOST_EVT_SYSTEM_EXTERNAL_SIGNAL,
+	HOST_EVT_HARDWARE_SOFT_TIMER,
+	HOST_EVT_LE_CONNECTION_OPENED,
+	HOST_EVT_LE_CONNECTION_CLOSED,
+	HOST_EVT_MESH_NODE_INITIALIZED,
+	HOST_EVT_MESH_NODE_PROVISIONED,
+	HOST_EVT_MESH_NODE_RESET,
+	HOST_EVT_MESH_GENERIC_SERVER_CLIENT_REQUEST,
+	HOST_EVT_MESH_FRIEND_FRIENDSHIP_ESTABLISHED,
+	HOST_EVT_MESH_FRIEND_FRIENDSHIP_TERMINATED,
+	HOST_EVT_COUNT
+} host_gecko_evt_t;
+
+/* Called with the host time the firmware spent handling one event, i.e.
+ * from gecko_wait_event() returning it until the next gecko_wait_event(). */
+typedef void (*host_gecko_latency_hook_t)(host_gecko_evt_t evt, uint64_t ns);
+
+typedef struct
+{
+	uint32_t commands;						// All BGAPI commands
+	uint32_t command[HOST_CMD_COUNT];		// Per command
+	uint32_t events;						// Events returned by gecko_wait_event()
+	uint32_t event[HOST_EVT_COUNT];			// Per event class
+	uint32_t trace_events;					// ... of which came from the trace
+	uint32_t soft_timer_events;				// ... of which were soft timer expiries
+	uint32_t external_signal_events;		// ... of which were external signals
+	uint32_t device_records;				// Trace records injected as IRQs
+	uint32_t sleeps;						// SLEEP_Sleep() calls while idle
+	uint32_t ps_bytes_written;				// Payload bytes handed to flash_ps_save
+} host_gecko_stats_t;
+
+extern host_gecko_stats_t host_gecko_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_gecko_reset(void);
+const char *host_gecko_cmd_name(host_gecko_cmd_t cmd);
+const char *host_gecko_evt_name(host_gecko_evt_t evt);
+void host_gecko_set_latency_hook(host_gecko_latency_hook_t hook);
+
+void host_gecko_run(int (*entry)(void), const host_trace_t *trace);
+
+int host_gecko_ps_get(uint16_t key, uint8_t *data, uint8_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_GECKO_H_ */
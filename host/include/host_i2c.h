@@ -0,0 +1,111 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_i2c.h
+ *
+ * @brief Host model of the I2C0 bus with an MCP9808 on it, and any other
+ * register file devices a harness attaches.
+ *
+ * I2C_TransferInit() latches the sequence and returns in-progress, exactly
+ * like the interrupt driven emlib driver. The transfer only finishes when
+ * the harness calls host_i2c_complete(), which raises I2C0_IRQn; the
+ * firmware handler then sees I2C_Transfer() return the final status.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_I2C_H_
+#define HOST_INCLUDE_HOST_I2C_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_i2c.h"
+#include "host_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* 7-bit address of the simulated MCP9808. */
+#define HOST_MCP9808_ADDR			0x18
+
+/* Generic devices that can be attached besides the MCP9808. */
+#define HOST_I2C_DEVICES_MAX		32
+
+/* Bus clock used when I2CSPM_Init() is given none. */
+#define HOST_I2C_DEFAULT_HZ			100000
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Slave behaviour; all zero means an always-ready device at bus speed. */
+typedef struct
+{
+	uint32_t latency_us;			// Extra slave latency (clock stretching) per transfer
+	uint16_t nack_permille;			// Chance that the address byte is NACKed
+	uint32_t seed;					// NACK PRNG seed
+} host_i2c_config_t;
+
+/* A generic register file device; the MCP9808 uses host_i2c_config_t. */
+typedef struct
+{
+	uint8_t addr;					// 7-bit
+	uint32_t latency_us;			// Extra slave latency per transfer
+	uint16_t nack_permille;			// Chance that the address byte is NACKed
+	uint16_t bus_error_permille;	// Chance of a bus error (misplaced start/stop)
+	const uint8_t *response;		// Bytes every read returns instead of the registers
+	uint8_t response_len;
+} host_i2c_device_config_t;
+
+typedef struct
+{
+	uint32_t transfers;				// Sequences started with I2C_TransferInit()
+	uint32_t completed;				// Sequences that returned i2cTransferDone
+	uint32_t nacks;					// Sequences addressed to an absent device
+	uint32_t bus_errors;
+	uint32_t alerts;				// MCP9808 ALERT output asserted
+	uint32_t bytes_written;
+	uint32_t bytes_read;
+	uint64_t busy_ticks;			// Virtual time the bus was occupied
+
+	/* Intervals between successive Ta reads, i.e. the sampling period. */
+	uint32_t samples;
+	uint64_t last_sample;
+	uint64_t interval_min;
+	uint64_t interval_max;
+	double interval_sum;
+	double interval_sumsq;
+} host_i2c_stats_t;
+
+extern host_i2c_stats_t host_i2c_stats;
+extern const host_sim_model_t host_i2c_model;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_i2c_reset(void);
+void host_i2c_configure(const host_i2c_config_t *config);
+bool host_i2c_attach(const host_i2c_device_config_t *config);
+void host_i2c_detach_all(void);
+bool host_i2c_busy(void);
+
+void host_mcp9808_set_temp_mC(int32_t temp_mC);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_I2C_H_ */
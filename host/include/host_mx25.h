@@ -0,0 +1,79 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_mx25.h
+ *
+ * @brief Host model of the MX25R8035F SPI NOR flash behind mx25flash_spi.h.
+ *
+ * The whole 1 MB array is kept in memory with NOR semantics: erase sets a
+ * 4 KB sector to 0xFF, page program can only clear bits and wraps at the
+ * 256 byte page boundary as the chip does. Programming bits that are
+ * already 0 back to 1 is counted as an overwrite, the sign of a missing
+ * erase. In deep power-down the chip ignores every command; the chip
+ * select edge of a command wakes it, and it answers from the next command
+ * on, which stands in for tRDP.
+ *
+ * Busy time is accumulated from the datasheet typical program and erase
+ * times, since the driver busy-waits for both.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_MX25_H_
+#define HOST_INCLUDE_HOST_MX25_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define HOST_MX25_PP_US			850			// Page program, typical
+#define HOST_MX25_SE_US			40000		// Sector erase, typical
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t inits;					// MX25_init() calls (bus taken from the LCD)
+	uint32_t wakeups;				// Exits from deep power-down
+	uint32_t power_downs;			// MX25_DP() calls that entered deep power-down
+	uint32_t ignored;				// Commands sent while powered down
+	uint32_t reads;
+	uint64_t read_bytes;
+	uint32_t programs;				// MX25_PP() calls
+	uint64_t program_bytes;			// Bytes clocked in by them
+	uint64_t overwrites;			// Bytes that needed a 0 bit programmed back to 1
+	uint32_t erases;				// MX25_SE() calls
+	uint64_t busy_us;				// Program and erase time, datasheet typical
+} host_mx25_stats_t;
+
+extern host_mx25_stats_t host_mx25_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_mx25_reset(void);
+void host_mx25_clear_stats(void);
+uint32_t host_mx25_sector_erases(uint32_t sector);
+int host_mx25_powered_down(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_MX25_H_ */
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_nvm3.h
+ *
+ * @brief Host model of the NVM3 default instance.
+ *
+ * The NVM3 core ships as a binary library for the target, so the calls the
+ * firmware makes are implemented here on top of a page-level model of the
+ * flash area: objects are appended to the newest page, rewriting a key
+ * leaves the old copy behind as garbage, and a repack copies the live
+ * objects out of the oldest page and erases it. A write that would eat
+ * into the last free page repacks by itself first; those forced repacks
+ * are the flash-erase stalls the firmware tries to keep out of its event
+ * handlers, and are counted separately from the ones it asks for.
+ *
+ * Object and page header sizes follow the NVM3 documentation; the model
+ * does not keep more than one live copy per key or simulate power loss.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_NVM3_H_
+#define HOST_INCLUDE_HOST_NVM3_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t writes;				// nvm3_writeData()/nvm3_writeCounter() calls
+	uint32_t reads;					// nvm3_readData()/nvm3_readCounter() calls
+	uint32_t deletes;				// nvm3_deleteObject() calls on existing keys
+	uint64_t data_bytes;			// Payload bytes written by the application
+	uint64_t flash_bytes;			// Bytes programmed, headers and repack copies included
+	uint32_t page_erases;
+	uint32_t user_repacks;			// nvm3_repack() calls that erased a page
+	uint32_t forced_repacks;		// Page erases done inside a write
+} host_nvm3_stats_t;
+
+extern host_nvm3_stats_t host_nvm3_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_nvm3_reset(void);
+uint32_t host_nvm3_free_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_NVM3_H_ */
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_sim.h
+ *
+ * @brief Discrete-event kernel for the host peripheral models.
+ *
+ * Peripheral models (I2C0, the sleeptimer, the display LDMA) are clocked
+ * from the virtual clock in host_device.c. Instead of ticking every peripheral
+ * cycle, each model reports the virtual time of its next externally
+ * visible event (an interrupt flag being set, a transfer completing) and
+ * the kernel jumps straight to it. Firmware register writes are folded into the model
+ * state at every sync point, i.e. whenever virtual time is about to move
+ * or a model is about to fire; the firmware itself runs in zero virtual
+ * time between two sync points.
+ *
+ * Idle time goes through the SLEEP driver like on the target: the harness
+ * arms a wake-up deadline with host_sim_sleep_until() and calls
+ * SLEEP_Sleep(); the EMU_EnterEMx() stubs then call host_sim_idle(), which
+ * returns on the first interrupt a model raises or at the deadline. The
+ * interrupt itself is serviced when SLEEP_Sleep() leaves its critical
+ * section, after the wake-up callback, as it would be after WFI.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_SIM_H_
+#define HOST_INCLUDE_HOST_SIM_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define HOST_SIM_NEVER				UINT64_MAX
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *name;
+	void (*reset)(void);
+	void (*sync)(uint64_t now);			// Fold register writes, refresh live registers
+	uint64_t (*next_event)(void);		// Absolute tick of the next event or HOST_SIM_NEVER
+	void (*fire)(uint64_t now);			// Called at exactly next_event()
+} host_sim_model_t;
+
+typedef struct
+{
+	uint64_t events;					// Model events fired
+	uint64_t syncs;						// Sync points
+	uint64_t idles;						// host_sim_idle() calls
+	uint64_t idle_irq_wakeups;			// Idles ended by an interrupt before the deadline
+} host_sim_stats_t;
+
+extern host_sim_stats_t host_sim_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void host_sim_reset(void);
+void host_sim_sync(void);
+uint64_t host_sim_next_event(void);
+void host_sim_advance_to(uint64_t ticks);
+void host_sim_sleep_until(uint64_t ticks);
+void host_sim_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_SIM_H_ */
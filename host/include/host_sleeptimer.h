@@ -0,0 +1,55 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_sleeptimer.h
+ *
+ * @brief Virtual-time model of the sleeptimer service (sl_sleeptimer.h).
+ *
+ * The sleeptimer runs on the RTCC, so its tick count is the 32768 Hz
+ * virtual clock. Running timers are kept sorted by deadline; when the
+ * first one is due the model raises RTCC_IRQn and the handler runs every
+ * expired callback in interrupt context, as sl_sleeptimer_hal_rtcc.c does.
+ * A timer started with a zero timeout calls back at once, in the caller's
+ * context, like the SDK. Only the one-shot and periodic timer and tick
+ * count calls are provided, not the wall clock.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_SLEEPTIMER_H_
+#define HOST_INCLUDE_HOST_SLEEPTIMER_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include "host_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t starts;				// Timers started or restarted
+	uint32_t stops;					// ... and stopped while running
+	uint32_t expired;				// Callbacks run
+	uint32_t irqs;					// RTCC interrupts raised
+} host_sleeptimer_stats_t;
+
+extern host_sleeptimer_stats_t host_sleeptimer_stats;
+extern const host_sim_model_t host_sleeptimer_model;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_SLEEPTIMER_H_ */
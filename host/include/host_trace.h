@@ -0,0 +1,107 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_trace.h
+ *
+ * @brief Event trace format shared by the trace generator and the replay
+ * benchmark.
+ *
+ * A trace is a text file with one record per line:
+ *
+ *     <time_ms> <kind> <arg0> <arg1>
+ *
+ * Lines starting with '#' are comments. Records must be in time order.
+ * Stack records become BGAPI events returned from gecko_wait_event();
+ * device records act on the peripheral models. The sleeptimer and I2C0
+ * interrupts are not traced; they come from the virtual-time models.
+ *
+ *     kind          arg0             arg1
+ *     boot          -                -
+ *     node_init     provisioned      unicast address
+ *     provisioned   unicast address  -
+ *     node_reset    -                -
+ *     conn_open     connection       -
+ *     conn_close    connection       reason
+ *     level         client address   generic level (int16)
+ *     friend_est    LPN address      -
+ *     friend_term   reason           -
+ *     temp          temperature mC   -           (MCP9808 ambient temperature)
+ *     button        0 = PB0, 1 = PB1 1 = pressed (GPIO edge IRQ)
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_HOST_TRACE_H_
+#define HOST_INCLUDE_HOST_TRACE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	HOST_TRACE_BOOT,
+	HOST_TRACE_NODE_INIT,
+	HOST_TRACE_PROVISIONED,
+	HOST_TRACE_NODE_RESET,
+	HOST_TRACE_CONN_OPEN,
+	HOST_TRACE_CONN_CLOSE,
+	HOST_TRACE_LEVEL,
+	HOST_TRACE_FRIEND_EST,
+	HOST_TRACE_FRIEND_TERM,
+	HOST_TRACE_TEMP,
+	HOST_TRACE_BUTTON,
+	HOST_TRACE_KIND_COUNT
+} host_trace_kind_t;
+
+typedef struct
+{
+	uint32_t time_ms;
+	host_trace_kind_t kind;
+	int32_t arg0;
+	int32_t arg1;
+} host_trace_record_t;
+
+typedef struct
+{
+	host_trace_record_t *records;
+	size_t count;
+	size_t capacity;
+} host_trace_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+const char *host_trace_kind_name(host_trace_kind_t kind);
+bool host_trace_kind_parse(const char *name, host_trace_kind_t *kind);
+
+bool host_trace_load(const char *path, host_trace_t *trace);
+bool host_trace_append(host_trace_t *trace, const host_trace_record_t *record);
+void host_trace_write(FILE *out, const host_trace_record_t *record);
+void host_trace_free(host_trace_t *trace);
+
+bool host_trace_is_device(host_trace_kind_t kind);
+void host_trace_inject(const host_trace_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_HOST_TRACE_H_ */
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file i2cspm.h
+ *
+ * @brief Host stand-in for the kit I2CSPM driver.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_I2CSPM_H_
+#define HOST_INCLUDE_I2CSPM_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include "em_gpio.h"
+#include "em_i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	I2C_TypeDef				*port;
+	GPIO_Port_TypeDef		sclPort;
+	uint8_t					sclPin;
+	GPIO_Port_TypeDef		sdaPort;
+	uint8_t					sdaPin;
+	uint8_t					portLocationScl;
+	uint8_t					portLocationSda;
+	uint32_t				i2cRefFreq;
+	uint32_t				i2cMaxFreq;
+	I2C_ClockHLR_TypeDef	i2cClhr;
+} I2CSPM_Init_TypeDef;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void I2CSPM_Init(I2CSPM_Init_TypeDef *init);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_INCLUDE_I2CSPM_H_ */
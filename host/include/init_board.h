@@ -0,0 +1,24 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file init_board.h
+ *
+ * @brief Host stand-in; board bring-up has no host equivalent.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_INIT_BOARD_H_
+#define HOST_INCLUDE_INIT_BOARD_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void initBoard(void) { }
+static inline void initVcomEnable(void) { }
+
+#endif /* HOST_INCLUDE_INIT_BOARD_H_ */
@@ -0,0 +1,23 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file init_mcu.h
+ *
+ * @brief Host stand-in; MCU bring-up has no host equivalent.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_INIT_MCU_H_
+#define HOST_INCLUDE_INIT_MCU_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void initMcu(void) { }
+
+#endif /* HOST_INCLUDE_INIT_MCU_H_ */
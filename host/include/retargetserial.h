@@ -0,0 +1,24 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file retargetserial.h
+ *
+ * @brief Host stand-in for the kit serial retarget driver. Log output goes
+ * straight to stdout on the host.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef HOST_INCLUDE_RETARGETSERIAL_H_
+#define HOST_INCLUDE_RETARGETSERIAL_H_
+
+#include <stdbool.h>
+
+static inline void RETARGET_SerialInit(void) { }
+static inline void RETARGET_SerialCrLf(int on) { (void)on; }
+static inline void RETARGET_SerialFlush(void) { }
+
+#endif /* HOST_INCLUDE_RETARGETSERIAL_H_ */
@@ -0,0 +1,331 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_device.c
+ *
+ * @brief Host device model: RAM peripherals, virtual clock, NVIC and CORE.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <time.h>
+#include "host_device.h"
+#include "em_core.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Peripheral register blocks that the redirected base macros point to. */
+GPIO_TypeDef		host_GPIO;
+CMU_TypeDef			host_CMU;
+EMU_TypeDef			host_EMU;
+MSC_TypeDef			host_MSC;
+LETIMER_TypeDef		host_LETIMER0;
+I2C_TypeDef			host_I2C0;
+USART_TypeDef		host_USART1;
+LDMA_TypeDef		host_LDMA;
+RTCC_TypeDef		host_RTCC;
+CoreDebug_Type		host_CoreDebug;
+
+static DWT_Type		host_DWT;
+static uint64_t		host_dwt_base;			// Host ns when CYCCNT last read 0
+
+host_device_stats_t host_device_stats;
+
+static host_isr_stats_t isr_stats[HOST_IRQ_LINES];
+
+/* Firmware handlers are weak so that benchmarks without the firmware link. */
+extern void LETIMER0_IRQHandler(void) __attribute__((weak));
+extern void I2C0_IRQHandler(void) __attribute__((weak));
+extern void GPIO_EVEN_IRQHandler(void) __attribute__((weak));
+extern void GPIO_ODD_IRQHandler(void) __attribute__((weak));
+extern void LDMA_IRQHandler(void) __attribute__((weak));
+extern void RTCC_IRQHandler(void) __attribute__((weak));
+
+static uint64_t clock_ticks;
+static uint64_t nvic_enabled;
+static uint64_t nvic_pending;
+static uint32_t primask;
+static uint32_t irq_nesting;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Look up the firmware handler for an IRQ line.
+ *
+ * @param IRQn_Type IRQn
+ * @return void (*)(void) Handler or NULL if none is linked.
+ */
+static void (*host_irq_handler(IRQn_Type IRQn))(void)
+{
+	switch(IRQn)
+	{
+		case LETIMER0_IRQn:		return LETIMER0_IRQHandler;
+		case I2C0_IRQn:			return I2C0_IRQHandler;
+		case GPIO_EVEN_IRQn:	return GPIO_EVEN_IRQHandler;
+		case GPIO_ODD_IRQn:		return GPIO_ODD_IRQHandler;
+		case LDMA_IRQn:			return LDMA_IRQHandler;
+		case RTCC_IRQn:			return RTCC_IRQHandler;
+		default:				return NULL;
+	}
+}
+
+const char *host_irq_name(IRQn_Type IRQn)
+{
+	switch(IRQn)
+	{
+		case LETIMER0_IRQn:		return "LETIMER0";
+		case I2C0_IRQn:			return "I2C0";
+		case GPIO_EVEN_IRQn:	return "GPIO_EVEN";
+		case GPIO_ODD_IRQn:		return "GPIO_ODD";
+		case LDMA_IRQn:			return "LDMA";
+		case RTCC_IRQn:			return "RTCC";
+		default:				return "unknown";
+	}
+}
+
+const host_isr_stats_t *host_isr_stats(IRQn_Type IRQn)
+{
+	return &isr_stats[(unsigned) IRQn % HOST_IRQ_LINES];
+}
+
+static uint64_t host_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Run every pending, enabled IRQ while interrupts are unmasked.
+ *
+ * @param void
+ * @return void.
+ */
+static void host_irq_service(void)
+{
+	while(!primask && !irq_nesting && (nvic_pending & nvic_enabled))
+	{
+		IRQn_Type IRQn = (IRQn_Type) __builtin_ctzll(nvic_pending & nvic_enabled);
+		void (*handler)(void) = host_irq_handler(IRQn);
+
+		nvic_pending &= ~(1ULL << IRQn);
+		if(handler)
+		{
+			host_isr_stats_t *stats = &isr_stats[IRQn];
+			uint64_t start = host_now_ns();
+			uint64_t elapsed;
+
+			irq_nesting++;
+			handler();
+			irq_nesting--;
+
+			elapsed = host_now_ns() - start;
+			stats->count++;
+			stats->ns_total += elapsed;
+			if(elapsed > stats->ns_max)
+				stats->ns_max = elapsed;
+			host_device_stats.irq_serviced++;
+		}
+	}
+}
+
+/**
+ * @brief Reset peripherals, clock and NVIC to power-on state.
+ *
+ * @param void
+ * @return void.
+ */
+void host_device_reset(void)
+{
+	memset(&host_GPIO, 0, sizeof(host_GPIO));
+	memset(&host_CMU, 0, sizeof(host_CMU));
+	memset(&host_EMU, 0, sizeof(host_EMU));
+	memset(&host_MSC, 0, sizeof(host_MSC));
+	memset(&host_LETIMER0, 0, sizeof(host_LETIMER0));
+	memset(&host_I2C0, 0, sizeof(host_I2C0));
+	memset(&host_USART1, 0, sizeof(host_USART1));
+	memset(&host_LDMA, 0, sizeof(host_LDMA));
+	memset(&host_RTCC, 0, sizeof(host_RTCC));
+	memset(&host_CoreDebug, 0, sizeof(host_CoreDebug));
+	memset(&host_DWT, 0, sizeof(host_DWT));
+	host_dwt_base = 0;
+	memset(&host_device_stats, 0, sizeof(host_device_stats));
+	memset(isr_stats, 0, sizeof(isr_stats));
+
+	clock_ticks = 0;
+	nvic_enabled = 0;
+	nvic_pending = 0;
+	primask = 0;
+	irq_nesting = 0;
+}
+
+/**
+ * @brief DWT registers, with CYCCNT brought up to date first.
+ *
+ * While trace and the counter are enabled CYCCNT follows host time scaled
+ * to the core clock, so the firmware measures its own host cost in target
+ * sized cycles. It is not tied to the virtual clock, which only moves
+ * between events.
+ *
+ * @param void
+ * @return DWT_Type *.
+ */
+DWT_Type *host_dwt(void)
+{
+	uint64_t now = host_now_ns();
+
+	if((host_CoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (host_DWT.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+	{
+		if(!host_dwt_base)
+			host_dwt_base = now - (host_DWT.CYCCNT * 1000000000ULL) / HOST_CORE_CLOCK_HZ;
+		host_DWT.CYCCNT = (uint32_t) (((now - host_dwt_base) * HOST_CORE_CLOCK_HZ) / 1000000000ULL);
+	}
+	else
+		host_dwt_base = 0;
+
+	return &host_DWT;
+}
+
+/**
+ * @brief Current virtual time in 32768 Hz ticks.
+ *
+ * @param void
+ * @return uint64_t.
+ */
+uint64_t host_clock_now(void)
+{
+	return clock_ticks;
+}
+
+/**
+ * @brief Move the virtual clock forward. Time never runs backwards.
+ *
+ * The RTCC counter runs off the same 32768 Hz clock and wraps at 32 bits.
+ *
+ * @param uint64_t ticks
+ * @return void.
+ */
+void host_clock_advance_to(uint64_t ticks)
+{
+	if(ticks > clock_ticks)
+	{
+		clock_ticks = ticks;
+		host_RTCC.CNT = (uint32_t) clock_ticks;
+	}
+}
+
+/**
+ * @brief Raise an IRQ line as the peripheral would.
+ *
+ * @param IRQn_Type IRQn
+ * @return void.
+ */
+void host_irq_raise(IRQn_Type IRQn)
+{
+	host_device_stats.irq_raised++;
+	nvic_pending |= (1ULL << IRQn);
+
+	if(primask || irq_nesting || !(nvic_enabled & (1ULL << IRQn)))
+	{
+		host_device_stats.irq_deferred++;
+	}
+	host_irq_service();
+}
+
+bool host_irq_enabled(IRQn_Type IRQn)
+{
+	return (nvic_enabled >> IRQn) & 0x1;
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	nvic_enabled |= (1ULL << IRQn);
+	host_irq_service();
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	nvic_enabled &= ~(1ULL << IRQn);
+}
+
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+	return (uint32_t) ((nvic_enabled >> IRQn) & 0x1);
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+	nvic_pending |= (1ULL << IRQn);
+	host_irq_service();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	nvic_pending &= ~(1ULL << IRQn);
+}
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+	return (uint32_t) ((nvic_pending >> IRQn) & 0x1);
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+	(void) IRQn;
+	(void) priority;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return primask;
+}
+
+void __set_PRIMASK(uint32_t priMask)
+{
+	primask = priMask & 0x1;
+	host_irq_service();
+}
+
+void __disable_irq(void)
+{
+	primask = 1;
+}
+
+void __enable_irq(void)
+{
+	primask = 0;
+	host_irq_service();
+}
+
+CORE_irqState_t CORE_EnterCritical(void)
+{
+	CORE_irqState_t irqState = primask;
+
+	primask = 1;
+	host_device_stats.critical_sections++;
+	return irqState;
+}
+
+void CORE_ExitCritical(CORE_irqState_t irqState)
+{
+	primask = irqState;
+	host_irq_service();
+}
+
+bool CORE_InIrqContext(void)
+{
+	return irq_nesting != 0;
+}
@@ -0,0 +1,263 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_display_pal.c
+ *
+ * @brief Host implementation of displaypal.h.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "host_display.h"
+#include "host_device.h"
+#include "displayconfigall.h"
+#include "displaypal.h"
+#include "dmadrv_config.h"
+#include "em_gpio.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define HOST_DISPLAY_DMA_XFER_MAX	2048		// Units per LDMA descriptor
+
+/* Writable view of the read-only LDMA interrupt flags. */
+#define HOST_LDMA_IF				(*(volatile uint32_t *) &LDMA->IF)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_display_stats_t host_display_stats;
+
+/* List in flight until its interrupt: virtual time its last bit leaves,
+ * or it fails, and its callback. */
+static bool dma_active;
+static bool dma_fail;
+static bool dma_error;
+static uint64_t dma_done = HOST_SIM_NEVER;
+static void (*dma_callback)(void *, EMSTATUS);
+static void *dma_arg;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+void host_display_reset(void)
+{
+	memset(&host_display_stats, 0, sizeof(host_display_stats));
+}
+
+bool host_display_busy(void)
+{
+	return dma_active;
+}
+
+/**
+ * @brief Make the next list fail half way with an LDMA error.
+ *
+ * @param void
+ * @return void.
+ */
+void host_display_fail_next(void)
+{
+	dma_fail = true;
+}
+
+EMSTATUS PAL_GpioInit(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_GpioShutdown(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_GpioPinModeSet(unsigned int port, unsigned int pin, PAL_GpioMode_t mode, unsigned int platformSpecific)
+{
+	(void) mode;
+	GPIO_PinModeSet((GPIO_Port_TypeDef) port, pin, gpioModePushPull, platformSpecific);
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_GpioPinOutSet(unsigned int port, unsigned int pin)
+{
+	host_display_stats.gpio_writes++;
+	GPIO_PinOutSet((GPIO_Port_TypeDef) port, pin);
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_GpioPinOutClear(unsigned int port, unsigned int pin)
+{
+	host_display_stats.gpio_writes++;
+	GPIO_PinOutClear((GPIO_Port_TypeDef) port, pin);
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_GpioPinOutToggle(unsigned int port, unsigned int pin)
+{
+	host_display_stats.gpio_writes++;
+	GPIO_PinOutToggle((GPIO_Port_TypeDef) port, pin);
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_SpiInit(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_SpiShutdown(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_SpiTransmit(uint8_t *data, unsigned int len)
+{
+	(void) data;
+	host_display_stats.spi_transfers++;
+	host_display_stats.spi_bytes += len;
+	return PAL_EMSTATUS_OK;
+}
+
+/**
+ * @brief Start a list on the LDMA model: the bytes are counted now and the
+ * list completes once they would have gone out, as the LDMA would send
+ * them with the core asleep.
+ *
+ * @param const PAL_SpiBlock_t *blocks, unsigned int count,
+ * void (*done)(void *, EMSTATUS), void *arg
+ * @return EMSTATUS PAL_EMSTATUS_INVALID_PARAM if the descriptors of
+ * dmadrv_config.h do not hold it.
+ */
+EMSTATUS PAL_SpiTransmitList(const PAL_SpiBlock_t *blocks, unsigned int count, void (*done)(void *, EMSTATUS), void *arg)
+{
+	unsigned int descriptors = 0;
+	uint64_t bytes = 0;
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		descriptors += (blocks[i].len + HOST_DISPLAY_DMA_XFER_MAX - 1) / HOST_DISPLAY_DMA_XFER_MAX;
+		bytes += blocks[i].len;
+	}
+	if(descriptors == 0 || descriptors > PAL_SPI_DMA_DESCRIPTORS || host_display_busy())
+		return PAL_EMSTATUS_INVALID_PARAM;
+
+	if(dma_fail)
+	{
+		bytes /= 2;
+		host_display_stats.dma_errors++;
+	}
+
+	host_display_stats.dma_transfers++;
+	host_display_stats.dma_bytes += bytes;
+	host_display_stats.spi_bytes += bytes;
+
+	dma_active = true;
+	dma_error = dma_fail;
+	dma_fail = false;
+	dma_callback = done;
+	dma_arg = arg;
+	dma_done = host_clock_now() + (bytes * 8 * HOST_CLOCK_HZ + HOST_DISPLAY_SPI_HZ - 1) / HOST_DISPLAY_SPI_HZ;
+	NVIC_EnableIRQ(LDMA_IRQn);
+	return PAL_EMSTATUS_OK;
+}
+
+/**
+ * @brief The LDMA and USART TXC interrupts of displaypalemlib.c in one: the
+ * list is out, or the LDMA failed.
+ *
+ * @param void
+ * @return void.
+ */
+void LDMA_IRQHandler(void)
+{
+	uint32_t mask = 1UL << PAL_SPI_DMA_CHANNEL;
+	uint32_t pending = HOST_LDMA_IF & (mask | LDMA_IF_ERROR);
+	void (*callback)(void *, EMSTATUS) = dma_callback;
+
+	if(!pending)
+		return;
+	HOST_LDMA_IF &= ~pending;
+
+	dma_active = false;
+	dma_callback = NULL;
+	if(callback)
+		callback(dma_arg, (pending & LDMA_IF_ERROR) ? PAL_EMSTATUS_DMA_ERROR : PAL_EMSTATUS_OK);
+}
+
+static void host_display_model_reset(void)
+{
+	dma_active = false;
+	dma_fail = false;
+	dma_error = false;
+	dma_done = HOST_SIM_NEVER;
+	dma_callback = NULL;
+}
+
+static void host_display_sync(uint64_t now)
+{
+	(void) now;
+}
+
+static uint64_t host_display_next_event(void)
+{
+	return dma_done;
+}
+
+/**
+ * @brief The last byte of the list has left the USART, or the LDMA
+ * failed: raise LDMA_IRQn.
+ *
+ * @param uint64_t now
+ * @return void.
+ */
+static void host_display_fire(uint64_t now)
+{
+	(void) now;
+
+	dma_done = HOST_SIM_NEVER;
+	HOST_LDMA_IF |= dma_error ? LDMA_IF_ERROR : (1UL << PAL_SPI_DMA_CHANNEL);
+	host_irq_raise(LDMA_IRQn);
+}
+
+const host_sim_model_t host_display_model =
+{
+	.name = "LDMA",
+	.reset = host_display_model_reset,
+	.sync = host_display_sync,
+	.next_event = host_display_next_event,
+	.fire = host_display_fire,
+};
+
+EMSTATUS PAL_TimerInit(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_TimerShutdown(void)
+{
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_TimerMicroSecondsDelay(unsigned int usecs)
+{
+	host_display_stats.delay_us += usecs;
+	return PAL_EMSTATUS_OK;
+}
+
+EMSTATUS PAL_TimerRepeat(void (*pFunction)(void *), void *argument, unsigned int frequency)
+{
+	(void) pFunction;
+	(void) argument;
+	(void) frequency;
+	return PAL_EMSTATUS_OK;
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_emlib.c
+ *
+ * @brief Host implementations of the emlib CMU, EMU and GPIO calls used by
+ * the firmware.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include "host_device.h"
+#include "host_sim.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t cmu_enabled;
+static CMU_Select_TypeDef cmu_select[cmuClock_COUNT];
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+	if(enable)
+		cmu_enabled |= (1UL << clock);
+	else
+		cmu_enabled &= ~(1UL << clock);
+}
+
+bool CMU_ClockEnabled(CMU_Clock_TypeDef clock)
+{
+	return (cmu_enabled >> clock) & 0x1;
+}
+
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref)
+{
+	cmu_select[clock] = ref;
+}
+
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock)
+{
+	return cmu_select[clock];
+}
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+{
+	switch(cmu_select[clock])
+	{
+		case cmuSelect_ULFRCO:	return 1000;
+		case cmuSelect_LFXO:
+		case cmuSelect_LFRCO:	return 32768;
+		default:				return 38400000;
+	}
+}
+
+void CMU_ClockDivSet(CMU_Clock_TypeDef clock, CMU_ClkDiv_TypeDef div)
+{
+	(void) clock;
+	(void) div;
+}
+
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait)
+{
+	(void) osc;
+	(void) enable;
+	(void) wait;
+}
+
+void EMU_EnterEM1(void)
+{
+	host_device_stats.em_entries[1]++;
+	host_sim_idle();
+}
+
+void EMU_EnterEM2(bool restore)
+{
+	(void) restore;
+	host_device_stats.em_entries[2]++;
+	host_sim_idle();
+}
+
+void EMU_EnterEM3(bool restore)
+{
+	(void) restore;
+	host_device_stats.em_entries[3]++;
+	host_sim_idle();
+}
+
+void EMU_EnterEM4(void)
+{
+	host_device_stats.em_entries[4]++;
+}
+
+void EMU_Save(void)
+{
+}
+
+void EMU_Restore(void)
+{
+}
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+	volatile uint32_t *model = (pin < 8) ? &GPIO->P[port].MODEL : &GPIO->P[port].MODEH;
+	unsigned int shift = (pin % 8) * 4;
+
+	*model = (*model & ~(0xFUL << shift)) | ((uint32_t) mode << shift);
+
+	if(out)
+		GPIO_PinOutSet(port, pin);
+	else
+		GPIO_PinOutClear(port, pin);
+
+	/* Pulled-up inputs idle high, which is what the push buttons rely on. */
+	if(mode == gpioModeInputPull || mode == gpioModeInputPullFilter)
+	{
+		if(out)
+			*(volatile uint32_t *)&GPIO->P[port].DIN |= (1UL << pin);
+		else
+			*(volatile uint32_t *)&GPIO->P[port].DIN &= ~(1UL << pin);
+	}
+}
+
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port, GPIO_DriveStrength_TypeDef strength)
+{
+	GPIO->P[port].CTRL = (GPIO->P[port].CTRL & ~(_GPIO_P_CTRL_DRIVESTRENGTH_MASK | _GPIO_P_CTRL_DRIVESTRENGTHALT_MASK))
+						 | (uint32_t) strength;
+}
+
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo,
+                       bool risingEdge, bool fallingEdge, bool enable)
+{
+	(void) port;
+	(void) pin;
+
+	if(risingEdge)
+		GPIO->EXTIRISE |= (1UL << intNo);
+	else
+		GPIO->EXTIRISE &= ~(1UL << intNo);
+
+	if(fallingEdge)
+		GPIO->EXTIFALL |= (1UL << intNo);
+	else
+		GPIO->EXTIFALL &= ~(1UL << intNo);
+
+	GPIO_IntClear(1UL << intNo);
+	if(enable)
+		GPIO_IntEnable(1UL << intNo);
+	else
+		GPIO_IntDisable(1UL << intNo);
+}
+
+/**
+ * @brief Drive an input pin from outside, as a sensor output would, and
+ * flag the external interrupt on a configured edge. External interrupt n
+ * is taken to be wired to pin n, as the firmware configures them.
+ *
+ * @param unsigned int port, unsigned int pin, bool high
+ * @return void.
+ */
+void host_gpio_drive(unsigned int port, unsigned int pin, bool high)
+{
+	volatile uint32_t *din = (volatile uint32_t *)&GPIO->P[port].DIN;
+	bool was_high = (*din >> pin) & 0x1;
+
+	if(high == was_high)
+		return;
+
+	if(high)
+		*din |= (1UL << pin);
+	else
+		*din &= ~(1UL << pin);
+
+	if((high && (GPIO->EXTIRISE & (1UL << pin))) || (!high && (GPIO->EXTIFALL & (1UL << pin))))
+	{
+		GPIO_IntSet(1UL << pin);
+		host_irq_raise((pin & 0x1) ? GPIO_ODD_IRQn : GPIO_EVEN_IRQn);
+	}
+}
@@ -0,0 +1,736 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_gecko.c
+ *
+ * @brief Host stand-in for the Bluetooth mesh stack: BGAPI command handlers,
+ * soft timers, external signals, persistent store and the trace driven
+ * event loop behind gecko_wait_event().
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <string.h>
+#include <time.h>
+#include "native_gecko.h"
+#include "nvm3.h"
+#include "nvm3_default.h"
+#include "mesh_generic_model_capi_types.h"
+#include "em_common.h"
+#include "host_gecko.h"
+#include "host_device.h"
+#include "host_sim.h"
+#include "sleep.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Matches gecko_configuration_t.max_timers in gecko_mesh.c. */
+#define HOST_SOFT_TIMER_MAX			16
+
+#define HOST_PS_KEY_MAX				32
+#define HOST_PS_VALUE_MAX			56
+
+/* Unicast address the replayed network assigns to this friend node. */
+#define HOST_FRIEND_ADDR			0x0001
+
+/* Generic on/off server model the firmware registers its handler on. */
+#define HOST_GENERIC_SERVER_MODEL	0x1000
+
+#define HOST_EVT_HEADER(id, len)	((id) | (((len) & 0xff) << 8) | (((len) & 0x700) >> 8))
+
+#define HOST_CMD_RESULT_ONLY(name, cmd)										\
+void sli_bt_cmd_##name(const void *payload)									\
+{																			\
+	(void) payload;															\
+	host_gecko_stats.command[cmd]++;										\
+	host_rsp()->data.rsp_##name.result = bg_err_success;					\
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_gecko_stats_t host_gecko_stats;
+
+static struct gecko_cmd_packet cmd_packet;
+static struct gecko_cmd_packet rsp_packet;
+static struct gecko_cmd_packet evt_packet;
+
+void *gecko_cmd_msg_buf = &cmd_packet;
+void *gecko_rsp_msg_buf = &rsp_packet;
+
+static const char *const cmd_names[HOST_CMD_COUNT] =
+{
+	[HOST_CMD_SYSTEM_RESET]							= "system_reset",
+	[HOST_CMD_SYSTEM_GET_BT_ADDRESS]				= "system_get_bt_address",
+	[HOST_CMD_HARDWARE_SET_SOFT_TIMER]				= "hardware_set_soft_timer",
+	[HOST_CMD_FLASH_PS_SAVE]						= "flash_ps_save",
+	[HOST_CMD_FLASH_PS_LOAD]						= "flash_ps_load",
+	[HOST_CMD_FLASH_PS_ERASE_ALL]					= "flash_ps_erase_all",
+	[HOST_CMD_GATT_SERVER_WRITE_ATTRIBUTE_VALUE]	= "gatt_server_write_attribute_value",
+	[HOST_CMD_GATT_SERVER_SEND_USER_WRITE_RESPONSE]	= "gatt_server_send_user_write_response",
+	[HOST_CMD_LE_CONNECTION_CLOSE]					= "le_connection_close",
+	[HOST_CMD_MESH_NODE_INIT]						= "mesh_node_init",
+	[HOST_CMD_MESH_NODE_START_UNPROV_BEACONING]		= "mesh_node_start_unprov_beaconing",
+	[HOST_CMD_MESH_FRIEND_INIT]						= "mesh_friend_init",
+	[HOST_CMD_MESH_LPN_ESTABLISH_FRIENDSHIP]		= "mesh_lpn_establish_friendship",
+	[HOST_CMD_MESH_GENERIC_SERVER_INIT]				= "mesh_generic_server_init",
+	[HOST_CMD_MESH_GENERIC_SERVER_RESPONSE]			= "mesh_generic_server_response",
+	[HOST_CMD_MESH_GENERIC_SERVER_UPDATE]			= "mesh_generic_server_update",
+	[HOST_CMD_MESH_GENERIC_SERVER_PUBLISH]			= "mesh_generic_server_publish",
+	[HOST_CMD_MESH_GENERIC_CLIENT_GET]				= "mesh_generic_client_get",
+	[HOST_CMD_MESH_GENERIC_CLIENT_SET]				= "mesh_generic_client_set",
+	[HOST_CMD_MESH_GENERIC_CLIENT_PUBLISH]			= "mesh_generic_client_publish",
+};
+
+static const struct
+{
+	uint32_t id;
+	const char *name;
+} evt_classes[HOST_EVT_COUNT] =
+{
+	[HOST_EVT_SYSTEM_BOOT]							= { gecko_evt_system_boot_id, "system_boot" },
+	[HOST_EVT_SYSTEM_EXTERNAL_SIGNAL]				= { gecko_evt_system_external_signal_id, "system_external_signal" },
+	[HOST_EVT_HARDWARE_SOFT_TIMER]					= { gecko_evt_hardware_soft_timer_id, "hardware_soft_timer" },
+	[HOST_EVT_LE_CONNECTION_OPENED]					= { gecko_evt_le_connection_opened_id, "le_connection_opened" },
+	[HOST_EVT_LE_CONNECTION_CLOSED]					= { gecko_evt_le_connection_closed_id, "le_connection_closed" },
+	[HOST_EVT_MESH_NODE_INITIALIZED]				= { gecko_evt_mesh_node_initialized_id, "mesh_node_initialized" },
+	[HOST_EVT_MESH_NODE_PROVISIONED]				= { gecko_evt_mesh_node_provisioned_id, "mesh_node_provisioned" },
+	[HOST_EVT_MESH_NODE_RESET]						= { gecko_evt_mesh_node_reset_id, "mesh_node_reset" },
+	[HOST_EVT_MESH_GENERIC_SERVER_CLIENT_REQUEST]	= { gecko_evt_mesh_generic_server_client_request_id, "mesh_generic_server_client_request" },
+	[HOST_EVT_MESH_FRIEND_FRIENDSHIP_ESTABLISHED]	= { gecko_evt_mesh_friend_friendship_established_id, "mesh_friend_friendship_established" },
+	[HOST_EVT_MESH_FRIEND_FRIENDSHIP_TERMINATED]	= { gecko_evt_mesh_friend_friendship_terminated_id, "mesh_friend_friendship_terminated" },
+};
+
+static struct
+{
+	bool active;
+	uint8_t handle;
+	bool single_shot;
+	uint32_t interval;
+	uint64_t expiry;
+} soft_timers[HOST_SOFT_TIMER_MAX];
+
+static struct
+{
+	bool used;
+	uint16_t key;
+	uint8_t len;
+	uint8_t data[HOST_PS_VALUE_MAX];
+} ps_store[HOST_PS_KEY_MAX];
+
+static uint32_t pending_signals;
+
+static const host_trace_t *replay_trace;
+static size_t replay_cursor;
+static jmp_buf replay_done;
+
+static host_gecko_latency_hook_t latency_hook;
+static int latency_evt = -1;
+static uint64_t latency_start_ns;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static inline struct gecko_cmd_packet *host_cmd(void)
+{
+	return &cmd_packet;
+}
+
+static inline struct gecko_cmd_packet *host_rsp(void)
+{
+	return &rsp_packet;
+}
+
+/**
+ * @brief Reset stack state: timers, signals, PS store and statistics.
+ *
+ * @param void
+ * @return void.
+ */
+void host_gecko_reset(void)
+{
+	memset(&host_gecko_stats, 0, sizeof(host_gecko_stats));
+	memset(soft_timers, 0, sizeof(soft_timers));
+	memset(ps_store, 0, sizeof(ps_store));
+	pending_signals = 0;
+	replay_trace = NULL;
+	replay_cursor = 0;
+	latency_evt = -1;
+}
+
+const char *host_gecko_cmd_name(host_gecko_cmd_t cmd)
+{
+	return (cmd < HOST_CMD_COUNT) ? cmd_names[cmd] : "unknown";
+}
+
+const char *host_gecko_evt_name(host_gecko_evt_t evt)
+{
+	return (evt < HOST_EVT_COUNT) ? evt_classes[evt].name : "unknown";
+}
+
+void host_gecko_set_latency_hook(host_gecko_latency_hook_t hook)
+{
+	latency_hook = hook;
+}
+
+static uint64_t host_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Close the handling interval of the previously delivered event.
+ *
+ * @param void
+ * @return void.
+ */
+static void host_latency_stop(void)
+{
+	if(latency_hook && latency_evt >= 0)
+	{
+		latency_hook((host_gecko_evt_t) latency_evt, host_now_ns() - latency_start_ns);
+	}
+	latency_evt = -1;
+}
+
+/**
+ * @brief Count an event about to be returned and open its handling interval.
+ *
+ * @param const struct gecko_cmd_packet *evt
+ * @return void.
+ */
+static void host_latency_start(const struct gecko_cmd_packet *evt)
+{
+	uint32_t id = BGLIB_MSG_ID(evt->header);
+
+	for(int i = 0; i < HOST_EVT_COUNT; i++)
+	{
+		if(evt_classes[i].id == id)
+		{
+			host_gecko_stats.event[i]++;
+			latency_evt = i;
+			break;
+		}
+	}
+
+	if(latency_hook)
+	{
+		latency_start_ns = host_now_ns();
+	}
+}
+
+/**
+ * @brief Copy a persistent store value out for inspection by the harness.
+ *
+ * @param uint16_t key, uint8_t *data, uint8_t max_len
+ * @return int Stored length, or -1 if the key is absent.
+ */
+int host_gecko_ps_get(uint16_t key, uint8_t *data, uint8_t max_len)
+{
+	for(int i = 0; i < HOST_PS_KEY_MAX; i++)
+	{
+		if(ps_store[i].used && ps_store[i].key == key)
+		{
+			memcpy(data, ps_store[i].data, SL_MIN(max_len, ps_store[i].len));
+			return ps_store[i].len;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Run the firmware entry point against a trace until it is consumed.
+ *
+ * The firmware main loop never returns, so gecko_wait_event() unwinds back
+ * here with longjmp() once the last record has been delivered.
+ *
+ * @param int (*entry)(void), const host_trace_t *trace
+ * @return void.
+ */
+void host_gecko_run(int (*entry)(void), const host_trace_t *trace)
+{
+	replay_trace = trace;
+	replay_cursor = 0;
+
+	if(setjmp(replay_done) == 0)
+	{
+		entry();
+	}
+
+	replay_trace = NULL;
+}
+
+/**
+ * @brief Index of the soft timer that expires first, or -1.
+ *
+ * @param void
+ * @return int.
+ */
+static int host_soft_timer_next(void)
+{
+	int next = -1;
+
+	for(int i = 0; i < HOST_SOFT_TIMER_MAX; i++)
+	{
+		if(soft_timers[i].active && (next < 0 || soft_timers[i].expiry < soft_timers[next].expiry))
+		{
+			next = i;
+		}
+	}
+	return next;
+}
+
+/**
+ * @brief Build a stack event from a trace record.
+ *
+ * @param const host_trace_record_t *record, struct gecko_cmd_packet *evt
+ * @return void.
+ */
+static void host_trace_event(const host_trace_record_t *record, struct gecko_cmd_packet *evt)
+{
+	switch(record->kind)
+	{
+		case HOST_TRACE_BOOT:
+		{
+			struct gecko_msg_system_boot_evt_t *boot = &evt->data.evt_system_boot;
+
+			memset(boot, 0, sizeof(*boot));
+			boot->major = 2;
+			boot->minor = 13;
+			evt->header = HOST_EVT_HEADER(gecko_evt_system_boot_id, sizeof(*boot));
+			break;
+		}
+		case HOST_TRACE_NODE_INIT:
+		{
+			struct gecko_msg_mesh_node_initialized_evt_t *init = &evt->data.evt_mesh_node_initialized;
+
+			init->provisioned = (uint8_t) record->arg0;
+			init->address = (uint16_t) (record->arg1 ? record->arg1 : HOST_FRIEND_ADDR);
+			init->ivi = 0;
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_node_initialized_id, sizeof(*init));
+			break;
+		}
+		case HOST_TRACE_PROVISIONED:
+		{
+			struct gecko_msg_mesh_node_provisioned_evt_t *prov = &evt->data.evt_mesh_node_provisioned;
+
+			prov->iv_index = 0;
+			prov->address = (uint16_t) (record->arg0 ? record->arg0 : HOST_FRIEND_ADDR);
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_node_provisioned_id, sizeof(*prov));
+			break;
+		}
+		case HOST_TRACE_NODE_RESET:
+		{
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_node_reset_id, 0);
+			break;
+		}
+		case HOST_TRACE_CONN_OPEN:
+		{
+			struct gecko_msg_le_connection_opened_evt_t *open = &evt->data.evt_le_connection_opened;
+
+			memset(open, 0, sizeof(*open));
+			open->connection = (uint8_t) record->arg0;
+			open->bonding = 0xFF;
+			evt->header = HOST_EVT_HEADER(gecko_evt_le_connection_opened_id, sizeof(*open));
+			break;
+		}
+		case HOST_TRACE_CONN_CLOSE:
+		{
+			struct gecko_msg_le_connection_closed_evt_t *close = &evt->data.evt_le_connection_closed;
+
+			close->connection = (uint8_t) record->arg0;
+			close->reason = (uint16_t) record->arg1;
+			evt->header = HOST_EVT_HEADER(gecko_evt_le_connection_closed_id, sizeof(*close));
+			break;
+		}
+		case HOST_TRACE_LEVEL:
+		{
+			struct gecko_msg_mesh_generic_server_client_request_evt_t *req = &evt->data.evt_mesh_generic_server_client_request;
+			int16_t level = (int16_t) record->arg1;
+
+			req->model_id = HOST_GENERIC_SERVER_MODEL;
+			req->elem_index = 0;
+			req->client_address = (uint16_t) record->arg0;
+			req->server_address = HOST_FRIEND_ADDR;
+			req->appkey_index = 0;
+			req->transition = 0;
+			req->delay = 0;
+			req->flags = 0;
+			req->type = mesh_generic_request_level;
+			req->parameters.len = 2;
+			req->parameters.data[0] = (uint8_t) level;
+			req->parameters.data[1] = (uint8_t) ((uint16_t) level >> 8);
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_generic_server_client_request_id, sizeof(*req) + 2);
+			break;
+		}
+		case HOST_TRACE_FRIEND_EST:
+		{
+			evt->data.evt_mesh_friend_friendship_established.lpn_address = (uint16_t) record->arg0;
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_friend_friendship_established_id,
+										  sizeof(evt->data.evt_mesh_friend_friendship_established));
+			break;
+		}
+		case HOST_TRACE_FRIEND_TERM:
+		{
+			evt->data.evt_mesh_friend_friendship_terminated.reason = (uint16_t) record->arg0;
+			evt->header = HOST_EVT_HEADER(gecko_evt_mesh_friend_friendship_terminated_id,
+										  sizeof(evt->data.evt_mesh_friend_friendship_terminated));
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Idle the stack until ticks, as its scheduler does on the target.
+ *
+ * Goes through SLEEP_Sleep() so that the SLEEP driver callbacks and sleep
+ * blocks behave as on the device. If the driver does not enter a sleep
+ * mode, the core spins in EM0 until the same deadline.
+ *
+ * @param uint64_t ticks
+ * @return void.
+ */
+static void host_sleep_until(uint64_t ticks)
+{
+	host_gecko_stats.sleeps++;
+	host_sim_sleep_until(ticks);
+
+	if(SLEEP_Sleep() == sleepEM0)
+	{
+		host_sim_idle();
+	}
+}
+
+/**
+ * @brief Block until the next event, advancing virtual time as needed.
+ *
+ * Pending external signals are reported first, as the real stack does.
+ * Otherwise the earlier of the next soft timer expiry and the next trace
+ * record wins, and the core sleeps until it is due. Device records are
+ * injected as IRQs and do not produce an event by themselves; the firmware
+ * handlers signal the stack instead.
+ *
+ * @param void
+ * @return struct gecko_cmd_packet *.
+ */
+struct gecko_cmd_packet *gecko_wait_event(void)
+{
+	struct gecko_cmd_packet *evt = &evt_packet;
+
+	host_latency_stop();
+
+	for(;;)
+	{
+		if(pending_signals)
+		{
+			evt->data.evt_system_external_signal.extsignals = pending_signals;
+			evt->header = HOST_EVT_HEADER(gecko_evt_system_external_signal_id,
+										  sizeof(evt->data.evt_system_external_signal));
+			pending_signals = 0;
+			host_gecko_stats.external_signal_events++;
+			break;
+		}
+
+		if(!replay_trace || replay_cursor >= replay_trace->count)
+		{
+			longjmp(replay_done, 1);
+		}
+
+		const host_trace_record_t *record = &replay_trace->records[replay_cursor];
+		uint64_t record_ticks = HOST_MS_TO_TICKS(record->time_ms);
+		int timer = host_soft_timer_next();
+		uint64_t next = record_ticks;
+
+		if(timer >= 0 && soft_timers[timer].expiry < next)
+			next = soft_timers[timer].expiry;
+
+		/* Nothing due yet: sleep until the next deadline or a peripheral
+		 * interrupt, which may signal the stack. */
+		if(next > host_clock_now())
+		{
+			host_sleep_until(next);
+			continue;
+		}
+
+		/* Peripheral events due at the same tick run first. */
+		if(host_sim_next_event() <= next)
+		{
+			host_sim_advance_to(next);
+			continue;
+		}
+
+		if(timer >= 0 && soft_timers[timer].expiry <= record_ticks)
+		{
+			evt->data.evt_hardware_soft_timer.handle = soft_timers[timer].handle;
+			evt->header = HOST_EVT_HEADER(gecko_evt_hardware_soft_timer_id,
+										  sizeof(evt->data.evt_hardware_soft_timer));
+
+			if(soft_timers[timer].single_shot)
+				soft_timers[timer].active = false;
+			else
+				soft_timers[timer].expiry += soft_timers[timer].interval;
+
+			host_gecko_stats.soft_timer_events++;
+			break;
+		}
+
+		replay_cursor++;
+
+		if(host_trace_is_device(record->kind))
+		{
+			host_gecko_stats.device_records++;
+			host_trace_inject(record);
+			continue;
+		}
+
+		host_trace_event(record, evt);
+		host_gecko_stats.trace_events++;
+		break;
+	}
+
+	host_gecko_stats.events++;
+	host_latency_start(evt);
+	return evt;
+}
+
+/**
+ * @brief True if gecko_wait_event() would return without sleeping.
+ *
+ * @param void
+ * @return int.
+ */
+int gecko_event_pending(void)
+{
+	int timer = host_soft_timer_next();
+
+	if(pending_signals)
+		return 1;
+	if(timer >= 0 && soft_timers[timer].expiry <= host_clock_now())
+		return 1;
+	if(replay_trace && replay_cursor < replay_trace->count
+		&& HOST_MS_TO_TICKS(replay_trace->records[replay_cursor].time_ms) <= host_clock_now())
+		return 1;
+	return 0;
+}
+
+void gecko_external_signal(uint32 signals)
+{
+	pending_signals |= signals;
+}
+
+/**
+ * @brief The mesh stack hook sits in the binary library; every event is
+ * passed on to the application here.
+ *
+ * @param struct gecko_cmd_packet *evt
+ * @return bool.
+ */
+bool mesh_bgapi_listener(struct gecko_cmd_packet *evt)
+{
+	(void) evt;
+	return true;
+}
+
+/**
+ * @brief The stack keeps its persistent store in the default NVM3 instance
+ * and opens it here.
+ *
+ * @param const gecko_configuration_t *config
+ * @return errorcode_t.
+ */
+errorcode_t gecko_stack_init(const gecko_configuration_t *config)
+{
+	(void) config;
+	nvm3_open(nvm3_defaultHandle, nvm3_defaultInit);
+	return bg_err_success;
+}
+
+void gecko_bgapi_class_dfu_init() { }
+void gecko_bgapi_class_system_init() { }
+void gecko_bgapi_class_le_gap_init() { }
+void gecko_bgapi_class_le_connection_init() { }
+void gecko_bgapi_class_gatt_server_init() { }
+void gecko_bgapi_class_hardware_init() { }
+void gecko_bgapi_class_flash_init() { }
+void gecko_bgapi_class_test_init() { }
+void gecko_bgapi_class_mesh_node_init() { }
+void gecko_bgapi_class_mesh_proxy_init() { }
+void gecko_bgapi_class_mesh_proxy_server_init() { }
+void gecko_bgapi_class_mesh_generic_server_init() { }
+void gecko_bgapi_class_mesh_friend_init() { }
+
+/**
+ * @brief Entry point of every BGAPI command issued through native_gecko.h.
+ *
+ * @param uint32_t header, gecko_cmd_handler handler, const void *payload
+ * @return void.
+ */
+void sli_bt_cmd_handler_delegate(uint32_t header, gecko_cmd_handler handler, const void *payload)
+{
+	(void) header;
+	host_gecko_stats.commands++;
+	handler(payload);
+}
+
+void sli_bt_cmd_system_reset(const void *payload)
+{
+	(void) payload;
+	host_gecko_stats.command[HOST_CMD_SYSTEM_RESET]++;
+
+	/* The stack forgets its timers and signals across a reset. */
+	memset(soft_timers, 0, sizeof(soft_timers));
+	pending_signals = 0;
+}
+
+void sli_bt_cmd_system_get_bt_address(const void *payload)
+{
+	static const uint8_t address[6] = { 0x5A, 0x23, 0x58, 0x57, 0x0B, 0x00 };
+
+	(void) payload;
+	host_gecko_stats.command[HOST_CMD_SYSTEM_GET_BT_ADDRESS]++;
+	memcpy(host_rsp()->data.rsp_system_get_bt_address.address.addr, address, sizeof(address));
+}
+
+void sli_bt_cmd_hardware_set_soft_timer(const void *payload)
+{
+	const struct gecko_msg_hardware_set_soft_timer_cmd_t *cmd = payload;
+	int slot = -1;
+
+	host_gecko_stats.command[HOST_CMD_HARDWARE_SET_SOFT_TIMER]++;
+
+	for(int i = 0; i < HOST_SOFT_TIMER_MAX; i++)
+	{
+		if(soft_timers[i].active && soft_timers[i].handle == cmd->handle)
+		{
+			slot = i;
+			break;
+		}
+		if(!soft_timers[i].active && slot < 0)
+		{
+			slot = i;
+		}
+	}
+
+	if(cmd->time == 0)
+	{
+		if(slot >= 0 && soft_timers[slot].handle == cmd->handle)
+		{
+			soft_timers[slot].active = false;
+		}
+		host_rsp()->data.rsp_hardware_set_soft_timer.result = bg_err_success;
+		return;
+	}
+
+	if(slot < 0)
+	{
+		host_rsp()->data.rsp_hardware_set_soft_timer.result = bg_err_out_of_memory;
+		return;
+	}
+
+	soft_timers[slot].active = true;
+	soft_timers[slot].handle = cmd->handle;
+	soft_timers[slot].single_shot = cmd->single_shot;
+	soft_timers[slot].interval = cmd->time;
+	soft_timers[slot].expiry = host_clock_now() + cmd->time;
+	host_rsp()->data.rsp_hardware_set_soft_timer.result = bg_err_success;
+}
+
+void sli_bt_cmd_flash_ps_save(const void *payload)
+{
+	const struct gecko_msg_flash_ps_save_cmd_t *cmd = payload;
+	int slot = -1;
+
+	host_gecko_stats.command[HOST_CMD_FLASH_PS_SAVE]++;
+	host_gecko_stats.ps_bytes_written += cmd->value.len;
+
+	if(cmd->value.len > HOST_PS_VALUE_MAX)
+	{
+		host_rsp()->data.rsp_flash_ps_save.result = bg_err_invalid_param;
+		return;
+	}
+
+	for(int i = 0; i < HOST_PS_KEY_MAX; i++)
+	{
+		if(ps_store[i].used && ps_store[i].key == cmd->key)
+		{
+			slot = i;
+			break;
+		}
+		if(!ps_store[i].used && slot < 0)
+		{
+			slot = i;
+		}
+	}
+
+	if(slot < 0)
+	{
+		host_rsp()->data.rsp_flash_ps_save.result = bg_err_hardware_ps_store_full;
+		return;
+	}
+
+	ps_store[slot].used = true;
+	ps_store[slot].key = cmd->key;
+	ps_store[slot].len = cmd->value.len;
+	memcpy(ps_store[slot].data, cmd->value.data, cmd->value.len);
+	host_rsp()->data.rsp_flash_ps_save.result = bg_err_success;
+}
+
+void sli_bt_cmd_flash_ps_load(const void *payload)
+{
+	const struct gecko_msg_flash_ps_load_cmd_t *cmd = payload;
+	struct gecko_msg_flash_ps_load_rsp_t *rsp = &host_rsp()->data.rsp_flash_ps_load;
+	int len;
+
+	host_gecko_stats.command[HOST_CMD_FLASH_PS_LOAD]++;
+
+	len = host_gecko_ps_get(cmd->key, rsp->value.data, HOST_PS_VALUE_MAX);
+	if(len < 0)
+	{
+		rsp->result = bg_err_hardware_ps_key_not_found;
+		rsp->value.len = 0;
+		return;
+	}
+
+	rsp->result = bg_err_success;
+	rsp->value.len = (uint8_t) len;
+}
+
+void sli_bt_cmd_flash_ps_erase_all(const void *payload)
+{
+	(void) payload;
+	host_gecko_stats.command[HOST_CMD_FLASH_PS_ERASE_ALL]++;
+	memset(ps_store, 0, sizeof(ps_store));
+	host_rsp()->data.rsp_flash_ps_erase_all.result = bg_err_success;
+}
+
+HOST_CMD_RESULT_ONLY(gatt_server_write_attribute_value, HOST_CMD_GATT_SERVER_WRITE_ATTRIBUTE_VALUE)
+HOST_CMD_RESULT_ONLY(gatt_server_send_user_write_response, HOST_CMD_GATT_SERVER_SEND_USER_WRITE_RESPONSE)
+HOST_CMD_RESULT_ONLY(le_connection_close, HOST_CMD_LE_CONNECTION_CLOSE)
+HOST_CMD_RESULT_ONLY(mesh_node_init, HOST_CMD_MESH_NODE_INIT)
+HOST_CMD_RESULT_ONLY(mesh_node_start_unprov_beaconing, HOST_CMD_MESH_NODE_START_UNPROV_BEACONING)
+HOST_CMD_RESULT_ONLY(mesh_friend_init, HOST_CMD_MESH_FRIEND_INIT)
+HOST_CMD_RESULT_ONLY(mesh_lpn_establish_friendship, HOST_CMD_MESH_LPN_ESTABLISH_FRIENDSHIP)
+HOST_CMD_RESULT_ONLY(mesh_generic_server_init, HOST_CMD_MESH_GENERIC_SERVER_INIT)
+HOST_CMD_RESULT_ONLY(mesh_generic_server_response, HOST_CMD_MESH_GENERIC_SERVER_RESPONSE)
+HOST_CMD_RESULT_ONLY(mesh_generic_server_update, HOST_CMD_MESH_GENERIC_SERVER_UPDATE)
+HOST_CMD_RESULT_ONLY(mesh_generic_server_publish, HOST_CMD_MESH_GENERIC_SERVER_PUBLISH)
+HOST_CMD_RESULT_ONLY(mesh_generic_client_get, HOST_CMD_MESH_GENERIC_CLIENT_GET)
+HOST_CMD_RESULT_ONLY(mesh_generic_client_set, HOST_CMD_MESH_GENERIC_CLIENT_SET)
+HOST_CMD_RESULT_ONLY(mesh_generic_client_publish, HOST_CMD_MESH_GENERIC_CLIENT_PUBLISH)
@@ -0,0 +1,625 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_i2c.c
+ *
+ * @brief Host model of the I2C0 bus, the I2CSPM init, an MCP9808 and any
+ * number of generic register file devices.
+ *
+ * A transfer started with I2C_TransferInit() occupies the bus for its
+ * bit time at the configured bus clock (start, 9 bits per byte including
+ * the address, repeated start, stop) plus the slave latency. It then
+ * completes in virtual time and raises I2C0_IRQn. A NACKed address or a
+ * bus error ends the transfer after the address byte.
+ *
+ * The MCP9808 ALERT output follows T_UPPER, T_LOWER and T_CRIT in
+ * comparator or interrupt mode, with the configured hysteresis and
+ * polarity, and drives its GPIO pin (open drain on the expansion header)
+ * through host_gpio_drive(). The part re-evaluates it at the end of each
+ * conversion, up to 250 ms after a change; the model does so at once, on
+ * every Ta change and limit or configuration write.
+ *
+ * A generic device has sixteen 16 bit registers, selected by the low
+ * nibble of the first byte written; two more bytes write the register
+ * (MSB first) and reads return registers MSB first from the pointer on.
+ * Each register powers up as its address and index, (addr << 8) | index.
+ * A device given a fixed response (a command based part, with CRCs)
+ * returns those bytes on every read instead.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "host_i2c.h"
+#include "host_device.h"
+#include "host_sim.h"
+#include "i2cspm.h"
+#include "em_common.h"
+#include "em_gpio.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* MCP9808 register map (pointer values). */
+#define MCP9808_REG_CONFIG			0x01
+#define MCP9808_REG_T_UPPER			0x02
+#define MCP9808_REG_T_LOWER			0x03
+#define MCP9808_REG_T_CRIT			0x04
+#define MCP9808_REG_TA				0x05
+#define MCP9808_REG_MANUF_ID		0x06
+#define MCP9808_REG_DEVICE_ID		0x07
+#define MCP9808_REG_RESOLUTION		0x08
+#define MCP9808_REG_COUNT			0x09
+
+/* CONFIG register bits. */
+#define MCP9808_CONFIG_ALERT_INT	0x0001
+#define MCP9808_CONFIG_ALERT_HIGH	0x0002
+#define MCP9808_CONFIG_ALERT_CRIT	0x0004
+#define MCP9808_CONFIG_ALERT_EN		0x0008
+#define MCP9808_CONFIG_ALERT_STAT	0x0010
+#define MCP9808_CONFIG_INT_CLEAR	0x0020
+#define MCP9808_CONFIG_HYST_SHIFT	9
+
+/* Ta register flags and the limit resolution (0.25 C). */
+#define MCP9808_TA_CRIT				0x8000
+#define MCP9808_TA_UPPER			0x4000
+#define MCP9808_TA_LOWER			0x2000
+#define MCP9808_LIMIT_MASK			0x1FFC
+
+/* ALERT output pin, PD10 on the expansion header. */
+#define MCP9808_ALERT_PORT			gpioPortD
+#define MCP9808_ALERT_PIN			10
+
+#define HOST_I2C_DEVICE_REGS		16
+
+/* Bits on the wire: start, address + data bytes with ACK, stop. */
+#define HOST_I2C_BYTE_BITS			9
+#define HOST_I2C_FRAME_BITS			2
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_i2c_stats_t host_i2c_stats;
+
+static I2C_TransferSeq_TypeDef *active_seq;
+static I2C_TransferReturn_TypeDef active_status;
+static I2C_TransferReturn_TypeDef active_fault;	// i2cTransferDone for none
+static uint64_t active_done;
+
+static host_i2c_config_t i2c_config;
+static uint32_t i2c_bus_hz = HOST_I2C_DEFAULT_HZ;
+static uint32_t i2c_rand_state;
+
+static struct
+{
+	uint8_t pointer;
+	uint16_t reg[MCP9808_REG_COUNT];
+
+	/* Limit comparators, with hysteresis, and the ALERT output. */
+	bool upper;
+	bool lower;
+	bool crit;
+	bool int_latched;						// Interrupt mode, until INT_CLEAR
+	bool pin_low;
+} mcp9808;
+
+/* Generic devices, kept across host_i2c_reset(). */
+static struct
+{
+	host_i2c_device_config_t config;
+	uint8_t pointer;
+	uint16_t reg[HOST_I2C_DEVICE_REGS];
+} devices[HOST_I2C_DEVICES_MAX];
+static uint32_t device_count;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Encode a temperature the way the MCP9808 Ta register holds it.
+ *
+ * 13-bit two's complement in 1/16 C steps; the flag bits 15:13 stay clear.
+ *
+ * @param int32_t temp_mC
+ * @return uint16_t Register value.
+ */
+static uint16_t mcp9808_encode(int32_t temp_mC)
+{
+	int32_t sixteenths = (temp_mC * 16) / 1000;
+
+	return (uint16_t) (sixteenths & 0x1FFF);
+}
+
+/* Ta or a limit register as 1/16 C, 13 bit two's complement. */
+static int32_t mcp9808_decode(uint16_t value)
+{
+	int32_t sixteenths = value & 0x1FFF;
+
+	return (sixteenths & 0x1000) ? sixteenths - 0x2000 : sixteenths;
+}
+
+/**
+ * @brief Re-evaluate the limit comparators and drive the ALERT pin.
+ *
+ * @param void
+ * @return void.
+ */
+static void mcp9808_alert_update(void)
+{
+	static const int32_t hyst_sixteenths[] = { 0, 24, 48, 96 };	// 0, 1.5, 3 and 6 C
+	uint16_t config = mcp9808.reg[MCP9808_REG_CONFIG];
+	int32_t ta = mcp9808_decode(mcp9808.reg[MCP9808_REG_TA]);
+	int32_t t_upper = mcp9808_decode(mcp9808.reg[MCP9808_REG_T_UPPER] & MCP9808_LIMIT_MASK);
+	int32_t t_lower = mcp9808_decode(mcp9808.reg[MCP9808_REG_T_LOWER] & MCP9808_LIMIT_MASK);
+	int32_t t_crit = mcp9808_decode(mcp9808.reg[MCP9808_REG_T_CRIT] & MCP9808_LIMIT_MASK);
+	int32_t hyst = hyst_sixteenths[(config >> MCP9808_CONFIG_HYST_SHIFT) & 0x3];
+	bool upper = mcp9808.upper ? ta > t_upper - hyst : ta > t_upper;
+	bool lower = mcp9808.lower ? ta < t_lower + hyst : ta < t_lower;
+	bool asserted = false;
+	bool pin_low;
+
+	/* Interrupt mode latches every window crossing, either way. */
+	if((config & MCP9808_CONFIG_ALERT_INT) && (upper != mcp9808.upper || lower != mcp9808.lower))
+		mcp9808.int_latched = true;
+
+	mcp9808.upper = upper;
+	mcp9808.lower = lower;
+	mcp9808.crit = mcp9808.crit ? ta >= t_crit - hyst : ta >= t_crit;
+
+	if(config & MCP9808_CONFIG_ALERT_EN)
+	{
+		if(config & MCP9808_CONFIG_ALERT_CRIT)
+			asserted = mcp9808.crit;
+		else if(config & MCP9808_CONFIG_ALERT_INT)
+			asserted = mcp9808.int_latched || mcp9808.crit;
+		else
+			asserted = mcp9808.upper || mcp9808.lower || mcp9808.crit;
+	}
+
+	mcp9808.reg[MCP9808_REG_CONFIG] = (config & ~MCP9808_CONFIG_ALERT_STAT) | (asserted ? MCP9808_CONFIG_ALERT_STAT : 0);
+
+	pin_low = (config & MCP9808_CONFIG_ALERT_HIGH) ? !asserted : asserted;
+	if(pin_low != mcp9808.pin_low)
+	{
+		mcp9808.pin_low = pin_low;
+		if(asserted)
+			host_i2c_stats.alerts++;
+		host_gpio_drive(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN, !pin_low);
+	}
+}
+
+/**
+ * @brief Apply bytes written by the master to the MCP9808.
+ *
+ * @param const uint8_t *data, uint16_t len
+ * @return void.
+ */
+static void mcp9808_write(const uint8_t *data, uint16_t len)
+{
+	if(len == 0)
+	{
+		return;
+	}
+
+	mcp9808.pointer = data[0] & 0x0F;
+	if(mcp9808.pointer >= MCP9808_REG_COUNT)
+	{
+		return;
+	}
+
+	/* Ta and the identification registers are read-only. */
+	if(mcp9808.pointer >= MCP9808_REG_TA && mcp9808.pointer <= MCP9808_REG_DEVICE_ID)
+	{
+		return;
+	}
+
+	if(len >= 3)
+	{
+		uint16_t value = (uint16_t) ((data[1] << 8) | data[2]);
+
+		if(mcp9808.pointer == MCP9808_REG_CONFIG)
+		{
+			if(value & MCP9808_CONFIG_INT_CLEAR)
+				mcp9808.int_latched = false;
+			value &= ~(MCP9808_CONFIG_INT_CLEAR | MCP9808_CONFIG_ALERT_STAT);
+		}
+		mcp9808.reg[mcp9808.pointer] = value;
+		mcp9808_alert_update();
+	}
+	else if(len == 2 && mcp9808.pointer == MCP9808_REG_RESOLUTION)
+	{
+		mcp9808.reg[mcp9808.pointer] = data[1];
+	}
+}
+
+/**
+ * @brief Record a temperature sample instant for the jitter statistics.
+ *
+ * @param uint64_t now
+ * @return void.
+ */
+static void host_i2c_sample(uint64_t now)
+{
+	if(host_i2c_stats.samples)
+	{
+		uint64_t interval = now - host_i2c_stats.last_sample;
+
+		if(host_i2c_stats.samples == 1 || interval < host_i2c_stats.interval_min)
+			host_i2c_stats.interval_min = interval;
+		if(interval > host_i2c_stats.interval_max)
+			host_i2c_stats.interval_max = interval;
+		host_i2c_stats.interval_sum += (double) interval;
+		host_i2c_stats.interval_sumsq += (double) interval * (double) interval;
+	}
+	host_i2c_stats.samples++;
+	host_i2c_stats.last_sample = now;
+}
+
+/**
+ * @brief Return bytes from the register selected by the last pointer write.
+ *
+ * @param uint8_t *data, uint16_t len
+ * @return void.
+ */
+static void mcp9808_read(uint8_t *data, uint16_t len)
+{
+	uint16_t value = 0;
+
+	if(mcp9808.pointer == MCP9808_REG_TA)
+	{
+		host_i2c_sample(host_clock_now());
+	}
+
+	if(mcp9808.pointer < MCP9808_REG_COUNT)
+	{
+		value = mcp9808.reg[mcp9808.pointer];
+	}
+
+	/* Ta carries the limit flags, without hysteresis. */
+	if(mcp9808.pointer == MCP9808_REG_TA)
+	{
+		int32_t ta = mcp9808_decode(value);
+
+		if(ta >= mcp9808_decode(mcp9808.reg[MCP9808_REG_T_CRIT] & MCP9808_LIMIT_MASK))
+			value |= MCP9808_TA_CRIT;
+		if(ta > mcp9808_decode(mcp9808.reg[MCP9808_REG_T_UPPER] & MCP9808_LIMIT_MASK))
+			value |= MCP9808_TA_UPPER;
+		if(ta < mcp9808_decode(mcp9808.reg[MCP9808_REG_T_LOWER] & MCP9808_LIMIT_MASK))
+			value |= MCP9808_TA_LOWER;
+	}
+
+	if(len == 1)
+	{
+		data[0] = (uint8_t) value;
+		return;
+	}
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		data[i] = (i == 0) ? (uint8_t) (value >> 8) : (uint8_t) value;
+	}
+}
+
+/* Index of the generic device at a 7 bit address, -1 if none is attached. */
+static int32_t host_i2c_device_find(uint8_t addr)
+{
+	for(uint32_t i = 0; i < device_count; i++)
+	{
+		if(devices[i].config.addr == addr)
+			return (int32_t) i;
+	}
+	return -1;
+}
+
+static void host_i2c_device_write(uint32_t index, const uint8_t *data, uint16_t len)
+{
+	if(len == 0)
+	{
+		return;
+	}
+
+	devices[index].pointer = data[0] & (HOST_I2C_DEVICE_REGS - 1);
+	if(len >= 3)
+	{
+		devices[index].reg[devices[index].pointer] = (uint16_t) ((data[1] << 8) | data[2]);
+	}
+}
+
+static void host_i2c_device_read(uint32_t index, uint8_t *data, uint16_t len)
+{
+	const host_i2c_device_config_t *config = &devices[index].config;
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		uint16_t value = devices[index].reg[(devices[index].pointer + i / 2) & (HOST_I2C_DEVICE_REGS - 1)];
+
+		if(config->response_len)
+			data[i] = config->response[i % config->response_len];
+		else
+			data[i] = (i & 1) ? (uint8_t) value : (uint8_t) (value >> 8);
+	}
+}
+
+static void host_i2c_slave_write(int32_t device, const uint8_t *data, uint16_t len)
+{
+	if(device < 0)
+		mcp9808_write(data, len);
+	else
+		host_i2c_device_write((uint32_t) device, data, len);
+}
+
+static void host_i2c_slave_read(int32_t device, uint8_t *data, uint16_t len)
+{
+	if(device < 0)
+		mcp9808_read(data, len);
+	else
+		host_i2c_device_read((uint32_t) device, data, len);
+}
+
+/**
+ * @brief Execute a latched sequence against the bus in one go.
+ *
+ * @param I2C_TransferSeq_TypeDef *seq
+ * @return I2C_TransferReturn_TypeDef.
+ */
+static I2C_TransferReturn_TypeDef host_i2c_execute(I2C_TransferSeq_TypeDef *seq)
+{
+	uint8_t addr = (uint8_t) (seq->addr >> 1);
+	int32_t device = host_i2c_device_find(addr);
+
+	if(active_fault == i2cTransferBusErr)
+	{
+		host_i2c_stats.bus_errors++;
+		return i2cTransferBusErr;
+	}
+	if(active_fault == i2cTransferNack || (device < 0 && addr != HOST_MCP9808_ADDR))
+	{
+		host_i2c_stats.nacks++;
+		return i2cTransferNack;
+	}
+
+	if(seq->flags & I2C_FLAG_READ)
+	{
+		host_i2c_slave_read(device, seq->buf[0].data, seq->buf[0].len);
+		host_i2c_stats.bytes_read += seq->buf[0].len;
+	}
+	else if(seq->flags & I2C_FLAG_WRITE)
+	{
+		host_i2c_slave_write(device, seq->buf[0].data, seq->buf[0].len);
+		host_i2c_stats.bytes_written += seq->buf[0].len;
+	}
+	else if(seq->flags & I2C_FLAG_WRITE_READ)
+	{
+		host_i2c_slave_write(device, seq->buf[0].data, seq->buf[0].len);
+		host_i2c_slave_read(device, seq->buf[1].data, seq->buf[1].len);
+		host_i2c_stats.bytes_written += seq->buf[0].len;
+		host_i2c_stats.bytes_read += seq->buf[1].len;
+	}
+	else if(seq->flags & I2C_FLAG_WRITE_WRITE)
+	{
+		uint8_t joined[8];
+		uint16_t len0 = SL_MIN(seq->buf[0].len, sizeof(joined));
+		uint16_t len1 = SL_MIN(seq->buf[1].len, sizeof(joined) - len0);
+
+		memcpy(joined, seq->buf[0].data, len0);
+		memcpy(&joined[len0], seq->buf[1].data, len1);
+		host_i2c_slave_write(device, joined, len0 + len1);
+		host_i2c_stats.bytes_written += seq->buf[0].len + seq->buf[1].len;
+	}
+	else
+	{
+		return i2cTransferUsageFault;
+	}
+
+	host_i2c_stats.completed++;
+	return i2cTransferDone;
+}
+
+/* xorshift32; NACKs and bus errors are reproducible for a given seed. */
+static uint32_t host_i2c_rand(void)
+{
+	i2c_rand_state ^= i2c_rand_state << 13;
+	i2c_rand_state ^= i2c_rand_state >> 17;
+	i2c_rand_state ^= i2c_rand_state << 5;
+	return i2c_rand_state;
+}
+
+/**
+ * @brief Bus time of a sequence in virtual ticks, rounded up.
+ *
+ * @param const I2C_TransferSeq_TypeDef *seq, bool fault, uint32_t latency_us
+ * @return uint64_t.
+ */
+static uint64_t host_i2c_bus_ticks(const I2C_TransferSeq_TypeDef *seq, bool fault, uint32_t latency_us)
+{
+	uint64_t bits = HOST_I2C_FRAME_BITS + HOST_I2C_BYTE_BITS;
+
+	if(!fault)
+	{
+		bits += (uint64_t) seq->buf[0].len * HOST_I2C_BYTE_BITS;
+		if(seq->flags & (I2C_FLAG_WRITE_READ | I2C_FLAG_WRITE_WRITE))
+		{
+			/* Repeated start and address for WRITE_READ; WRITE_WRITE just streams. */
+			if(seq->flags & I2C_FLAG_WRITE_READ)
+				bits += 1 + HOST_I2C_BYTE_BITS;
+			bits += (uint64_t) seq->buf[1].len * HOST_I2C_BYTE_BITS;
+		}
+	}
+
+	return ((bits * HOST_CLOCK_HZ) + i2c_bus_hz - 1) / i2c_bus_hz
+		   + (((uint64_t) latency_us * HOST_CLOCK_HZ) + 999999) / 1000000;
+}
+
+/**
+ * @brief Reset the bus, the MCP9808 (25 C) and the attached devices to
+ * power-on defaults; the devices stay attached.
+ *
+ * @param void
+ * @return void.
+ */
+void host_i2c_reset(void)
+{
+	memset(&host_i2c_stats, 0, sizeof(host_i2c_stats));
+	memset(&mcp9808, 0, sizeof(mcp9808));
+
+	for(uint32_t i = 0; i < device_count; i++)
+	{
+		devices[i].pointer = 0;
+		for(uint32_t reg = 0; reg < HOST_I2C_DEVICE_REGS; reg++)
+			devices[i].reg[reg] = (uint16_t) ((devices[i].config.addr << 8) | reg);
+	}
+
+	active_seq = NULL;
+	active_status = i2cTransferDone;
+	active_fault = i2cTransferDone;
+	active_done = HOST_SIM_NEVER;
+	i2c_bus_hz = HOST_I2C_DEFAULT_HZ;
+	i2c_rand_state = i2c_config.seed ? i2c_config.seed : 1;
+
+	mcp9808.reg[MCP9808_REG_TA] = mcp9808_encode(25000);
+	mcp9808.reg[MCP9808_REG_MANUF_ID] = 0x0054;
+	mcp9808.reg[MCP9808_REG_DEVICE_ID] = 0x0400;
+	mcp9808.reg[MCP9808_REG_RESOLUTION] = 0x03;
+}
+
+/**
+ * @brief Set the slave behaviour; takes effect at the next host_i2c_reset().
+ *
+ * @param const host_i2c_config_t *config
+ * @return void.
+ */
+void host_i2c_configure(const host_i2c_config_t *config)
+{
+	i2c_config = *config;
+}
+
+/**
+ * @brief Put a generic device on the bus; takes effect at the next
+ * host_i2c_reset().
+ *
+ * @param const host_i2c_device_config_t *config
+ * @return bool False if the table is full or the address is taken.
+ */
+bool host_i2c_attach(const host_i2c_device_config_t *config)
+{
+	if(device_count >= HOST_I2C_DEVICES_MAX || config->addr == HOST_MCP9808_ADDR
+	   || host_i2c_device_find(config->addr) >= 0)
+	{
+		return false;
+	}
+
+	memset(&devices[device_count], 0, sizeof(devices[device_count]));
+	devices[device_count].config = *config;
+	device_count++;
+	return true;
+}
+
+void host_i2c_detach_all(void)
+{
+	device_count = 0;
+}
+
+bool host_i2c_busy(void)
+{
+	return active_seq != NULL && active_status == i2cTransferInProgress;
+}
+
+static void host_i2c_sync(uint64_t now)
+{
+	(void) now;
+}
+
+static uint64_t host_i2c_next_event(void)
+{
+	return active_done;
+}
+
+/**
+ * @brief Finish the in-flight transfer and raise I2C0_IRQn.
+ *
+ * @param uint64_t now
+ * @return void.
+ */
+static void host_i2c_fire(uint64_t now)
+{
+	(void) now;
+
+	active_done = HOST_SIM_NEVER;
+	active_status = host_i2c_execute(active_seq);
+	host_irq_raise(I2C0_IRQn);
+}
+
+const host_sim_model_t host_i2c_model =
+{
+	.name = "I2C0",
+	.reset = host_i2c_reset,
+	.sync = host_i2c_sync,
+	.next_event = host_i2c_next_event,
+	.fire = host_i2c_fire,
+};
+
+void host_mcp9808_set_temp_mC(int32_t temp_mC)
+{
+	mcp9808.reg[MCP9808_REG_TA] = mcp9808_encode(temp_mC);
+	mcp9808_alert_update();
+}
+
+void I2CSPM_Init(I2CSPM_Init_TypeDef *init)
+{
+	i2c_bus_hz = init->i2cMaxFreq ? init->i2cMaxFreq : HOST_I2C_DEFAULT_HZ;
+}
+
+I2C_TransferReturn_TypeDef I2C_TransferInit(I2C_TypeDef *i2c, I2C_TransferSeq_TypeDef *seq)
+{
+	(void) i2c;
+
+	if(!seq || !seq->buf[0].data || !seq->buf[0].len)
+	{
+		return i2cTransferUsageFault;
+	}
+
+	int32_t device = host_i2c_device_find((uint8_t) (seq->addr >> 1));
+	uint32_t latency_us = i2c_config.latency_us;
+	uint16_t nack_permille = i2c_config.nack_permille;
+	uint16_t bus_error_permille = 0;
+
+	if(device >= 0)
+	{
+		latency_us = devices[device].config.latency_us;
+		nack_permille = devices[device].config.nack_permille;
+		bus_error_permille = devices[device].config.bus_error_permille;
+	}
+
+	active_seq = seq;
+	active_status = i2cTransferInProgress;
+	active_fault = i2cTransferDone;
+	if(nack_permille && (host_i2c_rand() % 1000) < nack_permille)
+		active_fault = i2cTransferNack;
+	else if(bus_error_permille && (host_i2c_rand() % 1000) < bus_error_permille)
+		active_fault = i2cTransferBusErr;
+	active_done = host_clock_now() + host_i2c_bus_ticks(seq, active_fault != i2cTransferDone, latency_us);
+	host_i2c_stats.transfers++;
+	host_i2c_stats.busy_ticks += active_done - host_clock_now();
+	return i2cTransferInProgress;
+}
+
+I2C_TransferReturn_TypeDef I2C_Transfer(I2C_TypeDef *i2c)
+{
+	(void) i2c;
+
+	if(active_status != i2cTransferInProgress)
+	{
+		active_seq = NULL;
+	}
+	return active_status;
+}
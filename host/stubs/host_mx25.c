@@ -0,0 +1,205 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_mx25.c
+ *
+ * @brief Host model of the MX25R8035F SPI NOR flash, implementing the
+ * mx25flash_spi.h calls the firmware makes.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "mx25flash_spi.h"
+#include "host_mx25.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define HOST_MX25_SECTORS		(FlashSize / Sector_Offset)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_mx25_stats_t host_mx25_stats;
+
+static uint8_t host_mx25_array[FlashSize];
+static uint32_t host_mx25_wear[HOST_MX25_SECTORS];
+static int host_mx25_asleep;
+static int host_mx25_powered;					// Array set up, the chip ships blank
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief A blank chip, awake.
+ *
+ * @param void
+ * @return void.
+ */
+void host_mx25_reset(void)
+{
+	memset(host_mx25_array, 0xFF, sizeof(host_mx25_array));
+	memset(host_mx25_wear, 0, sizeof(host_mx25_wear));
+	host_mx25_asleep = 0;
+	host_mx25_powered = 1;
+	host_mx25_clear_stats();
+}
+
+/**
+ * @brief Zero the counters but keep the array and wear, as across a reboot.
+ *
+ * @param void
+ * @return void.
+ */
+void host_mx25_clear_stats(void)
+{
+	memset(&host_mx25_stats, 0, sizeof(host_mx25_stats));
+}
+
+uint32_t host_mx25_sector_erases(uint32_t sector)
+{
+	return (sector < HOST_MX25_SECTORS) ? host_mx25_wear[sector] : 0;
+}
+
+int host_mx25_powered_down(void)
+{
+	return host_mx25_asleep;
+}
+
+/**
+ * @brief Chip select edge of a command: wakes the chip if it is powered
+ * down, in which case the command itself is lost.
+ *
+ * @param void
+ * @return int Non-zero if the chip takes the command.
+ */
+static int host_mx25_select(void)
+{
+	if(!host_mx25_asleep)
+		return 1;
+
+	host_mx25_asleep = 0;
+	host_mx25_stats.wakeups++;
+	host_mx25_stats.ignored++;
+	return 0;
+}
+
+void MX25_init(void)
+{
+	if(!host_mx25_powered)
+		host_mx25_reset();
+	host_mx25_stats.inits++;
+}
+
+void MX25_deinit(void)
+{
+}
+
+ReturnMsg MX25_RES(uint8_t *ElectricIdentification)
+{
+	/* MISO floats while the chip is powered down. */
+	*ElectricIdentification = host_mx25_select() ? ElectronicID : 0xFF;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_RDID(uint32_t *Identification)
+{
+	*Identification = host_mx25_select() ? FlashID : 0xFFFFFF;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_RDSR(uint8_t *StatusReg)
+{
+	*StatusReg = host_mx25_select() ? 0x00 : 0xFF;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_READ(uint32_t flash_address, uint8_t *target_address, uint32_t byte_length)
+{
+	if(flash_address > FlashSize)
+		return FlashAddressInvalid;
+
+	if(!host_mx25_select())
+	{
+		memset(target_address, 0xFF, byte_length);
+		return FlashOperationSuccess;
+	}
+
+	/* A read runs on through the whole array and wraps at its end. */
+	for(uint32_t i = 0; i < byte_length; i++)
+	{
+		target_address[i] = host_mx25_array[(flash_address + i) % FlashSize];
+	}
+	host_mx25_stats.reads++;
+	host_mx25_stats.read_bytes += byte_length;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_PP(uint32_t flash_address, uint8_t *source_address, uint32_t byte_length)
+{
+	uint32_t page = flash_address & ~(uint32_t) (Page_Offset - 1);
+
+	if(flash_address > FlashSize)
+		return FlashAddressInvalid;
+
+	if(!host_mx25_select())
+		return FlashOperationSuccess;
+
+	/* Only the last 256 bytes sent are kept, and the address wraps within the page. */
+	if(byte_length > Page_Offset)
+	{
+		source_address += byte_length - Page_Offset;
+		byte_length = Page_Offset;
+	}
+	for(uint32_t i = 0; i < byte_length; i++)
+	{
+		uint8_t *cell = &host_mx25_array[page + ((flash_address + i) & (Page_Offset - 1))];
+
+		if(source_address[i] & ~*cell)
+			host_mx25_stats.overwrites++;
+		*cell &= source_address[i];
+	}
+
+	host_mx25_stats.programs++;
+	host_mx25_stats.program_bytes += byte_length;
+	host_mx25_stats.busy_us += HOST_MX25_PP_US;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_SE(uint32_t flash_address)
+{
+	uint32_t sector = (flash_address % FlashSize) / Sector_Offset;
+
+	if(flash_address > FlashSize)
+		return FlashAddressInvalid;
+
+	if(!host_mx25_select())
+		return FlashOperationSuccess;
+
+	memset(&host_mx25_array[sector * Sector_Offset], 0xFF, Sector_Offset);
+	host_mx25_wear[sector]++;
+	host_mx25_stats.erases++;
+	host_mx25_stats.busy_us += HOST_MX25_SE_US;
+	return FlashOperationSuccess;
+}
+
+ReturnMsg MX25_DP(void)
+{
+	/* The driver wakes the chip first, so this always ends powered down. */
+	if(host_mx25_asleep)
+		host_mx25_stats.wakeups++;
+	host_mx25_asleep = 1;
+	host_mx25_stats.power_downs++;
+	return FlashOperationSuccess;
+}
@@ -0,0 +1,404 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_nvm3.c
+ *
+ * @brief Host model of the NVM3 default instance.
+ *
+ * The flash area is a ring of pages from tail (oldest) to head (being
+ * written); the pages after head are erased. Only the bookkeeping is
+ * modelled: where each live object sits and how many bytes each page has
+ * used and still holds live.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "nvm3.h"
+#include "nvm3_default.h"
+#include "host_nvm3.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Same instance size as the firmware project build. */
+#ifndef NVM3_DEFAULT_NVM_SIZE
+#define NVM3_DEFAULT_NVM_SIZE			24576
+#endif
+#ifndef NVM3_DEFAULT_MAX_OBJECT_SIZE
+#define NVM3_DEFAULT_MAX_OBJECT_SIZE	512
+#endif
+#ifndef NVM3_DEFAULT_REPACK_HEADROOM
+#define NVM3_DEFAULT_REPACK_HEADROOM	0
+#endif
+
+#define HOST_NVM3_PAGE_SIZE			2048		// EFR32BG13 flash page
+#define HOST_NVM3_PAGE_HEADER		20
+#define HOST_NVM3_PAGE_DATA			(HOST_NVM3_PAGE_SIZE - HOST_NVM3_PAGE_HEADER)
+#define HOST_NVM3_PAGES_MAX			64
+
+#define HOST_NVM3_SMALL_OBJECT		120			// Largest object with a short header
+#define HOST_NVM3_OBJECTS			256			// Live keys the model tracks
+#define HOST_NVM3_DATA_MAX			64			// Payload kept per key
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_nvm3_stats_t host_nvm3_stats;
+
+nvm3_Handle_t nvm3_defaultHandleData;
+nvm3_Handle_t *nvm3_defaultHandle = &nvm3_defaultHandleData;
+
+nvm3_Init_t nvm3_defaultInitData =
+{
+	.nvmAdr = NULL,
+	.nvmSize = NVM3_DEFAULT_NVM_SIZE,
+	.cachePtr = NULL,
+	.cacheEntryCount = 0,
+	.maxObjectSize = NVM3_DEFAULT_MAX_OBJECT_SIZE,
+	.repackHeadroom = NVM3_DEFAULT_REPACK_HEADROOM,
+	.halHandle = NULL,
+};
+
+nvm3_Init_t *nvm3_defaultInit = &nvm3_defaultInitData;
+
+static struct
+{
+	bool used;
+	bool counter;
+	nvm3_ObjectKey_t key;
+	uint16_t len;
+	uint16_t cost;						// Bytes in flash, header included
+	uint16_t page;						// Page holding the live copy
+	uint8_t data[HOST_NVM3_DATA_MAX];
+} objects[HOST_NVM3_OBJECTS];
+
+static struct
+{
+	uint32_t used;						// Bytes appended since the erase
+	uint32_t live;						// ... that still hold the newest copy of a key
+} pages[HOST_NVM3_PAGES_MAX];
+
+static bool nvm3_opened;
+static size_t page_count;
+static size_t page_head;
+static size_t page_tail;
+static size_t max_object;
+static size_t headroom;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+void host_nvm3_reset(void)
+{
+	memset(&host_nvm3_stats, 0, sizeof(host_nvm3_stats));
+	memset(objects, 0, sizeof(objects));
+	memset(pages, 0, sizeof(pages));
+	memset(&nvm3_defaultHandleData, 0, sizeof(nvm3_defaultHandleData));
+	nvm3_defaultInitData.repackHeadroom = NVM3_DEFAULT_REPACK_HEADROOM;
+	nvm3_opened = false;
+	page_count = 0;
+	page_head = 0;
+	page_tail = 0;
+}
+
+static size_t host_nvm3_erased_pages(void)
+{
+	return page_count - ((page_head + page_count - page_tail) % page_count) - 1;
+}
+
+/**
+ * @brief Unused bytes: the erased pages and the rest of the head page.
+ *
+ * @param void
+ * @return uint32_t.
+ */
+uint32_t host_nvm3_free_bytes(void)
+{
+	if(!nvm3_opened)
+		return 0;
+	return (uint32_t) (host_nvm3_erased_pages() * HOST_NVM3_PAGE_DATA + (HOST_NVM3_PAGE_DATA - pages[page_head].used));
+}
+
+/* One page is always kept erased so that a repack has somewhere to copy to. */
+static uint32_t host_nvm3_forced_threshold(void)
+{
+	return HOST_NVM3_PAGE_DATA;
+}
+
+static uint16_t host_nvm3_cost(size_t len)
+{
+	size_t header = (len <= HOST_NVM3_SMALL_OBJECT) ? 4 : 8;
+	return (uint16_t) (header + ((len + 3) & ~(size_t) 3));
+}
+
+static int host_nvm3_find(nvm3_ObjectKey_t key)
+{
+	for(int i = 0; i < HOST_NVM3_OBJECTS; i++)
+	{
+		if(objects[i].used && objects[i].key == key)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief Program bytes at the head, moving on to the next erased page if
+ * the head page is too full.
+ *
+ * @param uint16_t cost
+ * @return size_t Page the bytes went to.
+ */
+static size_t host_nvm3_append(uint16_t cost)
+{
+	if(pages[page_head].used + cost > HOST_NVM3_PAGE_DATA)
+	{
+		page_head = (page_head + 1) % page_count;
+		pages[page_head].used = 0;
+		pages[page_head].live = 0;
+	}
+
+	pages[page_head].used += cost;
+	host_nvm3_stats.flash_bytes += cost;
+	return page_head;
+}
+
+/**
+ * @brief Copy the live objects out of the oldest page and erase it.
+ *
+ * @param void
+ * @return bool False if only the head page is in use.
+ */
+static bool host_nvm3_repack_page(void)
+{
+	size_t victim = page_tail;
+
+	if(page_tail == page_head)
+		return false;
+
+	for(int i = 0; i < HOST_NVM3_OBJECTS; i++)
+	{
+		if(objects[i].used && objects[i].page == victim)
+		{
+			objects[i].page = (uint16_t) host_nvm3_append(objects[i].cost);
+			pages[objects[i].page].live += objects[i].cost;
+		}
+	}
+
+	pages[victim].used = 0;
+	pages[victim].live = 0;
+	page_tail = (page_tail + 1) % page_count;
+	host_nvm3_stats.page_erases++;
+	return true;
+}
+
+/**
+ * @brief Make room for an object, repacking inside the write if the free
+ * space would drop below the forced repack threshold.
+ *
+ * @param uint16_t cost
+ * @return bool False if the NVM is full of live data.
+ */
+static bool host_nvm3_reserve(uint16_t cost)
+{
+	for(size_t i = 0; i < page_count && host_nvm3_free_bytes() < host_nvm3_forced_threshold() + cost; i++)
+	{
+		if(!host_nvm3_repack_page())
+			break;
+		host_nvm3_stats.forced_repacks++;
+	}
+	return host_nvm3_free_bytes() >= host_nvm3_forced_threshold() + cost;
+}
+
+static Ecode_t host_nvm3_write(nvm3_ObjectKey_t key, const void *value, size_t len, bool counter)
+{
+	uint16_t cost = host_nvm3_cost(len);
+	int slot;
+
+	if(!nvm3_opened)
+		return ECODE_NVM3_ERR_NOT_OPENED;
+	if(key > NVM3_KEY_MAX)
+		return ECODE_NVM3_ERR_KEY_INVALID;
+	if(len > max_object || len > HOST_NVM3_DATA_MAX)
+		return ECODE_NVM3_ERR_WRITE_DATA_SIZE;
+
+	slot = host_nvm3_find(key);
+	if(slot < 0)
+	{
+		for(int i = 0; i < HOST_NVM3_OBJECTS && slot < 0; i++)
+		{
+			if(!objects[i].used)
+				slot = i;
+		}
+		if(slot < 0)
+			return ECODE_NVM3_ERR_STORAGE_FULL;
+	}
+
+	if(!host_nvm3_reserve(cost))
+		return ECODE_NVM3_ERR_STORAGE_FULL;
+
+	/* The old copy turns into garbage once the new one is written. */
+	if(objects[slot].used)
+		pages[objects[slot].page].live -= objects[slot].cost;
+
+	objects[slot].used = true;
+	objects[slot].counter = counter;
+	objects[slot].key = key;
+	objects[slot].len = (uint16_t) len;
+	objects[slot].cost = cost;
+	objects[slot].page = (uint16_t) host_nvm3_append(cost);
+	pages[objects[slot].page].live += cost;
+	memcpy(objects[slot].data, value, len);
+
+	host_nvm3_stats.writes++;
+	host_nvm3_stats.data_bytes += len;
+	return ECODE_NVM3_OK;
+}
+
+static Ecode_t host_nvm3_read(nvm3_ObjectKey_t key, void *value, size_t max_len, bool counter)
+{
+	int slot;
+
+	if(!nvm3_opened)
+		return ECODE_NVM3_ERR_NOT_OPENED;
+
+	host_nvm3_stats.reads++;
+
+	slot = host_nvm3_find(key);
+	if(slot < 0)
+		return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+	if(objects[slot].counter != counter)
+		return counter ? ECODE_NVM3_ERR_OBJECT_IS_NOT_A_COUNTER : ECODE_NVM3_ERR_OBJECT_IS_NOT_DATA;
+	if(objects[slot].len > max_len)
+		return ECODE_NVM3_ERR_READ_DATA_SIZE;
+
+	memcpy(value, objects[slot].data, objects[slot].len);
+	return ECODE_NVM3_OK;
+}
+
+/**
+ * @brief Open the instance. As on the target, opening it again with the
+ * same parameters is allowed and leaves the contents alone.
+ *
+ * @param nvm3_Handle_t *h, const nvm3_Init_t *i
+ * @return Ecode_t.
+ */
+Ecode_t nvm3_open(nvm3_Handle_t *h, const nvm3_Init_t *i)
+{
+	if(nvm3_opened)
+	{
+		if(i->nvmSize != h->nvmSize || i->maxObjectSize != max_object || i->repackHeadroom != headroom)
+			return ECODE_NVM3_ERR_OPENED_WITH_OTHER_PARAMETERS;
+		return ECODE_NVM3_OK;
+	}
+
+	if(i->nvmSize / HOST_NVM3_PAGE_SIZE < 3 || i->nvmSize / HOST_NVM3_PAGE_SIZE > HOST_NVM3_PAGES_MAX)
+		return ECODE_NVM3_ERR_SIZE_TOO_SMALL;
+
+	memset(objects, 0, sizeof(objects));
+	memset(pages, 0, sizeof(pages));
+	page_count = i->nvmSize / HOST_NVM3_PAGE_SIZE;
+	page_head = 0;
+	page_tail = 0;
+	max_object = i->maxObjectSize;
+	headroom = i->repackHeadroom;
+
+	h->nvmSize = i->nvmSize;
+	h->maxObjectSize = i->maxObjectSize;
+	h->repackHeadroom = i->repackHeadroom;
+	h->totalNvmPageCnt = page_count;
+	h->hasBeenOpened = true;
+	nvm3_opened = true;
+	return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_close(nvm3_Handle_t *h)
+{
+	h->hasBeenOpened = false;
+	nvm3_opened = false;
+	return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_writeData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len)
+{
+	(void) h;
+	return host_nvm3_write(key, value, len, false);
+}
+
+Ecode_t nvm3_readData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t maxLen)
+{
+	(void) h;
+	return host_nvm3_read(key, value, maxLen, false);
+}
+
+Ecode_t nvm3_writeCounter(nvm3_Handle_t *h, nvm3_ObjectKey_t key, uint32_t value)
+{
+	(void) h;
+	return host_nvm3_write(key, &value, sizeof(value), true);
+}
+
+Ecode_t nvm3_readCounter(nvm3_Handle_t *h, nvm3_ObjectKey_t key, uint32_t *value)
+{
+	(void) h;
+	return host_nvm3_read(key, value, sizeof(*value), true);
+}
+
+/**
+ * @brief Delete an object; NVM3 writes a small deletion marker for it.
+ *
+ * @param nvm3_Handle_t *h, nvm3_ObjectKey_t key
+ * @return Ecode_t.
+ */
+Ecode_t nvm3_deleteObject(nvm3_Handle_t *h, nvm3_ObjectKey_t key)
+{
+	int slot;
+
+	(void) h;
+	if(!nvm3_opened)
+		return ECODE_NVM3_ERR_NOT_OPENED;
+
+	slot = host_nvm3_find(key);
+	if(slot < 0)
+		return ECODE_NVM3_OK;
+
+	if(!host_nvm3_reserve(host_nvm3_cost(0)))
+		return ECODE_NVM3_ERR_STORAGE_FULL;
+
+	pages[objects[slot].page].live -= objects[slot].cost;
+	objects[slot].used = false;
+	host_nvm3_append(host_nvm3_cost(0));
+	host_nvm3_stats.deletes++;
+	return ECODE_NVM3_OK;
+}
+
+bool nvm3_repackNeeded(nvm3_Handle_t *h)
+{
+	(void) h;
+	return nvm3_opened && host_nvm3_free_bytes() < host_nvm3_forced_threshold() + headroom;
+}
+
+/**
+ * @brief User repack: erases at most one page, and only when needed.
+ *
+ * @param nvm3_Handle_t *h
+ * @return Ecode_t.
+ */
+Ecode_t nvm3_repack(nvm3_Handle_t *h)
+{
+	if(!nvm3_opened)
+		return ECODE_NVM3_ERR_NOT_OPENED;
+
+	if(nvm3_repackNeeded(h) && host_nvm3_repack_page())
+		host_nvm3_stats.user_repacks++;
+	return ECODE_NVM3_OK;
+}
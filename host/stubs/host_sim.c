@@ -0,0 +1,182 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_sim.c
+ *
+ * @brief Discrete-event kernel driving the host peripheral models.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "host_sim.h"
+#include "host_device.h"
+#include "host_i2c.h"
+#include "host_sleeptimer.h"
+#include "host_display.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_sim_stats_t host_sim_stats;
+
+static const host_sim_model_t *const sim_models[] =
+{
+	&host_i2c_model,
+	&host_sleeptimer_model,
+	&host_display_model,
+};
+
+#define HOST_SIM_MODEL_COUNT		(sizeof(sim_models) / sizeof(sim_models[0]))
+
+/* Deadline for the next host_sim_idle(), HOST_SIM_NEVER when unarmed. */
+static uint64_t sim_wakeup = HOST_SIM_NEVER;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Reset every model to power-on state.
+ *
+ * @param void
+ * @return void.
+ */
+void host_sim_reset(void)
+{
+	memset(&host_sim_stats, 0, sizeof(host_sim_stats));
+	sim_wakeup = HOST_SIM_NEVER;
+
+	for(size_t i = 0; i < HOST_SIM_MODEL_COUNT; i++)
+	{
+		sim_models[i]->reset();
+	}
+}
+
+/**
+ * @brief Fold firmware register writes into every model at the current time.
+ *
+ * @param void
+ * @return void.
+ */
+void host_sim_sync(void)
+{
+	uint64_t now = host_clock_now();
+
+	host_sim_stats.syncs++;
+	for(size_t i = 0; i < HOST_SIM_MODEL_COUNT; i++)
+	{
+		sim_models[i]->sync(now);
+	}
+}
+
+/**
+ * @brief Virtual time of the earliest pending model event.
+ *
+ * @param void
+ * @return uint64_t Absolute tick or HOST_SIM_NEVER.
+ */
+uint64_t host_sim_next_event(void)
+{
+	uint64_t next = HOST_SIM_NEVER;
+
+	host_sim_sync();
+	for(size_t i = 0; i < HOST_SIM_MODEL_COUNT; i++)
+	{
+		uint64_t event = sim_models[i]->next_event();
+
+		if(event < next)
+			next = event;
+	}
+	return next;
+}
+
+/**
+ * @brief Move virtual time to ticks, firing every model event on the way.
+ *
+ * Events due at the same tick fire in model order. Each fire may run a
+ * firmware IRQ handler, so the models are synced again before the next
+ * event is looked up.
+ *
+ * @param uint64_t ticks
+ * @return void.
+ */
+void host_sim_advance_to(uint64_t ticks)
+{
+	for(;;)
+	{
+		uint64_t next = host_sim_next_event();
+
+		if(next > ticks)
+			break;
+
+		host_clock_advance_to(next);
+		for(size_t i = 0; i < HOST_SIM_MODEL_COUNT; i++)
+		{
+			if(sim_models[i]->next_event() == next)
+			{
+				sim_models[i]->fire(next);
+				host_sim_stats.events++;
+				host_sim_sync();
+			}
+		}
+	}
+
+	host_clock_advance_to(ticks);
+	host_sim_sync();
+}
+
+/**
+ * @brief Arm the wake-up deadline for the next host_sim_idle().
+ *
+ * @param uint64_t ticks
+ * @return void.
+ */
+void host_sim_sleep_until(uint64_t ticks)
+{
+	sim_wakeup = ticks;
+}
+
+/**
+ * @brief Sleep until a model raises an interrupt or the deadline passes.
+ *
+ * Model events that raise no interrupt (e.g. with the source masked in
+ * IEN) do not wake the core, so time keeps moving past them. Without a
+ * deadline and without pending model events this returns at once instead
+ * of hanging, which the target would do.
+ *
+ * @param void
+ * @return void.
+ */
+void host_sim_idle(void)
+{
+	uint64_t wakeup = sim_wakeup;
+	uint32_t raised = host_device_stats.irq_raised;
+
+	sim_wakeup = HOST_SIM_NEVER;
+	host_sim_stats.idles++;
+
+	while(host_device_stats.irq_raised == raised)
+	{
+		uint64_t next = host_sim_next_event();
+
+		if(next > wakeup || next == HOST_SIM_NEVER)
+		{
+			if(wakeup != HOST_SIM_NEVER)
+				host_sim_advance_to(wakeup);
+			return;
+		}
+		host_sim_advance_to(next);
+	}
+
+	if(host_clock_now() < wakeup)
+		host_sim_stats.idle_irq_wakeups++;
+}
@@ -0,0 +1,303 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_sleeptimer.c
+ *
+ * @brief Virtual-time model of the sleeptimer service on the RTCC.
+ *
+ * A running timer keeps its absolute deadline (low 32 bits of the virtual
+ * clock) in the delta field of its handle, which the SDK uses for the
+ * delay relative to the previous timer instead.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <string.h>
+#include "host_sleeptimer.h"
+#include "host_device.h"
+#include "sl_sleeptimer.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+host_sleeptimer_stats_t host_sleeptimer_stats;
+
+static struct
+{
+	sl_sleeptimer_timer_handle_t *head;	// Running timers, earliest deadline first
+	bool initialized;
+	bool irq_pending;					// RTCC_IRQn raised, handler not run yet
+} sleeptimer;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Absolute tick of a deadline, now if it has passed. */
+static uint64_t host_sleeptimer_deadline(const sl_sleeptimer_timer_handle_t *handle)
+{
+	uint64_t now = host_clock_now();
+	int32_t left = (int32_t) (handle->delta - (uint32_t) now);
+
+	return (left > 0) ? now + (uint64_t) left : now;
+}
+
+static bool host_sleeptimer_unlink(sl_sleeptimer_timer_handle_t *handle)
+{
+	sl_sleeptimer_timer_handle_t **link;
+
+	for(link = &sleeptimer.head; *link; link = &(*link)->next)
+	{
+		if(*link == handle)
+		{
+			*link = handle->next;
+			handle->next = NULL;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Queue a timer due in timeout ticks from its deadline base; timers
+ * due at the same tick expire in priority order, then in start order.
+ *
+ * @param sl_sleeptimer_timer_handle_t *handle, uint32_t base, uint32_t timeout
+ * @return void.
+ */
+static void host_sleeptimer_insert(sl_sleeptimer_timer_handle_t *handle, uint32_t base, uint32_t timeout)
+{
+	sl_sleeptimer_timer_handle_t **link = &sleeptimer.head;
+	uint32_t now = (uint32_t) host_clock_now();
+
+	handle->delta = base + timeout;
+	while(*link)
+	{
+		int32_t diff = (int32_t) ((handle->delta - now) - ((*link)->delta - now));
+
+		if(diff < 0 || (diff == 0 && handle->priority < (*link)->priority))
+			break;
+		link = &(*link)->next;
+	}
+
+	handle->next = *link;
+	*link = handle;
+}
+
+static sl_status_t host_sleeptimer_create(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+										  uint32_t timeout_periodic, sl_sleeptimer_timer_callback_t callback,
+										  void *callback_data, uint8_t priority, uint16_t option_flags)
+{
+	handle->callback_data = callback_data;
+	handle->priority = priority;
+	handle->option_flags = option_flags;
+	handle->next = NULL;
+	handle->callback = callback;
+	handle->timeout_periodic = timeout_periodic;
+	host_sleeptimer_stats.starts++;
+
+	/* As the SDK: no timeout calls back at once, from the caller. */
+	if(timeout == 0)
+	{
+		if(callback)
+		{
+			host_sleeptimer_stats.expired++;
+			callback(handle, callback_data);
+		}
+		if(!timeout_periodic)
+			return SL_STATUS_OK;
+		timeout = timeout_periodic;
+	}
+
+	host_sleeptimer_insert(handle, (uint32_t) host_clock_now(), timeout);
+	return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_init(void)
+{
+	if(!sleeptimer.initialized)
+	{
+		sleeptimer.initialized = true;
+		NVIC_ClearPendingIRQ(RTCC_IRQn);
+		NVIC_EnableIRQ(RTCC_IRQn);
+	}
+	return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+									  sl_sleeptimer_timer_callback_t callback, void *callback_data,
+									  uint8_t priority, uint16_t option_flags)
+{
+	bool running;
+
+	if(handle == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	sl_sleeptimer_is_timer_running(handle, &running);
+	if(running)
+		return SL_STATUS_NOT_READY;
+
+	return host_sleeptimer_create(handle, timeout, 0, callback, callback_data, priority, option_flags);
+}
+
+sl_status_t sl_sleeptimer_restart_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+										sl_sleeptimer_timer_callback_t callback, void *callback_data,
+										uint8_t priority, uint16_t option_flags)
+{
+	if(handle == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	host_sleeptimer_unlink(handle);
+	return host_sleeptimer_create(handle, timeout, 0, callback, callback_data, priority, option_flags);
+}
+
+sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+											   sl_sleeptimer_timer_callback_t callback, void *callback_data,
+											   uint8_t priority, uint16_t option_flags)
+{
+	bool running;
+
+	if(handle == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	sl_sleeptimer_is_timer_running(handle, &running);
+	if(running)
+		return SL_STATUS_NOT_READY;
+
+	return host_sleeptimer_create(handle, timeout, timeout, callback, callback_data, priority, option_flags);
+}
+
+sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+												 sl_sleeptimer_timer_callback_t callback, void *callback_data,
+												 uint8_t priority, uint16_t option_flags)
+{
+	if(handle == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	host_sleeptimer_unlink(handle);
+	return host_sleeptimer_create(handle, timeout, timeout, callback, callback_data, priority, option_flags);
+}
+
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+	if(handle == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	if(!host_sleeptimer_unlink(handle))
+		return SL_STATUS_INVALID_STATE;
+
+	host_sleeptimer_stats.stops++;
+	return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle, bool *running)
+{
+	const sl_sleeptimer_timer_handle_t *timer;
+
+	if(handle == NULL || running == NULL)
+		return SL_STATUS_NULL_POINTER;
+
+	*running = false;
+	for(timer = sleeptimer.head; timer; timer = timer->next)
+	{
+		if(timer == handle)
+			*running = true;
+	}
+	return SL_STATUS_OK;
+}
+
+uint32_t sl_sleeptimer_get_tick_count(void)
+{
+	return (uint32_t) host_clock_now();
+}
+
+uint64_t sl_sleeptimer_get_tick_count64(void)
+{
+	return host_clock_now();
+}
+
+uint32_t sl_sleeptimer_get_timer_frequency(void)
+{
+	return (uint32_t) HOST_CLOCK_HZ;
+}
+
+/**
+ * @brief RTCC interrupt: run the callback of every expired timer, periodic
+ * ones queued again first, one period after their deadline.
+ *
+ * @param void
+ * @return void.
+ */
+void RTCC_IRQHandler(void)
+{
+	uint64_t now = host_clock_now();
+
+	sleeptimer.irq_pending = false;
+	NVIC_ClearPendingIRQ(RTCC_IRQn);
+
+	while(sleeptimer.head && host_sleeptimer_deadline(sleeptimer.head) <= now)
+	{
+		sl_sleeptimer_timer_handle_t *handle = sleeptimer.head;
+
+		sleeptimer.head = handle->next;
+		handle->next = NULL;
+		if(handle->timeout_periodic)
+			host_sleeptimer_insert(handle, handle->delta, handle->timeout_periodic);
+
+		host_sleeptimer_stats.expired++;
+		if(handle->callback)
+			handle->callback(handle, handle->callback_data);
+	}
+}
+
+static void host_sleeptimer_reset(void)
+{
+	memset(&host_sleeptimer_stats, 0, sizeof(host_sleeptimer_stats));
+	memset(&sleeptimer, 0, sizeof(sleeptimer));
+}
+
+/* Timers only change through the API calls, nothing to fold. */
+static void host_sleeptimer_sync(uint64_t now)
+{
+	(void) now;
+}
+
+static uint64_t host_sleeptimer_next_event(void)
+{
+	if(!sleeptimer.head || sleeptimer.irq_pending)
+		return HOST_SIM_NEVER;
+	return host_sleeptimer_deadline(sleeptimer.head);
+}
+
+/**
+ * @brief Compare match on the first deadline: raise the RTCC interrupt.
+ *
+ * @param uint64_t now
+ * @return void.
+ */
+static void host_sleeptimer_fire(uint64_t now)
+{
+	(void) now;
+
+	sleeptimer.irq_pending = true;
+	host_sleeptimer_stats.irqs++;
+	host_irq_raise(RTCC_IRQn);
+}
+
+const host_sim_model_t host_sleeptimer_model =
+{
+	.name = "SLEEPTIMER",
+	.reset = host_sleeptimer_reset,
+	.sync = host_sleeptimer_sync,
+	.next_event = host_sleeptimer_next_event,
+	.fire = host_sleeptimer_fire,
+};
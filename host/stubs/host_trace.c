@@ -0,0 +1,211 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware - Host Build
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file host_trace.c
+ *
+ * @brief Trace file parsing and device record injection.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_trace.h"
+#include "host_device.h"
+#include "host_i2c.h"
+#include "em_gpio.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Push buttons as wired on the BRD4104A (see push_button.h). */
+#define HOST_PB_PORT		gpioPortF
+#define HOST_PB0_PIN		6
+#define HOST_PB1_PIN		7
+
+#define HOST_TRACE_LINE_LEN	128
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static const char *const kind_names[HOST_TRACE_KIND_COUNT] =
+{
+	[HOST_TRACE_BOOT]			= "boot",
+	[HOST_TRACE_NODE_INIT]		= "node_init",
+	[HOST_TRACE_PROVISIONED]	= "provisioned",
+	[HOST_TRACE_NODE_RESET]		= "node_reset",
+	[HOST_TRACE_CONN_OPEN]		= "conn_open",
+	[HOST_TRACE_CONN_CLOSE]		= "conn_close",
+	[HOST_TRACE_LEVEL]			= "level",
+	[HOST_TRACE_FRIEND_EST]		= "friend_est",
+	[HOST_TRACE_FRIEND_TERM]	= "friend_term",
+	[HOST_TRACE_TEMP]			= "temp",
+	[HOST_TRACE_BUTTON]			= "button",
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+const char *host_trace_kind_name(host_trace_kind_t kind)
+{
+	if(kind >= HOST_TRACE_KIND_COUNT)
+	{
+		return "unknown";
+	}
+	return kind_names[kind];
+}
+
+bool host_trace_kind_parse(const char *name, host_trace_kind_t *kind)
+{
+	for(int i = 0; i < HOST_TRACE_KIND_COUNT; i++)
+	{
+		if(strcmp(name, kind_names[i]) == 0)
+		{
+			*kind = (host_trace_kind_t) i;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool host_trace_append(host_trace_t *trace, const host_trace_record_t *record)
+{
+	if(trace->count == trace->capacity)
+	{
+		size_t capacity = trace->capacity ? (trace->capacity * 2) : 1024;
+		host_trace_record_t *records = realloc(trace->records, capacity * sizeof(*records));
+
+		if(!records)
+		{
+			return false;
+		}
+		trace->records = records;
+		trace->capacity = capacity;
+	}
+
+	trace->records[trace->count++] = *record;
+	return true;
+}
+
+/**
+ * @brief Load a whole trace into memory so that parsing stays out of the
+ * timed replay.
+ *
+ * @param const char *path, host_trace_t *trace
+ * @return bool false on I/O or syntax error (reported on stderr).
+ */
+bool host_trace_load(const char *path, host_trace_t *trace)
+{
+	char line[HOST_TRACE_LINE_LEN];
+	unsigned int line_no = 0;
+	uint32_t last_ms = 0;
+	FILE *in = fopen(path, "r");
+
+	memset(trace, 0, sizeof(*trace));
+	if(!in)
+	{
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), in))
+	{
+		char name[24];
+		unsigned long time_ms;
+		long arg0 = 0, arg1 = 0;
+		host_trace_record_t record;
+
+		line_no++;
+		if(line[0] == '#' || line[0] == '\n')
+		{
+			continue;
+		}
+
+		if(sscanf(line, "%lu %23s %ld %ld", &time_ms, name, &arg0, &arg1) < 2
+		   || !host_trace_kind_parse(name, &record.kind)
+		   || time_ms < last_ms)
+		{
+			fprintf(stderr, "%s:%u: bad trace record\n", path, line_no);
+			fclose(in);
+			host_trace_free(trace);
+			return false;
+		}
+
+		record.time_ms = (uint32_t) time_ms;
+		record.arg0 = (int32_t) arg0;
+		record.arg1 = (int32_t) arg1;
+		last_ms = record.time_ms;
+
+		if(!host_trace_append(trace, &record))
+		{
+			fclose(in);
+			host_trace_free(trace);
+			return false;
+		}
+	}
+
+	fclose(in);
+	return true;
+}
+
+void host_trace_write(FILE *out, const host_trace_record_t *record)
+{
+	fprintf(out, "%lu %s %ld %ld\n", (unsigned long) record->time_ms,
+			host_trace_kind_name(record->kind), (long) record->arg0, (long) record->arg1);
+}
+
+void host_trace_free(host_trace_t *trace)
+{
+	free(trace->records);
+	memset(trace, 0, sizeof(*trace));
+}
+
+bool host_trace_is_device(host_trace_kind_t kind)
+{
+	return kind == HOST_TRACE_TEMP || kind == HOST_TRACE_BUTTON;
+}
+
+/**
+ * @brief Drive a device record into the peripheral models.
+ *
+ * @param const host_trace_record_t *record
+ * @return void.
+ */
+void host_trace_inject(const host_trace_record_t *record)
+{
+	switch(record->kind)
+	{
+		case HOST_TRACE_TEMP:
+		{
+			host_mcp9808_set_temp_mC(record->arg0);
+			break;
+		}
+		case HOST_TRACE_BUTTON:
+		{
+			unsigned int pin = record->arg0 ? HOST_PB1_PIN : HOST_PB0_PIN;
+			volatile uint32_t *din = (volatile uint32_t *)&GPIO->P[HOST_PB_PORT].DIN;
+
+			/* Buttons are active low. */
+			if(record->arg1)
+				*din &= ~(1UL << pin);
+			else
+				*din |= (1UL << pin);
+
+			GPIO_IntSet(1UL << pin);
+			host_irq_raise((pin & 0x1) ? GPIO_ODD_IRQn : GPIO_EVEN_IRQn);
+			break;
+		}
+		default:
+			break;
+	}
+}
@@ -242,6 +242,8 @@ void SLEEP_Init(SLEEP_CbFuncPtr_t pSleepCb, SLEEP_CbFuncPtr_t pWakeUpCb);
 
 void SLEEP_InitEx(const SLEEP_Init_t * init);
 
+void SLEEP_HooksSet(SLEEP_CbFuncPtr_t pSleepCb, SLEEP_CbFuncPtr_t pWakeUpCb);
+
 SLEEP_EnergyMode_t SLEEP_LowestEnergyModeGet(void);
 
 SLEEP_EnergyMode_t SLEEP_Sleep(void);
@@ -81,6 +81,11 @@ static SLEEP_Init_t sleepContext = { 0 };
  * SLEEP_InitEx this is no longer needed. */
 static SLEEP_CbFuncPtr_t sleepCallback  = NULL;
 
+/* Second pair of callbacks installed by SLEEP_HooksSet(). They survive
+ * SLEEP_Init() and SLEEP_InitEx(). */
+static SLEEP_CbFuncPtr_t sleepHook  = NULL;
+static SLEEP_CbFuncPtr_t wakeupHook = NULL;
+
 /* Sleep block counter array representing the nested sleep blocks for the low
  * energy modes (EM2/EM3). Array index 0 corresponds to EM2 and index 1
  * to EM3.
@@ -184,6 +189,33 @@ void SLEEP_InitEx(const SLEEP_Init_t * init)
   sleepContext.wakeupCallback  = init->wakeupCallback;
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Install a second pair of sleep and wake-up callbacks.
+ *
+ * @details
+ *   Unlike SLEEP_InitEx(), this leaves the callbacks of the module owner
+ *   and the sleep block counters untouched, so it may be called at any time,
+ *   before or after SLEEP_Init(). The sleep hook is called after the sleep
+ *   callback, only if that one lets the device sleep, and cannot prevent the
+ *   sleep; the wake-up hook is called after the wake-up callback.
+ *
+ * @param[in] pSleepCb
+ *   Called before the device goes to sleep, may be NULL.
+ *
+ * @param[in] pWakeUpCb
+ *   Called after wake up, may be NULL.
+ ******************************************************************************/
+void SLEEP_HooksSet(SLEEP_CbFuncPtr_t pSleepCb, SLEEP_CbFuncPtr_t pWakeUpCb)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  sleepHook  = pSleepCb;
+  wakeupHook = pWakeUpCb;
+  CORE_EXIT_CRITICAL();
+}
+
 /***************************************************************************//**
  * @brief
  *   Sets the system to sleep into the lowest possible energy mode.
@@ -415,6 +447,10 @@ static SLEEP_EnergyMode_t enterEMx(SLEEP_EnergyMode_t eMode)
     return sleepEM0;
   }
 
+  if (NULL != sleepHook) {
+    sleepHook(eMode);
+  }
+
   /* Enter the requested energy mode. */
   switch (eMode) {
     case sleepEM1:
@@ -443,6 +479,10 @@ static SLEEP_EnergyMode_t enterEMx(SLEEP_EnergyMode_t eMode)
     sleepContext.wakeupCallback(eMode);
   }
 
+  if (NULL != wakeupHook) {
+    wakeupHook(eMode);
+  }
+
   return eMode;
 }
 /** @endcond */
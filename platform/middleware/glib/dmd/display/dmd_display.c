@@ -49,7 +49,7 @@ static DMD_DisplayGeometry dimensions;
    The dirty table contains one bit per row/line on the display which
    indicates whether the corresponding row/line is dirty (written to without
    having been updated on the display. */
-uint32_t dirtyRows[DISPLAY0_WIDTH / sizeof(uint32_t) / 8];
+static uint32_t dirtyRows[DISPLAY0_WIDTH / sizeof(uint32_t) / 8];
 
 /* To become API functions later. */
 EMSTATUS DMD_allocateFramebuffer(void **framebuffer);
@@ -920,4 +920,34 @@ EMSTATUS DMD_getFrameBuffer(void **framebuffer)
   return DMD_OK;
 }
 
+/***************************************************************************//**
+ * @brief
+ *    Mark rows/lines written straight into the framebuffer as dirty, so that
+ *    the next DMD_updateDisplay() sends them.
+ *
+ * @param first
+ *    First row/line written.
+ * @param count
+ *    Number of rows/lines written.
+ *
+ * @return
+ *    DMD_OK on success, DMD_ERROR_PIXEL_OUT_OF_BOUNDS if the rows/lines are
+ *    not all on the display.
+ ******************************************************************************/
+EMSTATUS DMD_markRowsDirty(uint16_t first, uint16_t count)
+{
+  uint32_t row;
+
+  if ((uint32_t) first + count > dimensions.ySize) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  for (row = first; row < (uint32_t) first + count; row++) {
+    dirtyRows[row >> DIRTY_WORD_BITS_LOG2] |=
+      1 << (row & DIRTY_WORD_BITS_LOG2_MASK);
+  }
+
+  return DMD_OK;
+}
+
 /** @endcond */
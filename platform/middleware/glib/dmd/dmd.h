@@ -148,6 +148,7 @@ EMSTATUS DMD_flipDisplay(int horizontal, int vertical);
 
 EMSTATUS DMD_selectFramebuffer (void *framebuffer);
 EMSTATUS DMD_getFrameBuffer (void **framebuffer);
+EMSTATUS DMD_markRowsDirty (uint16_t first, uint16_t count);
 EMSTATUS DMD_updateDisplay (void);
 
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
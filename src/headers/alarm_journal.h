@@ -0,0 +1,96 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file alarm_journal.h
+ *
+ * @brief Append-only alarm event journal header file.
+ *
+ * Every alarm transition is written as one fixed-size record to NVM3, the
+ * same default instance the Bluetooth stack keeps its persistent store in.
+ * Records go to a ring of ALARM_JOURNAL_SLOTS objects in the application key
+ * range, record n to key ALARM_JOURNAL_KEY_BASE + n % ALARM_JOURNAL_SLOTS,
+ * so the newest records overwrite the oldest and NVM3 does the wear
+ * levelling. At boot the head is found by reading each slot once.
+ *
+ * Repacking (page erases) is kept out of the event handlers: the NVM3
+ * instance is opened with ALARM_JOURNAL_REPACK_HEADROOM bytes of headroom
+ * and alarmJournal_Idle() repacks from the main loop whenever
+ * nvm3_repackNeeded() reports that the headroom has been used up, well
+ * before a write would have to repack by itself.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_ALARM_JOURNAL_H_
+#define SRC_HEADERS_ALARM_JOURNAL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+/* Header File */
+#include "header.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* NVM3 keys 0x00000-0x0FFFF are left to the application; the stack uses 0x4xxxx. */
+#define ALARM_JOURNAL_KEY_BASE			0x01000
+#define ALARM_JOURNAL_SLOTS				64			// Records kept, oldest overwritten first
+#define ALARM_JOURNAL_KEY_BOOT			(ALARM_JOURNAL_KEY_BASE + ALARM_JOURNAL_SLOTS)	// Boot counter
+
+/* Free NVM3 space (bytes) reserved between a user repack and a forced one. */
+#ifndef ALARM_JOURNAL_REPACK_HEADROOM
+#define ALARM_JOURNAL_REPACK_HEADROOM	2048
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	ALARM_JOURNAL_SET = 1,				// LPN raised its alarm
+	ALARM_JOURNAL_CLEARED,				// LPN cleared its alarm
+	ALARM_JOURNAL_RESET					// Alarms cleared on the node (PB0), addr is 0
+} alarm_journal_event_t;
+
+/* One journal record, 16 bytes in NVM3. */
+typedef struct
+{
+	uint32_t seq;						// Record number since provisioning, selects the slot
+	uint32_t time_ms;					// wakeup_TimeMs() when written, sleeptimer ms since boot
+	uint16_t boot;						// Boot count when written, orders time_ms across resets
+	uint16_t addr;						// LPN unicast address
+	uint16_t level;						// Generic level of the message
+	uint8_t type;						// alarm_journal_event_t
+	uint8_t reserved;
+} alarm_journal_record_t;
+
+typedef struct
+{
+	uint32_t appends;					// Records written since boot
+	uint32_t write_errors;				// ... that NVM3 refused
+	uint32_t recovered;					// Valid records found by the boot scan
+	uint32_t repacks;					// nvm3_repack() calls from the idle hook
+	uint32_t repack_errors;
+} alarm_journal_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void alarmJournal_Setup(void);
+void alarmJournal_Init(void);
+void alarmJournal_Append(uint16_t addr, uint16_t level, alarm_journal_event_t type);
+bool alarmJournal_Read(uint32_t age, alarm_journal_record_t *record);
+uint32_t alarmJournal_Count(void);
+void alarmJournal_Erase(void);
+void alarmJournal_Idle(void);
+void alarmJournal_GetStats(alarm_journal_stats_t *stats);
+
+#endif /* SRC_HEADERS_ALARM_JOURNAL_H_ */
@@ -40,16 +40,46 @@ enum display_row {
 	DISPLAY_ROW_MAX,			// Max number of rows display can support
 };
 
+/**
+ * Rendering counts: the rows written are rendered together once per main loop
+ * iteration, and a row is only drawn when its content changed
+ */
+struct display_stats {
+	uint32_t writes;				// displayPrintf() calls
+	uint32_t frames;				// Renders by displayFlush()
+	uint32_t frames_unchanged;		// ... which changed no row, so nothing was sent
+	uint32_t rows_drawn;			// Rows cleared and drawn again
+	uint32_t rows_blitted;			// ... of which the text went straight into the frame buffer
+	uint32_t rows_skipped;			// Rows left as they were
+	uint32_t frames_sent;			// Frames handed to the LDMA
+	uint32_t frames_failed;			// ... which the LDMA failed to send, so they were sent again
+	uint32_t flushes_deferred;		// displayFlush() calls put off while a frame was being sent
+	uint32_t frames_skipped;		// Frames not rendered while the LCD was powered down
+	uint32_t power_ups;				// Full frames rendered when the LCD was powered up again
+};
+
 uint8_t timerEnabled1HzSchedulerEvent;
 
 #if ECEN5823_INCLUDE_DISPLAY_SUPPORT
 void displayInit();
 bool displayUpdate();
 void displayPrintf(enum display_row row, const char *format, ... );
+void displayFlush();
+bool displayBusy();
+bool displayWaitSent();
+void displaySetPower(bool on);
+bool displayPowered();
+const struct display_stats *displayStats();
 #else
 static inline void displayInit() { }
 static inline bool displayUpdate() { return true; }
 static inline void displayPrintf(enum display_row row, const char *format, ... ) { row=row; format=format;}
+static inline void displayFlush() { }
+static inline bool displayBusy() { return false; }
+static inline bool displayWaitSent() { return false; }
+static inline void displaySetPower(bool on) { on=on; }
+static inline bool displayPowered() { return true; }
+static inline const struct display_stats *displayStats() { return NULL; }
 #endif
 
 
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file event_ring.h
+ *
+ * @brief Lock-free single-producer/single-consumer event ring, for passing
+ * events from interrupt handlers to the main loop.
+ *
+ * Every event is queued on its own with a type, a 16 bit payload and the
+ * RTCC count at which it was pushed, so repeated events are not merged
+ * and the main loop can tell how long each one waited.
+ *
+ * The producer only writes head and the consumer only writes tail; both
+ * are free-running and masked on use, and a barrier orders the entry
+ * against the index that publishes it, so neither side needs a critical
+ * section. The producer side may be any number of interrupt handlers as
+ * long as they cannot preempt one another, i.e. they share one NVIC
+ * priority (the firmware leaves all of them at the reset default). A
+ * push from the main loop has to be made in a critical section.
+ *
+ * A push into a full ring is dropped and counted per type; the ring also
+ * keeps its high-water mark and the worst and total queueing delay.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_EVENT_RING_H_
+#define SRC_HEADERS_EVENT_RING_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define EVENT_RING_SIZE			16			// Entries, a power of two
+#define EVENT_RING_TYPES		8			// Event types counted separately
+
+#if (EVENT_RING_SIZE & (EVENT_RING_SIZE - 1)) != 0
+#error "EVENT_RING_SIZE must be a power of two"
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t time;							// RTCC count when pushed
+	uint8_t type;							// Below EVENT_RING_TYPES
+	uint16_t payload;
+} event_ring_entry_t;
+
+typedef struct
+{
+	uint32_t pushed[EVENT_RING_TYPES];		// Events queued, per type
+	uint32_t dropped[EVENT_RING_TYPES];		// Events lost to a full ring, per type
+	uint32_t popped;
+	uint16_t high_water;					// Most entries queued at once
+	uint32_t delay_max;						// RTCC ticks from push to pop
+	uint64_t delay_total;
+} event_ring_stats_t;
+
+typedef struct
+{
+	event_ring_entry_t entry[EVENT_RING_SIZE];
+	volatile uint32_t head;					// Written by the producer only
+	volatile uint32_t tail;					// Written by the consumer only
+	event_ring_stats_t stats;				// pushed/dropped/high_water: producer, rest: consumer
+} event_ring_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void eventRing_Init(event_ring_t *ring);
+bool eventRing_Push(event_ring_t *ring, uint8_t type, uint16_t payload);
+bool eventRing_Pop(event_ring_t *ring, event_ring_entry_t *entry);
+uint16_t eventRing_Count(const event_ring_t *ring);
+
+#endif /* SRC_HEADERS_EVENT_RING_H_ */
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file fsm.h
+ *
+ * @brief Table-driven finite state machine engine.
+ *
+ * A machine is described by const tables: one entry per state with its
+ * name and entry/exit actions, and a [state][event] transition table. The
+ * tables live in flash; the only RAM is the fsm_t and an optional array of
+ * per-state counters supplied by the caller.
+ *
+ * The machine does not queue events itself. Interrupt handlers push them
+ * to the ISR event ring (event_ring.h), and the main loop drains the ring
+ * and hands each one to fsm_Handle(), which looks the transition up
+ * directly in the table. Events are thus handled one at a time in the
+ * order they were raised, none is merged with another, and every event
+ * costs one table lookup.
+ *
+ * A transition runs the exit action of the current state, its own action,
+ * then the entry action of the next state, also when the next state is the
+ * current one. Table entries left zero are ignored events.
+ *
+ * The core cycle counter (DWT CYCCNT) is started by fsm_Init(); the cycles
+ * spent handling each event are charged to the state it arrived in.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_FSM_H_
+#define SRC_HEADERS_FSM_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Transition table entry: go to state, running action (may be NULL) on the way. */
+#define FSM_GOTO(state, action)		{ true, (state), (action) }
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct fsm fsm_t;
+
+typedef void (*fsm_action_t)(fsm_t *fsm);
+
+typedef struct
+{
+	const char *name;
+	fsm_action_t entry;						// Run on entering the state, may be NULL
+	fsm_action_t exit;						// Run on leaving the state, may be NULL
+} fsm_state_t;
+
+typedef struct
+{
+	bool handled;							// False: the event is ignored in this state
+	uint8_t next;
+	fsm_action_t action;					// Run between exit and entry, may be NULL
+} fsm_transition_t;
+
+typedef struct
+{
+	const char *name;
+	const fsm_state_t *states;				// [num_states]
+	const fsm_transition_t *transitions;	// [num_states][num_events], row per state
+	uint8_t num_states;
+	uint8_t num_events;
+	uint8_t initial;
+} fsm_table_t;
+
+typedef struct
+{
+	uint32_t entries;						// Times the state was entered
+	uint32_t events;						// Events handled in the state
+	uint64_t cycles;						// Core cycles spent handling them
+	uint32_t cycles_max;					// ... the most for one event
+} fsm_state_stats_t;
+
+struct fsm
+{
+	const fsm_table_t *table;
+	fsm_state_stats_t *stats;				// [num_states] or NULL
+	void *context;							// For the actions
+	uint8_t state;
+	uint32_t ignored;						// Events with no transition in their state
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void fsm_Init(fsm_t *fsm, const fsm_table_t *table, fsm_state_stats_t *stats, void *context);
+void fsm_Handle(fsm_t *fsm, uint8_t event);
+uint8_t fsm_State(const fsm_t *fsm);
+const char *fsm_StateName(const fsm_t *fsm, uint8_t state);
+
+#endif /* SRC_HEADERS_FSM_H_ */
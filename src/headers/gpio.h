@@ -21,6 +21,10 @@
 #define LCD_EXTCOMIN_port	gpioPortD	// LCD display EXTCOMIN port
 #define LCD_EXTCOMIN_pin	13			// LCD display EXTCOMIN pin
 
+/* display.c drives the LCD enable and EXTCOMIN pins through the functions below. */
+#define GPIO_SET_DISPLAY_EXT_COMIN_IMPLEMENTED	1
+#define GPIO_DISPLAY_SUPPORT_IMPLEMENTED		1
+
 void gpioInit();
 void gpioLed0SetOn();
 void gpioLed0SetOff();
@@ -26,7 +26,6 @@
 #include "em_emu.h"
 #include "em_device.h"
 #include "em_gpio.h"
-#include "em_letimer.h"
 #include "retargetserial.h"
 #include "sleep.h"
 #include "gatt_db.h"
@@ -36,16 +35,29 @@
 /* Custom headers */
 #include "cmu.h"
 #include "gpio.h"
-#include "letimer.h"
 #include "log.h"
 #include "display.h"
+#include "text_blit.h"
 #include "gecko_ble_errors.h"
 #include "ble_mesh_device_type.h"
 #include "push_button.h"
 #include "gpiointerrupt.h"
 #include "mcp9808.h"
+#include "i2c_queue.h"
 #include "i2c.h"
 #include "state.h"
+#include "sleep_profile.h"
+#include "lpn_registry.h"
+#include "time_series.h"
+#include "sample_rate.h"
+#include "sensor.h"
+#include "sensor_drivers.h"
+#include "series_codec.h"
+#include "latency.h"
+#include "timer_wheel.h"
+#include "wakeup.h"
+#include "alarm_journal.h"
+#include "sensor_history.h"
 
 /* Standard headers */
 #include <stdbool.h>
@@ -64,6 +76,15 @@
 /* Enabled MCP9808 interface. */
 #define MCP9808_ENABLED
 
+/* Sample the MCP9808 on ALERT threshold crossings as well as on its
+ * adaptive period; define MCP9808_POLLING for the period alone. */
+#ifndef MCP9808_POLLING
+	#define MCP9808_ALERT_ENABLED
+#endif
+
+/* Define SENSOR_EXTRAS_ENABLED to sample the SHT3x, SCD4x and OPT3001 on
+ * I2C0 in the MCP9808 batches (sensor.h). */
+
 /* Enable the LCD Display using the above #define statement. */
 #ifdef DISPLAY_ENABLE
 	#define SCHEDULER_SUPPORTS_DISPLAY_UPDATE_EVENT 1
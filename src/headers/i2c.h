@@ -25,16 +25,17 @@
 // GLOBAL VARIABLES & DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
 
-volatile float temp_reading;
-int32_t app_temp_reading;
+/* Last MCP9808 reading, in milli-degrees C. */
+volatile int32_t app_temp_reading;
+
+/* Transfers to every device on I2C0 (i2c.c). */
+extern i2c_queue_t i2c0_queue;
 
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION PROTOTYPES
 ////////////////////////////////////////////////////////////////////////////////
 
 void i2c_Init(void);
-void I2C_Write(uint8_t addr, uint8_t command);
-void I2C_Read(uint8_t addr);
 void I2C0_IRQHandler(void);
 
 #endif /* SRC_I2C_H_ */
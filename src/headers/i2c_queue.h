@@ -0,0 +1,125 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file i2c_queue.h
+ *
+ * @brief Asynchronous I2C transfer queue, for any number of devices on one
+ * bus.
+ *
+ * A transfer is a write, a read, or a write then a read after a repeated
+ * start, to a 7 bit address. i2cQueue_Transfer() copies the bytes to write
+ * into a request from a fixed pool and queues it; the requests run one at
+ * a time, in submission order, from the interrupt driven emlib I2C driver.
+ * When a transfer ends, its completion callback runs in the I2C interrupt
+ * with the status and the bytes read, and the next queued request is
+ * started from the same interrupt, so back-to-back transfers never wait
+ * for the main loop. The request goes back to the pool when its callback
+ * returns; a callback may queue further transfers.
+ *
+ * The busy hook is called when the queue takes the bus (first request) and
+ * when it gives it back (queue drained), so the caller holds one EM2 block
+ * and keeps the I2C interrupt enabled for a whole burst.
+ *
+ * Statistics are kept per device address: transfers, completions, NACKs,
+ * other failures (bus error, arbitration lost, usage fault) and the time
+ * from submission to completion on the queue clock, the RTCC by default.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_I2C_QUEUE_H_
+#define SRC_HEADERS_I2C_QUEUE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+#include "em_i2c.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define I2C_QUEUE_POOL_SIZE			8			// Requests queued or in flight at once
+#define I2C_QUEUE_WRITE_MAX			4			// Register pointer and up to 3 data bytes
+#define I2C_QUEUE_READ_MAX			6			// Two Sensirion words and their CRCs
+#define I2C_QUEUE_DEVICES_MAX		16			// Addresses with statistics of their own
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct i2c_request i2c_request_t;
+
+/* Runs in the I2C interrupt; request->read holds the bytes read. */
+typedef void (*i2c_callback_t)(const i2c_request_t *request);
+
+struct i2c_request
+{
+	i2c_request_t *next;
+	I2C_TransferSeq_TypeDef seq;
+	uint8_t write[I2C_QUEUE_WRITE_MAX];
+	uint8_t read[I2C_QUEUE_READ_MAX];
+	uint8_t addr;							// 7 bit
+	I2C_TransferReturn_TypeDef status;		// Final status, for the callback
+	uint32_t queued;						// Queue clock at submission
+	i2c_callback_t callback;				// NULL for none
+	void *context;							// For the callback
+};
+
+typedef struct
+{
+	uint8_t addr;							// 7 bit, 0 while the slot is free
+	uint32_t transfers;						// Transfers completed or failed
+	uint32_t done;
+	uint32_t nacks;
+	uint32_t bus_errors;					// Any other failure
+	uint32_t latency_max;					// Clock ticks from submission to completion
+	uint64_t latency_total;
+} i2c_device_stats_t;
+
+typedef struct
+{
+	uint32_t submitted;
+	uint32_t rejected;						// Pool empty or lengths out of range
+	uint32_t chained;						// Started from the interrupt of the transfer before
+	uint32_t high_water;					// Most requests queued or in flight
+	uint32_t busy_periods;					// Bus taken from idle
+	uint32_t other_devices;					// Transfers to addresses past the statistics table
+	i2c_device_stats_t device[I2C_QUEUE_DEVICES_MAX];
+} i2c_queue_stats_t;
+
+typedef struct
+{
+	I2C_TypeDef *port;
+	i2c_request_t pool[I2C_QUEUE_POOL_SIZE];
+	i2c_request_t *free;
+	i2c_request_t *head;					// Next to run, or running when active
+	i2c_request_t *tail;
+	uint32_t count;							// Requests queued or in flight
+	bool active;							// Head is on the bus
+	bool completing;						// In a completion callback
+	uint32_t (*clock)(void);				// Now, in ticks (RTCC by default)
+	void (*busy)(bool busy);				// Bus taken (true) or released (false)
+	i2c_queue_stats_t stats;
+} i2c_queue_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void i2cQueue_Init(i2c_queue_t *queue, I2C_TypeDef *port, uint32_t (*clock)(void), void (*busy)(bool busy));
+bool i2cQueue_Transfer(i2c_queue_t *queue, uint8_t addr, const uint8_t *write, uint16_t write_len,
+					   uint16_t read_len, i2c_callback_t callback, void *context);
+void i2cQueue_Irq(i2c_queue_t *queue);
+uint32_t i2cQueue_Pending(const i2c_queue_t *queue);
+const i2c_device_stats_t *i2cQueue_DeviceStats(const i2c_queue_t *queue, uint8_t addr);
+
+#endif /* SRC_HEADERS_I2C_QUEUE_H_ */
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file latency.h
+ *
+ * @brief End-to-end event latency histograms.
+ *
+ * An event is stamped at its source: by the interrupt handler that queued
+ * it (the isr_event_ring time stamp) or, for stack events, when
+ * gecko_wait_event() hands it to the main loop. latency_Begin() marks the
+ * dispatch of the event and latency_End() the return of its handler; in
+ * between, every completion point (Friend_RequestHandler(),
+ * gecko_store_alarms(), displayPrintf()) records the time from the source
+ * of the event being handled. Work deferred past the handler, such as the
+ * write-behind alarm store, keeps the mark of the event that caused it.
+ *
+ * Each (event, stage) pair has a histogram of power-of-two buckets: bucket
+ * 0 counts latencies below one clock tick, bucket b those from 2^(b-1) up
+ * to 2^b ticks, the last bucket everything longer. The clock is the RTCC
+ * (32768 Hz, it keeps counting in EM2) unless another one is installed,
+ * e.g. the fake clock of the host build.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_LATENCY_H_
+#define SRC_HEADERS_LATENCY_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define LATENCY_BUCKETS			20			// Up to 2^18 ticks, 8 s on the RTCC
+#define LATENCY_RTCC_HZ			32768
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	LATENCY_EVT_SENSOR,						// Sampling wakeup or I2C interrupt, MCP9808 sequence
+	LATENCY_EVT_BUTTON,						// Push button interrupt
+	LATENCY_EVT_CLIENT_REQUEST,				// Generic server client request (LPN message)
+	LATENCY_EVT_SOFT_TIMER,					// Stack soft timer
+	LATENCY_EVT_OTHER,						// Any other stack event
+	LATENCY_EVT_COUNT
+} latency_event_t;
+
+typedef enum
+{
+	LATENCY_DISPATCH,						// Source to handler start
+	LATENCY_REQUEST_DONE,					// Source to Friend_RequestHandler() return
+	LATENCY_ALARMS_STORED,					// Source to gecko_store_alarms() return
+	LATENCY_DISPLAYED,						// Source to the frame carrying its displayPrintf()
+	LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+/* The event being handled, kept by work that completes later. */
+typedef struct
+{
+	bool valid;
+	uint8_t event;
+	uint32_t source;						// Clock ticks
+} latency_mark_t;
+
+typedef struct
+{
+	uint32_t count[LATENCY_EVT_COUNT][LATENCY_STAGE_COUNT][LATENCY_BUCKETS];
+	uint32_t max[LATENCY_EVT_COUNT][LATENCY_STAGE_COUNT];		// Clock ticks
+} latency_histograms_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void latency_Init(uint32_t (*clock)(void), uint32_t hz);
+void latency_Reset(void);
+uint32_t latency_Now(void);
+uint32_t latency_FromRtcc(uint32_t rtcc_stamp);
+void latency_Arrive(void);
+uint32_t latency_Arrival(void);
+void latency_Begin(latency_event_t event, uint32_t source);
+void latency_End(void);
+void latency_Complete(latency_stage_t stage);
+void latency_Current(latency_mark_t *mark);
+void latency_CompleteMark(latency_stage_t stage, const latency_mark_t *mark);
+const latency_histograms_t *latency_Histograms(void);
+uint32_t latency_BucketLimitUs(uint8_t bucket);
+uint32_t latency_TicksToUs(uint32_t ticks);
+const char *latency_EventName(uint8_t event);
+const char *latency_StageName(uint8_t stage);
+
+#endif /* SRC_HEADERS_LATENCY_H_ */
@@ -11,8 +11,6 @@
 /* Header File */
 #include "header.h"
 
-extern volatile float temp_reading;
-
 /**
  * Instructions for using this module:
  * 1) #include "log.h" in the C file where you'd like to add logging
@@ -68,6 +66,8 @@ extern volatile float temp_reading;
 void logInit();
 uint32_t loggerGetTimestamp();
 void logFlush();
+void logSleepProfile();
+void logLatency();
 #else
 /**
  * Remove all logging related code on builds where logging is not enabled
@@ -80,6 +80,8 @@ static inline void logI2CWriteReturns(int status) {}
 static inline void logI2CReadReturns(int status) {}
 static inline void logSM_Status(int current_state) {}
 static inline void logString(char* mystring) {}
+static inline void logSleepProfile() {}
+static inline void logLatency() {}
 #endif
 
 
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file lpn_registry.h
+ *
+ * @brief Registry of the LPNs served by the friend node, with their alarms.
+ *
+ * Each LPN gets a slot in registration order; the slot never changes, so
+ * it indexes the alarm bitset and any other per-LPN array. Lookup by
+ * unicast address is a binary search over a sorted array of addresses
+ * that is kept apart from the slot numbers, so the search only touches
+ * 2 bytes per LPN (512 bytes for a full registry).
+ *
+ * The module only depends on the C library so that the host benchmark can
+ * link it on its own.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_LPN_REGISTRY_H_
+#define SRC_HEADERS_LPN_REGISTRY_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define LPN_REGISTRY_MAX		256							// LPNs the friend node can track
+#define LPN_ALARM_WORDS			((LPN_REGISTRY_MAX + 31) / 32)
+#define LPN_SLOT_INVALID		0xFFFF
+
+/* Bytes of alarm bitset in use for a given number of registered LPNs. */
+#define LPN_ALARM_BYTES(count)	(((count) + 7) / 8)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* An all-zero registry is valid and empty. */
+typedef struct
+{
+	uint16_t count;								// Registered LPNs
+	uint16_t key[LPN_REGISTRY_MAX];				// Unicast addresses, sorted
+	uint16_t key_slot[LPN_REGISTRY_MAX];		// Slot of key[i]
+	uint16_t slot_addr[LPN_REGISTRY_MAX];		// Unicast address per slot
+	uint32_t alarms[LPN_ALARM_WORDS];			// Alarm bit per slot
+} lpn_registry_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void lpnRegistry_Init(lpn_registry_t *registry);
+uint16_t lpnRegistry_Find(const lpn_registry_t *registry, uint16_t addr);
+uint16_t lpnRegistry_Add(lpn_registry_t *registry, uint16_t addr);
+uint16_t lpnRegistry_Addr(const lpn_registry_t *registry, uint16_t slot);
+
+bool lpnRegistry_AlarmGet(const lpn_registry_t *registry, uint16_t slot);
+bool lpnRegistry_AlarmSet(lpn_registry_t *registry, uint16_t slot, bool alarm);
+void lpnRegistry_AlarmClearAll(lpn_registry_t *registry);
+uint16_t lpnRegistry_AlarmCount(const lpn_registry_t *registry);
+uint16_t lpnRegistry_AlarmExport(const lpn_registry_t *registry, uint8_t *data, uint16_t max_len);
+void lpnRegistry_AlarmImport(lpn_registry_t *registry, const uint8_t *data, uint16_t len);
+
+#endif /* SRC_HEADERS_LPN_REGISTRY_H_ */
@@ -10,6 +10,31 @@
  * @brief MCP9808 High-accuracy Temperature Sensor (external) header file.
  * # Datasheet: http://ww1.microchip.com/downloads/en/DeviceDoc/25095A.pdf
  *
+ * The MCP9808 is read through its sensor descriptor (sensor.h, state.c):
+ * a pointer write and the two byte Ta register, joined by a repeated
+ * start, decoded by mcp9808_Decode(). Temperatures are integers in
+ * milli-degrees C from the register to the display: mcp9808_TaToMilliC()
+ * converts the Ta register in the I2C interrupt without floating point,
+ * and mcp9808_FormatMilliC() prints a reading with three decimals without
+ * printf.
+ *
+ * With MCP9808_ALERT_ENABLED the sensor is not polled every second. Its
+ * ALERT output runs in comparator mode against a window of T_LOWER and
+ * T_UPPER kept MCP9808_ALERT_BAND_MC either side of the last reading, so
+ * the pin only goes low when the temperature has moved by the band. The
+ * falling edge (gpiointerrupt) queues ISR_EVENT_MCP9808_ALERT, the sensor
+ * is read in the next batch and the window is centred on the reading
+ * again. If the pin is still low once the new window is written, the
+ * temperature moved on in the meantime and another sample is taken at
+ * once.
+ *
+ * T_CRIT holds the critical limit. At or above it the ALERT output stays
+ * low whatever the window, so mcp9808_AlertRearm() reports it and the
+ * caller samples every second again until the temperature has fallen back
+ * below the limit. The adaptive sampling period (sample_rate.h) keeps the
+ * history going while the temperature is flat; it also retries a read or
+ * window write that failed.
+ *
  * @author Rushi James Macwan
  */
 
@@ -33,11 +58,67 @@
 /* MCP9808 Command for reading temperature */
 #define mcp9808_read_command	0x05
 
+/* MCP9808 register pointers */
+#define MCP9808_REG_CONFIG			0x01
+#define MCP9808_REG_T_UPPER			0x02
+#define MCP9808_REG_T_LOWER			0x03
+#define MCP9808_REG_T_CRIT			0x04
+
+/* CONFIG register bits */
+#define MCP9808_CONFIG_ALERT_INT	0x0001		// Interrupt mode, comparator mode when clear
+#define MCP9808_CONFIG_ALERT_HIGH	0x0002		// Active high, active low when clear
+#define MCP9808_CONFIG_ALERT_CRIT	0x0004		// T_CRIT only, all limits when clear
+#define MCP9808_CONFIG_ALERT_EN		0x0008
+#define MCP9808_CONFIG_HYST_0C		0x0000
+#define MCP9808_CONFIG_HYST_1C5		0x0200
+#define MCP9808_CONFIG_HYST_3C		0x0400
+#define MCP9808_CONFIG_HYST_6C		0x0600
+
+/* Ta register: flags above the 13 bit temperature (1/16 C, two's complement) */
+#define MCP9808_TA_CRIT				0x8000		// Ta >= T_CRIT
+#define MCP9808_TA_MASK				0x1FFF
+#define MCP9808_TA_SIGN				0x1000
+
+/* Longest text of mcp9808_FormatMilliC(), "-2147483.648" and the NUL. */
+#define MCP9808_TEXT_MAX			13
+
+/* ALERT output (open drain) on the expansion header, EXP 9 */
+#define MCP9808_ALERT_PORT			gpioPortD
+#define MCP9808_ALERT_PIN			10
+
+/* Half width of the window around the last reading; a multiple of 0.25 C.
+ * The window moves with every reading, so it needs no hysteresis, and any
+ * hysteresis must stay below the band or the ALERT output never clears. */
+#define MCP9808_ALERT_BAND_MC		500
+#define MCP9808_ALERT_HYST			MCP9808_CONFIG_HYST_0C
+
+/* Greenhouse critical temperature */
+#define MCP9808_T_CRIT_MC			45000
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t alerts;						// ALERT falling edges
+	uint32_t rearms;						// Windows centred on a reading
+	uint32_t rechecks;						// ALERT still low after a rearm
+	uint32_t critical;						// Readings at or above T_CRIT
+	uint32_t write_failures;				// Limit or configuration writes that failed
+} mcp9808_alert_stats_t;
+
+mcp9808_alert_stats_t mcp9808_alert_stats;
+
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION PROTOTYPES
 ////////////////////////////////////////////////////////////////////////////////
 
-void mcp9808_Write(void);
-void mcp9808_Read(void);
+void mcp9808_Init(void);
+bool mcp9808_Decode(const uint8_t *raw, int32_t *value);
+int32_t mcp9808_TaToMilliC(uint16_t ta);
+uint8_t mcp9808_FormatMilliC(char *text, int32_t milli);
+bool mcp9808_AlertRearm(void);
+void mcp9808_AlertIRQHandler(uint8_t pin);
 
 #endif /* SRC_HEADERS_MCP9808_H_ */
@@ -34,15 +34,6 @@
 #define BUTTON_PRESSED		0x01			// button_state (service attribute)
 #define BUTTON_RELEASED		0x00			// button_state (service attribute)
 
-/*******************************************************************************
- * External signal definitions. These are used to signal button press events
- * from GPIO interrupt handler to application.
- ******************************************************************************/
-#define EXT_SIGNAL_PB0_PRESSED		4
-#define EXT_SIGNAL_PB0_RELEASED		5
-#define EXT_SIGNAL_PB1_PRESSED		6
-#define EXT_SIGNAL_PB1_RELEASED		7
-
 ////////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES & DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sample_rate.h
+ *
+ * @brief Adaptive sampling period, driven by the rate of change of the
+ * readings.
+ *
+ * sampleRate_Update() takes each reading and returns the period until the
+ * next one. While the readings change, the period is set so that the next
+ * reading should differ from this one by about the step: the faster the
+ * temperature moves, the shorter the period. While they stay within the
+ * stable band of the previous reading, the period doubles every reading
+ * up to the maximum. Near a threshold (within the margin, or heading for
+ * it at the current rate) the period is held at or below the near period,
+ * so a crossing is seen within it. The period never leaves the minimum
+ * and maximum.
+ *
+ * The configuration may be replaced at any time with sampleRate_Configure();
+ * the readings seen so far are kept and the next period follows the new
+ * policy. A configuration with the same minimum and maximum is a fixed
+ * period.
+ *
+ * The module only depends on the C library so that the host benchmark can
+ * link it on its own.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SAMPLE_RATE_H_
+#define SRC_HEADERS_SAMPLE_RATE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define SAMPLE_RATE_THRESHOLDS_MAX	4
+
+/* MCP9808 policy, in ms and milli-degrees C. The minimum is the sensor's
+ * conversion time at full resolution; a change of one LSB (62.5 mC) counts
+ * as stable. */
+#define SAMPLE_RATE_MIN_MS			250
+#define SAMPLE_RATE_BASE_MS			1000		// First period, and the near period
+#define SAMPLE_RATE_MAX_MS			60000
+#define SAMPLE_RATE_STEP_MC			250
+#define SAMPLE_RATE_STABLE_MC		63
+#define SAMPLE_RATE_MARGIN_MC		1000
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t min_ms;
+	uint32_t max_ms;
+	uint32_t base_ms;						// Period after the first reading
+	uint32_t near_ms;						// Longest period near a threshold
+	int32_t step;							// Change aimed for between two readings
+	int32_t stable;							// Largest change that counts as none
+	int32_t margin;							// Near a threshold within this
+	uint8_t thresholds;						// Used entries of threshold[]
+	int32_t threshold[SAMPLE_RATE_THRESHOLDS_MAX];
+} sample_rate_config_t;
+
+typedef struct
+{
+	uint32_t readings;
+	uint32_t stable;						// Readings that doubled the period
+	uint32_t faster;						// ... that shortened it
+	uint32_t near;							// ... that a threshold held down
+	uint32_t period_min;					// Shortest and longest period given
+	uint32_t period_max;
+} sample_rate_stats_t;
+
+typedef struct
+{
+	sample_rate_config_t config;
+	bool primed;							// A reading has been seen
+	uint32_t last_ms;						// Time and value of the last reading
+	int32_t last;
+	uint32_t period_ms;						// Period given for it
+	sample_rate_stats_t stats;
+} sample_rate_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void sampleRate_Init(sample_rate_t *rate, const sample_rate_config_t *config);
+void sampleRate_Configure(sample_rate_t *rate, const sample_rate_config_t *config);
+uint32_t sampleRate_Update(sample_rate_t *rate, uint32_t now_ms, int32_t value);
+uint32_t sampleRate_Period(const sample_rate_t *rate);
+
+#endif /* SRC_HEADERS_SAMPLE_RATE_H_ */
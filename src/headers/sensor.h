@@ -0,0 +1,135 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor.h
+ *
+ * @brief Sensors described by tables, sampled in batches.
+ *
+ * A sensor is a const descriptor: the bus and 7 bit address, the mesh
+ * device property it measures, the bytes that set it up once, the bytes
+ * that start a conversion and how long that takes, the bytes that select
+ * the result and how many to read, the decode function that turns them
+ * into a value and the report hook that uses the value. Adding a sensor
+ * is a descriptor and a decode function; neither the state machine nor
+ * the event handling change.
+ *
+ * Each sensor has its own period (and slack) on the wakeup coordinator;
+ * its activity only marks it due. Every sensor due on a wakeup goes into
+ * one batch: the conversions of all of them are started back-to-back, one
+ * sleeptimer one-shot waits for the longest, then all results are read
+ * back-to-back. The I2C queue holds the bus, its interrupt and the EM2
+ * block from the first transfer to the last, so a batch costs one I2C
+ * power-up for its conversions and one for its reads (a single one when
+ * no sensor needs a conversion started) however many sensors are in it.
+ *
+ * The decode functions run in the I2C interrupt. The end of the
+ * conversion wait and of the reads are queued as ISR_EVENT_SENSORS_
+ * CONVERTED and ISR_EVENT_SENSORS_READ, and the state machine (state.c)
+ * reads and reports the batch from the main loop.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SENSOR_H_
+#define SRC_HEADERS_SENSOR_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "i2c_queue.h"
+#include "wakeup.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define SENSOR_COMMAND_MAX			I2C_QUEUE_WRITE_MAX
+#define SENSOR_READ_MAX				I2C_QUEUE_READ_MAX
+
+/* Mesh device property IDs of the values. Temperature and light level are
+ * in mesh_device_properties.h; humidity and CO2 come from the later
+ * revision of the property list. */
+#define SENSOR_PROPERTY_TEMPERATURE	0x004F		// Present Ambient Temperature, mC
+#define SENSOR_PROPERTY_LIGHT		0x004E		// Present Ambient Light Level, 0.01 lux
+#define SENSOR_PROPERTY_HUMIDITY	0x0076		// Present Indoor Relative Humidity, 0.01 %
+#define SENSOR_PROPERTY_CO2			0x0008		// Present Ambient CO2 Concentration, ppm
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct sensor sensor_t;
+
+typedef struct
+{
+	const char *name;
+	i2c_queue_t *bus;
+	uint8_t addr;							// 7 bit
+	uint16_t property_id;
+	uint8_t setup[SENSOR_COMMAND_MAX];		// Written once by sensor_Register()
+	uint8_t setup_len;
+	uint8_t trigger[SENSOR_COMMAND_MAX];	// Starts a conversion; none for free running parts
+	uint8_t trigger_len;
+	uint16_t conversion_ms;					// From the trigger to the result
+	uint8_t read_cmd[SENSOR_COMMAND_MAX];	// Written before the read, with a repeated start
+	uint8_t read_cmd_len;
+	uint8_t read_len;
+	bool (*decode)(const uint8_t *raw, int32_t *value);	// I2C interrupt; false for a bad reading
+	void (*report)(sensor_t *sensor);		// Main loop, after a good reading; may be NULL
+	uint32_t period_ms;						// Until the report hook sets another
+	uint32_t slack_ms;
+} sensor_desc_t;
+
+typedef struct
+{
+	uint32_t reads;							// Good readings
+	uint32_t failures;						// Transfers that failed or were refused
+	uint32_t decode_errors;					// Readings the decode function refused
+} sensor_stats_t;
+
+struct sensor
+{
+	sensor_t *next;
+	const sensor_desc_t *desc;
+	wakeup_activity_t activity;
+	bool due;								// Waiting for a batch
+	volatile bool in_batch;				// Cleared in the I2C interrupt if a trigger fails
+	volatile bool valid;					// Good reading in this batch
+	volatile int32_t value;					// Last good reading
+	uint32_t time_ms;						// ... and when it was reported
+	sensor_stats_t stats;
+};
+
+typedef struct
+{
+	uint32_t batches;
+	uint32_t sensors;						// Sensors read, over all batches
+	uint32_t shared;						// Batches of more than one sensor
+	uint32_t conversions;					// Batches that waited for a conversion
+	uint32_t setup_failures;				// Setup writes that failed or were refused
+} sensor_batch_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void sensor_Init(void);
+void sensor_Register(sensor_t *sensor, const sensor_desc_t *desc);
+void sensor_MarkDue(sensor_t *sensor);
+bool sensor_Due(void);
+void sensor_StartBatch(void);
+void sensor_ReadBatch(void);
+void sensor_ReportBatch(void);
+void sensor_SetPeriod(sensor_t *sensor, uint32_t period_ms, uint32_t slack_ms);
+sensor_t *sensor_Find(uint16_t property_id);
+const sensor_t *sensor_List(void);
+const sensor_batch_stats_t *sensor_Stats(void);
+
+#endif /* SRC_HEADERS_SENSOR_H_ */
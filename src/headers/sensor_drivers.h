@@ -0,0 +1,67 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor_drivers.h
+ *
+ * @brief Decode functions of the I2C sensors the friend node can carry
+ * besides the MCP9808, for their sensor descriptors (sensor.h):
+ * - SHT3x humidity sensor: single shot, high repeatability, no clock
+ *   stretching; temperature and humidity words, each with its CRC-8.
+ * - SCD4x CO2 sensor: low power periodic measurement, one result every
+ *   30 s; the CO2 word with its CRC-8, from read_measurement.
+ * - OPT3001 ambient light sensor: continuous conversions of 800 ms, auto
+ *   range; the result register, exponent and mantissa.
+ *
+ * The decode functions run in the I2C interrupt and only use integers.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SENSOR_DRIVERS_H_
+#define SRC_HEADERS_SENSOR_DRIVERS_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* SHT3x, ADDR pin low */
+#define SHT3X_ADDR					0x44
+#define SHT3X_MEASURE_HIGH			0x24, 0x00	// Single shot, high repeatability
+#define SHT3X_CONVERSION_MS			16			// 15.5 ms at high repeatability
+#define SHT3X_READ_LEN				6
+
+/* SCD4x */
+#define SCD4X_ADDR					0x62
+#define SCD4X_START_LOW_POWER		0x21, 0xAC	// start_low_power_periodic_measurement
+#define SCD4X_READ_MEASUREMENT		0xEC, 0x05	// Result 1 ms after the command
+#define SCD4X_COMMAND_MS			1
+#define SCD4X_READ_LEN				3			// The CO2 word and its CRC
+
+/* OPT3001, ADDR pin to VDD */
+#define OPT3001_ADDR				0x45
+#define OPT3001_REG_RESULT			0x00
+#define OPT3001_REG_CONFIG			0x01
+#define OPT3001_CONFIG_CONTINUOUS	0xCE, 0x10	// Auto range, 800 ms, continuous
+#define OPT3001_READ_LEN			2
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+uint8_t sensirion_Crc8(const uint8_t *data, uint8_t len);
+bool sht3x_DecodeHumidity(const uint8_t *raw, int32_t *value);
+bool scd4x_DecodeCo2(const uint8_t *raw, int32_t *value);
+bool opt3001_DecodeLux(const uint8_t *raw, int32_t *value);
+
+#endif /* SRC_HEADERS_SENSOR_DRIVERS_H_ */
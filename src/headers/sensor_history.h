@@ -0,0 +1,115 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor_history.h
+ *
+ * @brief Log-structured sensor history on the external MX25 SPI flash.
+ *
+ * Samples are 8 byte records batched in RAM, one flash page at a time.
+ * A full page is written with a single MX25_PP burst; pages are laid out
+ * as a ring over the history region, page seq at page seq % pages, so the
+ * newest page is found at boot by reading the first page of each sector.
+ *
+ * Flash work is kept out of the event handlers: sensorHistory_Append()
+ * only copies the record, and sensorHistory_Idle(), run from the main
+ * loop when no event is pending, programs full pages and erases the
+ * sector ahead of the write position (MX25_SE) before it is needed. The
+ * chip is in MX25_DP deep power-down between these sessions. Only when
+ * both page buffers are full, or the sector ahead is still not erased,
+ * does the work happen inline; both cases are counted.
+ *
+ * The flash shares USART1 with the LCD, so every session routes the bus
+ * to the flash with MX25_init() and hands it back with PAL_SpiInit().
+ *
+ * The module only depends on the MX25 and display PAL drivers so that
+ * the host benchmark can link it against the flash model on its own.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SENSOR_HISTORY_H_
+#define SRC_HEADERS_SENSOR_HISTORY_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* History region on the MX25, whole sectors. */
+#ifndef SENSOR_HISTORY_FLASH_BASE
+#define SENSOR_HISTORY_FLASH_BASE		0x000000
+#endif
+#ifndef SENSOR_HISTORY_FLASH_SIZE
+#define SENSOR_HISTORY_FLASH_SIZE		0x100000						// Whole MX25R8035F
+#endif
+
+#define SENSOR_HISTORY_PAGE_SIZE		256								// One MX25_PP burst
+#define SENSOR_HISTORY_SECTOR_SIZE		4096							// One MX25_SE
+#define SENSOR_HISTORY_SECTOR_PAGES		(SENSOR_HISTORY_SECTOR_SIZE / SENSOR_HISTORY_PAGE_SIZE)
+#define SENSOR_HISTORY_PAGES			(SENSOR_HISTORY_FLASH_SIZE / SENSOR_HISTORY_PAGE_SIZE)
+#define SENSOR_HISTORY_PAGE_RECORDS		31								// (256 - 8 B header) / 8 B
+
+/* Pages kept erased ahead of the write position by sensorHistory_Idle(). */
+#define SENSOR_HISTORY_ERASE_AHEAD		SENSOR_HISTORY_SECTOR_PAGES
+
+/* Record source of the MCP9808 readings; LPN readings use the LPN address. */
+#define SENSOR_HISTORY_TEMPERATURE		0x0000
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint32_t time;							// Seconds since boot
+	uint16_t source;						// SENSOR_HISTORY_TEMPERATURE or LPN address
+	int16_t value;							// Centi-degrees C or generic level
+} sensor_history_record_t;
+
+/* One flash page; erased flash reads seq 0xFFFFFFFF. */
+typedef struct
+{
+	uint32_t seq;							// Page number since the region was blank
+	uint16_t boot;							// Boot count when written, orders record times
+	uint16_t count;							// Records used, short only when flushed before a reset
+	sensor_history_record_t record[SENSOR_HISTORY_PAGE_RECORDS];
+} sensor_history_page_t;
+
+typedef struct
+{
+	uint32_t appends;						// Records accepted
+	uint32_t dropped;						// Records lost: flash missing or both buffers busy
+	uint32_t pages;							// Pages programmed
+	uint32_t partial_pages;					// ... of them flushed before they were full
+	uint32_t erases;						// Sectors erased
+	uint32_t sessions;						// Times the flash was woken from deep power-down
+	uint32_t display_waits;					// Wake-ups that waited for an LCD frame to go out
+	uint32_t inline_writes;					// Pages programmed from sensorHistory_Append()
+	uint32_t inline_erases;					// Sectors erased because the idle hook fell behind
+	uint32_t errors;						// MX25 calls that did not succeed
+	uint32_t recovered;						// Pages found by the boot scan
+} sensor_history_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+bool sensorHistory_Init(void);
+void sensorHistory_Append(uint16_t source, uint32_t time, int16_t value);
+void sensorHistory_Idle(void);
+void sensorHistory_Flush(void);
+bool sensorHistory_ReadPage(uint32_t age, sensor_history_page_t *page);
+uint32_t sensorHistory_PageCount(void);
+void sensorHistory_GetStats(sensor_history_stats_t *stats);
+
+#endif /* SRC_HEADERS_SENSOR_HISTORY_H_ */
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file series_codec.h
+ *
+ * @brief Streaming compression of (time, value) sensor samples, after the
+ * Gorilla time-series encoding.
+ *
+ * Samples are packed MSB first into a caller-provided block. The first
+ * sample of a block is stored raw (32 bit time, 16 bit value); after that
+ * each time is stored as the change of its delta to the previous sample
+ * (delta-of-delta) and each value as the zig-zag coded change from the
+ * previous value, both behind a short prefix choosing the field width:
+ *
+ *   time	'0'				same interval as before
+ *			'10'   + 7 bits	dod -64..63 s (zig-zag)
+ *			'110'  + 9 bits	dod -256..255 s
+ *			'1110' + 12 bits	dod -2048..2047 s
+ *			'1111' + 32 bits	raw interval
+ *
+ *   value	'0'				same value as before
+ *			'10'  + 4 bits	change -8..7 (zig-zag)
+ *			'110' + 8 bits	change -128..127
+ *			'111' + 16 bits	raw value
+ *
+ * Values are integers (centi-degrees, generic levels), so zig-zag deltas
+ * take the place of Gorilla's XOR of floating point values. A sample at a
+ * steady rate with an unchanged reading costs 2 bits.
+ *
+ * Encoder and decoder state is a few words; the only other memory is the
+ * block itself. Blocks decode on their own, so a history store can use a
+ * flash page payload as the block. The module only depends on the C
+ * library so that the host benchmark can link it on its own.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SERIES_CODEC_H_
+#define SRC_HEADERS_SERIES_CODEC_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define SERIES_CODEC_FIRST_BITS		48			// Raw time and value of a block's first sample
+#define SERIES_CODEC_MAX_BITS		55			// Worst case of any later sample
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint8_t *block;
+	uint32_t size_bits;
+	uint32_t bits;							// Bits used so far
+	uint16_t count;							// Samples in the block
+	uint32_t time;							// Previous sample
+	int32_t delta;
+	int16_t value;
+} series_codec_encoder_t;
+
+typedef struct
+{
+	const uint8_t *block;
+	uint32_t size_bits;
+	uint32_t bits;							// Bits read so far
+	uint16_t remaining;						// Samples still to decode
+	bool first;
+	uint32_t time;							// Previous sample
+	int32_t delta;
+	int16_t value;
+} series_codec_decoder_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void seriesCodec_EncoderInit(series_codec_encoder_t *encoder, uint8_t *block, uint16_t size);
+bool seriesCodec_Encode(series_codec_encoder_t *encoder, uint32_t time, int16_t value);
+uint16_t seriesCodec_EncodedSize(const series_codec_encoder_t *encoder);
+void seriesCodec_DecoderInit(series_codec_decoder_t *decoder, const uint8_t *block, uint16_t size, uint16_t count);
+bool seriesCodec_Decode(series_codec_decoder_t *decoder, uint32_t *time, int16_t *value);
+
+#endif /* SRC_HEADERS_SERIES_CODEC_H_ */
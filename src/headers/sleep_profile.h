@@ -0,0 +1,72 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sleep_profile.h
+ *
+ * @brief Energy mode residency profiler header file.
+ *
+ * Hooks the SLEEP driver callbacks to count how often and for how long the
+ * node sits in each energy mode. Sleep blocks taken through
+ * sleepProfile_BlockBegin() are tagged with the subsystem holding them, so
+ * time spent above the deepest allowed mode is charged to that blocker.
+ * Time is measured on the RTCC counter that init_mcu.c clocks from LFXO;
+ * it keeps counting in EM2, which is the deepest mode the stack uses.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_SLEEP_PROFILE_H_
+#define SRC_HEADERS_SLEEP_PROFILE_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+/* Header File */
+#include "header.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define SLEEP_PROFILE_CLOCK_HZ		32768		// RTCC tick rate (LFXO, no prescaler)
+#define SLEEP_PROFILE_EM_COUNT		4			// EM0 (awake) to EM3; EM4 ends in a reset
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Subsystems that hold sleep blocks. */
+typedef enum
+{
+	SLEEP_BLOCKER_I2C,
+	SLEEP_BLOCKER_DISPLAY,				// LCD frame on the LDMA (EM1)
+	SLEEP_BLOCKER_OTHER,				// Untagged SLEEP_SleepBlockBegin() callers (e.g. the stack)
+	SLEEP_BLOCKER_COUNT
+} sleep_blocker_t;
+
+typedef struct
+{
+	uint32_t entries[SLEEP_PROFILE_EM_COUNT];		// Entries per mode (EM0: wake-ups)
+	uint64_t residency[SLEEP_PROFILE_EM_COUNT];		// Ticks spent per mode
+	uint64_t total;									// Ticks since sleepProfile_Reset()
+	uint32_t block_begins[SLEEP_BLOCKER_COUNT];		// Sleep blocks taken per blocker
+	uint64_t blocked[SLEEP_BLOCKER_COUNT];			// Sleep ticks kept above EM3 per blocker
+} sleep_profile_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void sleepProfile_Init(void);
+void sleepProfile_Reset(void);
+void sleepProfile_BlockBegin(SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker);
+void sleepProfile_BlockEnd(SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker);
+void sleepProfile_Get(sleep_profile_t *profile);
+const char *sleepProfile_BlockerName(sleep_blocker_t blocker);
+void sleepProfile_Tick(void);
+
+#endif /* SRC_HEADERS_SLEEP_PROFILE_H_ */
@@ -20,74 +20,25 @@
 
 /* Header File */
 #include "header.h"
+#include "time_series.h"
+#include "sample_rate.h"
+#include "sensor.h"
+#include "fsm.h"
+#include "event_ring.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // DEFINE STATEMENTS
 ////////////////////////////////////////////////////////////////////////////////
 
-/* Flag Macros */
-
-/* Flag check succeeds if the flag is set. */
-/* Flag set writes 1 to the flag bit position. */
-/* Flag clear writes 0 to the flag bit position. */
-
-#define LETIMER_WAIT_FLAG_SET()					(interrupt_event_bitmask |= 0x01)
-#define LETIMER_WAIT_FLAG_CLEAR()				(interrupt_event_bitmask &= 0xFE)
-#define LETIMER_WAIT_FLAG_CHECK()				({	\
-													uint8_t flag; \
-													flag = interrupt_event_bitmask & 0x01; \
-													flag; \
-												})
-
-#define TEMP_I2C_WRITE_FLAG_SET()				(interrupt_event_bitmask |= 0x04)
-#define TEMP_I2C_WRITE_FLAG_CLEAR()				(interrupt_event_bitmask &= 0xFB)
-#define TEMP_I2C_WRITE_FLAG_CHECK()				({	\
-													uint8_t flag; \
-													flag = interrupt_event_bitmask & 0x04; \
-													flag; \
-												})
-
-#define TEMP_I2C_READ_FLAG_SET()				(interrupt_event_bitmask |= 0x10)
-#define TEMP_I2C_READ_FLAG_CLEAR()				(interrupt_event_bitmask &= 0xEF)
-#define TEMP_I2C_READ_FLAG_CHECK()				({	\
-													uint8_t flag; \
-													flag = interrupt_event_bitmask & 0x10; \
-													flag; \
-												})
-
-#define P_LETIMER_WAIT_FLAG_SET()				(event_processing_bitmask |= 0x01)
-#define P_LETIMER_WAIT_FLAG_CLEAR()				(event_processing_bitmask &= 0xFE)
-#define P_LETIMER_WAIT_FLAG_CHECK()				({	\
-													uint8_t flag; \
-													flag = event_processing_bitmask & 0x01; \
-													flag; \
-												})
-
-#define P_TEMP_I2C_WRITE_FLAG_SET()				(event_processing_bitmask |= 0x04)
-#define P_TEMP_I2C_WRITE_FLAG_CLEAR()			(event_processing_bitmask &= 0xFB)
-#define P_TEMP_I2C_WRITE_FLAG_CHECK()			({	\
-													uint8_t flag; \
-													flag = event_processing_bitmask & 0x04; \
-													flag; \
-												})
-
-#define P_TEMP_I2C_READ_FLAG_SET()				(event_processing_bitmask |= 0x10)
-#define P_TEMP_I2C_READ_FLAG_CLEAR()			(event_processing_bitmask &= 0xEF)
-#define P_TEMP_I2C_READ_FLAG_CHECK()			({	\
-													uint8_t flag; \
-													flag = event_processing_bitmask & 0x10; \
-													flag; \
-												})
-
-/* Clearing unnecessary bits in the event_processing_bitmask variable. */
-
-#define EVT_PR_BITM_CLEAR_EXTRA()				(event_processing_bitmask &= 0x1F)
-
-/* State Machine External Event States */
-
-#define GECKO_LETIMER_WAIT_FLAG				1
-#define GECKO_TEMP_I2C_WRITE_FLAG			2
-#define GECKO_TEMP_I2C_READ_FLAG			3
+/* External signal that wakes the main loop to drain isr_event_ring. */
+#define GECKO_ISR_EVENT_SIGNAL				0x01
+/* External signal that wakes the main loop once an LCD frame is sent. */
+#define GECKO_DISPLAY_SENT_SIGNAL			0x02
+
+/* Sensor history channels and clock (seconds since boot). */
+#define SENSOR_SERIES_TEMPERATURE			0
+#define SENSOR_SERIES_LPN(slot)				(1 + (slot))
+#define SENSOR_SERIES_NOW()					wakeup_TimeS()
 
 ////////////////////////////////////////////////////////////////////////////////
 // GLOBAL VARIABLES & DEFINITIONS
@@ -95,35 +46,64 @@
 
 enum states
 {
-	/* State begins MCP9808 I2C write transaction. */
-	STATE0_MCP9808_TRANSACTION_START_EVENT,
-
-	/* State begins MCP9808 I2C read transaction. */
-	STATE1_MCP9808_I2C_WRITE_COMPLETED_EVENT,
+	/* Waiting for a sensor to be due. */
+	STATE0_SENSORS_IDLE,
 
-	/* State reports temperature readings. */
-	STATE2_MCP9808_I2C_READ_COMPLETED_EVENT,
+	/* A batch of sensors converting or being read (sensor.h). */
+	STATE1_SENSORS_BATCH,
 
 	/* Contains the number of states */
 	NUM_STATES
 };
 
+enum events
+{
+	EVENT0_SENSORS_DUE,
+	EVENT1_SENSORS_CONVERTED,
+	EVENT2_SENSORS_READ,
+
+	/* Contains the number of events */
+	NUM_EVENTS
+};
+
+/* Events queued by the interrupt handlers, payload in brackets. */
+enum isr_events
+{
+	ISR_EVENT_SENSORS_READ,					// Readings of the batch decoded
+	ISR_EVENT_PB0,							// [1 pressed, 0 released]
+	ISR_EVENT_PB1,							// [1 pressed, 0 released]
+	ISR_EVENT_WAKEUP,						// Periodic activities due (wakeup.h)
+	ISR_EVENT_MCP9808_ALERT,				// [1 still asserted after a rearm, 0 edge]
+	ISR_EVENT_SENSORS_CONVERTED,			// Conversions of the batch done
+};
+
+event_ring_t isr_event_ring;
+
+/* Sensor batch state machine and its per-state counters */
+
+fsm_t sensor_fsm;
+fsm_state_stats_t sensor_fsm_stats[NUM_STATES];
+
+/* The MCP9808, read in the sensor batches; ALERT edges mark it due. */
+sensor_t mcp9808_sensor;
+
 /* Event flag variables */
 
-volatile uint8_t event_processing_bitmask;
-volatile uint8_t interrupt_event_bitmask;
 extern uint8_t timerEnabled1HzSchedulerEvent;
-extern volatile float temp_reading;
+
+/* MCP9808 sampling period, from the rate of change of the readings. */
+sample_rate_t mcp9808_sample_rate;
+
+/* Sensor history: the MCP9808 temperature and the level of each LPN slot. */
+time_series_t sensor_series;
 
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION PROTOTYPES
 ////////////////////////////////////////////////////////////////////////////////
 
-void sm_ClearInt(void);
-void sm_HandleEvents(int current_state);
 const char *getStateReport(int current_state);
 void sm_Init(void);
-void sm_HandleReset(int current_state);
+void sm_Handle(uint8_t event);
 void sm_ReportState(int current_state);
 
 #endif /* SRC_STATE_H_ */
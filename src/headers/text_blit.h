@@ -0,0 +1,74 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file text_blit.h
+ *
+ * @brief Text drawn straight into the 1 bpp DMD frame buffer.
+ *
+ * GLIB_drawChar() draws a glyph one pixel at a time through
+ * GLIB_drawPixel(), each pixel clipped, its colour translated and written
+ * with a DMD_writeColor() read-modify-write. For the fixed fonts with
+ * one byte per glyph row (GLIB_FontNarrow6x8, GLIB_FontNormal8x8) the
+ * glyph rows of a whole string are instead shifted into a line of 32 bit
+ * words and combined with the frame buffer (DMD_getFrameBuffer()) one
+ * word at a time, one line per font row. The lines drawn are marked dirty
+ * in the DMD dirty row bitmap, as DMD_writeColor() would.
+ *
+ * Both the frame buffer and the font rows keep the leftmost pixel in the
+ * least significant bit, so on the little-endian Cortex-M4 a bit of the
+ * line words is the same pixel in the frame buffer. The LS013B7DH03 rows
+ * are 18 bytes (16 of pixels, 2 control), so the words are unaligned;
+ * the M4 loads and stores those in one access.
+ *
+ * Only a foreground over what is already there (GLIB_drawString() with
+ * opaque false) is drawn. Text that does not fit the display, characters
+ * outside ' ' to '~' and other fonts are left to GLIB.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_TEXT_BLIT_H_
+#define SRC_HEADERS_TEXT_BLIT_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "glib.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define TEXT_BLIT_WIDTH_MAX			256			// Pixels per line
+#define TEXT_BLIT_LINE_WORDS		(TEXT_BLIT_WIDTH_MAX / 32)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	uint8_t *frame;							// DMD_getFrameBuffer()
+	uint16_t bytes_per_line;				// Pixels and control bytes
+	uint16_t width;
+	uint16_t height;
+	bool inverse;							// A set bit is white (DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)
+} text_blit_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+bool textBlit_Init(text_blit_t *blit);
+bool textBlit_Supports(const text_blit_t *blit, const GLIB_Font_t *font);
+bool textBlit_String(const text_blit_t *blit, const GLIB_Context_t *context, const char *text, uint8_t len,
+					 uint16_t x, uint16_t y);
+
+#endif /* SRC_HEADERS_TEXT_BLIT_H_ */
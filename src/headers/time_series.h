@@ -0,0 +1,129 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file time_series.h
+ *
+ * @brief Fixed-memory time-series store for the sensor readings seen by
+ * the friend node.
+ *
+ * Each channel keeps the newest raw sample of each of the last
+ * TIME_SERIES_RAW_SAMPLES slots of TIME_SERIES_RAW_STEP seconds, so the
+ * raw window covers TIME_SERIES_RAW_MINUTES whatever the sampling rate
+ * (the temperature channel samples every 250 ms to 1 s near a threshold,
+ * the LPNs about every 20 s), and
+ * min/max/mean rollups for the last TIME_SERIES_MINUTES minutes and
+ * TIME_SERIES_HOURS hours. Rollup rings are indexed by minute (hour)
+ * number, so a bucket's time is implied by its position and empty buckets
+ * mark gaps. The minute and hour rollups are accumulated from the raw
+ * samples separately, so both means are exact. All memory is in the store
+ * itself; inserting a sample is O(1) apart from clearing buckets skipped
+ * by a gap, which is bounded by the ring sizes.
+ *
+ * Values are 16 bit: generic levels for LPN channels, centi-degrees
+ * Celsius for the temperature channel. Times are seconds on a clock the
+ * caller provides.
+ *
+ * The module only depends on the C library so that the host benchmark can
+ * link it on its own.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_TIME_SERIES_H_
+#define SRC_HEADERS_TIME_SERIES_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIME_SERIES_CHANNELS
+#define TIME_SERIES_CHANNELS		16			// Temperature and the first 15 LPN slots
+#endif
+
+#define TIME_SERIES_RAW_MINUTES		5			// Raw window queried by timeSeries_RawCount()
+#define TIME_SERIES_RAW_STEP		20			// Seconds per raw slot, the newest sample is kept
+#define TIME_SERIES_RAW_SAMPLES		16			// 5 minutes and the slot being filled
+
+#if (TIME_SERIES_RAW_SAMPLES - 1) * TIME_SERIES_RAW_STEP < TIME_SERIES_RAW_MINUTES * 60
+#error "time_series.h: the raw slots do not cover TIME_SERIES_RAW_MINUTES"
+#endif
+#define TIME_SERIES_MINUTES			15
+#define TIME_SERIES_HOURS			24
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	TIME_SERIES_MINUTE,
+	TIME_SERIES_HOUR
+} time_series_resolution_t;
+
+typedef struct
+{
+	uint16_t time;							// Seconds, low 16 bits
+	int16_t value;
+} time_series_sample_t;
+
+/* A closed bucket; count 0 marks a bucket without samples. */
+typedef struct
+{
+	int16_t min;
+	int16_t max;
+	int16_t mean;
+	uint16_t count;
+} time_series_rollup_t;
+
+/* The bucket still being filled. */
+typedef struct
+{
+	uint32_t index;							// Minute or hour number
+	int32_t sum;
+	int16_t min;
+	int16_t max;
+	uint16_t count;
+} time_series_acc_t;
+
+typedef struct
+{
+	uint32_t last_time;						// Seconds of the newest sample
+	uint16_t raw_head;						// Next raw slot to write
+	uint16_t raw_count;
+	time_series_sample_t raw[TIME_SERIES_RAW_SAMPLES];
+	time_series_acc_t acc[2];				// Open minute and hour buckets
+	time_series_rollup_t minutes[TIME_SERIES_MINUTES];
+	time_series_rollup_t hours[TIME_SERIES_HOURS];
+} time_series_channel_t;
+
+/* An all-zero store is valid and empty. */
+typedef struct
+{
+	uint32_t inserts;
+	uint32_t dropped;						// Samples for channels out of range
+	time_series_channel_t channel[TIME_SERIES_CHANNELS];
+} time_series_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void timeSeries_Init(time_series_t *series);
+bool timeSeries_Insert(time_series_t *series, uint16_t channel, uint32_t time, int16_t value);
+bool timeSeries_Raw(const time_series_t *series, uint16_t channel, uint16_t age, uint32_t *time, int16_t *value);
+uint16_t timeSeries_RawCount(const time_series_t *series, uint16_t channel, uint32_t now);
+bool timeSeries_Rollup(const time_series_t *series, uint16_t channel, time_series_resolution_t resolution,
+					   uint32_t now, uint16_t age, time_series_rollup_t *rollup);
+
+#endif /* SRC_HEADERS_TIME_SERIES_H_ */
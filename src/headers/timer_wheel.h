@@ -0,0 +1,124 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file timer_wheel.h
+ *
+ * @brief Hierarchical timer wheel, multiplexing any number of software
+ * timers onto one hardware (stack soft) timer.
+ *
+ * The wheel counts in ticks of 1/1024 s. It has TIMER_WHEEL_LEVELS levels
+ * of 64 slots; a slot of level n spans 8^n ticks, so level 0 holds timers
+ * due within 60 ms at 1 ms resolution, level 1 within half a second at
+ * 8 ms, and so on up to about 33 minutes at 32 s. A timer goes to the
+ * lowest level whose range covers it and its deadline is rounded up to the
+ * end of its slot: it never fires early, fires less than 1/7 of its delay
+ * late, and all timers of a slot expire in the same wakeup. Timers further
+ * out than the top level are parked in its last slot and re-queued when
+ * it comes round.
+ *
+ * Timers are caller-allocated and linked into their slot, so starting and
+ * stopping one is O(1) and the wheel never allocates. A 64 bit occupancy
+ * map per level finds the next due slot with a few count-trailing-zeros,
+ * and the wheel skips straight to it: the work per wakeup does not depend
+ * on how long the node slept. Slots are never cascaded into lower levels.
+ *
+ * The wheel programs its hardware timer through the arm callback, only
+ * when the next due slot moves earlier or the wheel runs empty; a timer
+ * stopped before its slot is due may therefore cost one empty wakeup.
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_TIMER_WHEEL_H_
+#define SRC_HEADERS_TIMER_WHEEL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIMER_WHEEL_HZ				1024
+#define TIMER_WHEEL_LEVELS			6
+#define TIMER_WHEEL_SLOT_BITS		6			// 64 slots per level
+#define TIMER_WHEEL_SLOTS			(1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVEL_SHIFT		3			// Each level 8 times coarser
+
+/* A level takes delays below this many of its slots, leaving room for the
+ * round-up and the partly elapsed current slot. */
+#define TIMER_WHEEL_LEVEL_RANGE		(TIMER_WHEEL_SLOTS - 2)
+
+/* Wheel ticks to and from the 32768 Hz ticks of the RTCC and the stack soft timers. */
+#define TIMER_WHEEL_RTCC_SHIFT		5
+#define TIMER_WHEEL_FROM_RTCC(t)	(((uint32_t) (t) + (1UL << TIMER_WHEEL_RTCC_SHIFT) - 1) >> TIMER_WHEEL_RTCC_SHIFT)
+#define TIMER_WHEEL_TO_RTCC(t)		((uint32_t) (t) << TIMER_WHEEL_RTCC_SHIFT)
+#define TIMER_WHEEL_MS(ms)			((((uint32_t) (ms)) * TIMER_WHEEL_HZ + 999) / 1000)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct timer_wheel_timer timer_wheel_timer_t;
+
+typedef void (*timer_wheel_callback_t)(timer_wheel_timer_t *timer);
+
+struct timer_wheel_timer
+{
+	timer_wheel_timer_t *next;
+	timer_wheel_timer_t **pprev;			// Link pointing at this timer, NULL when stopped
+	uint32_t expires;						// Wheel ticks
+	uint32_t period;						// Wheel ticks, 0 for a one-shot timer
+	timer_wheel_callback_t callback;
+	void *context;							// For the callback
+};
+
+typedef struct
+{
+	uint32_t starts;						// timerWheel_Start() calls
+	uint32_t stops;							// ... and timerWheel_Stop() calls on a running timer
+	uint32_t fired;							// Callbacks run
+	uint32_t requeued;						// Timers parked beyond the top level, moved on
+	uint32_t slots;							// Slots expired
+	uint32_t wakeups;						// timerWheel_Run() calls
+	uint32_t empty_wakeups;					// ... that found nothing due
+	uint32_t arms;							// Hardware timer programmed or stopped
+	uint32_t late_max;						// Most ticks a callback ran after its deadline
+	uint32_t count_max;						// Most timers running at once
+} timer_wheel_stats_t;
+
+typedef struct
+{
+	timer_wheel_timer_t *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+	uint64_t occupied[TIMER_WHEEL_LEVELS];	// Bit per non-empty slot
+	uint32_t clk;							// Wheel time, every slot due up to it has run
+	uint32_t armed;							// Deadline the hardware timer is set for
+	bool is_armed;
+	bool running;							// In timerWheel_Run(), arm once at the end
+	uint32_t count;							// Timers running
+	uint32_t (*clock)(void);				// Now, in wheel ticks (RTCC by default)
+	void (*arm)(uint32_t ticks);			// Fire in ticks (at least 1), 0 to stop
+	timer_wheel_stats_t stats;
+} timer_wheel_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void timerWheel_Init(timer_wheel_t *wheel, uint32_t (*clock)(void), void (*arm)(uint32_t ticks));
+void timerWheel_Setup(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *context);
+void timerWheel_Start(timer_wheel_t *wheel, timer_wheel_timer_t *timer, uint32_t delay, uint32_t period);
+void timerWheel_Stop(timer_wheel_t *wheel, timer_wheel_timer_t *timer);
+bool timerWheel_Pending(const timer_wheel_timer_t *timer);
+void timerWheel_Run(timer_wheel_t *wheel);
+bool timerWheel_Next(timer_wheel_t *wheel, uint32_t *ticks);
+
+#endif /* SRC_HEADERS_TIMER_WHEEL_H_ */
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file wakeup.h
+ *
+ * @brief Tickless wakeup coordinator for the periodic activities (sensor
+ * sampling, LCD EXTCOMIN and the display refresh).
+ *
+ * Each activity has a period and a slack: it is due every period and may
+ * run up to slack earlier or later than that. Rather than a timer per
+ * activity, the coordinator keeps one sleeptimer (RTCC) one-shot. It wakes
+ * at the latest due time that comes before any activity runs out of slack,
+ * and then runs every activity whose window has opened. An activity due
+ * shortly after another therefore rides along with it instead of waking
+ * the node on its own.
+ *
+ * An activity that keeps its phase is rescheduled one period after its
+ * last due time, so the slack it used does not add up (sampling). Any
+ * other one is rescheduled one period after it actually ran, which locks
+ * it onto the wakeup it shared (the LCD, whose EXTCOMIN only has to toggle
+ * about once a second): activities of the same period end up on a single
+ * wakeup per period.
+ *
+ * wakeup_SetPeriod() changes the period of a running activity in place:
+ * it becomes due one new period after its last due time (or from now, if
+ * that has passed), and only the sleeptimer one-shot is moved.
+ *
+ * The sleeptimer callback runs in the RTCC interrupt; it only queues
+ * ISR_EVENT_WAKEUP, the activities run from the main loop in wakeup_Run().
+ *
+ * @author Rushi James Macwan
+ */
+
+#ifndef SRC_HEADERS_WAKEUP_H_
+#define SRC_HEADERS_WAKEUP_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Periods and slacks of the activities. The MCP9808 sample period is set
+ * after every reading (sample_rate.h), with a slack of a twentieth of it. */
+#define WAKEUP_SAMPLE_PERIOD_MS		1000		// Until the first reading, and at or above T_CRIT
+#define WAKEUP_SAMPLE_SLACK_DIV		20			// Keeps the sample interval within 5%
+#define WAKEUP_LCD_PERIOD_MS		1000
+#define WAKEUP_LCD_SLACK_MS			500			// EXTCOMIN toggles every 0.5 to 1.5 s
+#define WAKEUP_PROFILE_PERIOD_MS	60000		// One energy mode report a minute
+#define WAKEUP_PROFILE_SLACK_MS		30000		// Rides on whichever wakeup comes
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct wakeup_activity wakeup_activity_t;
+
+typedef struct
+{
+	uint32_t runs;							// Times the activity ran
+	uint32_t shared;						// ... on a wakeup another activity also ran on
+	uint32_t early_max;						// Most ticks it ran before its due time
+	uint32_t late_max;						// ... and after it
+} wakeup_activity_stats_t;
+
+struct wakeup_activity
+{
+	wakeup_activity_t *next;
+	const char *name;
+	void (*run)(void *context);
+	void *context;							// For run()
+	uint32_t period;						// Sleeptimer ticks
+	uint32_t slack;							// Sleeptimer ticks
+	bool keep_phase;						// Reschedule from the due time, not the run time
+	bool active;
+	uint32_t due;							// Sleeptimer tick count
+	wakeup_activity_stats_t stats;
+};
+
+typedef struct
+{
+	uint32_t wakeups;						// Sleeptimer wakeups taken
+	uint32_t empty_wakeups;					// ... that found nothing due
+	uint32_t runs;							// Activity runs, a wakeup each without the coordinator
+	uint32_t arms;							// Sleeptimer (re)started
+} wakeup_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+void wakeup_Init(void);
+void wakeup_Setup(wakeup_activity_t *activity, const char *name, void (*run)(void *context), void *context,
+				  uint32_t period_ms, uint32_t slack_ms, bool keep_phase);
+void wakeup_Start(wakeup_activity_t *activity);
+void wakeup_Stop(wakeup_activity_t *activity);
+void wakeup_SetPeriod(wakeup_activity_t *activity, uint32_t period_ms, uint32_t slack_ms);
+void wakeup_Run(void);
+uint32_t wakeup_TimeMs(void);
+uint32_t wakeup_TimeS(void);
+const wakeup_stats_t *wakeup_Stats(void);
+const wakeup_activity_t *wakeup_Activities(void);
+
+#endif /* SRC_HEADERS_WAKEUP_H_ */
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file alarm_journal.c
+ *
+ * @brief Append-only alarm event journal source file.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <src/headers/alarm_journal.h>
+#include "nvm3.h"
+#include "nvm3_default.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static alarm_journal_stats_t journal_stats;
+
+static bool journal_open;						// NVM3 opened by alarmJournal_Init()
+static uint16_t journal_boot;					// Boot count of this run
+static uint32_t journal_next;					// Sequence number of the next record
+static uint32_t journal_count;					// Valid records, at most ALARM_JOURNAL_SLOTS
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Read the record stored in a slot.
+ *
+ * @param uint32_t slot, alarm_journal_record_t *record
+ * @return bool True if the slot holds a record that belongs there.
+ */
+static bool alarmJournal_ReadSlot(uint32_t slot, alarm_journal_record_t *record)
+{
+	if(nvm3_readData(nvm3_defaultHandle, ALARM_JOURNAL_KEY_BASE + slot, record, sizeof(*record)) != ECODE_NVM3_OK)
+	{
+		return false;
+	}
+	return (record->seq % ALARM_JOURNAL_SLOTS) == slot;
+}
+
+/**
+ * @brief Journal setup, must run before gecko_stack_init().
+ *
+ * The stack opens the default NVM3 instance; giving it repack headroom here
+ * makes nvm3_repackNeeded() report early enough for alarmJournal_Idle() to
+ * repack before any write is forced to.
+ *
+ * @param void
+ * @return void.
+ */
+void alarmJournal_Setup(void)
+{
+	nvm3_defaultInit->repackHeadroom = ALARM_JOURNAL_REPACK_HEADROOM;
+}
+
+/**
+ * @brief Journal initialisation function, run once the stack is up.
+ *
+ * Bumps the boot counter and finds the newest record. The scan reads each
+ * of the ALARM_JOURNAL_SLOTS keys exactly once, however many records have
+ * been written, and skips slots that are empty or hold a stray record.
+ *
+ * @param void
+ * @return void.
+ */
+void alarmJournal_Init(void)
+{
+	alarm_journal_record_t record;
+	uint32_t boot = 0;
+	uint32_t newest = 0;
+
+	memset(&journal_stats, 0, sizeof(journal_stats));
+	journal_next = 0;
+	journal_count = 0;
+
+	/* Already open by the stack with the same parameters, this only hands over the handle. */
+	journal_open = (nvm3_open(nvm3_defaultHandle, nvm3_defaultInit) == ECODE_NVM3_OK);
+	if(!journal_open)
+	{
+		LOG_ERROR("Alarm journal: NVM3 not available.");
+		return;
+	}
+
+	if(nvm3_readCounter(nvm3_defaultHandle, ALARM_JOURNAL_KEY_BOOT, &boot) != ECODE_NVM3_OK)
+	{
+		boot = 0;
+	}
+	journal_boot = (uint16_t) ++boot;
+	nvm3_writeCounter(nvm3_defaultHandle, ALARM_JOURNAL_KEY_BOOT, boot);
+
+	for(uint32_t slot = 0; slot < ALARM_JOURNAL_SLOTS; slot++)
+	{
+		if(!alarmJournal_ReadSlot(slot, &record))
+			continue;
+
+		if(!journal_count || record.seq > newest)
+			newest = record.seq;
+		journal_count++;
+	}
+
+	journal_stats.recovered = journal_count;
+	if(journal_count)
+		journal_next = newest + 1;
+
+	LOG_INFO("Alarm journal: boot %u, %lu records, next %lu", journal_boot,
+			 (unsigned long) journal_count, (unsigned long) journal_next);
+}
+
+/**
+ * @brief Append one record, overwriting the oldest once the ring is full.
+ *
+ * This is a single small NVM3 write. Page erases are left to
+ * alarmJournal_Idle(), so the call is safe from the mesh request handlers.
+ *
+ * @param uint16_t addr, uint16_t level, alarm_journal_event_t type
+ * @return void.
+ */
+void alarmJournal_Append(uint16_t addr, uint16_t level, alarm_journal_event_t type)
+{
+	alarm_journal_record_t record;
+
+	if(!journal_open)
+		return;
+
+	memset(&record, 0, sizeof(record));
+	record.seq = journal_next;
+	record.time_ms = wakeup_TimeMs();
+	record.boot = journal_boot;
+	record.addr = addr;
+	record.level = level;
+	record.type = (uint8_t) type;
+
+	if(nvm3_writeData(nvm3_defaultHandle, ALARM_JOURNAL_KEY_BASE + (journal_next % ALARM_JOURNAL_SLOTS),
+					  &record, sizeof(record)) != ECODE_NVM3_OK)
+	{
+		journal_stats.write_errors++;
+		return;
+	}
+
+	journal_next++;
+	if(journal_count < ALARM_JOURNAL_SLOTS)
+		journal_count++;
+	journal_stats.appends++;
+}
+
+/**
+ * @brief Read a record back, newest first.
+ *
+ * @param uint32_t age (0 for the newest record), alarm_journal_record_t *record
+ * @return bool False if there is no such record.
+ */
+bool alarmJournal_Read(uint32_t age, alarm_journal_record_t *record)
+{
+	uint32_t seq;
+
+	if(!journal_open || age >= journal_count)
+		return false;
+
+	seq = journal_next - 1 - age;
+	return alarmJournal_ReadSlot(seq % ALARM_JOURNAL_SLOTS, record) && record->seq == seq;
+}
+
+uint32_t alarmJournal_Count(void)
+{
+	return journal_count;
+}
+
+/**
+ * @brief Delete every record and the boot counter (factory reset).
+ *
+ * @param void
+ * @return void.
+ */
+void alarmJournal_Erase(void)
+{
+	if(!journal_open)
+		return;
+
+	for(uint32_t slot = 0; slot <= ALARM_JOURNAL_SLOTS; slot++)
+	{
+		nvm3_deleteObject(nvm3_defaultHandle, ALARM_JOURNAL_KEY_BASE + slot);
+	}
+
+	journal_next = 0;
+	journal_count = 0;
+}
+
+/**
+ * @brief Main loop hook, called when no stack event is pending.
+ *
+ * Each nvm3_repack() call does a bounded amount of work (at most one page
+ * erase), so a backlog is worked off over several idle passes.
+ *
+ * @param void
+ * @return void.
+ */
+void alarmJournal_Idle(void)
+{
+	if(!journal_open || !nvm3_repackNeeded(nvm3_defaultHandle))
+		return;
+
+	if(nvm3_repack(nvm3_defaultHandle) == ECODE_NVM3_OK)
+		journal_stats.repacks++;
+	else
+		journal_stats.repack_errors++;
+}
+
+void alarmJournal_GetStats(alarm_journal_stats_t *stats)
+{
+	*stats = journal_stats;
+}
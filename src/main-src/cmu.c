@@ -92,7 +92,4 @@ void cmu_ClkEnable(void)
 
 	// Enabling clock to GPIO module:
 	CMU_ClockEnable(cmuClock_GPIO, true);
-
-	// Enabling clock to LETIMER0 module:
-	CMU_ClockEnable(cmuClock_LETIMER0, true);
 }
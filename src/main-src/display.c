@@ -16,6 +16,7 @@
 #include <string.h>
 #include <src/headers/display.h>
 #include "hardware/kit/common/drivers/display.h"
+#include "displayls013b7dh03.h"
 
 
 #if ECEN5823_INCLUDE_DISPLAY_SUPPORT
@@ -25,10 +26,9 @@
  */
 #define DISPLAY_ROW_LEN   			 32
 /**
- * The number of rows
+ * The number of events whose display updates one frame can carry to the latency histograms
  */
-#define DISPLAY_ROW_NUMBER_OF_ROWS	 8
-
+#define DISPLAY_LATENCY_MARKS		 4
 /**
  * A structure containing information about the data we want to display on a given
  * LCD display
@@ -45,7 +45,48 @@ struct display_data {
 	/**
 	 * The char content of each row, null terminated
 	 */
-	char row_data[DISPLAY_ROW_NUMBER_OF_ROWS][DISPLAY_ROW_LEN+1];
+	char row_data[DISPLAY_ROW_MAX][DISPLAY_ROW_LEN+1];
+	/**
+	 * The content of each row as it was last drawn in the frame buffer
+	 */
+	char drawn_data[DISPLAY_ROW_MAX][DISPLAY_ROW_LEN+1];
+	/**
+	 * Set once the whole frame buffer has been cleared, after which only
+	 * the rows which change are cleared and drawn again
+	 */
+	bool frame_cleared;
+	/**
+	 * Set by displayPrintf() when row_data changed since the last frame was rendered
+	 */
+	bool frame_pending;
+	/**
+	 * The events which wrote the pending frame, completed when it is sent
+	 */
+	latency_mark_t latency_marks[DISPLAY_LATENCY_MARKS];
+	uint8_t latency_mark_count;
+	/**
+	 * The events of the frame the LDMA is sending, and the flag its interrupt sets once
+	 * the frame is out, with frame_failed if it was not all sent
+	 */
+	latency_mark_t sent_marks[DISPLAY_LATENCY_MARKS];
+	uint8_t sent_mark_count;
+	volatile bool frame_sent;
+	volatile bool frame_failed;
+	/**
+	 * Set while the LCD is powered down by displaySetPower().  Rows are still written to
+	 * row_data, but nothing is rendered or sent until it is powered up again
+	 */
+	bool powered_off;
+	/**
+	 * Set when the LCD was powered down while a frame was being sent; displayFlush()
+	 * cuts its power once the frame is out
+	 */
+	bool power_off_pending;
+	/**
+	 * Draws the rows straight into the DMD frame buffer, see text_blit.h
+	 */
+	text_blit_t blit;
+	struct display_stats stats;
 };
 
 /**
@@ -65,51 +106,169 @@ static struct display_data *displayGetData() {
 extern size_t strnlen(const char *, size_t);
 
 /**
- * Write the display data in the buffer represented by @param display to the device
+ * Fill the pixel band of @param row, its line spacing included, with the background
+ * color.  DMD marks only the lines of the band dirty.
+ */
+static EMSTATUS displayClearRow(GLIB_Context_t *context, enum display_row row)
+{
+	uint8_t red, green, blue;
+	uint16_t band = context->font.lineSpacing + context->font.fontHeight;
+	EMSTATUS result = GLIB_resetDisplayClippingArea(context);
+	if( result != GLIB_OK ) {
+		return result;
+	}
+	GLIB_colorTranslate24bpp(context->backgroundColor, &red, &green, &blue);
+	return DMD_writeColor(0, band * row, red, green, blue, context->pDisplayGeometry->clipWidth * band);
+}
+
+/**
+ * Write the display data in the buffer represented by @param display to the device.
+ * Only the rows whose content differs from what was last drawn are cleared and drawn
+ * again, so DMD_updateDisplay() only queues their lines for the LCD.
+ * @return true when lines were queued, to be sent by DISPLAY_Ls013b7dh03Flush()
  */
-static void displayUpdateWriteBuffer(struct display_data *display)
+static bool displayUpdateWriteBuffer(struct display_data *display)
 {
 	enum display_row row = DISPLAY_ROW_NAME;
 	GLIB_Context_t *context = &display->context;
-	EMSTATUS result = GLIB_clear(context);
-	if( result != GLIB_OK ) {
-		LOG_ERROR("GLIB_Clear failed with result %d",(int)result);
-	} else {
+	EMSTATUS result = GLIB_OK;
+	bool changed = false;
+	if( !display->frame_cleared ) {
+		result = GLIB_clear(context);
+		if( result != GLIB_OK ) {
+			LOG_ERROR("GLIB_Clear failed with result %d",(int)result);
+			return false;
+		}
 		/**
-		 * See example in graphics.c graphPrintCenter()
+		 * The cleared frame buffer holds empty rows
 		 */
-		for( row = DISPLAY_ROW_NAME; row < DISPLAY_ROW_MAX; row ++) {
-			uint8_t row_len = strnlen(display->row_data[row],DISPLAY_ROW_LEN);
-			uint8_t row_width = row_len * context->font.fontWidth;
-			if( row_width > context->pDisplayGeometry->xSize ) {
-				LOG_ERROR("Content of display row %d (%s) with length %d font width %d is too wide for display geometry size %d",
-						row,&display->row_data[row][0],row_len,context->font.fontWidth,context->pDisplayGeometry->xSize);
-			} else {
-				uint8_t posX = (context->pDisplayGeometry->xSize - row_width) >> 1;
-				uint8_t posY = ((context->font.lineSpacing + context->font.fontHeight) * row)
-							   + context->font.lineSpacing;
-				result = GLIB_drawString(context, &display->row_data[row][0], row_len, posX, posY, 0);
-				if( result != GLIB_OK ) {
-					if( result == GLIB_ERROR_NOTHING_TO_DRAW ) {
-						/**
-						 * This error happens if the content of the draw string did not change
-						 */
-						LOG_DEBUG("GLIB_drawString returned GLIB_ERROR_NOTHING_TO_DRAW for string %s len %d",&display->row_data[row][0],row_len);
-						result = GLIB_OK;
-					} else {
-						LOG_ERROR("GLIB_drawString failed with result %d for content %s length %d at X=%d Y=%d",
-								(int)result,&display->row_data[row][0],row_len,posX,posY);
-					}
+		memset(display->drawn_data,0,sizeof(display->drawn_data));
+		display->frame_cleared = true;
+		changed = true;
+	}
+	/**
+	 * See example in graphics.c graphPrintCenter()
+	 */
+	for( row = DISPLAY_ROW_NAME; row < DISPLAY_ROW_MAX; row ++) {
+		if( strcmp(display->row_data[row],display->drawn_data[row]) == 0 ) {
+			display->stats.rows_skipped++;
+			continue;
+		}
+		result = displayClearRow(context, row);
+		if( result != DMD_OK ) {
+			LOG_ERROR("Clearing display row %d failed with result %d",row,(int)result);
+			continue;
+		}
+		strcpy(display->drawn_data[row],display->row_data[row]);
+		display->stats.rows_drawn++;
+		changed = true;
+
+		uint8_t row_len = strnlen(display->row_data[row],DISPLAY_ROW_LEN);
+		uint8_t row_width = row_len * context->font.fontWidth;
+		if( row_width > context->pDisplayGeometry->xSize ) {
+			LOG_ERROR("Content of display row %d (%s) with length %d font width %d is too wide for display geometry size %d",
+					row,&display->row_data[row][0],row_len,context->font.fontWidth,context->pDisplayGeometry->xSize);
+		} else {
+			uint8_t posX = (context->pDisplayGeometry->xSize - row_width) >> 1;
+			uint8_t posY = ((context->font.lineSpacing + context->font.fontHeight) * row)
+						   + context->font.lineSpacing;
+			if( textBlit_String(&display->blit, context, &display->row_data[row][0], row_len, posX, posY) ) {
+				display->stats.rows_blitted++;
+				continue;
+			}
+			result = GLIB_drawString(context, &display->row_data[row][0], row_len, posX, posY, 0);
+			if( result != GLIB_OK ) {
+				if( result == GLIB_ERROR_NOTHING_TO_DRAW ) {
+					/**
+					 * This error happens if the content of the draw string did not change
+					 */
+					LOG_DEBUG("GLIB_drawString returned GLIB_ERROR_NOTHING_TO_DRAW for string %s len %d",&display->row_data[row][0],row_len);
+					result = GLIB_OK;
+				} else {
+					LOG_ERROR("GLIB_drawString failed with result %d for content %s length %d at X=%d Y=%d",
+							(int)result,&display->row_data[row][0],row_len,posX,posY);
 				}
 			}
 		}
 	}
+	display->stats.frames++;
+	if( !changed ) {
+		/**
+		 * Nothing is dirty, the LCD already shows this content
+		 */
+		display->stats.frames_unchanged++;
+		return false;
+	}
 	result = DMD_updateDisplay();
 	if( result != DMD_OK ) {
 		LOG_ERROR("DMD_updateDisplay failed with result %d",(int)result);
 	}
+	return true;
+}
+
+/**
+ * The LCD frame is out, called from interrupt context.  Lets the core go back to EM2
+ * and wakes the main loop, whose displayFlush() completes the frame, or sends it again
+ * if @param status says the LDMA failed.
+ */
+static void displayFrameSent(void *arg, EMSTATUS status)
+{
+	struct display_data *display = arg;
+	display->frame_failed = (status != DISPLAY_EMSTATUS_OK);
+	display->frame_sent = true;
+	sleepProfile_BlockEnd(sleepEM2, SLEEP_BLOCKER_DISPLAY);
+	gecko_external_signal(GECKO_DISPLAY_SENT_SIGNAL);
+}
+
+/**
+ * Record the display latency of the events carried by @param count marks
+ */
+static void displayCompleteMarks(const latency_mark_t *marks, uint8_t count)
+{
+	uint8_t i;
+	for( i = 0; i < count; i++ ) {
+		latency_CompleteMark(LATENCY_DISPLAYED, &marks[i]);
+	}
+}
+
+/**
+ * The frame the LDMA failed to send carries its events over to the pending one
+ */
+static void displayRequeueMarks(struct display_data *display)
+{
+	uint8_t i;
+	for( i = 0; i < display->sent_mark_count && display->latency_mark_count < DISPLAY_LATENCY_MARKS; i++ ) {
+		display->latency_marks[display->latency_mark_count++] = display->sent_marks[i];
+	}
+	display->sent_mark_count = 0;
 }
 
+/**
+ * Keep the latency mark of the event being handled for the frame which will carry its
+ * display update, once per event
+ */
+static void displayKeepLatencyMark(struct display_data *display)
+{
+	latency_mark_t mark;
+	uint8_t i;
+	latency_Current(&mark);
+	if( !mark.valid ) {
+		return;
+	}
+	for( i = 0; i < display->latency_mark_count; i++ ) {
+		if( display->latency_marks[i].event == mark.event && display->latency_marks[i].source == mark.source ) {
+			return;
+		}
+	}
+	if( display->latency_mark_count < DISPLAY_LATENCY_MARKS ) {
+		display->latency_marks[display->latency_mark_count++] = mark;
+	}
+}
+
+/**
+ * Update the content of @param row.  Nothing is drawn here: the rows written since the
+ * last frame are rendered and sent together by displayFlush() from the main loop.
+ */
 void displayPrintf(enum display_row row, const char *format, ... )
 {
 	struct display_data *display = displayGetData();
@@ -132,9 +291,112 @@ void displayPrintf(enum display_row row, const char *format, ... )
 		 */
 		display->row_data[row][chars_written] = 0;
 		LOG_DEBUG("Updating display row %d with content \"%s\"",row,&display->row_data[row][0]);
+		display->stats.writes++;
+		display->frame_pending = true;
+		displayKeepLatencyMark(display);
 	}
+}
 
-	displayUpdateWriteBuffer(display);
+/**
+ * Render the rows written since the last frame and start sending them to the LCD.
+ * Call once per main loop iteration, before waiting for the next event, so that a burst
+ * of displayPrintf() calls costs one frame.  The frame goes out on the LDMA while the
+ * main loop carries on; the frame buffer is not touched again until it is out, so rows
+ * written meanwhile wait for the next call after GECKO_DISPLAY_SENT_SIGNAL.
+ */
+void displayFlush()
+{
+	struct display_data *display = displayGetData();
+	EMSTATUS result;
+	if( display->frame_sent ) {
+		display->frame_sent = false;
+		if( display->frame_failed ) {
+			/**
+			 * Part of the frame may not have reached the panel and its lines are no
+			 * longer dirty: clear and draw the whole frame buffer again
+			 */
+			LOG_ERROR("LCD frame was not sent, sending the whole frame again");
+			display->frame_failed = false;
+			display->stats.frames_failed++;
+			display->frame_cleared = false;
+			display->frame_pending = true;
+			displayRequeueMarks(display);
+		} else {
+			displayCompleteMarks(display->sent_marks, display->sent_mark_count);
+			display->sent_mark_count = 0;
+		}
+	}
+	if( display->power_off_pending && !DISPLAY_Ls013b7dh03Busy() ) {
+		display->power_off_pending = false;
+#if GPIO_DISPLAY_SUPPORT_IMPLEMENTED
+		gpioDisableDisplay();
+#endif
+	}
+	if( !display->frame_pending ) {
+		return;
+	}
+	if( display->powered_off ) {
+		/**
+		 * The rows stay in row_data and are drawn by the frame rendered on power up;
+		 * the events that wrote them never reach the panel
+		 */
+		display->frame_pending = false;
+		display->latency_mark_count = 0;
+		display->stats.frames_skipped++;
+		return;
+	}
+	if( DISPLAY_Ls013b7dh03Busy() ) {
+		display->stats.flushes_deferred++;
+		return;
+	}
+	display->frame_pending = false;
+	if( !displayUpdateWriteBuffer(display) ) {
+		displayCompleteMarks(display->latency_marks, display->latency_mark_count);
+		display->latency_mark_count = 0;
+		return;
+	}
+	memcpy(display->sent_marks, display->latency_marks, sizeof(display->sent_marks));
+	display->sent_mark_count = display->latency_mark_count;
+	display->latency_mark_count = 0;
+	display->stats.frames_sent++;
+	/**
+	 * The LDMA and USART need the HF clocks: EM1 at most until the frame is out
+	 */
+	sleepProfile_BlockBegin(sleepEM2, SLEEP_BLOCKER_DISPLAY);
+	result = DISPLAY_Ls013b7dh03Flush(displayFrameSent, display);
+	if( result != DISPLAY_EMSTATUS_OK ) {
+		LOG_ERROR("DISPLAY_Ls013b7dh03Flush failed with result %d",(int)result);
+		displayFrameSent(display, result);
+	}
+}
+
+/**
+ * @return true while an LCD frame is being sent: USART1 and the frame buffer are in use
+ */
+bool displayBusy()
+{
+	return DISPLAY_Ls013b7dh03Busy();
+}
+
+/**
+ * Wait in EM1 until the frame being sent is out, before taking USART1 from the LCD.
+ * The interrupt ending the frame wakes the core even inside the critical section and
+ * runs once it is left, so it cannot slip in between the check and the sleep.
+ * @return true if a frame was in flight
+ */
+bool displayWaitSent()
+{
+	bool waited = false;
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	while( DISPLAY_Ls013b7dh03Busy() ) {
+		waited = true;
+		EMU_EnterEM1();
+		CORE_EXIT_CRITICAL();
+		CORE_ENTER_CRITICAL();
+	}
+	CORE_EXIT_CRITICAL();
+	return waited;
 }
 
 
@@ -188,6 +450,9 @@ void displayInit()
 	memset(display,0,sizeof(struct display_data));
 	display->last_extcomin_state_high = false;
 	displayGlibInit(&display->context);
+	if( !textBlit_Init(&display->blit) || !textBlit_Supports(&display->blit, &display->context.font) ) {
+		LOG_INFO("Display rows are drawn by GLIB, the text blitter does not support this display or font");
+	}
 	for( row = DISPLAY_ROW_NAME; row < DISPLAY_ROW_MAX; row++ ) {
 		displayPrintf(row,"%s"," ");
 	}
@@ -222,4 +487,63 @@ bool displayUpdate()
 	return true;
 }
 
+/**
+ * Power the LCD down or up.  While it is down displayPrintf() only updates the row text;
+ * displayFlush() renders and sends nothing and the caller should stop calling
+ * displayUpdate().  A frame still being sent is let out first: its power is cut by the
+ * displayFlush() which sees the frame out.  The panel loses its memory when powered down,
+ * so powering it up clears the whole frame buffer and renders every row into one frame,
+ * sent by the next displayFlush().
+ * @param on true to power the LCD up
+ */
+void displaySetPower(bool on)
+{
+	struct display_data *display = displayGetData();
+	if( on != display->powered_off ) {
+		return;
+	}
+	display->powered_off = !on;
+	if( !on ) {
+		LOG_INFO("Display powered down, rendering suspended");
+		if( DISPLAY_Ls013b7dh03Busy() ) {
+			display->power_off_pending = true;
+			return;
+		}
+#if GPIO_DISPLAY_SUPPORT_IMPLEMENTED
+		gpioDisableDisplay();
+#endif
+		return;
+	}
+	LOG_INFO("Display powered up, %u frames skipped so far",(unsigned)display->stats.frames_skipped);
+	if( display->power_off_pending ) {
+		/**
+		 * Powered up again before the frame was out: the LCD never lost its power
+		 */
+		display->power_off_pending = false;
+	} else {
+#if GPIO_DISPLAY_SUPPORT_IMPLEMENTED
+		gpioEnableDisplay();
+#endif
+	}
+	display->frame_cleared = false;
+	display->frame_pending = true;
+	display->stats.power_ups++;
+}
+
+/**
+ * @return true unless the LCD was powered down by displaySetPower()
+ */
+bool displayPowered()
+{
+	return !displayGetData()->powered_off;
+}
+
+/**
+ * @return the counts of display updates and of the rows they drew and skipped
+ */
+const struct display_stats *displayStats()
+{
+	return &displayGetData()->stats;
+}
+
 #endif // ECEN5823_INCLUDE_DISPLAY_SUPPORT
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file event_ring.c
+ *
+ * @brief Lock-free single-producer/single-consumer event ring.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "em_device.h"
+#include "em_rtcc.h"
+#include <src/headers/event_ring.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Empty the ring and clear its counters. Call before the producer
+ * interrupts are enabled.
+ *
+ * @param event_ring_t *ring
+ * @return void.
+ */
+void eventRing_Init(event_ring_t *ring)
+{
+	memset(ring, 0, sizeof(*ring));
+}
+
+/**
+ * @brief Queue an event, stamped with the RTCC count. Producer side only.
+ *
+ * @param event_ring_t *ring, uint8_t type, uint16_t payload
+ * @return bool False if the ring was full and the event was dropped.
+ */
+bool eventRing_Push(event_ring_t *ring, uint8_t type, uint16_t payload)
+{
+	uint32_t head = ring->head;
+	uint32_t used = head - ring->tail;
+	event_ring_entry_t *entry;
+
+	type &= (EVENT_RING_TYPES - 1);
+	if(used >= EVENT_RING_SIZE)
+	{
+		ring->stats.dropped[type]++;
+		return false;
+	}
+
+	entry = &ring->entry[head & (EVENT_RING_SIZE - 1)];
+	entry->time = RTCC_CounterGet();
+	entry->type = type;
+	entry->payload = payload;
+
+	/* The entry must be complete before the consumer can see it. */
+	__DMB();
+	ring->head = head + 1;
+
+	ring->stats.pushed[type]++;
+	if(used + 1 > ring->stats.high_water)
+		ring->stats.high_water = (uint16_t) (used + 1);
+	return true;
+}
+
+/**
+ * @brief Take the oldest event. Consumer side only.
+ *
+ * @param event_ring_t *ring, event_ring_entry_t *entry
+ * @return bool False if the ring is empty.
+ */
+bool eventRing_Pop(event_ring_t *ring, event_ring_entry_t *entry)
+{
+	uint32_t tail = ring->tail;
+	uint32_t delay;
+
+	if(tail == ring->head)
+		return false;
+
+	/* Read the entry only after seeing the head that published it. */
+	__DMB();
+	*entry = ring->entry[tail & (EVENT_RING_SIZE - 1)];
+	__DMB();
+	ring->tail = tail + 1;
+
+	delay = RTCC_CounterGet() - entry->time;
+	ring->stats.popped++;
+	ring->stats.delay_total += delay;
+	if(delay > ring->stats.delay_max)
+		ring->stats.delay_max = delay;
+	return true;
+}
+
+/**
+ * @brief Events queued right now.
+ *
+ * @param const event_ring_t *ring
+ * @return uint16_t.
+ */
+uint16_t eventRing_Count(const event_ring_t *ring)
+{
+	return (uint16_t) (ring->head - ring->tail);
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file fsm.c
+ *
+ * @brief Table-driven finite state machine engine.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "em_device.h"
+#include <src/headers/fsm.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Run an action, if the table has one.
+ *
+ * @param fsm_t *fsm, fsm_action_t action
+ * @return void.
+ */
+static inline void fsm_Do(fsm_t *fsm, fsm_action_t action)
+{
+	if(action)
+		action(fsm);
+}
+
+/**
+ * @brief Handle one event in the current state now; main loop only.
+ *
+ * @param fsm_t *fsm, uint8_t event
+ * @return void.
+ */
+void fsm_Handle(fsm_t *fsm, uint8_t event)
+{
+	const fsm_table_t *table = fsm->table;
+	const fsm_transition_t *transition;
+	uint8_t state = fsm->state;
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cycles;
+
+	if(event >= table->num_events)
+	{
+		fsm->ignored++;
+		return;
+	}
+
+	transition = &table->transitions[(state * table->num_events) + event];
+	if(!transition->handled)
+	{
+		fsm->ignored++;
+		return;
+	}
+
+	fsm_Do(fsm, table->states[state].exit);
+	fsm->state = transition->next;
+	fsm_Do(fsm, transition->action);
+	fsm_Do(fsm, table->states[transition->next].entry);
+
+	if(fsm->stats)
+	{
+		cycles = DWT->CYCCNT - start;
+		fsm->stats[transition->next].entries++;
+		fsm->stats[state].events++;
+		fsm->stats[state].cycles += cycles;
+		if(cycles > fsm->stats[state].cycles_max)
+			fsm->stats[state].cycles_max = cycles;
+	}
+}
+
+/**
+ * @brief Start a machine in its initial state and run that state's entry
+ * action. Also starts the core cycle counter the statistics use.
+ *
+ * @param fsm_t *fsm, const fsm_table_t *table, fsm_state_stats_t *stats (num_states or NULL), void *context
+ * @return void.
+ */
+void fsm_Init(fsm_t *fsm, const fsm_table_t *table, fsm_state_stats_t *stats, void *context)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	memset(fsm, 0, sizeof(*fsm));
+	fsm->table = table;
+	fsm->stats = stats;
+	fsm->context = context;
+	fsm->state = table->initial;
+
+	if(stats)
+	{
+		memset(stats, 0, table->num_states * sizeof(*stats));
+		stats[table->initial].entries = 1;
+	}
+	fsm_Do(fsm, table->states[table->initial].entry);
+}
+
+/**
+ * @brief Current state.
+ *
+ * @param const fsm_t *fsm
+ * @return uint8_t.
+ */
+uint8_t fsm_State(const fsm_t *fsm)
+{
+	return fsm->state;
+}
+
+/**
+ * @brief Name of a state of the machine, for logs.
+ *
+ * @param const fsm_t *fsm, uint8_t state
+ * @return const char.
+ */
+const char *fsm_StateName(const fsm_t *fsm, uint8_t state)
+{
+	if(state >= fsm->table->num_states)
+		return "STATE UNDEFINED";
+	return fsm->table->states[state].name;
+}
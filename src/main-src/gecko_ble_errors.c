@@ -30,6 +30,8 @@ const char *bleResponseFailureDescription(enum bg_error error)
 	const char *detailstr = "Unknown";
 	switch(error) {
 		BG_ERROR_LIST
+		default:
+			break;
 	}
 	return detailstr;
 }
@@ -54,6 +56,8 @@ const char *bleResponseString(enum bg_error error)
 	const char *enumstr = "Unknown";
 	switch(error) {
 		BG_ERROR_LIST
+		default:
+			break;
 	}
 	return enumstr;
 }
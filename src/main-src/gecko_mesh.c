@@ -102,6 +102,9 @@ void gecko_mesh_init(void)
 	// interrupt the scanner.
 	linklayer_priorities.scan_max = linklayer_priorities.adv_min + 1;
 
+	// Reserve NVM3 repack headroom before the stack opens the instance
+	alarmJournal_Setup();
+
 	// Gecko stack configuration initialisation
 	gecko_stack_init(&config);
 
@@ -65,170 +65,66 @@ I2CSPM_Init_TypeDef i2cInit =
 		.portLocationSda = 16
 };
 
-volatile I2C_TransferReturn_TypeDef transferStatusConnect;
-volatile I2C_TransferReturn_TypeDef transferStatusRead;
-
-volatile uint8_t connect_flag;
-volatile uint8_t read_flag;
-
-I2C_TransferSeq_TypeDef    seq;
-uint8_t i2c_read_data[2];
-uint8_t i2c_write_data[1];
+i2c_queue_t i2c0_queue;
 
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @brief I2C initialization
- *
- * Function overview
- * Initializes the I2C peripheral for connection with the Si7021 Temperature-Humidity sensor.
- *
- * @param void
- * @return  void.
- */
-
-void i2c_Init(void)
-{
-	I2CSPM_Init(&i2cInit);
-}
-
-/**
- * @brief I2C Connect Function
+ * @brief I2C0 queue busy hook: the bus stays in EM1 with its interrupt
+ * enabled from the first queued transfer until the queue drains.
  *
- * Function overview
- * For writing to the I2C Slave device.
- *
- * @param uint8_t addr, uint8_t command
+ * @param bool busy
  * @return  void.
- *
- * https://www.silabs.com/community/mcu/32-bit/forum.topic.html/interrupt-driveni2c-FM0S
  */
 
-void I2C_Write(uint8_t addr, uint8_t command)
+static void i2c_Busy(bool busy)
 {
-	addr 	= addr << 1;
-	i2c_write_data[0] = command;
-
-	seq.addr = addr;
-	seq.flags = I2C_FLAG_WRITE;
-	seq.buf[0].data = i2c_write_data;
-	seq.buf[0].len = 1;
-
-	connect_flag = 1;
-	NVIC_EnableIRQ(I2C0_IRQn);
-	transferStatusConnect = I2C_TransferInit(I2C0, &seq);
-	SLEEP_SleepBlockBegin(sleepEM2);
+	if(busy)
+	{
+		NVIC_ClearPendingIRQ(I2C0_IRQn);
+		NVIC_EnableIRQ(I2C0_IRQn);
+		sleepProfile_BlockBegin(sleepEM2, SLEEP_BLOCKER_I2C);
+	}
+	else
+	{
+		NVIC_DisableIRQ(I2C0_IRQn);
+		sleepProfile_BlockEnd(sleepEM2, SLEEP_BLOCKER_I2C);
+	}
 }
 
 /**
- * @brief I2C Read Function
+ * @brief I2C initialization
  *
  * Function overview
- * For reading from the I2C Slave device.
+ * Initializes the I2C peripheral for connection with the I2C sensors and
+ * empties the I2C0 transfer queue.
  *
- * @param uint8_t addr
+ * @param void
  * @return  void.
- *
- * https://www.silabs.com/community/mcu/32-bit/forum.topic.html/interrupt-driveni2c-FM0S
  */
 
-void I2C_Read(uint8_t addr)
+void i2c_Init(void)
 {
-	addr = addr << 1;
-	addr |= 0x01;
-
-	seq.addr  = addr;
-	seq.flags = I2C_FLAG_READ;
-	seq.buf[0].data = i2c_read_data;
-	seq.buf[0].len  = 2;
-
-	read_flag = 1;
-	NVIC_EnableIRQ(I2C0_IRQn);
-	transferStatusRead = I2C_TransferInit(I2C0, &seq);
-	SLEEP_SleepBlockBegin(sleepEM2);
+	I2CSPM_Init(&i2cInit);
+	i2cQueue_Init(&i2c0_queue, I2C0, NULL, i2c_Busy);
 }
 
 /*
  * @brief I2C (Interrupt Request) Handler
  *
  * Function overview
- * Handles interrupts for I2C Transfers
+ * Handles interrupts for I2C Transfers: the transfer on the bus advances,
+ * and when it ends its callback runs and the next queued one starts.
  *
  * @param void
  * @return  void.
+ *
+ * https://www.silabs.com/community/mcu/32-bit/forum.topic.html/interrupt-driveni2c-FM0S
  */
 
 void I2C0_IRQHandler(void)
 {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
-
-	if(connect_flag)
-	{
-		transferStatusConnect = I2C_Transfer(I2C0);
-		if(transferStatusConnect != i2cTransferInProgress)
-		{
-			if(transferStatusConnect == i2cTransferDone)
-			{
-				SLEEP_SleepBlockEnd(sleepEM2);
-				NVIC_DisableIRQ(I2C0_IRQn);
-
-				TEMP_I2C_WRITE_FLAG_SET();
-				gecko_external_signal(GECKO_TEMP_I2C_WRITE_FLAG);
-
-				connect_flag = 0;
-			}
-			else
-			{
-				int status = transferStatusConnect;
-				logI2CWriteReturns(status);
-			}
-		}
-	}
-	else if(read_flag)
-	{
-		transferStatusRead	= I2C_Transfer(I2C0);
-		if(transferStatusRead != i2cTransferInProgress)
-		{
-			if(transferStatusRead == i2cTransferDone)
-			{
-				SLEEP_SleepBlockEnd(sleepEM2);
-				NVIC_DisableIRQ(I2C0_IRQn);
-
-				uint8_t LSB = i2c_read_data[1];
-				uint8_t MSB = i2c_read_data[0];
-
-				MSB &= 0x1F;
-
-				// Negative temperature reading
-				if((MSB & 0x10) == 0x10)
-				{
-					MSB &= 0x0F;
-					temp_reading = 256 - (((float) MSB * 16) + ((float) LSB / 16));
-				}
-
-				// Positive temperature reading
-				else
-				{
-					temp_reading = (((float) MSB * 16) + ((float) LSB / 16));
-				}
-
-				app_temp_reading = temp_reading * 1000;
-
-				TEMP_I2C_READ_FLAG_SET();
-				gecko_external_signal(GECKO_TEMP_I2C_READ_FLAG);
-
-				read_flag = 0;
-			}
-			else
-			{
-				int status = transferStatusRead;
-				logI2CReadReturns(status);
-			}
-		}
-	}
-
-	CORE_EXIT_CRITICAL();
+	i2cQueue_Irq(&i2c0_queue);
 }
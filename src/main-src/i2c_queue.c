@@ -0,0 +1,284 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file i2c_queue.c
+ *
+ * @brief Asynchronous I2C transfer queue with completion callbacks.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "em_core.h"
+#include "em_rtcc.h"
+#include <src/headers/i2c_queue.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t i2cQueue_Rtcc(void)
+{
+	return RTCC_CounterGet();
+}
+
+/**
+ * @brief Statistics slot of a device, taken on its first transfer; NULL
+ * once the table is full.
+ *
+ * @param i2c_queue_t *queue, uint8_t addr
+ * @return i2c_device_stats_t *.
+ */
+static i2c_device_stats_t *i2cQueue_Device(i2c_queue_t *queue, uint8_t addr)
+{
+	i2c_device_stats_t *device;
+
+	for(device = queue->stats.device; device < &queue->stats.device[I2C_QUEUE_DEVICES_MAX]; device++)
+	{
+		if(device->addr == addr)
+			return device;
+		if(device->addr == 0)
+		{
+			device->addr = addr;
+			return device;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Retire the request at the head: account for it, run its callback
+ * and return it to the pool. In a critical section.
+ *
+ * @param i2c_queue_t *queue, I2C_TransferReturn_TypeDef status
+ * @return void.
+ */
+static void i2cQueue_Finish(i2c_queue_t *queue, I2C_TransferReturn_TypeDef status)
+{
+	i2c_request_t *request = queue->head;
+	i2c_device_stats_t *device = i2cQueue_Device(queue, request->addr);
+	uint32_t latency = queue->clock() - request->queued;
+
+	queue->head = request->next;
+	if(!queue->head)
+		queue->tail = NULL;
+
+	request->status = status;
+	if(device)
+	{
+		device->transfers++;
+		if(status == i2cTransferDone)
+			device->done++;
+		else if(status == i2cTransferNack)
+			device->nacks++;
+		else
+			device->bus_errors++;
+
+		device->latency_total += latency;
+		if(latency > device->latency_max)
+			device->latency_max = latency;
+	}
+	else
+		queue->stats.other_devices++;
+
+	/* Still counted while its callback runs, so a transfer queued from the
+	 * callback does not see the queue drain and take the bus again. */
+	queue->completing = true;
+	if(request->callback)
+		request->callback(request);
+	queue->completing = false;
+
+	request->next = queue->free;
+	queue->free = request;
+
+	if(--queue->count == 0 && queue->busy)
+		queue->busy(false);
+}
+
+/**
+ * @brief Put queued requests on the bus until one is in progress; those
+ * that fail at once are retired on the way. In a critical section.
+ *
+ * @param i2c_queue_t *queue, bool chained (from the interrupt of the
+ * transfer before)
+ * @return void.
+ */
+static void i2cQueue_Kick(i2c_queue_t *queue, bool chained)
+{
+	I2C_TransferReturn_TypeDef status;
+
+	while(queue->head && !queue->active)
+	{
+		status = I2C_TransferInit(queue->port, &queue->head->seq);
+		if(status == i2cTransferInProgress)
+		{
+			queue->active = true;
+			if(chained)
+				queue->stats.chained++;
+		}
+		else
+			i2cQueue_Finish(queue, status);
+	}
+}
+
+/**
+ * @brief Empty the queue and install its port, clock (NULL for the RTCC)
+ * and busy hook (NULL for none).
+ *
+ * @param i2c_queue_t *queue, I2C_TypeDef *port, uint32_t (*clock)(void),
+ * void (*busy)(bool busy)
+ * @return void.
+ */
+void i2cQueue_Init(i2c_queue_t *queue, I2C_TypeDef *port, uint32_t (*clock)(void), void (*busy)(bool busy))
+{
+	uint32_t i;
+
+	memset(queue, 0, sizeof(*queue));
+	queue->port = port;
+	queue->clock = clock ? clock : i2cQueue_Rtcc;
+	queue->busy = busy;
+
+	for(i = 0; i < I2C_QUEUE_POOL_SIZE; i++)
+	{
+		queue->pool[i].next = queue->free;
+		queue->free = &queue->pool[i];
+	}
+}
+
+/**
+ * @brief Queue a transfer: a write (read_len 0), a read (write_len 0) or a
+ * write then a read after a repeated start. The bytes to write are copied.
+ *
+ * May be called from the main loop or from a completion callback.
+ *
+ * @param i2c_queue_t *queue, uint8_t addr (7 bit), const uint8_t *write,
+ * uint16_t write_len, uint16_t read_len, i2c_callback_t callback,
+ * void *context
+ * @return bool False if the pool is empty or a length is out of range.
+ */
+bool i2cQueue_Transfer(i2c_queue_t *queue, uint8_t addr, const uint8_t *write, uint16_t write_len,
+					   uint16_t read_len, i2c_callback_t callback, void *context)
+{
+	i2c_request_t *request;
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_CRITICAL();
+
+	request = queue->free;
+	if(!request || write_len > I2C_QUEUE_WRITE_MAX || read_len > I2C_QUEUE_READ_MAX
+	   || (write_len == 0 && read_len == 0))
+	{
+		queue->stats.rejected++;
+		CORE_EXIT_CRITICAL();
+		return false;
+	}
+	queue->free = request->next;
+
+	request->next = NULL;
+	request->addr = addr;
+	request->status = i2cTransferInProgress;
+	request->queued = queue->clock();
+	request->callback = callback;
+	request->context = context;
+	if(write_len)
+		memcpy(request->write, write, write_len);
+
+	/* emlib sets the read bit of the address itself. */
+	request->seq.addr = (uint16_t) (addr << 1);
+	if(!read_len)
+	{
+		request->seq.flags = I2C_FLAG_WRITE;
+		request->seq.buf[0].data = request->write;
+		request->seq.buf[0].len = write_len;
+	}
+	else if(!write_len)
+	{
+		request->seq.flags = I2C_FLAG_READ;
+		request->seq.buf[0].data = request->read;
+		request->seq.buf[0].len = read_len;
+	}
+	else
+	{
+		request->seq.flags = I2C_FLAG_WRITE_READ;
+		request->seq.buf[0].data = request->write;
+		request->seq.buf[0].len = write_len;
+		request->seq.buf[1].data = request->read;
+		request->seq.buf[1].len = read_len;
+	}
+
+	if(queue->tail)
+		queue->tail->next = request;
+	else
+		queue->head = request;
+	queue->tail = request;
+
+	queue->stats.submitted++;
+	if(++queue->count == 1)
+	{
+		queue->stats.busy_periods++;
+		if(queue->busy)
+			queue->busy(true);
+	}
+	if(queue->count > queue->stats.high_water)
+		queue->stats.high_water = queue->count;
+
+	/* From a completion callback, the caller starts it once the callback returns. */
+	if(!queue->completing)
+		i2cQueue_Kick(queue, false);
+
+	CORE_EXIT_CRITICAL();
+	return true;
+}
+
+/**
+ * @brief Advance the transfer on the bus; call from the I2C interrupt. A
+ * finished transfer is retired and the next queued one started at once.
+ *
+ * @param i2c_queue_t *queue
+ * @return void.
+ */
+void i2cQueue_Irq(i2c_queue_t *queue)
+{
+	I2C_TransferReturn_TypeDef status;
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_CRITICAL();
+
+	if(queue->active)
+	{
+		status = I2C_Transfer(queue->port);
+		if(status != i2cTransferInProgress)
+		{
+			queue->active = false;
+			i2cQueue_Finish(queue, status);
+			i2cQueue_Kick(queue, true);
+		}
+	}
+
+	CORE_EXIT_CRITICAL();
+}
+
+uint32_t i2cQueue_Pending(const i2c_queue_t *queue)
+{
+	return queue->count;
+}
+
+const i2c_device_stats_t *i2cQueue_DeviceStats(const i2c_queue_t *queue, uint8_t addr)
+{
+	uint32_t i;
+
+	for(i = 0; i < I2C_QUEUE_DEVICES_MAX && queue->stats.device[i].addr; i++)
+	{
+		if(queue->stats.device[i].addr == addr)
+			return &queue->stats.device[i];
+	}
+	return NULL;
+}
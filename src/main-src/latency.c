@@ -0,0 +1,217 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file latency.c
+ *
+ * @brief End-to-end event latency histograms.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "em_device.h"
+#include "em_rtcc.h"
+#include <src/headers/latency.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static latency_histograms_t latency_histograms;
+
+static uint32_t (*latency_clock)(void);
+static uint32_t latency_hz = LATENCY_RTCC_HZ;
+
+static uint32_t latency_arrival;			// Last stack event handed to the main loop
+static latency_mark_t latency_current;		// Event being handled
+
+static const char *const latency_event_names[LATENCY_EVT_COUNT] =
+{
+	[LATENCY_EVT_SENSOR]			= "Sensor IRQ",
+	[LATENCY_EVT_BUTTON]			= "Button IRQ",
+	[LATENCY_EVT_CLIENT_REQUEST]	= "Client request",
+	[LATENCY_EVT_SOFT_TIMER]		= "Soft timer",
+	[LATENCY_EVT_OTHER]				= "Other event",
+};
+
+static const char *const latency_stage_names[LATENCY_STAGE_COUNT] =
+{
+	[LATENCY_DISPATCH]				= "dispatch",
+	[LATENCY_REQUEST_DONE]			= "request handled",
+	[LATENCY_ALARMS_STORED]			= "alarms stored",
+	[LATENCY_DISPLAYED]				= "display updated",
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t latency_Rtcc(void)
+{
+	return RTCC_CounterGet();
+}
+
+/**
+ * @brief Add one latency to a histogram.
+ *
+ * @param uint8_t event, latency_stage_t stage, uint32_t ticks
+ * @return void.
+ */
+static void latency_Record(uint8_t event, latency_stage_t stage, uint32_t ticks)
+{
+	uint8_t bucket = ticks ? (uint8_t) (32 - __CLZ(ticks)) : 0;
+
+	if(bucket >= LATENCY_BUCKETS)
+		bucket = LATENCY_BUCKETS - 1;
+
+	latency_histograms.count[event][stage][bucket]++;
+	if(ticks > latency_histograms.max[event][stage])
+		latency_histograms.max[event][stage] = ticks;
+}
+
+/**
+ * @brief Install the clock, NULL for the RTCC, and clear the histograms.
+ *
+ * @param uint32_t (*clock)(void), uint32_t hz
+ * @return void.
+ */
+void latency_Init(uint32_t (*clock)(void), uint32_t hz)
+{
+	latency_clock = clock ? clock : latency_Rtcc;
+	latency_hz = clock ? hz : LATENCY_RTCC_HZ;
+	latency_Reset();
+}
+
+void latency_Reset(void)
+{
+	memset(&latency_histograms, 0, sizeof(latency_histograms));
+	memset(&latency_current, 0, sizeof(latency_current));
+}
+
+uint32_t latency_Now(void)
+{
+	return latency_clock ? latency_clock() : RTCC_CounterGet();
+}
+
+/**
+ * @brief Convert an RTCC time stamp (the isr_event_ring ones) to a source
+ * time on the latency clock, by taking the RTCC time since off now.
+ *
+ * @param uint32_t rtcc_stamp
+ * @return uint32_t.
+ */
+uint32_t latency_FromRtcc(uint32_t rtcc_stamp)
+{
+	uint32_t ticks = RTCC_CounterGet() - rtcc_stamp;
+
+	return latency_Now() - (uint32_t) (((uint64_t) ticks * latency_hz) / LATENCY_RTCC_HZ);
+}
+
+/**
+ * @brief Stamp the arrival of a stack event, right after gecko_wait_event().
+ *
+ * @param void
+ * @return void.
+ */
+void latency_Arrive(void)
+{
+	latency_arrival = latency_Now();
+}
+
+uint32_t latency_Arrival(void)
+{
+	return latency_arrival;
+}
+
+/**
+ * @brief Dispatch of an event stamped at source; completions recorded until
+ * latency_End() are charged to it.
+ *
+ * @param latency_event_t event, uint32_t source
+ * @return void.
+ */
+void latency_Begin(latency_event_t event, uint32_t source)
+{
+	if(event >= LATENCY_EVT_COUNT)
+		event = LATENCY_EVT_OTHER;
+
+	latency_current.valid = true;
+	latency_current.event = (uint8_t) event;
+	latency_current.source = source;
+	latency_Record(event, LATENCY_DISPATCH, latency_Now() - source);
+}
+
+void latency_End(void)
+{
+	latency_current.valid = false;
+}
+
+/**
+ * @brief A completion point of the event being handled; ignored outside
+ * of any event (start-up code, idle hooks).
+ *
+ * @param latency_stage_t stage
+ * @return void.
+ */
+void latency_Complete(latency_stage_t stage)
+{
+	latency_CompleteMark(stage, &latency_current);
+}
+
+/**
+ * @brief Copy the mark of the event being handled, for work it defers.
+ *
+ * @param latency_mark_t *mark
+ * @return void.
+ */
+void latency_Current(latency_mark_t *mark)
+{
+	*mark = latency_current;
+}
+
+void latency_CompleteMark(latency_stage_t stage, const latency_mark_t *mark)
+{
+	if(mark->valid && stage < LATENCY_STAGE_COUNT)
+		latency_Record(mark->event, stage, latency_Now() - mark->source);
+}
+
+const latency_histograms_t *latency_Histograms(void)
+{
+	return &latency_histograms;
+}
+
+/**
+ * @brief Upper limit of a bucket in microseconds, UINT32_MAX for the last.
+ *
+ * @param uint8_t bucket
+ * @return uint32_t.
+ */
+uint32_t latency_BucketLimitUs(uint8_t bucket)
+{
+	if(bucket >= LATENCY_BUCKETS - 1)
+		return UINT32_MAX;
+	return latency_TicksToUs(1UL << bucket);
+}
+
+uint32_t latency_TicksToUs(uint32_t ticks)
+{
+	return (uint32_t) (((uint64_t) ticks * 1000000ULL) / latency_hz);
+}
+
+const char *latency_EventName(uint8_t event)
+{
+	return (event < LATENCY_EVT_COUNT) ? latency_event_names[event] : "Unknown";
+}
+
+const char *latency_StageName(uint8_t stage)
+{
+	return (stage < LATENCY_STAGE_COUNT) ? latency_stage_names[stage] : "unknown";
+}
@@ -14,7 +14,7 @@
  */
 uint32_t loggerGetTimestamp(void)
 {
-	uint32_t timestamp_log = letimer_TimeStampSet();
+	uint32_t timestamp_log = wakeup_TimeMs();
 	return timestamp_log;
 }
 
@@ -41,6 +41,8 @@ void logInit(void)
 
 void logTemp(void)
 {
+	char text[MCP9808_TEXT_MAX];
+
 	logFlush();
 
 	RETARGET_SerialInit();
@@ -49,7 +51,8 @@ void logTemp(void)
 	 * RETARGET_SerialCrLf() ensures each linefeed also includes carriage return.  Without it, the first character is shifted in TeraTerm
 	 */
 	RETARGET_SerialCrLf(true);
-	LOG_INFO("Temperature Reading (degree Celsius): %.3f C", temp_reading);
+	mcp9808_FormatMilliC(text, app_temp_reading);
+	LOG_INFO("Temperature Reading (degree Celsius): %s C", text);
 }
 
 /*
@@ -149,6 +152,81 @@ void logString(char* mystring)
 	LOG_INFO("%s", mystring);
 }
 
+/*
+ * Log the energy mode residency and the time each sleep blocker kept the node out of EM3
+ */
+
+void logSleepProfile(void)
+{
+	sleep_profile_t profile;
+
+	logFlush();
+
+	RETARGET_SerialInit();
+	/**
+	 * See https://siliconlabs.github.io/Gecko_SDK_Doc/efm32g/html/group__RetargetIo.html#ga9e36c68713259dd181ef349430ba0096
+	 * RETARGET_SerialCrLf() ensures each linefeed also includes carriage return.  Without it, the first character is shifted in TeraTerm
+	 */
+	RETARGET_SerialCrLf(true);
+
+	sleepProfile_Get(&profile);
+
+	for(uint8_t em = 0; em < SLEEP_PROFILE_EM_COUNT; em++)
+	{
+		LOG_INFO("EM%u: %"PRIu32" entries, %"PRIu32" ms", em, profile.entries[em],
+				 (uint32_t) ((profile.residency[em] * 1000) / SLEEP_PROFILE_CLOCK_HZ));
+	}
+
+	for(uint8_t i = 0; i < SLEEP_BLOCKER_COUNT; i++)
+	{
+		LOG_INFO("Blocker %s: %"PRIu32" blocks, %"PRIu32" ms", sleepProfile_BlockerName(i),
+				 profile.block_begins[i], (uint32_t) ((profile.blocked[i] * 1000) / SLEEP_PROFILE_CLOCK_HZ));
+	}
+}
+
+/*
+ * Logging the latency histograms: one line per event and stage seen, with
+ * the count in each bucket (upper limit in us) and the worst case.
+ */
+
+void logLatency(void)
+{
+	const latency_histograms_t *histograms = latency_Histograms();
+
+	logFlush();
+
+	RETARGET_SerialInit();
+	RETARGET_SerialCrLf(true);
+
+	for(uint8_t event = 0; event < LATENCY_EVT_COUNT; event++)
+	{
+		for(uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++)
+		{
+			char line[LATENCY_BUCKETS * 24];
+			int len = 0;
+
+			if(!histograms->max[event][stage] && !histograms->count[event][stage][0])
+				continue;
+
+			for(uint8_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+			{
+				uint32_t count = histograms->count[event][stage][bucket];
+
+				if(!count)
+					continue;
+				if(bucket == LATENCY_BUCKETS - 1)
+					len += snprintf(&line[len], sizeof(line) - len, " >:%"PRIu32, count);
+				else
+					len += snprintf(&line[len], sizeof(line) - len, " <%"PRIu32":%"PRIu32,
+									latency_BucketLimitUs(bucket), count);
+			}
+
+			LOG_INFO("%s %s (us):%s max %"PRIu32, latency_EventName(event), latency_StageName(stage), line,
+					 latency_TicksToUs(histograms->max[event][stage]));
+		}
+	}
+}
+
 /**
  * Block for chars to be flushed out of the serial port.  Important to do this before entering SLEEP() or you may see garbage chars output.
  */
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file lpn_registry.c
+ *
+ * @brief Registry of the LPNs served by the friend node, with their alarms.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <src/headers/lpn_registry.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Index of the first key not below addr (lower bound).
+ *
+ * The loop halves the range without a data dependent branch, so it
+ * compiles to a conditional move and costs the same for hits and misses.
+ *
+ * @param const lpn_registry_t *registry, uint16_t addr
+ * @return uint16_t Insertion point in key[], equal to count if none.
+ */
+static uint16_t lpnRegistry_LowerBound(const lpn_registry_t *registry, uint16_t addr)
+{
+	const uint16_t *base = registry->key;
+	uint16_t n = registry->count;
+
+	if(!n)
+	{
+		return 0;
+	}
+
+	while(n > 1)
+	{
+		uint16_t half = n >> 1;
+
+		base = (base[half] < addr) ? base + half : base;
+		n -= half;
+	}
+
+	return (uint16_t) (base - registry->key) + (*base < addr);
+}
+
+/**
+ * @brief Empty the registry and clear all alarms.
+ *
+ * @param lpn_registry_t *registry
+ * @return void.
+ */
+void lpnRegistry_Init(lpn_registry_t *registry)
+{
+	memset(registry, 0, sizeof(*registry));
+}
+
+/**
+ * @brief Look up the slot of an LPN in O(log n).
+ *
+ * @param const lpn_registry_t *registry, uint16_t addr
+ * @return uint16_t Slot or LPN_SLOT_INVALID if the LPN is not registered.
+ */
+uint16_t lpnRegistry_Find(const lpn_registry_t *registry, uint16_t addr)
+{
+	uint16_t i = lpnRegistry_LowerBound(registry, addr);
+
+	if(i < registry->count && registry->key[i] == addr)
+	{
+		return registry->key_slot[i];
+	}
+	return LPN_SLOT_INVALID;
+}
+
+/**
+ * @brief Register an LPN, or look it up if it is already known.
+ *
+ * New LPNs take the next free slot. Insertion shifts the sorted key array,
+ * which is O(n) but only happens once per LPN.
+ *
+ * @param lpn_registry_t *registry, uint16_t addr
+ * @return uint16_t Slot or LPN_SLOT_INVALID if the registry is full.
+ */
+uint16_t lpnRegistry_Add(lpn_registry_t *registry, uint16_t addr)
+{
+	uint16_t i = lpnRegistry_LowerBound(registry, addr);
+	uint16_t slot;
+
+	if(i < registry->count && registry->key[i] == addr)
+	{
+		return registry->key_slot[i];
+	}
+
+	if(registry->count >= LPN_REGISTRY_MAX)
+	{
+		return LPN_SLOT_INVALID;
+	}
+
+	slot = registry->count;
+
+	memmove(&registry->key[i + 1], &registry->key[i], (registry->count - i) * sizeof(registry->key[0]));
+	memmove(&registry->key_slot[i + 1], &registry->key_slot[i], (registry->count - i) * sizeof(registry->key_slot[0]));
+	registry->key[i] = addr;
+	registry->key_slot[i] = slot;
+	registry->slot_addr[slot] = addr;
+	registry->count++;
+
+	return slot;
+}
+
+/**
+ * @brief Unicast address registered in a slot.
+ *
+ * @param const lpn_registry_t *registry, uint16_t slot
+ * @return uint16_t Address or 0 (unassigned address) for an empty slot.
+ */
+uint16_t lpnRegistry_Addr(const lpn_registry_t *registry, uint16_t slot)
+{
+	if(slot < registry->count)
+	{
+		return registry->slot_addr[slot];
+	}
+	return 0;
+}
+
+bool lpnRegistry_AlarmGet(const lpn_registry_t *registry, uint16_t slot)
+{
+	if(slot >= registry->count)
+	{
+		return false;
+	}
+	return (registry->alarms[slot >> 5] >> (slot & 31)) & 0x1;
+}
+
+/**
+ * @brief Set or clear the alarm bit of a slot.
+ *
+ * @param lpn_registry_t *registry, uint16_t slot, bool alarm
+ * @return bool True if the bit changed.
+ */
+bool lpnRegistry_AlarmSet(lpn_registry_t *registry, uint16_t slot, bool alarm)
+{
+	uint32_t mask;
+	uint32_t word;
+
+	if(slot >= registry->count)
+	{
+		return false;
+	}
+
+	mask = 1UL << (slot & 31);
+	word = registry->alarms[slot >> 5];
+
+	if(alarm)
+		registry->alarms[slot >> 5] = word | mask;
+	else
+		registry->alarms[slot >> 5] = word & ~mask;
+
+	return registry->alarms[slot >> 5] != word;
+}
+
+void lpnRegistry_AlarmClearAll(lpn_registry_t *registry)
+{
+	memset(registry->alarms, 0, sizeof(registry->alarms));
+}
+
+uint16_t lpnRegistry_AlarmCount(const lpn_registry_t *registry)
+{
+	uint16_t count = 0;
+
+	for(uint16_t i = 0; i < LPN_ALARM_WORDS; i++)
+	{
+		count += __builtin_popcount(registry->alarms[i]);
+	}
+	return count;
+}
+
+/**
+ * @brief Serialise the alarm bitset, slot 0 in bit 0 of the first byte.
+ *
+ * Only the bytes covering registered slots are written, so with the three
+ * original LPNs this is the single alarm byte the node always stored.
+ *
+ * @param const lpn_registry_t *registry, uint8_t *data, uint16_t max_len
+ * @return uint16_t Bytes written.
+ */
+uint16_t lpnRegistry_AlarmExport(const lpn_registry_t *registry, uint8_t *data, uint16_t max_len)
+{
+	uint16_t len = LPN_ALARM_BYTES(registry->count);
+
+	if(len > max_len)
+		len = max_len;
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		data[i] = (uint8_t) (registry->alarms[i >> 2] >> ((i & 3) * 8));
+	}
+	return len;
+}
+
+/**
+ * @brief Restore the alarm bitset written by lpnRegistry_AlarmExport().
+ *
+ * Register the LPNs first; bits beyond the registered slots are dropped.
+ *
+ * @param lpn_registry_t *registry, const uint8_t *data, uint16_t len
+ * @return void.
+ */
+void lpnRegistry_AlarmImport(lpn_registry_t *registry, const uint8_t *data, uint16_t len)
+{
+	lpnRegistry_AlarmClearAll(registry);
+
+	if(len > LPN_ALARM_BYTES(registry->count))
+		len = LPN_ALARM_BYTES(registry->count);
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		registry->alarms[i >> 2] |= (uint32_t) data[i] << ((i & 3) * 8);
+	}
+
+	/* Mask off the bits past the last registered slot. */
+	if(registry->count & 31)
+	{
+		registry->alarms[registry->count >> 5] &= (1UL << (registry->count & 31)) - 1;
+	}
+}
@@ -56,43 +56,94 @@
 
 void gecko_system_init(void)
 {
+	/* The sleep profiler only hooks into the SLEEP driver the stack set up, its blocks stay held. */
+	sleepProfile_Init();
+
+	/* Sensor history starts empty on every boot. */
+	timeSeries_Init(&sensor_series);
+
+	/* The interrupt handlers queue their events here from the first enable on. */
+	eventRing_Init(&isr_event_ring);
+	latency_Reset();
+
+	/* Periodic activities share sleeptimer wakeups; the sensor sampling starts in sm_Init(). */
+	wakeup_Init();
+
+	/* Application timers run on the timer wheel from the boot event on. */
+	gecko_timers_init();
+
 	/* Initializing Peripherals and Configurations */
-	sm_Init();
 	gpioInit();
 	pushButton_Init();
 	cmu_Init();
-	letimer_Init();
 	i2c_Init();
+	#ifdef MCP9808_ENABLED
+	mcp9808_Init();
+	#endif
+	sm_Init();
 	logInit();
 	displayInit();
+
+	/* Recover the alarm journal; NVM3 has been opened by the stack by now. */
+	alarmJournal_Init();
+
+	/* Find the write position of the MX25 history; needs the LCD up as they share USART1. */
+	if(!sensorHistory_Init())
+	{
+		LOG_ERROR("Sensor history: MX25 flash not responding.");
+	}
 }
 
 /***************************************************************************//**
- * This function handles the BTM external events occurring with the MCP9808
- * temperature state machine.
+ * This function handles the events queued by the interrupt handlers, in the
+ * order they happened: the periodic activities (wakeup.h), the sensor
+ * batch state machine and the push buttons. Only the events already
+ * queued on entry are taken, so the loop ends even if interrupts keep
+ * coming. Every sensor found due by then (period or alert) goes into one
+ * batch, started once the events are handled.
  ******************************************************************************/
 
 void gecko_external_evt_handler(void)
 {
-	#ifdef MCP9808_ENABLED
+	event_ring_entry_t event;
 
+	for(uint16_t n = eventRing_Count(&isr_event_ring); n && eventRing_Pop(&isr_event_ring, &event); n--)
 	{
-		CORE_DECLARE_IRQ_STATE;
-		CORE_ENTER_CRITICAL();
-		{
-		  event_processing_bitmask |= interrupt_event_bitmask;
-		  EVT_PR_BITM_CLEAR_EXTRA();
-		  sm_ClearInt();
-		}
-		CORE_EXIT_CRITICAL();
+		latency_Begin((event.type == ISR_EVENT_PB0 || event.type == ISR_EVENT_PB1) ? LATENCY_EVT_BUTTON
+					  : LATENCY_EVT_SENSOR, latency_FromRtcc(event.time));
 
-		if(event_processing_bitmask)
+		switch(event.type)
 		{
-		  static int i = 0;
-		  for(i = 0; event_processing_bitmask != 0; i++)
-			  sm_HandleEvents(i);
+			case ISR_EVENT_WAKEUP:
+				wakeup_Run();
+				break;
+
+			case ISR_EVENT_SENSORS_CONVERTED:
+				sm_Handle(EVENT1_SENSORS_CONVERTED);
+				break;
+
+			case ISR_EVENT_SENSORS_READ:
+				sm_Handle(EVENT2_SENSORS_READ);
+				break;
+
+			#ifdef MCP9808_ENABLED
+			case ISR_EVENT_MCP9808_ALERT:
+				sensor_MarkDue(&mcp9808_sensor);
+				break;
+			#endif
+
+			case ISR_EVENT_PB0:
+			case ISR_EVENT_PB1:
+				gecko_button_handler(event.type, event.payload != 0);
+				break;
+
+			default:
+				break;
 		}
+
+		latency_End();
 	}
 
-	#endif
+	if(sensor_Due())
+		sm_Handle(EVENT0_SENSORS_DUE);
 }
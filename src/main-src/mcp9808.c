@@ -47,26 +47,216 @@
 
 #include <src/headers/mcp9808.h>
 
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Ta register of the last good read, flags included. */
+static volatile uint16_t mcp9808_ta;
+
+#ifdef MCP9808_ALERT_ENABLED
+/* The last reading was at or above T_CRIT, the ALERT output stays low. */
+static volatile bool mcp9808_critical;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
 
 /***************************************************************************//**
- * This function performs I2C write transaction with the MCP9808 I2C
- * temperature sensor for sending commands for reading temperature values.
+ * Decode function of the MCP9808 sensor descriptor, in the I2C interrupt:
+ * the two byte Ta register, read after a pointer write and a repeated
+ * start, is kept for the ALERT window and converted to milli-degrees C.
+ ******************************************************************************/
+
+bool mcp9808_Decode(const uint8_t *raw, int32_t *value)
+{
+	uint16_t ta = ((uint16_t) raw[0] << 8) | raw[1];
+
+	mcp9808_ta = ta;
+	*value = mcp9808_TaToMilliC(ta);
+	return true;
+}
+
+/***************************************************************************//**
+ * This function converts a Ta register to milli-degrees C, in integers:
+ * the 13 bit two's complement reading is in 1/16 C, 62.5 mC, so it is
+ * multiplied by 125 and halved, rounding towards zero. The flag bits are
+ * ignored.
  ******************************************************************************/
 
-void mcp9808_Write(void)
+int32_t mcp9808_TaToMilliC(uint16_t ta)
 {
-	I2C_Write(mcp9808_slave_addr, mcp9808_read_command);
+	int32_t sixteenths = (int32_t) (ta & MCP9808_TA_MASK);
+
+	if(sixteenths & MCP9808_TA_SIGN)
+		sixteenths -= MCP9808_TA_MASK + 1;
+
+	return (sixteenths * 125) / 2;
 }
 
 /***************************************************************************//**
- * This function performs I2C read transaction with the MCP9808 I2C
- * temperature sensor for reading temperature values.
+ * This function prints milli-degrees as degrees with three decimals
+ * ("-12.345") into text, which holds MCP9808_TEXT_MAX characters, and
+ * returns the length. Digits are produced from the right by division by
+ * 10, so no printf or floating point is involved.
  ******************************************************************************/
 
-void mcp9808_Read(void)
+uint8_t mcp9808_FormatMilliC(char *text, int32_t milli)
 {
-	I2C_Read(mcp9808_slave_addr);
+	char digits[MCP9808_TEXT_MAX];
+	uint32_t magnitude = (milli < 0) ? 0u - (uint32_t) milli : (uint32_t) milli;
+	uint8_t count = 0, length = 0;
+
+	/* At least one integer digit: "0.005". */
+	do
+	{
+		if(count == 3)
+			digits[count++] = '.';
+		digits[count++] = (char) ('0' + (magnitude % 10));
+		magnitude /= 10;
+	} while(magnitude || count < 5);
+
+	if(milli < 0)
+		text[length++] = '-';
+	while(count)
+		text[length++] = digits[--count];
+	text[length] = '\0';
+
+	return length;
 }
+
+#ifdef MCP9808_ALERT_ENABLED
+
+/***************************************************************************//**
+ * Temperature in 1/16 C to a T_UPPER, T_LOWER or T_CRIT value: 13 bit two's
+ * complement with the two bits below 0.25 C clear.
+ ******************************************************************************/
+
+static uint16_t mcp9808_EncodeLimit(int32_t sixteenths)
+{
+	return (uint16_t) (sixteenths & 0x1FFC);
+}
+
+/***************************************************************************//**
+ * Completion callback of a limit or configuration write, in the I2C
+ * interrupt.
+ ******************************************************************************/
+
+static void mcp9808_WriteDone(const i2c_request_t *request)
+{
+	if(request->status != i2cTransferDone)
+		mcp9808_alert_stats.write_failures++;
+}
+
+/***************************************************************************//**
+ * Completion callback of the last write of a rearm: an ALERT output still
+ * asserted has no edge left to give, the temperature left the new window
+ * already, so another sample is queued.
+ ******************************************************************************/
+
+static void mcp9808_RearmDone(const i2c_request_t *request)
+{
+	mcp9808_WriteDone(request);
+
+	if(request->status == i2cTransferDone && !mcp9808_critical
+	   && GPIO_PinInGet(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN) == 0)
+	{
+		mcp9808_alert_stats.rechecks++;
+		eventRing_Push(&isr_event_ring, ISR_EVENT_MCP9808_ALERT, 1);
+		gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
+	}
+}
+
+/***************************************************************************//**
+ * This function queues a write of a 16 bit MCP9808 register.
+ ******************************************************************************/
+
+static void mcp9808_WriteRegister(uint8_t reg, uint16_t value, i2c_callback_t callback)
+{
+	uint8_t write[3] = { reg, (uint8_t) (value >> 8), (uint8_t) value };
+
+	if(!i2cQueue_Transfer(&i2c0_queue, mcp9808_slave_addr, write, sizeof(write), 0, callback, NULL))
+		mcp9808_alert_stats.write_failures++;
+}
+
+/***************************************************************************//**
+ * This function sets up the ALERT pin and the MCP9808 alert output, and
+ * queues a first sample to centre the window on; the main loop takes it
+ * on its first pass.
+ ******************************************************************************/
+
+void mcp9808_Init(void)
+{
+	CORE_DECLARE_IRQ_STATE;
+
+	memset(&mcp9808_alert_stats, 0, sizeof(mcp9808_alert_stats));
+	mcp9808_critical = false;
+
+	/* Open drain output, pulled up here; the edge of interest is the falling one. */
+	GPIO_PinModeSet(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN, gpioModeInputPull, true);
+	GPIO_ExtIntConfig(MCP9808_ALERT_PORT, MCP9808_ALERT_PIN, MCP9808_ALERT_PIN, false, true, true);
+	GPIOINT_CallbackRegister(MCP9808_ALERT_PIN, mcp9808_AlertIRQHandler);
+
+	mcp9808_WriteRegister(MCP9808_REG_T_CRIT, mcp9808_EncodeLimit((MCP9808_T_CRIT_MC * 16) / 1000),
+						  mcp9808_WriteDone);
+	mcp9808_WriteRegister(MCP9808_REG_CONFIG, MCP9808_CONFIG_ALERT_EN | MCP9808_ALERT_HYST, mcp9808_WriteDone);
+
+	/* The ALERT interrupt is enabled already and pushes to the same
+	 * single-producer ring, so it is masked around this push. */
+	CORE_ENTER_CRITICAL();
+	eventRing_Push(&isr_event_ring, ISR_EVENT_MCP9808_ALERT, 0);
+	gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * This function centres the ALERT window on the last reading, rounded out
+ * to the 0.25 C steps of the limits.
+ *
+ * @return bool True if the reading was at or above T_CRIT: the ALERT output
+ * stays low until it falls back, so the caller has to poll.
+ ******************************************************************************/
+
+bool mcp9808_AlertRearm(void)
+{
+	uint16_t ta = mcp9808_ta;
+	int32_t centre = (int32_t) (ta & MCP9808_TA_MASK);
+	int32_t band = (MCP9808_ALERT_BAND_MC * 16) / 1000;
+
+	/* Sign extend the 13 bit reading. */
+	if(centre & MCP9808_TA_SIGN)
+		centre -= MCP9808_TA_MASK + 1;
+
+	mcp9808_critical = (ta & MCP9808_TA_CRIT) != 0;
+	if(mcp9808_critical)
+		mcp9808_alert_stats.critical++;
+	mcp9808_alert_stats.rearms++;
+
+	mcp9808_WriteRegister(MCP9808_REG_T_UPPER, mcp9808_EncodeLimit((centre + band + 3) & ~3), mcp9808_WriteDone);
+	mcp9808_WriteRegister(MCP9808_REG_T_LOWER, mcp9808_EncodeLimit((centre - band) & ~3), mcp9808_RearmDone);
+
+	return mcp9808_critical;
+}
+
+/***************************************************************************//**
+ * ALERT falling edge (gpiointerrupt callback): the temperature left the
+ * window or reached T_CRIT.
+ ******************************************************************************/
+
+void mcp9808_AlertIRQHandler(uint8_t pin)
+{
+	(void) pin;
+
+	mcp9808_alert_stats.alerts++;
+	eventRing_Push(&isr_event_ring, ISR_EVENT_MCP9808_ALERT, 0);
+	gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
+}
+
+#else
+
+void mcp9808_Init(void)
+{
+}
+
+#endif
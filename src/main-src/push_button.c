@@ -136,14 +136,16 @@ void pushButton_IRQHandler(uint8_t pin)
 		if(GPIO_PinInGet(PB0_PORT, PB0_PIN) == 0)
 		{
 			PB0_val = BUTTON_PRESSED;
-			gecko_external_signal(EXT_SIGNAL_PB0_PRESSED);
+			eventRing_Push(&isr_event_ring, ISR_EVENT_PB0, 1);
+			gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
 		}
 
 		/* PB0 Released */
 		else
 		{
 			PB0_val = BUTTON_RELEASED;
-			gecko_external_signal(EXT_SIGNAL_PB0_RELEASED);
+			eventRing_Push(&isr_event_ring, ISR_EVENT_PB0, 0);
+			gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
 		}
 	}
 
@@ -153,14 +155,16 @@ void pushButton_IRQHandler(uint8_t pin)
 		if(GPIO_PinInGet(PB1_PORT, PB1_PIN) == 0)
 		{
 			PB1_val = BUTTON_PRESSED;
-			gecko_external_signal(EXT_SIGNAL_PB1_PRESSED);
+			eventRing_Push(&isr_event_ring, ISR_EVENT_PB1, 1);
+			gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
 		}
 
 		/* PB1 Released */
 		else
 		{
 			PB1_val = BUTTON_RELEASED;
-			gecko_external_signal(EXT_SIGNAL_PB1_RELEASED);
+			eventRing_Push(&isr_event_ring, ISR_EVENT_PB1, 0);
+			gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
 		}
 	}
 
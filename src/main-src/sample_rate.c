@@ -0,0 +1,172 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sample_rate.c
+ *
+ * @brief Adaptive sampling period, driven by the rate of change of the
+ * readings.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <src/headers/sample_rate.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t sampleRate_Clamp(const sample_rate_config_t *config, uint64_t period)
+{
+	if(period < config->min_ms)
+		return config->min_ms;
+	if(period > config->max_ms)
+		return config->max_ms;
+	return (uint32_t) period;
+}
+
+/**
+ * @brief Longest period that still sees a threshold crossing in time: the
+ * near period within the margin, and half the time left to the margin at
+ * the current rate when heading for it.
+ *
+ * @param const sample_rate_config_t *config, int32_t value, int32_t change
+ * (since the last reading), uint32_t elapsed (ms since the last reading)
+ * @return uint32_t UINT32_MAX when no threshold is close.
+ */
+static uint32_t sampleRate_NearLimit(const sample_rate_config_t *config, int32_t value, int32_t change,
+									 uint32_t elapsed)
+{
+	uint32_t limit = UINT32_MAX;
+	uint8_t i;
+
+	for(i = 0; i < config->thresholds; i++)
+	{
+		int32_t distance = config->threshold[i] - value, towards = change;
+		uint64_t left;
+
+		if(distance <= config->margin && distance >= -config->margin)
+			return config->near_ms;
+
+		/* Heading for it: the change has the sign of the distance. */
+		if(change > config->stable || change < -config->stable)
+		{
+			if((distance > 0) != (towards > 0))
+				continue;
+
+			if(distance < 0)
+			{
+				distance = -distance;
+				towards = -towards;
+			}
+			left = ((uint64_t) (distance - config->margin) * elapsed) / (uint32_t) towards;
+			if(left / 2 < limit)
+				limit = (left / 2 > config->near_ms) ? (uint32_t) (left / 2) : config->near_ms;
+		}
+	}
+	return limit;
+}
+
+/**
+ * @brief Start without readings, on a copy of the configuration.
+ *
+ * @param sample_rate_t *rate, const sample_rate_config_t *config
+ * @return void.
+ */
+void sampleRate_Init(sample_rate_t *rate, const sample_rate_config_t *config)
+{
+	memset(rate, 0, sizeof(*rate));
+	rate->config = *config;
+	rate->period_ms = sampleRate_Clamp(config, config->base_ms);
+}
+
+/**
+ * @brief Replace the configuration, keeping the readings seen so far; the
+ * current period is brought within the new bounds.
+ *
+ * @param sample_rate_t *rate, const sample_rate_config_t *config
+ * @return void.
+ */
+void sampleRate_Configure(sample_rate_t *rate, const sample_rate_config_t *config)
+{
+	rate->config = *config;
+	rate->period_ms = sampleRate_Clamp(config, rate->period_ms);
+}
+
+/**
+ * @brief Take a reading and give the period until the next one.
+ *
+ * @param sample_rate_t *rate, uint32_t now_ms, int32_t value
+ * @return uint32_t Period in ms.
+ */
+uint32_t sampleRate_Update(sample_rate_t *rate, uint32_t now_ms, int32_t value)
+{
+	const sample_rate_config_t *config = &rate->config;
+	uint64_t period = rate->period_ms;
+	uint32_t elapsed, limit;
+	int32_t change = 0, size;
+
+	if(!rate->primed)
+	{
+		rate->primed = true;
+		elapsed = config->base_ms;
+		period = config->base_ms;
+	}
+	else
+	{
+		elapsed = now_ms - rate->last_ms;
+		if(elapsed == 0)
+			elapsed = 1;
+
+		change = value - rate->last;
+		size = (change < 0) ? -change : change;
+		if(size <= config->stable)
+		{
+			period *= 2;
+			rate->stats.stable++;
+		}
+		else
+		{
+			/* The period that would have made this change one step, but
+			 * lengthening no faster than when stable. */
+			uint64_t target = ((uint64_t) elapsed * (uint32_t) config->step) / (uint32_t) size;
+
+			if(target < period)
+				rate->stats.faster++;
+			period = (target < period * 2) ? target : period * 2;
+		}
+	}
+
+	period = sampleRate_Clamp(config, period);
+	limit = sampleRate_NearLimit(config, value, change, elapsed);
+	if(limit < period)
+	{
+		period = sampleRate_Clamp(config, limit);
+		rate->stats.near++;
+	}
+
+	rate->last_ms = now_ms;
+	rate->last = value;
+	rate->period_ms = (uint32_t) period;
+
+	if(rate->stats.readings == 0 || rate->period_ms < rate->stats.period_min)
+		rate->stats.period_min = rate->period_ms;
+	if(rate->period_ms > rate->stats.period_max)
+		rate->stats.period_max = rate->period_ms;
+	rate->stats.readings++;
+
+	return rate->period_ms;
+}
+
+uint32_t sampleRate_Period(const sample_rate_t *rate)
+{
+	return rate->period_ms;
+}
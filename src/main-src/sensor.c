@@ -0,0 +1,404 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor.c
+ *
+ * @brief Sensors described by tables, sampled in batches.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "sl_sleeptimer.h"
+#include <src/headers/header.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static sensor_t *sensor_list;
+static sensor_batch_stats_t sensor_stats;
+
+static sl_sleeptimer_timer_handle_t sensor_timer;
+static bool sensor_batch_open;				// Between sensor_StartBatch() and sensor_ReportBatch()
+
+/* Transfers of the current stage still outstanding, plus one held by the
+ * main loop while it queues them; whoever takes it to zero ends the stage.
+ * Changed in the I2C interrupt, so only in critical sections elsewhere. */
+static volatile uint8_t sensor_outstanding;
+static volatile bool sensor_converting;		// Stage: conversions started, or results read
+static volatile uint16_t sensor_conversion_ms;	// Longest conversion started
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static void sensor_Signal(uint8_t type)
+{
+	eventRing_Push(&isr_event_ring, type, 0);
+	gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
+}
+
+/**
+ * @brief Sleeptimer callback, in the RTCC interrupt: the conversions of
+ * the batch are done.
+ *
+ * @param sl_sleeptimer_timer_handle_t *handle, void *data
+ * @return void.
+ */
+static void sensor_Converted(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+	(void) handle;
+	(void) data;
+
+	sensor_Signal(ISR_EVENT_SENSORS_CONVERTED);
+}
+
+/**
+ * @brief One transfer of the stage is over; the last one waits for the
+ * conversions or hands the readings to the main loop. In the I2C
+ * interrupt or a critical section.
+ *
+ * @param void
+ * @return void.
+ */
+static void sensor_TransferOver(void)
+{
+	if(--sensor_outstanding)
+		return;
+
+	if(!sensor_converting)
+		sensor_Signal(ISR_EVENT_SENSORS_READ);
+	else if(sensor_conversion_ms)
+		sl_sleeptimer_start_timer(&sensor_timer,
+								  (uint32_t) (((uint64_t) sensor_conversion_ms
+											   * sl_sleeptimer_get_timer_frequency() + 999) / 1000),
+								  sensor_Converted, NULL, 0, SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG);
+	else
+		sensor_Signal(ISR_EVENT_SENSORS_CONVERTED);
+}
+
+/* Queue one transfer of the stage, counted before it can complete. */
+static bool sensor_Queue(sensor_t *sensor, const uint8_t *write, uint8_t write_len, uint8_t read_len,
+						 i2c_callback_t callback)
+{
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_CRITICAL();
+	sensor_outstanding++;
+	CORE_EXIT_CRITICAL();
+
+	if(i2cQueue_Transfer(sensor->desc->bus, sensor->desc->addr, write, write_len, read_len, callback, sensor))
+		return true;
+
+	CORE_ENTER_CRITICAL();
+	sensor_outstanding--;
+	CORE_EXIT_CRITICAL();
+	sensor->stats.failures++;
+	return false;
+}
+
+/* Give back the count the main loop held while queueing the stage. */
+static void sensor_Release(void)
+{
+	CORE_DECLARE_IRQ_STATE;
+
+	CORE_ENTER_CRITICAL();
+	sensor_TransferOver();
+	CORE_EXIT_CRITICAL();
+}
+
+static void sensor_SetupDone(const i2c_request_t *request)
+{
+	if(request->status != i2cTransferDone)
+		sensor_stats.setup_failures++;
+}
+
+/**
+ * @brief Completion of a conversion trigger, in the I2C interrupt; a
+ * sensor that did not take it is left out of the reads.
+ *
+ * @param const i2c_request_t *request
+ * @return void.
+ */
+static void sensor_TriggerDone(const i2c_request_t *request)
+{
+	sensor_t *sensor = request->context;
+
+	if(request->status != i2cTransferDone)
+	{
+		sensor->in_batch = false;
+		sensor->stats.failures++;
+	}
+	sensor_TransferOver();
+}
+
+/**
+ * @brief Completion of a result read, in the I2C interrupt: the bytes are
+ * decoded into the value of the sensor.
+ *
+ * @param const i2c_request_t *request
+ * @return void.
+ */
+static void sensor_ReadDone(const i2c_request_t *request)
+{
+	sensor_t *sensor = request->context;
+	int32_t value;
+
+	if(request->status != i2cTransferDone)
+		sensor->stats.failures++;
+	else if(!sensor->desc->decode(request->read, &value))
+		sensor->stats.decode_errors++;
+	else
+	{
+		sensor->value = value;
+		sensor->valid = true;
+		sensor->stats.reads++;
+	}
+	sensor_TransferOver();
+}
+
+/* Period of a sensor elapsed, from wakeup_Run(). */
+static void sensor_Expired(void *context)
+{
+	sensor_MarkDue(context);
+}
+
+/**
+ * @brief Forget every sensor; before the first sensor_Register().
+ *
+ * @param void
+ * @return void.
+ */
+void sensor_Init(void)
+{
+	sl_sleeptimer_stop_timer(&sensor_timer);
+	sensor_list = NULL;
+	sensor_batch_open = false;
+	sensor_outstanding = 0;
+	memset(&sensor_stats, 0, sizeof(sensor_stats));
+}
+
+/**
+ * @brief Add a sensor: its setup bytes are queued on its bus and its
+ * period starts on the wakeup coordinator. Sensors are batched in the
+ * order they were registered.
+ *
+ * @param sensor_t *sensor, const sensor_desc_t *desc
+ * @return void.
+ */
+void sensor_Register(sensor_t *sensor, const sensor_desc_t *desc)
+{
+	sensor_t **link;
+
+	memset(sensor, 0, sizeof(*sensor));
+	sensor->desc = desc;
+	for(link = &sensor_list; *link; link = &(*link)->next)
+		;
+	*link = sensor;
+
+	if(desc->setup_len && !i2cQueue_Transfer(desc->bus, desc->addr, desc->setup, desc->setup_len, 0,
+											 sensor_SetupDone, sensor))
+		sensor_stats.setup_failures++;
+
+	wakeup_Setup(&sensor->activity, desc->name, sensor_Expired, sensor, desc->period_ms, desc->slack_ms, true);
+	wakeup_Start(&sensor->activity);
+}
+
+/**
+ * @brief Have a sensor read in the next batch, ahead of its period (an
+ * alert). A sensor in the open batch is being read already and is not
+ * read again after it.
+ *
+ * @param sensor_t *sensor
+ * @return void.
+ */
+void sensor_MarkDue(sensor_t *sensor)
+{
+	if(sensor->desc && !sensor->in_batch)
+		sensor->due = true;
+}
+
+/**
+ * @brief A sensor is due and no batch is open: the state machine should
+ * start one.
+ *
+ * @param void
+ * @return bool.
+ */
+bool sensor_Due(void)
+{
+	const sensor_t *sensor;
+
+	if(sensor_batch_open)
+		return false;
+
+	for(sensor = sensor_list; sensor; sensor = sensor->next)
+	{
+		if(sensor->due)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Open a batch of every due sensor and start their conversions
+ * back-to-back; the results are read on ISR_EVENT_SENSORS_CONVERTED. With
+ * no conversion to start, they are read at once.
+ *
+ * @param void
+ * @return void.
+ */
+void sensor_StartBatch(void)
+{
+	sensor_t *sensor;
+	uint32_t count = 0;
+	bool triggered = false;
+
+	sensor_batch_open = true;
+	sensor_converting = true;
+	sensor_conversion_ms = 0;
+	sensor_outstanding = 1;
+
+	for(sensor = sensor_list; sensor; sensor = sensor->next)
+	{
+		const sensor_desc_t *desc = sensor->desc;
+
+		if(!sensor->due)
+			continue;
+
+		sensor->due = false;
+		sensor->in_batch = true;
+		sensor->valid = false;
+		count++;
+
+		if(!desc->trigger_len)
+			continue;
+
+		if(!sensor_Queue(sensor, desc->trigger, desc->trigger_len, 0, sensor_TriggerDone))
+		{
+			sensor->in_batch = false;
+			continue;
+		}
+
+		triggered = true;
+		if(desc->conversion_ms > sensor_conversion_ms)
+			sensor_conversion_ms = desc->conversion_ms;
+	}
+
+	sensor_stats.batches++;
+	sensor_stats.sensors += count;
+	if(count > 1)
+		sensor_stats.shared++;
+
+	if(triggered)
+	{
+		sensor_stats.conversions++;
+		sensor_Release();
+	}
+	else
+	{
+		sensor_outstanding = 0;
+		sensor_ReadBatch();
+	}
+}
+
+/**
+ * @brief Read the results of every sensor in the batch back-to-back; the
+ * batch is reported on ISR_EVENT_SENSORS_READ.
+ *
+ * @param void
+ * @return void.
+ */
+void sensor_ReadBatch(void)
+{
+	sensor_t *sensor;
+
+	sensor_converting = false;
+	sensor_outstanding = 1;
+
+	for(sensor = sensor_list; sensor; sensor = sensor->next)
+	{
+		if(sensor->in_batch)
+			sensor_Queue(sensor, sensor->desc->read_cmd, sensor->desc->read_cmd_len, sensor->desc->read_len,
+						 sensor_ReadDone);
+	}
+
+	sensor_Release();
+}
+
+/**
+ * @brief Close the batch: every sensor read well is time stamped and its
+ * report hook runs. One that failed is read again on its next period.
+ *
+ * @param void
+ * @return void.
+ */
+void sensor_ReportBatch(void)
+{
+	sensor_t *sensor;
+
+	sensor_batch_open = false;
+
+	for(sensor = sensor_list; sensor; sensor = sensor->next)
+	{
+		if(!sensor->in_batch)
+			continue;
+
+		sensor->in_batch = false;
+		if(!sensor->valid)
+			continue;
+
+		sensor->time_ms = wakeup_TimeMs();
+		if(sensor->desc->report)
+			sensor->desc->report(sensor);
+	}
+}
+
+/**
+ * @brief Change the period of a sensor from its report hook, e.g. after
+ * the rate of change of its readings.
+ *
+ * @param sensor_t *sensor, uint32_t period_ms, uint32_t slack_ms
+ * @return void.
+ */
+void sensor_SetPeriod(sensor_t *sensor, uint32_t period_ms, uint32_t slack_ms)
+{
+	wakeup_SetPeriod(&sensor->activity, period_ms, slack_ms);
+}
+
+/**
+ * @brief The sensor measuring a mesh device property.
+ *
+ * @param uint16_t property_id
+ * @return sensor_t * NULL if none does.
+ */
+sensor_t *sensor_Find(uint16_t property_id)
+{
+	sensor_t *sensor;
+
+	for(sensor = sensor_list; sensor; sensor = sensor->next)
+	{
+		if(sensor->desc->property_id == property_id)
+			return sensor;
+	}
+	return NULL;
+}
+
+const sensor_t *sensor_List(void)
+{
+	return sensor_list;
+}
+
+const sensor_batch_stats_t *sensor_Stats(void)
+{
+	return &sensor_stats;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor_drivers.c
+ *
+ * @brief Decode functions of the SHT3x, SCD4x and OPT3001 sensors.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <src/headers/sensor_drivers.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Sensirion word CRC: x^8 + x^5 + x^4 + 1, from 0xFF. */
+#define SENSIRION_CRC_POLY			0x31
+#define SENSIRION_CRC_INIT			0xFF
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief CRC-8 of the SHT3x and SCD4x, over the two bytes of a word;
+ * 0xBEEF gives 0x92.
+ *
+ * @param const uint8_t *data, uint8_t len
+ * @return uint8_t.
+ */
+uint8_t sensirion_Crc8(const uint8_t *data, uint8_t len)
+{
+	uint8_t crc = SENSIRION_CRC_INIT;
+
+	while(len--)
+	{
+		crc ^= *data++;
+		for(uint8_t bit = 0; bit < 8; bit++)
+			crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ SENSIRION_CRC_POLY) : (uint8_t) (crc << 1);
+	}
+	return crc;
+}
+
+/**
+ * @brief SHT3x humidity, in 0.01 %RH: 10000 * S / (2^16 - 1), from the
+ * second word. Both words have to pass their CRC.
+ *
+ * @param const uint8_t *raw, int32_t *value
+ * @return bool.
+ */
+bool sht3x_DecodeHumidity(const uint8_t *raw, int32_t *value)
+{
+	if(sensirion_Crc8(&raw[0], 2) != raw[2] || sensirion_Crc8(&raw[3], 2) != raw[5])
+		return false;
+
+	*value = (int32_t) ((((uint32_t) raw[3] << 8) | raw[4]) * 10000 / 65535);
+	return true;
+}
+
+/**
+ * @brief SCD4x CO2 concentration, in ppm; 0 until the first measurement
+ * after start up is ready, which is refused.
+ *
+ * @param const uint8_t *raw, int32_t *value
+ * @return bool.
+ */
+bool scd4x_DecodeCo2(const uint8_t *raw, int32_t *value)
+{
+	uint16_t co2 = (uint16_t) ((raw[0] << 8) | raw[1]);
+
+	if(sensirion_Crc8(raw, 2) != raw[2] || co2 == 0)
+		return false;
+
+	*value = co2;
+	return true;
+}
+
+/**
+ * @brief OPT3001 illuminance, in 0.01 lux: the 12 bit mantissa shifted by
+ * the 4 bit exponent (LSB 0.01 lux << E). Exponents above 11 are not
+ * defined.
+ *
+ * @param const uint8_t *raw, int32_t *value
+ * @return bool.
+ */
+bool opt3001_DecodeLux(const uint8_t *raw, int32_t *value)
+{
+	uint8_t exponent = raw[0] >> 4;
+	uint32_t mantissa = ((uint32_t) (raw[0] & 0x0F) << 8) | raw[1];
+
+	if(exponent > 11)
+		return false;
+
+	*value = (int32_t) (mantissa << exponent);
+	return true;
+}
@@ -0,0 +1,440 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sensor_history.c
+ *
+ * @brief Log-structured sensor history on the external MX25 SPI flash.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <src/headers/sensor_history.h>
+#include <src/headers/display.h>
+#include "mx25flash_spi.h"
+#include "displaypal.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define SENSOR_HISTORY_SECTORS			(SENSOR_HISTORY_PAGES / SENSOR_HISTORY_SECTOR_PAGES)
+#define SENSOR_HISTORY_HEADER_SIZE		8			// seq, boot and count
+#define SENSOR_HISTORY_WAKE_TRIES		8			// MX25_RES calls allowed to see the ID after deep power-down
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static sensor_history_stats_t history_stats;
+
+static bool history_ready;						// Flash found by sensorHistory_Init()
+static uint16_t history_boot;					// Boot count of this run
+static uint32_t history_first;					// Oldest page still on flash
+static uint32_t history_next;					// Page to program next
+static uint32_t history_erased;					// Pages [history_next, history_erased) are erased
+
+/* Appends fill one buffer while the other waits for sensorHistory_Idle(). */
+static sensor_history_page_t history_buffer[2];
+static uint8_t history_fill;
+static bool history_full;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t sensorHistory_Address(uint32_t seq)
+{
+	return SENSOR_HISTORY_FLASH_BASE + ((seq % SENSOR_HISTORY_PAGES) * SENSOR_HISTORY_PAGE_SIZE);
+}
+
+/**
+ * @brief Empty a page buffer. Unused records stay 0xFF, which programming
+ * leaves untouched.
+ *
+ * @param sensor_history_page_t *page
+ * @return void.
+ */
+static void sensorHistory_Clear(sensor_history_page_t *page)
+{
+	memset(page, 0xFF, sizeof(*page));
+	page->count = 0;
+}
+
+/**
+ * @brief Check that pages are erased. The flash must be awake.
+ *
+ * @param uint32_t seq (first page), uint32_t pages, sensor_history_page_t *buffer
+ * @return bool.
+ */
+static bool sensorHistory_Blank(uint32_t seq, uint32_t pages, sensor_history_page_t *buffer)
+{
+	const uint32_t *word = (const uint32_t *) buffer;
+
+	for(uint32_t p = 0; p < pages; p++)
+	{
+		MX25_READ(sensorHistory_Address(seq + p), (uint8_t *) buffer, sizeof(*buffer));
+		for(uint32_t i = 0; i < sizeof(*buffer) / sizeof(*word); i++)
+		{
+			if(word[i] != 0xFFFFFFFF)
+				return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Take USART1 from the LCD and wake the flash from deep power-down.
+ *
+ * An LCD frame still going out on the LDMA is waited for first, so no
+ * session, the ones from sensorHistory_Append() and sensorHistory_Flush()
+ * included, reroutes the USART under it. MX25_init() then restores the
+ * flash routing and clocking of the shared USART. The chip select edge of
+ * the first MX25_RES releases the chip from deep power-down; it answers
+ * with its ID once tRDP has passed.
+ *
+ * @param void
+ * @return bool False if the flash did not answer, the bus is handed back.
+ */
+static bool sensorHistory_Wake(void)
+{
+	uint8_t id = 0;
+
+	if(displayWaitSent())
+		history_stats.display_waits++;
+
+	MX25_init();
+	for(int i = 0; i < SENSOR_HISTORY_WAKE_TRIES; i++)
+	{
+		MX25_RES(&id);
+		if(id == ElectronicID)
+		{
+			history_stats.sessions++;
+			return true;
+		}
+	}
+
+	history_stats.errors++;
+	PAL_SpiInit();
+	return false;
+}
+
+/**
+ * @brief Put the flash back into deep power-down and return USART1 to the LCD.
+ *
+ * @param void
+ * @return void.
+ */
+static void sensorHistory_Sleep(void)
+{
+	MX25_DP();
+	PAL_SpiInit();
+}
+
+/**
+ * @brief Erase the sector at the end of the erased window. This drops the
+ * oldest sector of the ring once the region has wrapped.
+ *
+ * @param void
+ * @return bool.
+ */
+static bool sensorHistory_EraseAhead(void)
+{
+	if(MX25_SE(sensorHistory_Address(history_erased)) != FlashOperationSuccess)
+	{
+		history_stats.errors++;
+		return false;
+	}
+
+	history_erased += SENSOR_HISTORY_SECTOR_PAGES;
+	if(history_erased > SENSOR_HISTORY_PAGES && history_first < history_erased - SENSOR_HISTORY_PAGES)
+		history_first = history_erased - SENSOR_HISTORY_PAGES;
+	history_stats.erases++;
+	return true;
+}
+
+/**
+ * @brief Program one page buffer as the next page of the ring, in a single
+ * MX25_PP burst. The flash must be awake.
+ *
+ * @param sensor_history_page_t *page
+ * @return bool.
+ */
+static bool sensorHistory_Program(sensor_history_page_t *page)
+{
+	if(history_next >= history_erased)
+	{
+		/* The idle hook has not caught up, erase in line. */
+		if(!sensorHistory_EraseAhead())
+			return false;
+		history_stats.inline_erases++;
+	}
+
+	page->seq = history_next;
+	page->boot = history_boot;
+	if(MX25_PP(sensorHistory_Address(history_next), (uint8_t *) page, SENSOR_HISTORY_PAGE_SIZE)
+		!= FlashOperationSuccess)
+	{
+		history_stats.errors++;
+		return false;
+	}
+
+	history_next++;
+	history_stats.pages++;
+	return true;
+}
+
+/**
+ * @brief Find the write position and put the flash into deep power-down.
+ *
+ * The boot scan reads the header of the first page of each sector to find
+ * the newest sector, then the headers of that sector's pages. The page
+ * after the newest one is checked to be blank, so a page torn by a reset
+ * during programming is skipped rather than programmed over, and so is the
+ * next sector, so an erase done ahead before the reset is not repeated.
+ *
+ * @param void
+ * @return bool False if no MX25 answered; appends are then dropped.
+ */
+bool sensorHistory_Init(void)
+{
+	sensor_history_page_t page;
+	bool found = false;
+	uint32_t newest = 0, oldest = 0;
+	uint16_t boot = 0;
+
+	memset(&history_stats, 0, sizeof(history_stats));
+	sensorHistory_Clear(&history_buffer[0]);
+	sensorHistory_Clear(&history_buffer[1]);
+	history_fill = 0;
+	history_full = false;
+	history_first = 0;
+	history_next = 0;
+	history_erased = 0;
+	history_ready = false;
+
+	if(!sensorHistory_Wake())
+		return false;
+
+	for(uint32_t sector = 0; sector < SENSOR_HISTORY_SECTORS; sector++)
+	{
+		uint32_t first = sector * SENSOR_HISTORY_SECTOR_PAGES;
+
+		MX25_READ(sensorHistory_Address(first), (uint8_t *) &page, SENSOR_HISTORY_HEADER_SIZE);
+		if(page.seq == 0xFFFFFFFF || (page.seq % SENSOR_HISTORY_PAGES) != first
+			|| page.count > SENSOR_HISTORY_PAGE_RECORDS)
+			continue;
+
+		if(!found || page.seq > newest)
+		{
+			newest = page.seq;
+			boot = page.boot;
+		}
+		if(!found || page.seq < oldest)
+			oldest = page.seq;
+		found = true;
+	}
+
+	if(found)
+	{
+		for(uint32_t i = 1; i < SENSOR_HISTORY_SECTOR_PAGES; i++)
+		{
+			MX25_READ(sensorHistory_Address(newest + 1), (uint8_t *) &page, SENSOR_HISTORY_HEADER_SIZE);
+			if(page.seq != newest + 1 || page.count > SENSOR_HISTORY_PAGE_RECORDS)
+				break;
+			newest++;
+			boot = page.boot;
+		}
+
+		history_first = oldest;
+		history_next = newest + 1;
+	}
+
+	/* The rest of the newest sector was never programmed, if the next page is blank. */
+	if(history_next % SENSOR_HISTORY_SECTOR_PAGES)
+	{
+		if(!sensorHistory_Blank(history_next, 1, &page))
+			history_next++;
+	}
+	history_erased = (history_next + SENSOR_HISTORY_SECTOR_PAGES - 1) / SENSOR_HISTORY_SECTOR_PAGES
+					 * SENSOR_HISTORY_SECTOR_PAGES;
+
+	if(sensorHistory_Blank(history_erased, SENSOR_HISTORY_SECTOR_PAGES, &page))
+		history_erased += SENSOR_HISTORY_SECTOR_PAGES;
+
+	sensorHistory_Sleep();
+
+	history_boot = boot + 1;
+	history_stats.recovered = history_next - history_first;
+	history_ready = true;
+	return true;
+}
+
+/**
+ * @brief Add a record to the page being filled.
+ *
+ * This is a copy into RAM. Only if the previous full page is still waiting
+ * for sensorHistory_Idle() is it programmed here.
+ *
+ * @param uint16_t source, uint32_t time (seconds), int16_t value
+ * @return void.
+ */
+void sensorHistory_Append(uint16_t source, uint32_t time, int16_t value)
+{
+	sensor_history_page_t *page = &history_buffer[history_fill];
+	sensor_history_record_t *record;
+
+	if(!history_ready)
+	{
+		history_stats.dropped++;
+		return;
+	}
+
+	record = &page->record[page->count++];
+	record->time = time;
+	record->source = source;
+	record->value = value;
+	history_stats.appends++;
+
+	if(page->count < SENSOR_HISTORY_PAGE_RECORDS)
+		return;
+
+	if(history_full)
+	{
+		sensor_history_page_t *waiting = &history_buffer[history_fill ^ 1];
+
+		if(!sensorHistory_Wake())
+		{
+			history_stats.dropped += waiting->count;
+		}
+		else
+		{
+			if(sensorHistory_Program(waiting))
+				history_stats.inline_writes++;
+			else
+				history_stats.dropped += waiting->count;
+			sensorHistory_Sleep();
+		}
+	}
+
+	history_full = true;
+	history_fill ^= 1;
+	sensorHistory_Clear(&history_buffer[history_fill]);
+}
+
+/**
+ * @brief Main loop hook, called when no stack event is pending.
+ *
+ * Programs the waiting full page and keeps a sector erased ahead of the
+ * write position, in one wake-up. MX25_SE busy-waits for the erase (tens
+ * of ms), which happens once every SENSOR_HISTORY_SECTOR_PAGES pages.
+ *
+ * @param void
+ * @return void.
+ */
+void sensorHistory_Idle(void)
+{
+	bool erase;
+
+	if(!history_ready)
+		return;
+
+	erase = (history_erased - history_next) < SENSOR_HISTORY_ERASE_AHEAD;
+	if(!history_full && !erase)
+		return;
+
+	if(!sensorHistory_Wake())
+		return;
+
+	if(erase)
+		sensorHistory_EraseAhead();
+
+	if(history_full)
+	{
+		sensor_history_page_t *waiting = &history_buffer[history_fill ^ 1];
+
+		if(!sensorHistory_Program(waiting))
+			history_stats.dropped += waiting->count;
+		history_full = false;
+	}
+
+	sensorHistory_Sleep();
+}
+
+/**
+ * @brief Program everything held in RAM, the page being filled included,
+ * before a reset.
+ *
+ * @param void
+ * @return void.
+ */
+void sensorHistory_Flush(void)
+{
+	sensor_history_page_t *page = &history_buffer[history_fill];
+
+	if(!history_ready || (!history_full && !page->count))
+		return;
+
+	if(!sensorHistory_Wake())
+		return;
+
+	if(history_full)
+	{
+		if(!sensorHistory_Program(&history_buffer[history_fill ^ 1]))
+			history_stats.dropped += history_buffer[history_fill ^ 1].count;
+		history_full = false;
+	}
+
+	if(page->count)
+	{
+		if(sensorHistory_Program(page))
+			history_stats.partial_pages++;
+		else
+			history_stats.dropped += page->count;
+		sensorHistory_Clear(page);
+	}
+
+	sensorHistory_Sleep();
+}
+
+/**
+ * @brief Read a programmed page back, newest first. Records still in RAM
+ * are not included.
+ *
+ * @param uint32_t age (0 for the newest page), sensor_history_page_t *page
+ * @return bool False if there is no such page.
+ */
+bool sensorHistory_ReadPage(uint32_t age, sensor_history_page_t *page)
+{
+	uint32_t seq;
+
+	if(!history_ready || age >= sensorHistory_PageCount())
+		return false;
+
+	if(!sensorHistory_Wake())
+		return false;
+
+	seq = history_next - 1 - age;
+	MX25_READ(sensorHistory_Address(seq), (uint8_t *) page, sizeof(*page));
+	sensorHistory_Sleep();
+
+	return page->seq == seq && page->count <= SENSOR_HISTORY_PAGE_RECORDS;
+}
+
+uint32_t sensorHistory_PageCount(void)
+{
+	return history_next - history_first;
+}
+
+void sensorHistory_GetStats(sensor_history_stats_t *stats)
+{
+	*stats = history_stats;
+}
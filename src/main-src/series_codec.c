@@ -0,0 +1,297 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file series_codec.c
+ *
+ * @brief Streaming compression of (time, value) sensor samples.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <src/headers/series_codec.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t seriesCodec_ZigZag(int32_t n)
+{
+	return ((uint32_t) n << 1) ^ (uint32_t) (n >> 31);
+}
+
+static int32_t seriesCodec_UnZigZag(uint32_t n)
+{
+	return (int32_t) (n >> 1) ^ -(int32_t) (n & 1);
+}
+
+/**
+ * @brief Append the low n bits of a value, MSB first. The block must have
+ * been zeroed.
+ *
+ * @param uint8_t *block, uint32_t *bits, uint32_t value, uint8_t n (at most 32)
+ * @return void.
+ */
+static void seriesCodec_Put(uint8_t *block, uint32_t *bits, uint32_t value, uint8_t n)
+{
+	while(n)
+	{
+		uint8_t room = 8 - (*bits & 7);
+		uint8_t take = (n < room) ? n : room;
+		uint32_t chunk = (value >> (n - take)) & ((1u << take) - 1);
+
+		block[*bits >> 3] |= (uint8_t) (chunk << (room - take));
+		*bits += take;
+		n -= take;
+	}
+}
+
+/**
+ * @brief Read the next n bits, MSB first. Reading past the end of the
+ * block returns 0 and leaves the decoder past its end.
+ *
+ * @param series_codec_decoder_t *decoder, uint8_t n (at most 32)
+ * @return uint32_t.
+ */
+static uint32_t seriesCodec_Get(series_codec_decoder_t *decoder, uint8_t n)
+{
+	uint32_t value = 0;
+
+	if(decoder->bits + n > decoder->size_bits)
+	{
+		decoder->bits = decoder->size_bits + 1;
+		return 0;
+	}
+
+	while(n)
+	{
+		uint8_t room = 8 - (decoder->bits & 7);
+		uint8_t take = (n < room) ? n : room;
+		uint8_t byte = decoder->block[decoder->bits >> 3];
+
+		value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+		decoder->bits += take;
+		n -= take;
+	}
+	return value;
+}
+
+/* Number of leading 1 bits of a prefix, at most max; the terminating 0 is consumed. */
+static uint8_t seriesCodec_Prefix(series_codec_decoder_t *decoder, uint8_t max)
+{
+	uint8_t ones = 0;
+
+	while(ones < max && seriesCodec_Get(decoder, 1))
+		ones++;
+	return ones;
+}
+
+/**
+ * @brief Bits needed for a time, given the delta-of-delta.
+ *
+ * @param int64_t dod
+ * @return uint8_t.
+ */
+static uint8_t seriesCodec_TimeBits(int64_t dod)
+{
+	uint32_t zz;
+
+	if(dod == 0)
+		return 1;
+	if(dod < -2048 || dod > 2048)
+		return 4 + 32;
+
+	zz = seriesCodec_ZigZag((int32_t) dod);
+	if(zz < (1u << 7))
+		return 2 + 7;
+	if(zz < (1u << 9))
+		return 3 + 9;
+	if(zz < (1u << 12))
+		return 4 + 12;
+	return 4 + 32;
+}
+
+static uint8_t seriesCodec_ValueBits(int32_t change)
+{
+	uint32_t zz = seriesCodec_ZigZag(change);
+
+	if(zz == 0)
+		return 1;
+	if(zz < (1u << 4))
+		return 2 + 4;
+	if(zz < (1u << 8))
+		return 3 + 8;
+	return 3 + 16;
+}
+
+/**
+ * @brief Start an empty block.
+ *
+ * @param series_codec_encoder_t *encoder, uint8_t *block, uint16_t size (bytes)
+ * @return void.
+ */
+void seriesCodec_EncoderInit(series_codec_encoder_t *encoder, uint8_t *block, uint16_t size)
+{
+	memset(encoder, 0, sizeof(*encoder));
+	memset(block, 0, size);
+	encoder->block = block;
+	encoder->size_bits = (uint32_t) size * 8;
+}
+
+/**
+ * @brief Append a sample to the block.
+ *
+ * @param series_codec_encoder_t *encoder, uint32_t time, int16_t value
+ * @return bool False if the sample does not fit; the block is left as it was.
+ */
+bool seriesCodec_Encode(series_codec_encoder_t *encoder, uint32_t time, int16_t value)
+{
+	int64_t delta, dod;
+	int32_t change;
+	uint8_t time_bits, value_bits;
+
+	if(!encoder->count)
+	{
+		if(encoder->bits + SERIES_CODEC_FIRST_BITS > encoder->size_bits)
+			return false;
+
+		seriesCodec_Put(encoder->block, &encoder->bits, time, 32);
+		seriesCodec_Put(encoder->block, &encoder->bits, (uint16_t) value, 16);
+		encoder->time = time;
+		encoder->delta = 0;
+		encoder->value = value;
+		encoder->count = 1;
+		return true;
+	}
+
+	delta = (int64_t) time - encoder->time;
+	dod = delta - encoder->delta;
+	change = (int32_t) value - encoder->value;
+	time_bits = seriesCodec_TimeBits(dod);
+	value_bits = seriesCodec_ValueBits(change);
+
+	if(encoder->bits + time_bits + value_bits > encoder->size_bits)
+		return false;
+
+	switch(time_bits)
+	{
+		case 1:			seriesCodec_Put(encoder->block, &encoder->bits, 0x0, 1); break;
+		case 2 + 7:		seriesCodec_Put(encoder->block, &encoder->bits, 0x2, 2);
+						seriesCodec_Put(encoder->block, &encoder->bits, seriesCodec_ZigZag((int32_t) dod), 7); break;
+		case 3 + 9:		seriesCodec_Put(encoder->block, &encoder->bits, 0x6, 3);
+						seriesCodec_Put(encoder->block, &encoder->bits, seriesCodec_ZigZag((int32_t) dod), 9); break;
+		case 4 + 12:	seriesCodec_Put(encoder->block, &encoder->bits, 0xE, 4);
+						seriesCodec_Put(encoder->block, &encoder->bits, seriesCodec_ZigZag((int32_t) dod), 12); break;
+		default:		seriesCodec_Put(encoder->block, &encoder->bits, 0xF, 4);
+						seriesCodec_Put(encoder->block, &encoder->bits, (uint32_t) delta, 32); break;
+	}
+
+	switch(value_bits)
+	{
+		case 1:			seriesCodec_Put(encoder->block, &encoder->bits, 0x0, 1); break;
+		case 2 + 4:		seriesCodec_Put(encoder->block, &encoder->bits, 0x2, 2);
+						seriesCodec_Put(encoder->block, &encoder->bits, seriesCodec_ZigZag(change), 4); break;
+		case 3 + 8:		seriesCodec_Put(encoder->block, &encoder->bits, 0x6, 3);
+						seriesCodec_Put(encoder->block, &encoder->bits, seriesCodec_ZigZag(change), 8); break;
+		default:		seriesCodec_Put(encoder->block, &encoder->bits, 0x7, 3);
+						seriesCodec_Put(encoder->block, &encoder->bits, (uint16_t) value, 16); break;
+	}
+
+	encoder->time = time;
+	encoder->delta = (int32_t) delta;
+	encoder->value = value;
+	encoder->count++;
+	return true;
+}
+
+/**
+ * @brief Bytes of the block in use.
+ *
+ * @param const series_codec_encoder_t *encoder
+ * @return uint16_t.
+ */
+uint16_t seriesCodec_EncodedSize(const series_codec_encoder_t *encoder)
+{
+	return (uint16_t) ((encoder->bits + 7) / 8);
+}
+
+/**
+ * @brief Start decoding a block holding count samples.
+ *
+ * @param series_codec_decoder_t *decoder, const uint8_t *block, uint16_t size (bytes), uint16_t count
+ * @return void.
+ */
+void seriesCodec_DecoderInit(series_codec_decoder_t *decoder, const uint8_t *block, uint16_t size, uint16_t count)
+{
+	memset(decoder, 0, sizeof(*decoder));
+	decoder->block = block;
+	decoder->size_bits = (uint32_t) size * 8;
+	decoder->remaining = count;
+	decoder->first = true;
+}
+
+/**
+ * @brief Decode the next sample.
+ *
+ * @param series_codec_decoder_t *decoder, uint32_t *time, int16_t *value
+ * @return bool False at the end of the block or if the block is corrupt.
+ */
+bool seriesCodec_Decode(series_codec_decoder_t *decoder, uint32_t *time, int16_t *value)
+{
+	static const uint8_t time_width[4] = { 7, 9, 12, 32 };
+	static const uint8_t value_width[3] = { 4, 8, 16 };
+	uint8_t prefix;
+
+	if(!decoder->remaining)
+		return false;
+
+	if(decoder->first)
+	{
+		decoder->time = seriesCodec_Get(decoder, 32);
+		decoder->value = (int16_t) seriesCodec_Get(decoder, 16);
+		decoder->first = false;
+	}
+	else
+	{
+		prefix = seriesCodec_Prefix(decoder, 4);
+		if(prefix == 4)
+		{
+			decoder->delta = (int32_t) seriesCodec_Get(decoder, 32);
+		}
+		else if(prefix)
+		{
+			decoder->delta += seriesCodec_UnZigZag(seriesCodec_Get(decoder, time_width[prefix - 1]));
+		}
+		decoder->time += (uint32_t) decoder->delta;
+
+		prefix = seriesCodec_Prefix(decoder, 3);
+		if(prefix == 3)
+		{
+			decoder->value = (int16_t) seriesCodec_Get(decoder, 16);
+		}
+		else if(prefix)
+		{
+			decoder->value = (int16_t) (decoder->value
+										+ seriesCodec_UnZigZag(seriesCodec_Get(decoder, value_width[prefix - 1])));
+		}
+	}
+
+	if(decoder->bits > decoder->size_bits)
+	{
+		decoder->remaining = 0;
+		return false;
+	}
+
+	decoder->remaining--;
+	*time = decoder->time;
+	*value = decoder->value;
+	return true;
+}
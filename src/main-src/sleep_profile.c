@@ -0,0 +1,243 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Author: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file sleep_profile.c
+ *
+ * @brief Energy mode residency profiler source file.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <src/headers/sleep_profile.h>
+#include "em_rtcc.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static sleep_profile_t sleep_profile;
+
+/* Blocks currently held per blocker, [0] for EM2 and [1] for EM3 blocks. */
+static uint8_t sleep_held[SLEEP_BLOCKER_COUNT][2];
+
+static uint32_t sleep_mark;						// RTCC count at the last mode change
+
+static const char *const sleep_blocker_names[SLEEP_BLOCKER_COUNT] =
+{
+	[SLEEP_BLOCKER_I2C]			= "I2C",
+	[SLEEP_BLOCKER_DISPLAY]		= "Display",
+	[SLEEP_BLOCKER_OTHER]		= "Other",
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Close the interval since the last mode change.
+ *
+ * The RTCC counter is 32 bits wide, so the unsigned difference stays
+ * correct across a wrap as long as one interval is shorter than 36 hours.
+ *
+ * @param void
+ * @return uint32_t Ticks elapsed in the interval.
+ */
+static uint32_t sleepProfile_Elapsed(void)
+{
+	uint32_t now = RTCC_CounterGet();
+	uint32_t elapsed = now - sleep_mark;
+
+	sleep_mark = now;
+	sleep_profile.total += elapsed;
+	return elapsed;
+}
+
+/**
+ * @brief SLEEP driver callback run right before the core goes to sleep.
+ *
+ * Closes the EM0 interval. Runs inside the SLEEP_Sleep() critical section.
+ *
+ * @param SLEEP_EnergyMode_t eMode
+ * @return void.
+ */
+static void sleepProfile_SleepCallback(SLEEP_EnergyMode_t eMode)
+{
+	sleep_profile.residency[sleepEM0] += sleepProfile_Elapsed();
+
+	if(eMode < SLEEP_PROFILE_EM_COUNT)
+	{
+		sleep_profile.entries[eMode]++;
+	}
+}
+
+/**
+ * @brief SLEEP driver callback run right after the core wakes up.
+ *
+ * Books the sleep interval to the mode that was entered. If that mode is
+ * shallower than EM3, the interval is also charged to every blocker
+ * holding the block that kept the core from going one mode deeper; blocks
+ * with no tagged holder are charged to SLEEP_BLOCKER_OTHER.
+ *
+ * @param SLEEP_EnergyMode_t eMode
+ * @return void.
+ */
+static void sleepProfile_WakeupCallback(SLEEP_EnergyMode_t eMode)
+{
+	uint32_t elapsed = sleepProfile_Elapsed();
+	bool charged = false;
+
+	sleep_profile.entries[sleepEM0]++;
+
+	if(eMode >= SLEEP_PROFILE_EM_COUNT)
+	{
+		return;
+	}
+
+	sleep_profile.residency[eMode] += elapsed;
+
+	if(eMode == sleepEM1 || eMode == sleepEM2)
+	{
+		/* EM1 means an EM2 block was held, EM2 means an EM3 block was held. */
+		uint8_t level = eMode - sleepEM1;
+
+		for(uint8_t i = 0; i < SLEEP_BLOCKER_COUNT; i++)
+		{
+			if(sleep_held[i][level])
+			{
+				sleep_profile.blocked[i] += elapsed;
+				charged = true;
+			}
+		}
+
+		if(!charged)
+		{
+			sleep_profile.blocked[SLEEP_BLOCKER_OTHER] += elapsed;
+		}
+	}
+}
+
+/**
+ * @brief Sleep profiler initialisation function
+ *
+ * Hooks the profiler callbacks into the SLEEP driver with SLEEP_HooksSet(),
+ * which keeps the callbacks and the sleep blocks the stack installed when
+ * it initialised the driver; their blocks are charged to
+ * SLEEP_BLOCKER_OTHER.
+ *
+ * @param void
+ * @return void.
+ */
+void sleepProfile_Init(void)
+{
+	memset(sleep_held, 0, sizeof(sleep_held));
+	SLEEP_HooksSet(sleepProfile_SleepCallback, sleepProfile_WakeupCallback);
+	sleepProfile_Reset();
+}
+
+/**
+ * @brief Clear the counters and start a new measurement window.
+ *
+ * Blocks that are currently held stay tracked.
+ *
+ * @param void
+ * @return void.
+ */
+void sleepProfile_Reset(void)
+{
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	{
+		memset(&sleep_profile, 0, sizeof(sleep_profile));
+		sleep_mark = RTCC_CounterGet();
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief Take a sleep block on behalf of a blocker.
+ *
+ * Drop-in replacement for SLEEP_SleepBlockBegin(); safe to call from ISRs.
+ *
+ * @param SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker
+ * @return void.
+ */
+void sleepProfile_BlockBegin(SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker)
+{
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	{
+		if((eMode == sleepEM2 || eMode == sleepEM3) && blocker < SLEEP_BLOCKER_COUNT)
+		{
+			sleep_held[blocker][eMode - sleepEM2]++;
+			sleep_profile.block_begins[blocker]++;
+		}
+		SLEEP_SleepBlockBegin(eMode);
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief Release a sleep block taken with sleepProfile_BlockBegin().
+ *
+ * @param SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker
+ * @return void.
+ */
+void sleepProfile_BlockEnd(SLEEP_EnergyMode_t eMode, sleep_blocker_t blocker)
+{
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	{
+		if((eMode == sleepEM2 || eMode == sleepEM3) && blocker < SLEEP_BLOCKER_COUNT
+			&& sleep_held[blocker][eMode - sleepEM2])
+		{
+			sleep_held[blocker][eMode - sleepEM2]--;
+		}
+		SLEEP_SleepBlockEnd(eMode);
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief Snapshot the counters, including the EM0 interval still open.
+ *
+ * @param sleep_profile_t *profile
+ * @return void.
+ */
+void sleepProfile_Get(sleep_profile_t *profile)
+{
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	{
+		sleep_profile.residency[sleepEM0] += sleepProfile_Elapsed();
+		*profile = sleep_profile;
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+const char *sleepProfile_BlockerName(sleep_blocker_t blocker)
+{
+	if(blocker < SLEEP_BLOCKER_COUNT)
+	{
+		return sleep_blocker_names[blocker];
+	}
+	return "Unknown";
+}
+
+/**
+ * @brief Periodic hook, dumps the counters to the log. Runs once a minute
+ * on its own wakeup activity (WAKEUP_PROFILE_PERIOD_MS).
+ *
+ * @param void
+ * @return void.
+ */
+void sleepProfile_Tick(void)
+{
+	logSleepProfile();
+}
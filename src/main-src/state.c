@@ -45,96 +45,227 @@
 
 #include <src/headers/state.h>
 
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////
+
+static void sm_EnterBatch(fsm_t *fsm);
+static void sm_StartBatch(fsm_t *fsm);
+static void sm_ReadBatch(fsm_t *fsm);
+static void sm_ReportBatch(fsm_t *fsm);
+static void sm_ReportTemperature(sensor_t *sensor);
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static const fsm_state_t sm_states[NUM_STATES] =
+{
+	[STATE0_SENSORS_IDLE]			= { "STATE0_SENSORS_IDLE", NULL, NULL },
+	[STATE1_SENSORS_BATCH]			= { "STATE1_SENSORS_BATCH", sm_EnterBatch, NULL },
+};
+
+/* Sensors that fall due during a batch wait for the next one; the main
+ * loop only signals EVENT0 while idle (sensor_Due()). */
+static const fsm_transition_t sm_transitions[NUM_STATES][NUM_EVENTS] =
+{
+	[STATE0_SENSORS_IDLE] =
+	{
+		[EVENT0_SENSORS_DUE]					= FSM_GOTO(STATE1_SENSORS_BATCH, sm_StartBatch),
+	},
+	[STATE1_SENSORS_BATCH] =
+	{
+		[EVENT1_SENSORS_CONVERTED]				= FSM_GOTO(STATE1_SENSORS_BATCH, sm_ReadBatch),
+		[EVENT2_SENSORS_READ]					= FSM_GOTO(STATE0_SENSORS_IDLE, sm_ReportBatch),
+	},
+};
+
+static const fsm_table_t sm_table =
+{
+	.name			= "Sensors",
+	.states			= sm_states,
+	.transitions	= &sm_transitions[0][0],
+	.num_states		= NUM_STATES,
+	.num_events		= NUM_EVENTS,
+	.initial		= STATE0_SENSORS_IDLE,
+};
+
+/* Sampling policy: shorter periods while the temperature moves or nears
+ * T_CRIT, doubling up to a minute while it holds. */
+static const sample_rate_config_t sm_rate_config =
+{
+	.min_ms			= SAMPLE_RATE_MIN_MS,
+	.max_ms			= SAMPLE_RATE_MAX_MS,
+	.base_ms		= SAMPLE_RATE_BASE_MS,
+	.near_ms		= SAMPLE_RATE_BASE_MS,
+	.step			= SAMPLE_RATE_STEP_MC,
+	.stable			= SAMPLE_RATE_STABLE_MC,
+	.margin			= SAMPLE_RATE_MARGIN_MC,
+	.thresholds		= 1,
+	.threshold		= { MCP9808_T_CRIT_MC },
+};
+
+/* The sensors of the node. The MCP9808 period follows its readings
+ * (sample_rate.h); the others keep theirs, multiples of each other from
+ * the same start. With one slack for all of them, the windows of those
+ * due together open together, so they share a batch. */
+static const sensor_desc_t sm_mcp9808_desc =
+{
+	.name			= "mcp9808",
+	.bus			= &i2c0_queue,
+	.addr			= mcp9808_slave_addr,
+	.property_id	= SENSOR_PROPERTY_TEMPERATURE,
+	.read_cmd		= { mcp9808_read_command },
+	.read_cmd_len	= 1,
+	.read_len		= 2,
+	.decode			= mcp9808_Decode,
+	.report			= sm_ReportTemperature,
+	.period_ms		= WAKEUP_SAMPLE_PERIOD_MS,
+	.slack_ms		= WAKEUP_SAMPLE_PERIOD_MS / WAKEUP_SAMPLE_SLACK_DIV,
+};
+
+#ifdef SENSOR_EXTRAS_ENABLED
+#define SM_EXTRA_SLACK_MS			250
+
+static const sensor_desc_t sm_extra_desc[] =
+{
+	{
+		.name			= "sht3x",
+		.bus			= &i2c0_queue,
+		.addr			= SHT3X_ADDR,
+		.property_id	= SENSOR_PROPERTY_HUMIDITY,
+		.trigger		= { SHT3X_MEASURE_HIGH },
+		.trigger_len	= 2,
+		.conversion_ms	= SHT3X_CONVERSION_MS,
+		.read_len		= SHT3X_READ_LEN,
+		.decode			= sht3x_DecodeHumidity,
+		.period_ms		= 10000,
+		.slack_ms		= SM_EXTRA_SLACK_MS,
+	},
+	{
+		.name			= "scd4x",
+		.bus			= &i2c0_queue,
+		.addr			= SCD4X_ADDR,
+		.property_id	= SENSOR_PROPERTY_CO2,
+		.setup			= { SCD4X_START_LOW_POWER },
+		.setup_len		= 2,
+		.trigger		= { SCD4X_READ_MEASUREMENT },
+		.trigger_len	= 2,
+		.conversion_ms	= SCD4X_COMMAND_MS,
+		.read_len		= SCD4X_READ_LEN,
+		.decode			= scd4x_DecodeCo2,
+		.period_ms		= 30000,
+		.slack_ms		= SM_EXTRA_SLACK_MS,
+	},
+	{
+		.name			= "opt3001",
+		.bus			= &i2c0_queue,
+		.addr			= OPT3001_ADDR,
+		.property_id	= SENSOR_PROPERTY_LIGHT,
+		.setup			= { OPT3001_REG_CONFIG, OPT3001_CONFIG_CONTINUOUS },
+		.setup_len		= 3,
+		.read_cmd		= { OPT3001_REG_RESULT },
+		.read_cmd_len	= 1,
+		.read_len		= OPT3001_READ_LEN,
+		.decode			= opt3001_DecodeLux,
+		.period_ms		= 5000,
+		.slack_ms		= SM_EXTRA_SLACK_MS,
+	},
+};
+
+static sensor_t sm_extra_sensors[sizeof(sm_extra_desc) / sizeof(sm_extra_desc[0])];
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // FUNCTION DEFINITIONS
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @brief State Machine Clear interrupts in the interrupt_event_bitmask variable
+ * @brief Entry of STATE1.
  *
- * Function overview
- * Handles state machine defined interrupts.
+ * @param fsm_t *fsm
+ * @return void.
+ */
+
+static void sm_EnterBatch(fsm_t *fsm)
+{
+	sm_ReportState(fsm_State(fsm));
+}
+
+/**
+ * @brief Transition STATE0 -> STATE1: start the conversions of every due
+ * sensor, or read them at once if none needs starting.
  *
- * @param void
- * @return  void.
+ * @param fsm_t *fsm
+ * @return void.
  */
 
-void sm_ClearInt(void)
+static void sm_StartBatch(fsm_t *fsm)
 {
-	/* STATE0_MCP9808_TRANSACTION_START_EVENT */
-	if(LETIMER_WAIT_FLAG_CHECK())
-	{
-		LETIMER_WAIT_FLAG_CLEAR();
-	}
+	sensor_StartBatch();
+}
 
-	/* STATE1_MCP9808_I2C_WRITE_COMPLETED_EVENT */
-	if(TEMP_I2C_WRITE_FLAG_CHECK())
-	{
-		TEMP_I2C_WRITE_FLAG_CLEAR();
-	}
+/**
+ * @brief Transition STATE1 -> STATE1: the conversions are done, read the
+ * results.
+ *
+ * @param fsm_t *fsm
+ * @return void.
+ */
 
-	/* STATE2_MCP9808_I2C_READ_COMPLETED_EVENT */
-	if(TEMP_I2C_READ_FLAG_CHECK())
-	{
-		TEMP_I2C_READ_FLAG_CLEAR();
-	}
+static void sm_ReadBatch(fsm_t *fsm)
+{
+	sensor_ReadBatch();
 }
 
 /**
- * @brief State Machine Handle interrupt events based on event_processing_bitmask value
+ * @brief Transition STATE1 -> STATE0: hand every reading to its sensor's
+ * report hook.
  *
- * Function overview
- * Schedules events and handles current event.
+ * @param fsm_t *fsm
+ * @return void.
+ */
+
+static void sm_ReportBatch(fsm_t *fsm)
+{
+	sensor_ReportBatch();
+}
+
+/**
+ * @brief Report hook of the MCP9808: store and display the reading, and
+ * set the period until the next one.
  *
- * @param int current_state
- * @return  void.
+ * @param sensor_t *sensor
+ * @return void.
  */
 
-void sm_HandleEvents(int current_state)
+static void sm_ReportTemperature(sensor_t *sensor)
 {
-	sm_HandleReset(current_state);
+	static char LCD_print[30] = "Temp(C): ";
+	int32_t reading = sensor->value;
+	uint32_t period;
+	bool critical;
 
-	static char LCD_print[30];
+	app_temp_reading = reading;
 
-	switch(current_state)
-	{
-		case 0:
-			/* STATE0_MCP9808_TRANSACTION_START_EVENT */
-			if(P_LETIMER_WAIT_FLAG_CHECK())
-			{
-				sm_ReportState(current_state);
-				P_LETIMER_WAIT_FLAG_CLEAR();
-				mcp9808_Write();
-			}
-			break;
-
-		case 1:
-			/* STATE1_MCP9808_I2C_WRITE_COMPLETED_EVENT */
-			if(P_TEMP_I2C_WRITE_FLAG_CHECK())
-			{
-				sm_ReportState(current_state);
-				P_TEMP_I2C_WRITE_FLAG_CLEAR();
-				mcp9808_Read();
-			}
-			break;
-
-		case 2:
-			/* STATE2_MCP9808_I2C_READ_COMPLETED_EVENT */
-			if(P_TEMP_I2C_READ_FLAG_CHECK())
-			{
-				sm_ReportState(current_state);
-				P_TEMP_I2C_READ_FLAG_CLEAR();
-				//logTemp();
-				sprintf(LCD_print, "%s %f", "Temp(C): ", temp_reading);
-				displayPrintf(DISPLAY_ROW_TEMPERATURE, LCD_print);
-			}
-			break;
-
-		default:
-			/* Reset the state machine */
-			sm_HandleReset(current_state);
-			break;
-	}
+	//logTemp();
+	timeSeries_Insert(&sensor_series, SENSOR_SERIES_TEMPERATURE, SENSOR_SERIES_NOW(), (int16_t) (reading / 10));
+	sensorHistory_Append(SENSOR_HISTORY_TEMPERATURE, SENSOR_SERIES_NOW(), (int16_t) (reading / 10));
+	mcp9808_FormatMilliC(&LCD_print[sizeof("Temp(C): ") - 1], reading);
+	displayPrintf(DISPLAY_ROW_TEMPERATURE, LCD_print);
+
+	#ifdef MCP9808_ALERT_ENABLED
+	critical = mcp9808_AlertRearm();
+	#else
+	critical = reading >= MCP9808_T_CRIT_MC;
+	#endif
+
+	/* At or above T_CRIT the ALERT output gives no more edges: every second
+	 * at least, whatever the rate of change. */
+	period = sampleRate_Update(&mcp9808_sample_rate, sensor->time_ms, reading);
+	if(critical && period > WAKEUP_SAMPLE_PERIOD_MS)
+		period = WAKEUP_SAMPLE_PERIOD_MS;
+	sensor_SetPeriod(sensor, period, period / WAKEUP_SAMPLE_SLACK_DIV);
 }
 
 /**
@@ -146,28 +277,12 @@ void sm_HandleEvents(int current_state)
 
 const char *getStateReport(int current_state)
 {
-	switch(current_state)
-	{
-		case 0:
-			return "STATE0_MCP9808_TRANSACTION_START_EVENT";
-			break;
-
-		case 1:
-			return "STATE1_MCP9808_I2C_WRITE_COMPLETED_EVENT";
-			break;
-
-		case 2:
-			return "STATE2_MCP9808_I2C_READ_COMPLETED_EVENT";
-			break;
-
-		default:
-			return "STATE UNDEFINED";
-			break;
-	}
+	return fsm_StateName(&sensor_fsm, (uint8_t) current_state);
 }
 
 /**
- * @brief State Machine Clear interrupt flags
+ * @brief State Machine Start in STATE0 with no event pending, and register
+ * the sensors; after i2c_Init(), as their setup writes are queued on I2C0.
  *
  * @param void
  * @return void.
@@ -175,42 +290,30 @@ const char *getStateReport(int current_state)
 
 void sm_Init(void)
 {
-	/* Configuration for: Interrupt event bitmask OR Event processing bitmask
-	 *
-	 * 		0b | 0 0 0 0 | 0 0 0 0 |
-	 *  Bits ->  7 6 5 4   3 2 1 0
-	 *
-	 *		Flag Type						Bit			Set Condition (1)	Reset Condition (0)
-	 *
-	 *      LETIMER_WAIT_FLAG				-> 0		-> |= 0x01			-> &= 0xFE
-	 *      LPM_WARMUP_FLAG			 		-> 1		-> |= 0x02			-> &= 0xFD
-	 *      TEMP_I2C_WRITE_FLAG		 		-> 2		-> |= 0x04			-> &= 0xFB
-	 *      TEMP_I2C_READ_DELAY_FLAG		-> 3		-> |= 0x08			-> &= 0xF7
-	 *      TEMP_I2C_READ_FLAG				-> 4		-> |= 0x10			-> &= 0xEF
-	 *
-	 *      LPM_WARMUP_START_FLAG			-> 5		-> |= 0x20			-> &= 0xDF
-	 *      TEMP_I2C_READ_DELAY_START_FLAG	-> 6		-> |= 0x40  		-> &= 0xBF
-	 *
-	 *
-	 */
-
-	event_processing_bitmask = 0;
-	interrupt_event_bitmask = 0;
+	fsm_Init(&sensor_fsm, &sm_table, sensor_fsm_stats, NULL);
+
+	sampleRate_Init(&mcp9808_sample_rate, &sm_rate_config);
+
+	sensor_Init();
+	#ifdef MCP9808_ENABLED
+	sensor_Register(&mcp9808_sensor, &sm_mcp9808_desc);
+	#endif
+	#ifdef SENSOR_EXTRAS_ENABLED
+	for(uint8_t i = 0; i < sizeof(sm_extra_desc) / sizeof(sm_extra_desc[0]); i++)
+		sensor_Register(&sm_extra_sensors[i], &sm_extra_desc[i]);
+	#endif
 }
 
 /**
- * @brief State Machine Handle reset events
+ * @brief State Machine Handle one event taken from isr_event_ring
  *
- * @param int current_state
+ * @param uint8_t event
  * @return void.
  */
 
-void sm_HandleReset(int current_state)
+void sm_Handle(uint8_t event)
 {
-	if(current_state > 2 || current_state < 0)
-	{
-		current_state = 0;
-	}
+	fsm_Handle(&sensor_fsm, event);
 }
 
 /**
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file text_blit.c
+ *
+ * @brief Text drawn straight into the 1 bpp DMD frame buffer.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "dmd.h"
+#include "hardware/kit/common/drivers/display.h"
+#include <src/headers/text_blit.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Take the frame buffer and geometry of display device 0, after
+ * DMD_init().
+ *
+ * @param text_blit_t *blit
+ * @return bool false if it is not a 1 bpp display addressed by rows.
+ */
+bool textBlit_Init(text_blit_t *blit)
+{
+	DISPLAY_Device_t device;
+	void *frame;
+
+	memset(blit, 0, sizeof(*blit));
+	if(DISPLAY_DeviceGet(0, &device) != DISPLAY_EMSTATUS_OK || DMD_getFrameBuffer(&frame) != DMD_OK)
+		return false;
+
+	if(device.addressMode != DISPLAY_ADDRESSING_BY_ROWS_ONLY
+	   || (device.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME
+		   && device.colourMode != DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)
+	   || device.geometry.width > TEXT_BLIT_WIDTH_MAX)
+		return false;
+
+	blit->frame = frame;
+	blit->bytes_per_line = device.geometry.stride / 8;
+	blit->width = device.geometry.width;
+	blit->height = device.geometry.height;
+	blit->inverse = (device.colourMode == DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE);
+	return true;
+}
+
+/**
+ * @brief A full font with one byte per glyph row, at most 8 pixels wide.
+ *
+ * @param const text_blit_t *blit, const GLIB_Font_t *font
+ * @return bool.
+ */
+bool textBlit_Supports(const text_blit_t *blit, const GLIB_Font_t *font)
+{
+	return blit->frame && font->class == FullFont && font->sizeOfMapElement == 1 && font->fontWidth <= 8
+		   && font->cntOfMapElements >= ('~' - ' ' + 1);
+}
+
+/**
+ * @brief Draw a string in the foreground colour of the context, the top
+ * left corner of its first glyph at x, y, the way GLIB_drawString() with
+ * opaque false does, and mark its lines dirty.
+ *
+ * @param const text_blit_t *blit, const GLIB_Context_t *context,
+ * const char *text, uint8_t len, uint16_t x, uint16_t y
+ * @return bool false when nothing was drawn: GLIB should draw it.
+ */
+bool textBlit_String(const text_blit_t *blit, const GLIB_Context_t *context, const char *text, uint8_t len,
+					 uint16_t x, uint16_t y)
+{
+	const GLIB_Font_t *font = &context->font;
+	const uint8_t *pixmap = font->pFontPixMap;
+	uint32_t line[TEXT_BLIT_LINE_WORDS + 1];
+	uint16_t advance = font->fontWidth + font->charSpacing;
+	uint16_t first, last, row, i;
+	uint8_t red, green, blue;
+	bool set;
+
+	if(!textBlit_Supports(blit, font) || len == 0)
+		return false;
+	if((uint32_t) x + (uint32_t) len * advance - font->charSpacing > blit->width
+	   || (uint32_t) y + font->fontHeight > blit->height)
+		return false;
+	if((int32_t) x < context->clippingRegion.xMin || (int32_t) y < context->clippingRegion.yMin
+	   || (int32_t) (x + len * advance - font->charSpacing - 1) > context->clippingRegion.xMax
+	   || (int32_t) (y + font->fontHeight - 1) > context->clippingRegion.yMax)
+		return false;
+	for(i = 0; i < len; i++)
+	{
+		if(text[i] < ' ' || text[i] > '~')
+			return false;
+	}
+
+	/* The bits a foreground pixel takes, as DMD_writeColor() works it out. */
+	GLIB_colorTranslate24bpp(context->foregroundColor, &red, &green, &blue);
+	set = (green == 0) != blit->inverse;
+
+	first = x >> 5;
+	last = (x + len * advance - font->charSpacing - 1) >> 5;
+
+	for(row = 0; row < font->fontHeight; row++)
+	{
+		const uint8_t *glyphs = pixmap + row * font->fontRowOffset;
+		uint8_t *dst = blit->frame + (uint32_t) (y + row) * blit->bytes_per_line;
+		uint16_t bit = x;
+
+		memset(&line[first], 0, (last - first + 1) * sizeof(uint32_t));
+		for(i = 0; i < len; i++, bit += advance)
+		{
+			uint32_t glyph = glyphs[text[i] - ' '];
+			uint8_t shift = bit & 31;
+
+			line[bit >> 5] |= glyph << shift;
+			if(shift + font->fontWidth > 32)
+				line[(bit >> 5) + 1] |= glyph >> (32 - shift);
+		}
+
+		for(i = first; i <= last; i++)
+		{
+			uint32_t word;
+
+			if(line[i] == 0)
+				continue;
+			memcpy(&word, dst + i * 4, sizeof(word));
+			word = set ? (word | line[i]) : (word & ~line[i]);
+			memcpy(dst + i * 4, &word, sizeof(word));
+		}
+	}
+
+	/* Inside the frame, checked above. */
+	DMD_markRowsDirty(y, font->fontHeight);
+	return true;
+}
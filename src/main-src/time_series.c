@@ -0,0 +1,256 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file time_series.c
+ *
+ * @brief Fixed-memory time-series store for the sensor readings seen by
+ * the friend node.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <src/headers/time_series.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Bucket width and ring length per resolution. */
+static const uint16_t time_series_width[2] = { 60, 3600 };
+static const uint16_t time_series_length[2] = { TIME_SERIES_MINUTES, TIME_SERIES_HOURS };
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static time_series_rollup_t *timeSeries_Ring(time_series_channel_t *channel, time_series_resolution_t resolution)
+{
+	return (resolution == TIME_SERIES_MINUTE) ? channel->minutes : channel->hours;
+}
+
+static const time_series_rollup_t *timeSeries_RingConst(const time_series_channel_t *channel,
+														time_series_resolution_t resolution)
+{
+	return (resolution == TIME_SERIES_MINUTE) ? channel->minutes : channel->hours;
+}
+
+/**
+ * @brief Turn an accumulator into a rollup.
+ *
+ * @param const time_series_acc_t *acc, time_series_rollup_t *rollup
+ * @return void.
+ */
+static void timeSeries_Close(const time_series_acc_t *acc, time_series_rollup_t *rollup)
+{
+	rollup->count = acc->count;
+	rollup->min = acc->min;
+	rollup->max = acc->max;
+	rollup->mean = acc->count ? (int16_t) (acc->sum / (int32_t) acc->count) : 0;
+}
+
+/**
+ * @brief Add a sample to the open bucket of one resolution, closing it
+ * first if the sample belongs to a later bucket.
+ *
+ * Buckets skipped over are cleared, at most one ring's worth, so stale
+ * rollups never show up in place of a gap.
+ *
+ * @param time_series_channel_t *channel, time_series_resolution_t resolution,
+ * uint32_t time, int16_t value
+ * @return void.
+ */
+static void timeSeries_Accumulate(time_series_channel_t *channel, time_series_resolution_t resolution,
+								  uint32_t time, int16_t value)
+{
+	time_series_acc_t *acc = &channel->acc[resolution];
+	time_series_rollup_t *ring = timeSeries_Ring(channel, resolution);
+	uint16_t length = time_series_length[resolution];
+	uint32_t index = time / time_series_width[resolution];
+
+	if(acc->count && index != acc->index)
+	{
+		uint32_t gap = index - acc->index;
+
+		if(gap >= length)
+		{
+			/* The closed bucket would already be out of the ring. */
+			memset(ring, 0, length * sizeof(ring[0]));
+		}
+		else
+		{
+			timeSeries_Close(acc, &ring[acc->index % length]);
+			for(uint32_t i = 1; i < gap; i++)
+			{
+				memset(&ring[(acc->index + i) % length], 0, sizeof(ring[0]));
+			}
+		}
+		acc->count = 0;
+	}
+
+	if(!acc->count)
+	{
+		acc->index = index;
+		acc->sum = 0;
+		acc->min = value;
+		acc->max = value;
+	}
+
+	acc->sum += value;
+	acc->count++;
+	if(value < acc->min)
+		acc->min = value;
+	if(value > acc->max)
+		acc->max = value;
+}
+
+/**
+ * @brief Empty the store.
+ *
+ * @param time_series_t *series
+ * @return void.
+ */
+void timeSeries_Init(time_series_t *series)
+{
+	memset(series, 0, sizeof(*series));
+}
+
+/**
+ * @brief Record a sample.
+ *
+ * Samples older than the newest one of the channel are booked at the time
+ * of the newest one, so the rings only move forward. A sample in the same
+ * TIME_SERIES_RAW_STEP slot as the newest raw one replaces it; the rollups
+ * take every sample.
+ *
+ * @param time_series_t *series, uint16_t channel, uint32_t time (seconds), int16_t value
+ * @return bool False if the channel is not tracked.
+ */
+bool timeSeries_Insert(time_series_t *series, uint16_t channel, uint32_t time, int16_t value)
+{
+	time_series_channel_t *ch;
+
+	if(channel >= TIME_SERIES_CHANNELS)
+	{
+		series->dropped++;
+		return false;
+	}
+
+	ch = &series->channel[channel];
+	if(ch->raw_count && time < ch->last_time)
+		time = ch->last_time;
+
+	if(ch->raw_count && time / TIME_SERIES_RAW_STEP == ch->last_time / TIME_SERIES_RAW_STEP)
+	{
+		/* Same slot: overwrite the newest raw sample. */
+		ch->raw_head = (ch->raw_head + TIME_SERIES_RAW_SAMPLES - 1) % TIME_SERIES_RAW_SAMPLES;
+	}
+	else if(ch->raw_count < TIME_SERIES_RAW_SAMPLES)
+	{
+		ch->raw_count++;
+	}
+	ch->last_time = time;
+
+	ch->raw[ch->raw_head].time = (uint16_t) time;
+	ch->raw[ch->raw_head].value = value;
+	ch->raw_head = (ch->raw_head + 1) % TIME_SERIES_RAW_SAMPLES;
+
+	timeSeries_Accumulate(ch, TIME_SERIES_MINUTE, time, value);
+	timeSeries_Accumulate(ch, TIME_SERIES_HOUR, time, value);
+
+	series->inserts++;
+	return true;
+}
+
+/**
+ * @brief Read a raw sample back, newest first.
+ *
+ * @param const time_series_t *series, uint16_t channel, uint16_t age (0 for the newest),
+ * uint32_t *time, int16_t *value
+ * @return bool False if there is no such sample.
+ */
+bool timeSeries_Raw(const time_series_t *series, uint16_t channel, uint16_t age, uint32_t *time, int16_t *value)
+{
+	const time_series_channel_t *ch;
+	const time_series_sample_t *sample;
+
+	if(channel >= TIME_SERIES_CHANNELS || age >= series->channel[channel].raw_count)
+		return false;
+
+	ch = &series->channel[channel];
+	sample = &ch->raw[(ch->raw_head + TIME_SERIES_RAW_SAMPLES - 1 - age) % TIME_SERIES_RAW_SAMPLES];
+
+	/* Raw samples span far less than 2^16 s, so the low bits are enough. */
+	*time = ch->last_time - (uint16_t) ((uint16_t) ch->last_time - sample->time);
+	*value = sample->value;
+	return true;
+}
+
+/**
+ * @brief Number of raw samples taken in the last TIME_SERIES_RAW_MINUTES,
+ * at most one per TIME_SERIES_RAW_STEP slot.
+ *
+ * @param const time_series_t *series, uint16_t channel, uint32_t now
+ * @return uint16_t.
+ */
+uint16_t timeSeries_RawCount(const time_series_t *series, uint16_t channel, uint32_t now)
+{
+	uint32_t time;
+	int16_t value;
+	uint16_t count = 0;
+
+	while(timeSeries_Raw(series, channel, count, &time, &value) && now - time < TIME_SERIES_RAW_MINUTES * 60)
+	{
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Rollup of one minute or hour bucket.
+ *
+ * Age 0 is the bucket holding now, which is still open; age 1 the one
+ * before it and so on. Buckets without samples come back with count 0.
+ *
+ * @param const time_series_t *series, uint16_t channel, time_series_resolution_t resolution,
+ * uint32_t now, uint16_t age, time_series_rollup_t *rollup
+ * @return bool False if the bucket is out of the ring or the channel is not tracked.
+ */
+bool timeSeries_Rollup(const time_series_t *series, uint16_t channel, time_series_resolution_t resolution,
+					   uint32_t now, uint16_t age, time_series_rollup_t *rollup)
+{
+	const time_series_channel_t *ch;
+	const time_series_acc_t *acc;
+	uint16_t length = time_series_length[resolution];
+	uint32_t index = now / time_series_width[resolution];
+
+	if(channel >= TIME_SERIES_CHANNELS || age >= length || age > index)
+		return false;
+
+	ch = &series->channel[channel];
+	acc = &ch->acc[resolution];
+	index -= age;
+
+	memset(rollup, 0, sizeof(*rollup));
+
+	if(!acc->count || index > acc->index)
+		return true;
+
+	if(index == acc->index)
+	{
+		timeSeries_Close(acc, rollup);
+	}
+	else if(acc->index - index < length)
+	{
+		*rollup = timeSeries_RingConst(ch, resolution)[index % length];
+	}
+	return true;
+}
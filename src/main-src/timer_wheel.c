@@ -0,0 +1,416 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file timer_wheel.c
+ *
+ * @brief Hierarchical timer wheel on one hardware timer.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "em_device.h"
+#include "em_rtcc.h"
+#include <src/headers/timer_wheel.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE STATEMENTS
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIMER_WHEEL_SHIFT(level)	((level) * TIMER_WHEEL_LEVEL_SHIFT)
+#define TIMER_WHEEL_MASK			(TIMER_WHEEL_SLOTS - 1)
+
+/* Deadlines are compared as wrapping differences. */
+#define TIMER_WHEEL_AFTER(a, b)		((int32_t) ((a) - (b)) > 0)
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* RTCC count and the part of a wheel tick not yet handed out, for the default clock. */
+static uint32_t timer_wheel_rtcc_last;
+static uint32_t timer_wheel_rtcc_ticks;
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Default clock: the RTCC in wheel ticks. The RTCC keeps counting in
+ * EM2; extending it here keeps the wheel time wrapping at 32 bits.
+ *
+ * @param void
+ * @return uint32_t.
+ */
+static uint32_t timerWheel_Rtcc(void)
+{
+	uint32_t rtcc = RTCC_CounterGet();
+	uint32_t elapsed = (rtcc - timer_wheel_rtcc_last) >> TIMER_WHEEL_RTCC_SHIFT;
+
+	timer_wheel_rtcc_last += elapsed << TIMER_WHEEL_RTCC_SHIFT;
+	timer_wheel_rtcc_ticks += elapsed;
+	return timer_wheel_rtcc_ticks;
+}
+
+/**
+ * @brief Index of the lowest set bit, the map must not be zero.
+ *
+ * @param uint64_t map
+ * @return uint8_t.
+ */
+static uint8_t timerWheel_Ctz(uint64_t map)
+{
+	uint32_t low = (uint32_t) map;
+
+	if(low)
+		return __CLZ(__RBIT(low));
+	return (uint8_t) (32 + __CLZ(__RBIT((uint32_t) (map >> 32))));
+}
+
+/**
+ * @brief Ticks from the wheel time to the next slot holding timers.
+ *
+ * @param const timer_wheel_t *wheel, uint32_t *ticks
+ * @return bool False if the wheel is empty.
+ */
+static bool timerWheel_NextDelta(const timer_wheel_t *wheel, uint32_t *ticks)
+{
+	bool found = false;
+
+	for(uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+	{
+		uint8_t shift = TIMER_WHEEL_SHIFT(level);
+		uint32_t next = (wheel->clk >> shift) + 1;
+		uint8_t start = (uint8_t) (next & TIMER_WHEEL_MASK);
+		uint64_t map = wheel->occupied[level];
+		uint32_t delta;
+
+		if(!map)
+			continue;
+
+		/* Rotate the map so that bit 0 is the first slot still to come. */
+		if(start)
+			map = (map >> start) | (map << (TIMER_WHEEL_SLOTS - start));
+
+		delta = ((next + timerWheel_Ctz(map)) << shift) - wheel->clk;
+		if(!found || delta < *ticks)
+			*ticks = delta;
+		found = true;
+	}
+	return found;
+}
+
+/**
+ * @brief Link a timer into the slot of its deadline, relative to the wheel
+ * time. Deadlines already passed go to the next tick, deadlines beyond the
+ * top level to its furthest slot.
+ *
+ * @param timer_wheel_t *wheel, timer_wheel_timer_t *timer
+ * @return void.
+ */
+static void timerWheel_Enqueue(timer_wheel_t *wheel, timer_wheel_timer_t *timer)
+{
+	uint32_t delta = TIMER_WHEEL_AFTER(timer->expires, wheel->clk) ? timer->expires - wheel->clk : 1;
+	uint8_t level = 0;
+	uint8_t shift;
+	uint8_t index;
+	timer_wheel_timer_t **head;
+
+	while(level < TIMER_WHEEL_LEVELS - 1 && delta >= ((uint32_t) TIMER_WHEEL_LEVEL_RANGE << TIMER_WHEEL_SHIFT(level)))
+		level++;
+
+	shift = TIMER_WHEEL_SHIFT(level);
+	if(delta >= ((uint32_t) TIMER_WHEEL_LEVEL_RANGE << shift))
+		delta = ((uint32_t) TIMER_WHEEL_LEVEL_RANGE << shift) - 1;
+
+	/* Round up to the end of the slot: the timer may fire late, never early. */
+	index = (uint8_t) (((wheel->clk + delta + (1UL << shift) - 1) >> shift) & TIMER_WHEEL_MASK);
+	head = &wheel->slot[level][index];
+
+	timer->next = *head;
+	if(timer->next)
+		timer->next->pprev = &timer->next;
+	timer->pprev = head;
+	*head = timer;
+	wheel->occupied[level] |= 1ULL << index;
+}
+
+/**
+ * @brief Unlink a timer from its list. Only the first timer of a slot is
+ * linked from the slot array, and only its removal can empty the slot.
+ *
+ * @param timer_wheel_t *wheel, timer_wheel_timer_t *timer
+ * @return void.
+ */
+static void timerWheel_Unlink(timer_wheel_t *wheel, timer_wheel_timer_t *timer)
+{
+	timer_wheel_timer_t **pprev = timer->pprev;
+
+	*pprev = timer->next;
+	if(timer->next)
+		timer->next->pprev = pprev;
+	timer->next = NULL;
+	timer->pprev = NULL;
+
+	if(*pprev == NULL && pprev >= &wheel->slot[0][0] && pprev < &wheel->slot[0][0] + (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS))
+	{
+		uint32_t slot = (uint32_t) (pprev - &wheel->slot[0][0]);
+
+		wheel->occupied[slot / TIMER_WHEEL_SLOTS] &= ~(1ULL << (slot % TIMER_WHEEL_SLOTS));
+	}
+}
+
+/**
+ * @brief Program the hardware timer for the next due slot, if it is
+ * earlier than the one already programmed; stop it if the wheel is empty.
+ *
+ * @param timer_wheel_t *wheel
+ * @return void.
+ */
+static void timerWheel_Arm(timer_wheel_t *wheel)
+{
+	uint32_t ticks;
+	uint32_t deadline;
+	uint32_t now;
+
+	if(!timerWheel_NextDelta(wheel, &ticks))
+	{
+		if(wheel->is_armed)
+		{
+			wheel->is_armed = false;
+			wheel->stats.arms++;
+			wheel->arm(0);
+		}
+		return;
+	}
+
+	deadline = wheel->clk + ticks;
+	if(wheel->is_armed && !TIMER_WHEEL_AFTER(wheel->armed, deadline))
+		return;
+
+	now = wheel->clock();
+	wheel->armed = deadline;
+	wheel->is_armed = true;
+	wheel->stats.arms++;
+	wheel->arm(TIMER_WHEEL_AFTER(deadline, now) ? deadline - now : 1);
+}
+
+/**
+ * @brief Expire the slots due at the wheel time, lowest level first.
+ * Callbacks may start and stop any timer, including their own.
+ *
+ * @param timer_wheel_t *wheel, uint32_t now
+ * @return bool True if a callback ran or a timer moved on.
+ */
+static bool timerWheel_Expire(timer_wheel_t *wheel, uint32_t now)
+{
+	bool work = false;
+
+	for(uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+	{
+		uint8_t shift = TIMER_WHEEL_SHIFT(level);
+		uint8_t index = (uint8_t) ((wheel->clk >> shift) & TIMER_WHEEL_MASK);
+		timer_wheel_timer_t *expired;
+
+		/* A slot of a level is due only on its boundary, and so are the ones above it. */
+		if(wheel->clk & ((1UL << shift) - 1))
+			break;
+		if(!(wheel->occupied[level] & (1ULL << index)))
+			continue;
+
+		/* Move the whole slot to a local list first, so that a timer its
+		 * callback restarts lands in a slot still to come. */
+		expired = wheel->slot[level][index];
+		wheel->slot[level][index] = NULL;
+		wheel->occupied[level] &= ~(1ULL << index);
+		expired->pprev = &expired;
+		wheel->stats.slots++;
+
+		while(expired)
+		{
+			timer_wheel_timer_t *timer = expired;
+
+			timerWheel_Unlink(wheel, timer);
+			work = true;
+
+			if(TIMER_WHEEL_AFTER(timer->expires, wheel->clk))
+			{
+				wheel->stats.requeued++;
+				timerWheel_Enqueue(wheel, timer);
+				continue;
+			}
+
+			if(now - timer->expires > wheel->stats.late_max)
+				wheel->stats.late_max = now - timer->expires;
+
+			/* Periodic timers keep their phase; periods missed while the node was held up are dropped. */
+			if(timer->period)
+			{
+				timer->expires += timer->period;
+				if(!TIMER_WHEEL_AFTER(timer->expires, wheel->clk))
+					timer->expires = wheel->clk + timer->period;
+				timerWheel_Enqueue(wheel, timer);
+			}
+			else
+				wheel->count--;
+
+			wheel->stats.fired++;
+			timer->callback(timer);
+		}
+	}
+	return work;
+}
+
+/**
+ * @brief Empty the wheel and install its clock (NULL for the RTCC) and the
+ * function that programs its hardware timer.
+ *
+ * @param timer_wheel_t *wheel, uint32_t (*clock)(void), void (*arm)(uint32_t ticks)
+ * @return void.
+ */
+void timerWheel_Init(timer_wheel_t *wheel, uint32_t (*clock)(void), void (*arm)(uint32_t ticks))
+{
+	memset(wheel, 0, sizeof(*wheel));
+
+	if(!clock)
+	{
+		timer_wheel_rtcc_last = RTCC_CounterGet();
+		timer_wheel_rtcc_ticks = 0;
+		clock = timerWheel_Rtcc;
+	}
+
+	wheel->clock = clock;
+	wheel->arm = arm;
+	wheel->clk = clock();
+}
+
+void timerWheel_Setup(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *context)
+{
+	memset(timer, 0, sizeof(*timer));
+	timer->callback = callback;
+	timer->context = context;
+}
+
+/**
+ * @brief Start a timer, or restart it if it is running.
+ *
+ * @param timer_wheel_t *wheel, timer_wheel_timer_t *timer, uint32_t delay
+ * (ticks, 0 means the next tick), uint32_t period (ticks, 0 for one-shot)
+ * @return void.
+ */
+void timerWheel_Start(timer_wheel_t *wheel, timer_wheel_timer_t *timer, uint32_t delay, uint32_t period)
+{
+	uint32_t now = wheel->clock();
+	uint32_t ticks;
+
+	if(timer->pprev)
+		timerWheel_Unlink(wheel, timer);
+	else
+		wheel->count++;
+
+	/* Bring an idle wheel up to date, stopping short of the next due slot,
+	 * so that the delay is placed at the resolution it deserves. */
+	if(!wheel->running && TIMER_WHEEL_AFTER(now, wheel->clk))
+	{
+		if(!timerWheel_NextDelta(wheel, &ticks))
+			wheel->clk = now;
+		else if(TIMER_WHEEL_AFTER(wheel->clk + ticks, now))
+			wheel->clk = now;
+		else
+			wheel->clk += ticks - 1;
+	}
+
+	timer->expires = now + (delay ? delay : 1);
+	timer->period = period;
+	timerWheel_Enqueue(wheel, timer);
+
+	wheel->stats.starts++;
+	if(wheel->count > wheel->stats.count_max)
+		wheel->stats.count_max = wheel->count;
+
+	if(!wheel->running)
+		timerWheel_Arm(wheel);
+}
+
+/**
+ * @brief Stop a timer; nothing happens if it is not running.
+ *
+ * @param timer_wheel_t *wheel, timer_wheel_timer_t *timer
+ * @return void.
+ */
+void timerWheel_Stop(timer_wheel_t *wheel, timer_wheel_timer_t *timer)
+{
+	if(!timer->pprev)
+		return;
+
+	timerWheel_Unlink(wheel, timer);
+	wheel->count--;
+	wheel->stats.stops++;
+
+	/* Leave the hardware timer alone unless nothing is left to wait for. */
+	if(!wheel->running && !wheel->count)
+		timerWheel_Arm(wheel);
+}
+
+bool timerWheel_Pending(const timer_wheel_timer_t *timer)
+{
+	return timer->pprev != NULL;
+}
+
+/**
+ * @brief Run every timer due by now, then program the hardware timer for
+ * the next one. Call when the hardware timer fires.
+ *
+ * @param timer_wheel_t *wheel
+ * @return void.
+ */
+void timerWheel_Run(timer_wheel_t *wheel)
+{
+	uint32_t now = wheel->clock();
+	uint32_t ticks;
+	bool work = false;
+
+	wheel->stats.wakeups++;
+	wheel->running = true;
+	wheel->is_armed = false;
+
+	while(timerWheel_NextDelta(wheel, &ticks) && !TIMER_WHEEL_AFTER(wheel->clk + ticks, now))
+	{
+		wheel->clk += ticks;
+		work |= timerWheel_Expire(wheel, now);
+	}
+	if(TIMER_WHEEL_AFTER(now, wheel->clk))
+		wheel->clk = now;
+
+	if(!work)
+		wheel->stats.empty_wakeups++;
+
+	wheel->running = false;
+	timerWheel_Arm(wheel);
+}
+
+/**
+ * @brief Ticks from now until the next due slot.
+ *
+ * @param timer_wheel_t *wheel, uint32_t *ticks
+ * @return bool False if no timer is running.
+ */
+bool timerWheel_Next(timer_wheel_t *wheel, uint32_t *ticks)
+{
+	uint32_t now = wheel->clock();
+	uint32_t delta;
+
+	if(!timerWheel_NextDelta(wheel, &delta))
+		return false;
+
+	*ticks = TIMER_WHEEL_AFTER(wheel->clk + delta, now) ? wheel->clk + delta - now : 0;
+	return true;
+}
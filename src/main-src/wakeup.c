@@ -0,0 +1,322 @@
+/******************************************************************************
+ * ECEN 5823 IoT Embedded Firmware (Spring-2020)
+ * Final Course Project Firmware
+ * Node		: Friend Node
+ * Author	: Rushi James Macwan
+ ******************************************************************************/
+
+/* @file wakeup.c
+ *
+ * @brief Tickless wakeup coordinator for the periodic activities.
+ *
+ * @author Rushi James Macwan
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// HEADER FILES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "sl_sleeptimer.h"
+#include <src/headers/header.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL VARIABLES & DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+static wakeup_activity_t *wakeup_list;
+static wakeup_stats_t wakeup_stats;
+
+static sl_sleeptimer_timer_handle_t wakeup_timer;
+static uint32_t wakeup_hz;					// Sleeptimer frequency, 0 before wakeup_Init()
+static uint64_t wakeup_boot;				// Tick count at wakeup_Init()
+static bool wakeup_running;					// In wakeup_Run(), schedule once at the end
+
+////////////////////////////////////////////////////////////////////////////////
+// FUNCTION DEFINITIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/* Tick count a is before b, across the 32 bit wrap. */
+static bool wakeup_Before(uint32_t a, uint32_t b)
+{
+	return (int32_t) (a - b) < 0;
+}
+
+/* The window of an activity has opened: it is due within its slack. */
+static bool wakeup_Open(const wakeup_activity_t *activity, uint32_t now)
+{
+	return !wakeup_Before(now, activity->due - activity->slack);
+}
+
+static uint32_t wakeup_MsToTicks(uint32_t ms)
+{
+	return (uint32_t) (((uint64_t) ms * wakeup_hz + 999) / 1000);
+}
+
+/**
+ * @brief Sleeptimer callback, in the RTCC interrupt: hand the wakeup to
+ * the main loop.
+ *
+ * @param sl_sleeptimer_timer_handle_t *handle, void *data
+ * @return void.
+ */
+static void wakeup_Expired(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+	(void) handle;
+	(void) data;
+
+	eventRing_Push(&isr_event_ring, ISR_EVENT_WAKEUP, 0);
+	gecko_external_signal(GECKO_ISR_EVENT_SIGNAL);
+}
+
+/**
+ * @brief Program the sleeptimer for the next wakeup.
+ *
+ * The wakeup may come no later than the earliest due time plus slack of
+ * any activity. It is put at the latest due time before that limit: every
+ * activity due by then runs on time or within its slack, and one whose
+ * window has opened by then runs early rather than on a wakeup of its own.
+ *
+ * @param void
+ * @return void.
+ */
+static void wakeup_Schedule(void)
+{
+	wakeup_activity_t *activity;
+	uint32_t limit = 0, when = 0, now;
+	bool found = false;
+
+	if(wakeup_running)
+		return;
+
+	sl_sleeptimer_stop_timer(&wakeup_timer);
+	if(!wakeup_list)
+		return;
+
+	for(activity = wakeup_list; activity; activity = activity->next)
+	{
+		if(activity == wakeup_list || wakeup_Before(activity->due + activity->slack, limit))
+			limit = activity->due + activity->slack;
+	}
+
+	/* The activity setting the limit is due by then itself, so one is always found. */
+	for(activity = wakeup_list; activity; activity = activity->next)
+	{
+		if(!wakeup_Before(limit, activity->due) && (!found || wakeup_Before(when, activity->due)))
+		{
+			when = activity->due;
+			found = true;
+		}
+	}
+
+	now = sl_sleeptimer_get_tick_count();
+	wakeup_stats.arms++;
+	sl_sleeptimer_start_timer(&wakeup_timer, wakeup_Before(now, when) ? when - now : 0, wakeup_Expired, NULL, 0,
+							  SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG);
+}
+
+/**
+ * @brief Start the sleeptimer and forget any activity; before the first
+ * wakeup_Start() and the first time stamp.
+ *
+ * @param void
+ * @return void.
+ */
+void wakeup_Init(void)
+{
+	/* Already done by the stack on the target; a second call returns at once. */
+	sl_sleeptimer_init();
+
+	sl_sleeptimer_stop_timer(&wakeup_timer);
+	wakeup_list = NULL;
+	wakeup_running = false;
+	memset(&wakeup_stats, 0, sizeof(wakeup_stats));
+
+	wakeup_hz = sl_sleeptimer_get_timer_frequency();
+	wakeup_boot = sl_sleeptimer_get_tick_count64();
+}
+
+/**
+ * @brief Describe an activity; it does not run until wakeup_Start().
+ *
+ * @param wakeup_activity_t *activity, const char *name, void (*run)(void *context),
+ * void *context, uint32_t period_ms, uint32_t slack_ms, bool keep_phase
+ * @return void.
+ */
+void wakeup_Setup(wakeup_activity_t *activity, const char *name, void (*run)(void *context), void *context,
+				  uint32_t period_ms, uint32_t slack_ms, bool keep_phase)
+{
+	memset(activity, 0, sizeof(*activity));
+	activity->name = name;
+	activity->run = run;
+	activity->context = context;
+	activity->period = wakeup_MsToTicks(period_ms);
+	activity->slack = wakeup_MsToTicks(slack_ms);
+	activity->keep_phase = keep_phase;
+}
+
+/**
+ * @brief (Re)start an activity; it is first due one period from now.
+ *
+ * @param wakeup_activity_t *activity
+ * @return void.
+ */
+void wakeup_Start(wakeup_activity_t *activity)
+{
+	if(!activity->active)
+	{
+		activity->next = wakeup_list;
+		wakeup_list = activity;
+		activity->active = true;
+	}
+
+	activity->due = sl_sleeptimer_get_tick_count() + activity->period;
+	wakeup_Schedule();
+}
+
+void wakeup_Stop(wakeup_activity_t *activity)
+{
+	wakeup_activity_t **link;
+
+	if(!activity->active)
+		return;
+
+	for(link = &wakeup_list; *link; link = &(*link)->next)
+	{
+		if(*link == activity)
+		{
+			*link = activity->next;
+			break;
+		}
+	}
+
+	activity->next = NULL;
+	activity->active = false;
+	wakeup_Schedule();
+}
+
+/**
+ * @brief Change the period and slack of an activity without stopping it.
+ * It is due one new period after its last due time (its start, before the
+ * first run), or one new period from now if that has passed already.
+ *
+ * @param wakeup_activity_t *activity, uint32_t period_ms, uint32_t slack_ms
+ * @return void.
+ */
+void wakeup_SetPeriod(wakeup_activity_t *activity, uint32_t period_ms, uint32_t slack_ms)
+{
+	uint32_t last = activity->due - activity->period;
+	uint32_t now;
+
+	activity->period = wakeup_MsToTicks(period_ms);
+	activity->slack = wakeup_MsToTicks(slack_ms);
+	if(!activity->active)
+		return;
+
+	now = sl_sleeptimer_get_tick_count();
+	activity->due = last + activity->period;
+	if(wakeup_Before(activity->due, now))
+		activity->due = now + activity->period;
+	wakeup_Schedule();
+}
+
+/**
+ * @brief Run every activity that is due, on ISR_EVENT_WAKEUP, and program
+ * the next wakeup.
+ *
+ * @param void
+ * @return void.
+ */
+void wakeup_Run(void)
+{
+	wakeup_activity_t *activity, *next;
+	uint32_t now = sl_sleeptimer_get_tick_count();
+	uint32_t open = 0;
+
+	wakeup_stats.wakeups++;
+
+	for(activity = wakeup_list; activity; activity = activity->next)
+	{
+		if(wakeup_Open(activity, now))
+			open++;
+	}
+
+	if(!open)
+		wakeup_stats.empty_wakeups++;
+
+	wakeup_running = true;
+	for(activity = wakeup_list; activity; activity = next)
+	{
+		next = activity->next;
+		if(!wakeup_Open(activity, now))
+			continue;
+
+		activity->stats.runs++;
+		if(open > 1)
+			activity->stats.shared++;
+		if(wakeup_Before(now, activity->due))
+		{
+			if(activity->due - now > activity->stats.early_max)
+				activity->stats.early_max = activity->due - now;
+		}
+		else if(now - activity->due > activity->stats.late_max)
+			activity->stats.late_max = now - activity->due;
+		wakeup_stats.runs++;
+
+		if(activity->keep_phase)
+		{
+			activity->due += activity->period;
+
+			/* Periods missed altogether are skipped, not made up for. */
+			if(!wakeup_Before(now, activity->due))
+				activity->due += ((now - activity->due) / activity->period + 1) * activity->period;
+		}
+		else
+			activity->due = now + activity->period;
+
+		activity->run(activity->context);
+	}
+	wakeup_running = false;
+
+	wakeup_Schedule();
+}
+
+/**
+ * @brief Milliseconds since wakeup_Init(), on the sleeptimer (RTCC); the
+ * firmware time stamp.
+ *
+ * @param void
+ * @return uint32_t.
+ */
+uint32_t wakeup_TimeMs(void)
+{
+	if(!wakeup_hz)
+		return 0;
+
+	return (uint32_t) (((sl_sleeptimer_get_tick_count64() - wakeup_boot) * 1000) / wakeup_hz);
+}
+
+/**
+ * @brief Seconds since wakeup_Init(), from the 64 bit tick count so it does
+ * not wrap with wakeup_TimeMs() after 49.7 days; the sensor history clock.
+ *
+ * @param void
+ * @return uint32_t.
+ */
+uint32_t wakeup_TimeS(void)
+{
+	if(!wakeup_hz)
+		return 0;
+
+	return (uint32_t) ((sl_sleeptimer_get_tick_count64() - wakeup_boot) / wakeup_hz);
+}
+
+const wakeup_stats_t *wakeup_Stats(void)
+{
+	return &wakeup_stats;
+}
+
+const wakeup_activity_t *wakeup_Activities(void)
+{
+	return wakeup_list;
+}
@@ -49,7 +49,21 @@ int main(void)
 	{
 		gecko_external_evt_handler();
 
+		/* One LCD frame for every row written since the last wait, ahead
+		 * of the housekeeping so it does not wait behind flash work. */
+		displayFlush();
+
+		/* Housekeeping that may erase flash runs only when no event waits,
+		 * and the MX25 only while no LCD frame is on USART1. */
+		if(!gecko_event_pending())
+		{
+			alarmJournal_Idle();
+			if(!displayBusy())
+				sensorHistory_Idle();
+		}
+
 		struct gecko_cmd_packet *evt = gecko_wait_event();
+		latency_Arrive();
 		bool pass = mesh_bgapi_listener(evt);
 
 		if (pass)